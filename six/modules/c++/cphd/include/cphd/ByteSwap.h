@@ -38,13 +38,32 @@ namespace cphd
  *  \param buffer Buffer to swap (contents will be overridden)
  *  \param elemSize Size of each element in 'buffer'
  *  \param numElements Number of elements in 'buffer'
- *  \param numThreads Number of threads to use for byte-swapping
+ *  \param numThreads Number of threads to use for byte-swapping.  These
+ *         come from six::Executor::get(numThreads), so aren't started anew
+ *         on each call.
  */
 void byteSwap(void* buffer,
               size_t elemSize,
               size_t numElements,
               size_t numThreads);
 
+/*
+ *  \func byteSwap
+ *  \brief Threaded byte-swapping into another buffer
+ *
+ *  \param input Buffer to swap
+ *  \param elemSize Size of each element in 'input'
+ *  \param numElements Number of elements in 'input'
+ *  \param numThreads Number of threads to use for byte-swapping
+ *  \param output Buffer of the same size as 'input' to swap into.  Must not
+ *         overlap 'input'.
+ */
+void byteSwap(const void* input,
+              size_t elemSize,
+              size_t numElements,
+              size_t numThreads,
+              void* output);
+
 /*
  *  \func byteSwapAndPromote
  *  \brief Threaded byte-swapping and promote input to complex<floats>
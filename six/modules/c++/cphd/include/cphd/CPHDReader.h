@@ -154,8 +154,10 @@ private:
 
     /*
      *  Read in header, metadata, supportblock, pvpblock and wideband
+     *  If pathname isn't empty, the wideband is read from it directly
      */
     void initialize(std::shared_ptr<io::SeekableInputStream> inStream,
+                    const std::string& pathname,
                     size_t numThreads,
                     std::shared_ptr<logging::Logger> logger,
                     const std::vector<std::string>& schemaPaths);
@@ -91,7 +91,9 @@ protected:
  *
  *  \brief Class to handle writing to output stream and byte swapping
  *
- *  For little endian to big endian storage
+ *  For little endian to big endian storage.  Data is swapped a chunk at a
+ *  time into one of two scratch buffers, so the next chunk is being swapped
+ *  while the last one is being written.
  */
 struct DataWriterLittleEndian final : public DataWriter
 {
@@ -101,7 +103,8 @@ struct DataWriterLittleEndian final : public DataWriter
      *
      *  \param stream The seekable output stream to be written
      *  \param numThreads Number of threads for parallel processing
-     *  \param scratchSize Size of buffer to be used for scratch space
+     *  \param scratchSize Total size of the buffers to be used for scratch
+     *         space; each chunk written is half this
      */
     DataWriterLittleEndian(std::shared_ptr<io::SeekableOutputStream> stream,
                            size_t numThreads,
@@ -127,8 +130,8 @@ struct DataWriterLittleEndian final : public DataWriter
 
 
 private:
-    // Scratch space buffer
-    std::vector<std::byte> mScratch;
+    // Scratch space buffers: one being written, one being swapped into
+    std::vector<std::byte> mScratch[2];
 };
 
 /*
@@ -197,7 +200,8 @@ struct CPHDWriter
      *  \param schemaPaths (Optional) A vector of XML schema paths for validation
      *  \param numThreads (Optional) The number of threads to use for processing.
      *  \param scratchSpaceSize (Optional) The maximum size of internal scratch space
-     *         that may be used if byte swapping is necessary.
+     *         that may be used if byte swapping is necessary.  It's split in
+     *         two so that swapping and writing can overlap.
      *         Default is 4 MB
      */
     CPHDWriter(
@@ -223,7 +227,8 @@ struct CPHDWriter
      *  \param schemaPaths (Optional) A vector of XML schema paths for validation
      *  \param numThreads (Optional) The number of threads to use for processing.
      *  \param scratchSpaceSize (Optional) The maximum size of internal scratch space
-     *         that may be used if byte swapping is necessary.
+     *         that may be used if byte swapping is necessary.  It's split in
+     *         two so that swapping and writing can overlap.
      *         Default is 4 MB
      */
     CPHDWriter(
@@ -272,6 +277,65 @@ struct CPHDWriter
      */
     void writeMetadata(const PVPBlock& pvpBlock);
 
+    /*
+     *  \func writeMetadata
+     *  \brief Writes the header and metadata into the file, with the PVP
+     *  and signal block sizes taken from the metadata.
+     *
+     *  This starts a file whose vectors will be written with
+     *  appendVectors(), so nothing has to be held in memory for a whole
+     *  channel.  Support arrays can be written with writeSupportData(data)
+     *  at any point before close().  Vectors are written where they go in
+     *  the file, so the output stream has to allow seeking past its end,
+     *  as files do.
+     */
+    void writeMetadata();
+
+    /*
+     *  \func appendVectors
+     *  \brief Writes the next vectors of a channel: their PVPs and their
+     *  signal data.
+     *
+     *  Each channel's vectors must be appended in order, but channels can be
+     *  appended to in any order, e.g. interleaved as pulses arrive.  Each
+     *  call writes straight to where the vectors go in the file.
+     *  writeMetadata() must be called first.  Not for compressed signal
+     *  arrays.
+     *
+     *  \param channel The channel to append to
+     *  \param pvpSets The PVPs of the vectors, as channel 0 of a PVPBlock
+     *  made with this file's Pvp.  Its number of vectors is the number to
+     *  append.
+     *  \param samples The signal data of the vectors: the number of vectors
+     *  times the channel's number of samples.  Valid types are the same as
+     *  for writeCPHDData().
+     *
+     *  \throws except::Exception if the channel doesn't have room for that
+     *  many more vectors
+     */
+    template <typename T>
+    void appendVectors(size_t channel,
+                       const PVPBlock& pvpSets,
+                       const T* samples);
+
+    /*
+     *  \func appendVectors
+     *  \brief As above, with the PVPs already laid out as in the file, but
+     *  in native byte order (as from PVPBlock::getPVPdata()).
+     *
+     *  \param numVectors The number of vectors to append
+     */
+    template <typename T>
+    void appendVectors(size_t channel,
+                       size_t numVectors,
+                       const std::byte* pvpData,
+                       const T* samples);
+
+    /*
+     *  \return The number of vectors appended to a channel so far
+     */
+    size_t getNumVectorsAppended(size_t channel) const;
+
     /*
      *  \func writeSupportData
      *  \brief Writes the specified support Array to the file
@@ -347,10 +411,14 @@ struct CPHDWriter
                        size_t numElements,
                        size_t channel = 1);
 
-    void close()
-    {
-        mStream->close();
-    }
+    /*
+     *  \func close
+     *  \brief Closes the output stream
+     *
+     *  \throws except::Exception if appendVectors() was used and some
+     *  channel didn't get all of its vectors
+     */
+    void close();
 
 private:
     /*
@@ -379,6 +447,14 @@ private:
     void writeCompressedCPHDDataImpl(const std::byte* data,
                                      size_t channel);
 
+    /*
+     *  Implementation of append vectors
+     */
+    void appendVectorsImpl(size_t channel,
+                           size_t numVectors,
+                           const std::byte* pvpData,
+                           const std::byte* samples);
+
     /*
      *  Implementation of write support data
      */
@@ -404,6 +480,16 @@ private:
     const std::vector<std::string> mSchemaPaths;
     //! Output stream contains CPHD file
     std::shared_ptr<io::SeekableOutputStream> mStream;
+
+    // Book-keeping for appendVectors()
+    //! file offset of each channel's PVP array
+    std::vector<int64_t> mPVPOffsets;
+    //! file offset of each channel's signal array
+    std::vector<int64_t> mSignalOffsets;
+    //! number of vectors appended to each channel
+    std::vector<size_t> mNumVectorsAppended;
+    //! PVP data of the vectors being appended
+    std::vector<std::byte> mPVPScratch;
 };
 }
 
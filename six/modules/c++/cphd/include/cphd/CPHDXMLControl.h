@@ -31,6 +31,7 @@
 #include <std/string>
 
 #include <scene/sys_Conf.h>
+#include <io/OutputStream.h>
 #include <xml/lite/Element.h>
 #include <xml/lite/Document.h>
 #include <cphd/CPHDXMLParser.h>
@@ -106,6 +107,20 @@ public:
             const Metadata& metadata,
             const std::vector<std::string>& schemaPaths = std::vector<std::string>());
 
+    /*!
+     *  \func toXML
+     *
+     *  \brief Write metadata as XML, the same as toXMLString() without
+     *  prettyPrint, but without ever building the whole DOM
+     *
+     *  \param metadata Valid CPHD metadata object
+     *  \param os Where the XML goes
+     *  \param pSchemaPaths XML Schema for validation; if there are any,
+     *  the XML is kept in memory until it's been validated
+     */
+    void toXML(const Metadata& metadata, io::OutputStream& os,
+               const std::vector<std::filesystem::path>* pSchemaPaths = nullptr);
+
     /*!
      *  \func fromXML
      *
@@ -176,6 +191,9 @@ private:
 
     // Given the URI get associated version
     std::string uriToVersion(const xml::lite::Uri&) const;
+
+    // Given the version get associated URI
+    static xml::lite::Uri versionToUri(const std::string& version);
 };
 }
 
@@ -24,7 +24,9 @@
 #define __CPHD_CPHD_XML_PARSER_H__
 
 #include <memory>
+#include <vector>
 
+#include <io/OutputStream.h>
 #include <logging/Logger.h>
 #include <xml/lite/Element.h>
 #include <xml/lite/Document.h>
@@ -75,6 +77,17 @@ public:
     std::unique_ptr<xml::lite::Document> toXML(
             const Metadata& metadata);
 
+    /*!
+     *  \func toXML
+     *
+     *  \brief Write metadata as XML, the same as printing the document
+     *  above, but only ever holding one top-level block of it as a DOM
+     *
+     *  \param metadata Valid CPHD metadata object
+     *  \param os Where the XML goes
+     */
+    void toXML(const Metadata& metadata, io::OutputStream& os);
+
     /*!
      *  \func fromXML
      *
@@ -92,13 +105,15 @@ private:
     typedef xml::lite::Element*  XMLElem;
 
 private:
+    //! What toXML() adds to the root, in order
+    std::vector<XMLBlock> getXMLBlocks(const Metadata& metadata);
+    void setNamespaces(XMLElem root) const;
 
     //! Write to XML object
     XMLElem toXML(const CollectionInformation& obj, XMLElem parent);
     XMLElem toXML(const Global& obj, XMLElem parent);
     XMLElem toXML(const SceneCoordinates& obj, XMLElem parent);
     XMLElem toXML(const Data& obj, XMLElem parent);
-    XMLElem toXML(const Channel& obj, XMLElem parent);
     XMLElem toXML(const Pvp& obj, XMLElem parent);
     XMLElem toXML(const SupportArray& obj, XMLElem parent);
     XMLElem toXML(const Dwell& obj, XMLElem parent);
@@ -110,6 +125,11 @@ private:
     XMLElem toXML(const GeoInfo& obj, XMLElem parent);
     XMLElem toXML(const MatchInformation& obj, XMLElem parent);
 
+    //! The Channel element is made a piece at a time; see getXMLBlocks()
+    XMLElem createChannel(const Channel& obj, XMLElem parent);
+    XMLElem toXML(const ChannelParameter& obj, XMLElem parent);
+    void addAddedParameters(const Channel& obj, XMLElem channelXML);
+
     //! Read from XML object
     void fromXML(const xml::lite::Element* collectionIDXML, CollectionInformation& collectionID);
     void fromXML(const xml::lite::Element* globalXML, Global& global);
@@ -27,10 +27,15 @@
 #include <vector>
 #include <complex>
 #include <cstdint>
+#include <string>
+#include <type_traits>
 #include <stddef.h>
 #include <unordered_map>
+#include <atomic>
+#include <mutex>
 
 #include <std/optional>
+#include <std/span>
 
 #include <scene/sys_Conf.h>
 #include <cphd/Types.h>
@@ -76,6 +81,60 @@ struct AddedPVP<std::string>
     }
 };
 
+/*
+ *  \struct AddedPVPValue
+ *  \brief The type an added pvp of type T is handed to PVPBlock as
+ *
+ *  Numbers widen to double, std::int64_t or std::uint64_t, and complex
+ *  numbers to std::complex<double> or std::complex<std::int64_t>
+ *
+ * \tparam T Type of the value being set
+ */
+template<typename T>
+struct AddedPVPValue
+{
+    typedef typename std::conditional<std::is_floating_point<T>::value,
+            double, typename std::conditional<std::is_signed<T>::value,
+            std::int64_t, std::uint64_t>::type>::type type;
+
+    static type widen(T val)
+    {
+        return static_cast<type>(val);
+    }
+};
+template<typename T>
+struct AddedPVPValue<std::complex<T> >
+{
+    typedef std::complex<typename std::conditional<
+            std::is_floating_point<T>::value,
+            double, std::int64_t>::type> type;
+
+    static type widen(const std::complex<T>& val)
+    {
+        return type(val.real(), val.imag());
+    }
+};
+template<>
+struct AddedPVPValue<std::string>
+{
+    typedef std::string type;
+
+    static const std::string& widen(const std::string& val)
+    {
+        return val;
+    }
+};
+template<>
+struct AddedPVPValue<const char*>
+{
+    typedef std::string type;
+
+    static std::string widen(const char* val)
+    {
+        return val;
+    }
+};
+
 /*!
  *  \struct PVPBlock
  *
@@ -179,16 +238,56 @@ struct PVPBlock
     T getAddedPVP(size_t channel, size_t set, const std::string& name) const
     {
         verifyChannelVector(channel, set);
-        if(mData[channel][set].addedPVP.count(name) == 1)
+        const size_t field = getAddedPVPField(name);
+        if (field < mAddedPVPNames.size())
         {
-            AddedPVP<T> aP;
-            return aP.getAddedPVP(mData[channel][set].addedPVP.find(name)->second);
-            // return AddPVPNamespace::getAddedPVP<T>(mData[channel][set].addedPVP.find(name)->second);
+            const auto& addedPVP = getArrays(channel).addedPVP[field];
+            if (addedPVP.isSet[set])
+            {
+                AddedPVP<T> aP;
+                return aP.getAddedPVP(addedPVP.getParameter(set));
+            }
         }
         throw except::Exception(Ctxt(
                 "Parameter was not set"));
     }
 
+    /*
+     *  Bulk getter functions
+     *
+     *  Each returns a parameter for every vector of a channel at once,
+     *  indexed by vector.  The span is good until the block is changed
+     *  or destroyed.  Vectors whose parameter was never set hold
+     *  six::Init::undefined().
+     *
+     *  \throws except::Exception If the channel is invalid, or for the
+     *  optional parameters, if it's not in the metadata
+     */
+    std::span<const double> getTxTime(size_t channel) const;
+    std::span<const Vector3> getTxPos(size_t channel) const;
+    std::span<const Vector3> getTxVel(size_t channel) const;
+    std::span<const double> getRcvTime(size_t channel) const;
+    std::span<const Vector3> getRcvPos(size_t channel) const;
+    std::span<const Vector3> getRcvVel(size_t channel) const;
+    std::span<const Vector3> getSRPPos(size_t channel) const;
+    std::span<const double> getaFDOP(size_t channel) const;
+    std::span<const double> getaFRR1(size_t channel) const;
+    std::span<const double> getaFRR2(size_t channel) const;
+    std::span<const double> getFx1(size_t channel) const;
+    std::span<const double> getFx2(size_t channel) const;
+    std::span<const double> getTOA1(size_t channel) const;
+    std::span<const double> getTOA2(size_t channel) const;
+    std::span<const double> getTdTropoSRP(size_t channel) const;
+    std::span<const double> getSC0(size_t channel) const;
+    std::span<const double> getSCSS(size_t channel) const;
+    std::span<const double> getAmpSF(size_t channel) const;
+    std::span<const double> getFxN1(size_t channel) const;
+    std::span<const double> getFxN2(size_t channel) const;
+    std::span<const double> getTOAE1(size_t channel) const;
+    std::span<const double> getTOAE2(size_t channel) const;
+    std::span<const double> getTdIonoSRP(size_t channel) const;
+    std::span<const std::int64_t> getSignal(size_t channel) const;
+
     //! Setter functions
     void setTxTime(double value, size_t channel, size_t set);
     void setTxPos(const Vector3& value, size_t channel, size_t set);
@@ -219,12 +318,13 @@ struct PVPBlock
     void setAddedPVP(T value, size_t channel, size_t set, const std::string& name)
     {
         verifyChannelVector(channel, set);
-        if(mPvp.addedPVP.count(name) != 0)
+        const size_t field = getAddedPVPField(name);
+        if (field < mAddedPVPNames.size())
         {
-            if(mData[channel][set].addedPVP.count(name) == 0)
+            auto& addedPVP = getArrays(channel).addedPVP[field];
+            if (!addedPVP.isSet[set])
             {
-                mData[channel][set].addedPVP[name] = six::Parameter();
-                mData[channel][set].addedPVP.find(name)->second.setValue(value);
+                addedPVP.setValue(set, AddedPVPValue<T>::widen(value));
                 return;
             }
             throw except::Exception(Ctxt(
@@ -311,6 +411,11 @@ struct PVPBlock
      *
      *  \brief Reads in the entire PVP array from an input stream
      *
+     *  The PVP data is kept as read, and single parameters are read
+     *  straight out of it.  It's only unpacked into per-parameter arrays
+     *  when they're needed: by the bulk getters, added parameters or
+     *  setters.
+     *
      *  \param inStream Input stream that contains a valid CPHD file
      *  \param startPVP Offset of start of pvp block
      *  \param sizePVP Size of pvp block
@@ -329,73 +434,126 @@ struct PVPBlock
     int64_t load(io::SeekableInputStream& inStream, const FileHeader&, size_t numThreads);
 
     //! Equality operators
-    bool operator==(const PVPBlock& other) const
-    {
-        return mData == other.mData &&
-               mNumBytesPerVector == other.mNumBytesPerVector;
-    }
+    bool operator==(const PVPBlock& other) const;
 
     bool operator!=(const PVPBlock& other) const
     {
         return !((*this) == other);
     }
 
-protected:
-    /*!
-     *  \struct PVPSet
-     *
-     *  \brief Parameters for each vector
+private:
+    /*
+     *  An optional parameter for each vector, and whether it's been set
+     */
+    template <typename T>
+    struct OptionalPVP
+    {
+        void resize(size_t numVectors)
+        {
+            values.resize(numVectors, six::Init::undefined<T>());
+            isSet.resize(numVectors, false);
+        }
+
+        void set(size_t vector, const T& value)
+        {
+            values[vector] = value;
+            isSet[vector] = true;
+        }
+
+        bool operator==(const OptionalPVP& other) const
+        {
+            return values == other.values && isSet == other.isSet;
+        }
+
+        std::vector<T> values;
+        // Not vector<bool>: different vectors get set from different threads
+        std::vector<std::uint8_t> isSet;
+    };
+
+    /*
+     *  An added parameter for each vector, and whether it's been set
      *
-     *  Stores a single set of parameters
-     *  Each channel consists of a PVP Array,
-     *  which consists of multiple sets
+     *  Held by the parameter's format rather than as text: reals in
+     *  reals, integers in integers (U8 as the bits of a std::uint64_t),
+     *  and anything else in strings.  Complex formats take two entries
+     *  per vector, real then imaginary.  A six::Parameter is only made
+     *  when getParameter() is called.
      */
-    struct PVPSet
+    struct AddedPVPArray
     {
-        /*!
-         *  \func PVPSet
-         *
-         *  \brief Default constructor
-         */
-        PVPSet();
+        enum Storage
+        {
+            REAL,
+            INTEGER,
+            UNSIGNED,
+            COMPLEX_REAL,
+            COMPLEX_INTEGER,
+            STRING
+        };
+
+        //! Choose the storage from the format, e.g. "F8", "CI4" or "S10"
+        void resize(const std::string& format, size_t numVectors);
+
+        size_t size() const
+        {
+            return isSet.size();
+        }
+
+        six::Parameter getParameter(size_t vector) const;
 
         /*
-         *  \func write
+         *  Convert a value to the storage and mark it set
          *
-         *  \brief Writes binary data input into PVP Set
-         *
-         *  \param pvpBlock A pvpBlock struct to access optional parameter flags
-         *  \param pvp A filled out pvp sturcture. This will be used for
-         *  information on where to allocate memory and set each
-         *  parameter in a PVP set.
-         *  \param input A pointer to an array of bytes that contains the
-         *  parameter data to write into the pvp set
+         *  \throws except::Exception If a complex value is given for a
+         *  real parameter, or a string doesn't parse
          */
-        void write(const PVPBlock& pvpBlock, const Pvp& pvp, const sys::byte* input);
-        void write(const PVPBlock& pvpBlock, const Pvp& pvp, const std::byte* input)
+        void setValue(size_t vector, double value);
+        void setValue(size_t vector, std::int64_t value);
+        void setValue(size_t vector, std::uint64_t value);
+        void setValue(size_t vector, const std::complex<double>& value);
+        void setValue(size_t vector, const std::complex<std::int64_t>& value);
+        void setValue(size_t vector, const std::string& value);
+
+        bool operator==(const AddedPVPArray& other) const
         {
-            write(pvpBlock, pvp, reinterpret_cast<const sys::byte*>(input));
+            return storage == other.storage && reals == other.reals &&
+                    integers == other.integers && strings == other.strings &&
+                    isSet == other.isSet;
         }
 
-        /*
-         *  \func read
-         *
-         *  \brief Read PVP set into binary data output
-         *
-         *  \param pvp A filled out pvp sturcture. This will be used for
-         *  information on where to allocate memory and set each
-         *  parameter in a PVP set.
-         *  \param[out] output A pointer to an array of allocated bytes that
-         *  will be written to
-         */
-        void read(const Pvp& pvp, sys::ubyte* output) const;
-        void read(const Pvp& pvp, std::byte* output) const
+        Storage storage = STRING;
+        std::vector<double> reals;
+        std::vector<std::int64_t> integers;
+        std::vector<std::string> strings;
+        // Not vector<bool>: different vectors get set from different threads
+        std::vector<std::uint8_t> isSet;
+
+    private:
+        template <typename T>
+        void store(size_t vector, const T& value);
+    };
+
+    /*
+     *  \struct PVPArrays
+     *
+     *  \brief The parameters of every vector of a channel
+     *
+     *  Stored by parameter rather than by vector: each parameter is a
+     *  contiguous array with an entry per vector.  Optional parameters
+     *  that aren't in the metadata are empty.
+     */
+    struct PVPArrays
+    {
+        //! Resize the required parameters
+        void resize(size_t numVectors);
+
+        size_t size() const
         {
-            read(pvp, reinterpret_cast<sys::ubyte*>(output));
+            return txTime.size();
         }
 
         //! Equality operators
-        bool operator==(const PVPSet& other) const
+        bool operator==(const PVPArrays& other) const
         {
             return txTime == other.txTime && txPos == other.txPos &&
                     txVel == other.txVel && rcvTime == other.rcvTime &&
@@ -411,51 +569,125 @@ protected:
                     toaE2 == other.toaE2 && tdIonoSRP == other.tdIonoSRP &&
                     signal == other.signal && addedPVP == other.addedPVP;
         }
-        bool operator!=(const PVPSet& other) const
+        bool operator!=(const PVPArrays& other) const
         {
             return !((*this) == other);
         }
 
         //! Required Parameters
-        double txTime;
-        Vector3 txPos;
-        Vector3 txVel;
-        double rcvTime;
-        Vector3 rcvPos;
-        Vector3 rcvVel;
-        Vector3 srpPos;
-        double aFDOP;
-        double aFRR1;
-        double aFRR2;
-        double fx1;
-        double fx2;
-        double toa1;
-        double toa2;
-        double tdTropoSRP;
-        double sc0;
-        double scss;
+        std::vector<double> txTime;
+        std::vector<Vector3> txPos;
+        std::vector<Vector3> txVel;
+        std::vector<double> rcvTime;
+        std::vector<Vector3> rcvPos;
+        std::vector<Vector3> rcvVel;
+        std::vector<Vector3> srpPos;
+        std::vector<double> aFDOP;
+        std::vector<double> aFRR1;
+        std::vector<double> aFRR2;
+        std::vector<double> fx1;
+        std::vector<double> fx2;
+        std::vector<double> toa1;
+        std::vector<double> toa2;
+        std::vector<double> tdTropoSRP;
+        std::vector<double> sc0;
+        std::vector<double> scss;
 
         //! (Optional) Parameters
-        mem::ScopedCopyablePtr<double> ampSF;
-        mem::ScopedCopyablePtr<double> fxN1;
-        mem::ScopedCopyablePtr<double> fxN2;
-        mem::ScopedCopyablePtr<double> toaE1;
-        mem::ScopedCopyablePtr<double> toaE2;
-        mem::ScopedCopyablePtr<double> tdIonoSRP;
-        mem::ScopedCopyablePtr<std::int64_t> signal;
-
-        //! (Optional) Additional parameters
-        std::unordered_map<std::string,six::Parameter> addedPVP;
+        OptionalPVP<double> ampSF;
+        OptionalPVP<double> fxN1;
+        OptionalPVP<double> fxN2;
+        OptionalPVP<double> toaE1;
+        OptionalPVP<double> toaE2;
+        OptionalPVP<double> tdIonoSRP;
+        OptionalPVP<std::int64_t> signal;
+
+        /*
+         *  (Optional) Additional parameters, sorted by name like
+         *  mAddedPVPNames (not in XML declaration order)
+         */
+        std::vector<AddedPVPArray> addedPVP;
     };
-    friend std::ostream& operator<< (std::ostream& os, const PVPSet& p);
 
-private:
-    //! The PVP Block [Num Channles][Num Parameters]
-    std::vector<std::vector<PVPSet> > mData;
+    /*
+     *  \struct Channel
+     *
+     *  \brief The PVP data of a channel
+     *
+     *  A channel loaded from a file keeps its PVP data as read until its
+     *  arrays are first needed, which may be from several threads at once.
+     *  Until then the arrays are empty.
+     */
+    struct Channel
+    {
+        Channel() = default;
+        Channel(const Channel&);
+        Channel& operator=(const Channel&);
+        Channel(Channel&&) noexcept;
+        Channel& operator=(Channel&&) noexcept;
+
+        size_t numVectors = 0;
+        //! PVP data as read (in native byte order), until it's unpacked;
+        //! only touched under the mutex while other threads may read it
+        mutable std::vector<std::byte> loaded;
+        //! Filled in by getArrays()
+        mutable PVPArrays arrays;
+        mutable std::atomic<bool> ready{false};
+        mutable std::mutex mutex;
+    };
+
+    //! Set up the channels; their arrays are allocated when first needed
+    void allocate(const std::vector<size_t>& numVectors);
+    void allocate(PVPArrays& arrays, size_t numVectors) const;
+
+    /*
+     *  The arrays of a channel, unpacking its loaded PVP data into them
+     *  first if need be.  The loaded data is released once unpacked.
+     */
+    const PVPArrays& getArrays(size_t channel) const;
+    PVPArrays& getArrays(size_t channel);
+
+    /*
+     *  Calls read() with a vector's loaded PVP data while holding the
+     *  channel's mutex, so it can't be released meanwhile.  Returns false
+     *  (without calling read()) if the channel's been unpacked.
+     */
+    template <typename TFunc>
+    bool readLoadedVector(size_t channel, size_t vector, TFunc read) const;
+
+    //! Get a parameter from the loaded PVP data or the arrays
+    template <typename T>
+    T getRequiredPVP(size_t channel, size_t vector, const PVPType& param,
+                     const std::vector<T> PVPArrays::* values) const;
+    template <typename T>
+    T getOptionalPVP(size_t channel, size_t vector, bool enabled,
+                     const PVPType& param,
+                     const OptionalPVP<T> PVPArrays::* values) const;
+
+    /*
+     *  Set vectors [begin, end) of a channel from PVP data laid out as in
+     *  the file, numBytesPerVector apart
+     */
+    void setVectors(PVPArrays& arrays, const std::byte* input,
+                    size_t numBytesPerVector, size_t begin, size_t end) const;
+
+    //! Index of an added parameter, or mAddedPVPNames.size() if it isn't one
+    size_t getAddedPVPField(const std::string& name) const;
+
+    void verifyChannel(size_t channel) const;
+    void verifyOptional(bool enabled) const;
+
+    //! The PVP Block [Num Channels]
+    std::vector<Channel> mData;
     //! Number of bytes per PVP vector
     size_t mNumBytesPerVector = 0;
     //! PVP block metadata
     Pvp mPvp;
+    //! Names of the added parameters, sorted by name (std::map order)
+    //! so getAddedPVPField() can binary search them
+    std::vector<std::string> mAddedPVPNames;
+    //! Number of threads to unpack loaded PVP data with
+    size_t mNumThreads = 1;
 
     /*
      *  Optional parameter flags
@@ -48,6 +48,7 @@ namespace cphd
  */
 //  It contains the cphd::Data structure (for channel and vector sizes).
 //  Provides methods read wideband data from CPHD file/stream
+//  The read() methods may be called from any number of threads at once.
 struct Wideband final
 {
     static const size_t ALL;
@@ -57,6 +58,9 @@ struct Wideband final
      *
      *  \brief Constructor initializes signal block book keeping
      *
+     *  Reads are positional (pread() and the like), so concurrent reads
+     *  don't wait on each other.
+     *
      *  \param pathname Input CPHD pathname
      *  \param metadata Metadata section of CPHD file
      *  \param startWB CPHD header keyword "CPHD_BYTE_OFFSET"
@@ -72,6 +76,9 @@ struct Wideband final
      *
      *  \brief Constructor initializes signal block book keeping
      *
+     *  A stream has only the one cursor, so concurrent reads take turns
+     *  seeking and reading it.
+     *
      *  \param inStream Input stream to an already opened CPHD file
      *  \param metadata Metadata section of CPHD file
      *  \param startWB CPHD header keyword "cphd_BYTE_OFFSET"
@@ -82,6 +89,8 @@ struct Wideband final
              int64_t startWB,
              int64_t sizeWB);
 
+    ~Wideband();
+
     /*!
      *  \func getFileOffset
      *
@@ -462,7 +471,9 @@ private:
     const Wideband& operator=(const Wideband&) = delete;
 
 private:
-    const std::shared_ptr<io::SeekableInputStream> mInStream;
+    // Positional reads with no shared file cursor
+    struct Reader;
+    const std::unique_ptr<Reader> mReader;
     const cphd::MetadataBase& mMetadata;  // pointer to data metadata
     const int64_t mWBOffset;  // offset in bytes to start of wideband
     const size_t mWBSize;  // total size in bytes of wideband
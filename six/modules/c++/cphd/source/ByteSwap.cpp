@@ -21,35 +21,19 @@
  */
 #include <cphd/ByteSwap.h>
 
+#include <string.h>
+
 #include <string>
-#include <std/memory>
 
 #include <sys/Conf.h>
-#include <mt/ThreadPlanner.h>
-#include <mt/ThreadGroup.h>
 #include <nitf/coda-oss.hpp>
+#include <six/ComplexConversion.h>
+#include <six/Executor.h>
 
 namespace
 {
-// TODO: Maybe this should go in sys/Conf.h
-//       It's more flexible in that it properly handles float's - you can't
-//       just call sys::byteSwap(floatVal) because the compiler may change the
-//       byte-swapped float value into a valid IEEE value beforehand.
-// TODO: If we're really looking to optimize this, could specialize it for
-//       sizes of 2, 4, and 8 to eliminate the for loop
-template <typename T>
-inline
-void byteSwap(const void* in, T& out)
-{
-    const std::byte* const inPtr = static_cast<const std::byte*>(in);
-    std::byte* const outPtr = reinterpret_cast<std::byte*>(&out);
-
-    for (size_t ii = 0, jj = sizeof(T) - 1; ii < jj; ++ii, --jj)
-    {
-        outPtr[ii] = inPtr[jj];
-        outPtr[jj] = inPtr[ii];
-    }
-}
+// Byte swapping is cheap; don't bother another thread with less than this
+const size_t MIN_ELEMENTS_PER_THREAD = 64 * 1024;
 
 class ByteSwapRunnable : public sys::Runnable
 {
@@ -98,26 +82,11 @@ public:
 
     virtual void run()
     {
-        InT real(0);
-        InT imag(0);
-
-        for (size_t row = 0, inIdx = 0, outIdx = 0; row < mDims.row; ++row)
-        {
-            for (size_t col = 0;
-                 col < mDims.col;
-                 ++col, inIdx += sizeof(std::complex<InT>), ++outIdx)
-            {
-                // Have to be careful here - can't treat mInput as a
-                // std::complex<InT> directly in case InT is a float (see
-                // explanation in byteSwap() comments)
-                const auto input = calc_offset(mInput, inIdx);
-                byteSwap(input, real);
-                byteSwap(calc_offset(input, sizeof(InT)), imag);
-
-                mOutput[outIdx] = std::complex<float>(real,
-                                                      imag);
-            }
-        }
+        six::promoteToComplexFloat(mInput,
+                                   sizeof(std::complex<InT>),
+                                   mDims.area(),
+                                   true,
+                                   mOutput);
     }
 
 private:
@@ -146,28 +115,15 @@ public:
 
     virtual void run()
     {
-        InT real(0);
-        InT imag(0);
-
-        for (size_t row = 0, inIdx = 0, outIdx = 0; row < mDims.row; ++row)
+        const size_t bytesPerRow = mDims.col * sizeof(std::complex<InT>);
+        for (size_t row = 0; row < mDims.row; ++row)
         {
-            const double scaleFactor(mScaleFactors[row]);
-
-            for (size_t col = 0;
-                 col < mDims.col;
-                 ++col, inIdx += sizeof(std::complex<InT>), ++outIdx)
-            {
-                // Have to be careful here - can't treat mInput as a
-                // std::complex<InT> directly in case InT is a float (see
-                // explanation in byteSwap() comments)
-                const auto input = calc_offset(mInput, inIdx);
-                byteSwap(input, real);
-                byteSwap(calc_offset(input, sizeof(InT)), imag);
-
-                mOutput[outIdx] = std::complex<float>(
-                        static_cast<float>(real * scaleFactor),
-                        static_cast<float>(imag * scaleFactor));
-            }
+            six::scaleToComplexFloat(calc_offset(mInput, row * bytesPerRow),
+                                     sizeof(std::complex<InT>),
+                                     mDims.col,
+                                     true,
+                                     mScaleFactors[row],
+                                     mOutput + row * mDims.col);
         }
     }
 
@@ -190,26 +146,15 @@ void byteSwapAndPromote(const void* input,
     }
     else
     {
-        mt::ThreadGroup threads;
-        const mt::ThreadPlanner planner(dims.row, numThreads);
-
-        size_t threadNum(0);
-        size_t startRow(0);
-        size_t numRowsThisThread(0);
-        while (planner.getThreadInfo(threadNum++,
-                                     startRow,
-                                     numRowsThisThread))
-        {
-            auto scaler = std::make_unique<ByteSwapAndPromoteRunnable<InT>>(
-                    input,
-                    startRow,
-                    numRowsThisThread,
-                    dims.col,
-                    output);
-            threads.createThread(std::move(scaler));
-        }
-
-        threads.joinAll();
+        six::Executor::get(numThreads)->parallelFor(dims.row,
+                [&](size_t startRow, size_t endRow)
+                {
+                    ByteSwapAndPromoteRunnable<InT>(input,
+                                                    startRow,
+                                                    endRow - startRow,
+                                                    dims.col,
+                                                    output).run();
+                });
     }
 }
 
@@ -227,27 +172,16 @@ void byteSwapAndScale(const void* input,
     }
     else
     {
-        mt::ThreadGroup threads;
-        const mt::ThreadPlanner planner(dims.row, numThreads);
-
-        size_t threadNum(0);
-        size_t startRow(0);
-        size_t numRowsThisThread(0);
-        while (planner.getThreadInfo(threadNum++,
-                                     startRow,
-                                     numRowsThisThread))
-        {
-            auto scaler = std::make_unique<ByteSwapAndScaleRunnable<InT>>(
-                    input,
-                    startRow,
-                    numRowsThisThread,
-                    dims.col,
-                    scaleFactors,
-                    output);
-            threads.createThread(std::move(scaler));
-        }
-
-        threads.joinAll();
+        six::Executor::get(numThreads)->parallelFor(dims.row,
+                [&](size_t startRow, size_t endRow)
+                {
+                    ByteSwapAndScaleRunnable<InT>(input,
+                                                  startRow,
+                                                  endRow - startRow,
+                                                  dims.col,
+                                                  scaleFactors,
+                                                  output).run();
+                });
     }
 }
 }
@@ -267,24 +201,50 @@ void byteSwap(void* buffer,
     }
     else
     {
-        mt::ThreadGroup threads;
-        const mt::ThreadPlanner planner(numElements, numThreads);
-
-        size_t threadNum(0);
-        size_t startElement(0);
-        size_t numElementsThisThread(0);
-        while (planner.getThreadInfo(threadNum++,
+        six::Executor::get(numThreads)->parallelFor(numElements,
+                [&](size_t startElement, size_t endElement)
+                {
+                    ByteSwapRunnable(buffer,
+                                     elemSize,
                                      startElement,
-                                     numElementsThisThread))
+                                     endElement - startElement).run();
+                }, MIN_ELEMENTS_PER_THREAD);
+    }
+}
+
+void byteSwap(const void* input,
+              size_t elemSize,
+              size_t numElements,
+              size_t numThreads,
+              void* output)
+{
+    auto swap = [&](size_t startElement, size_t endElement)
+    {
+        const size_t offset = startElement * elemSize;
+        const size_t size = (endElement - startElement) * elemSize;
+        if (elemSize < 2)
+        {
+            // Nothing to swap; sys::byteSwap() wouldn't copy it either
+            ::memcpy(static_cast<std::byte*>(output) + offset,
+                     calc_offset(input, offset), size);
+        }
+        else
         {
-            auto thread = std::make_unique<ByteSwapRunnable>(
-                    buffer,
-                    elemSize,
-                    startElement,
-                    numElementsThisThread);
-            threads.createThread(std::move(thread));
+            sys::byteSwap(calc_offset(input, offset),
+                          static_cast<unsigned short>(elemSize),
+                          endElement - startElement,
+                          static_cast<std::byte*>(output) + offset);
         }
-        threads.joinAll();
+    };
+
+    if (numThreads <= 1)
+    {
+        swap(0, numElements);
+    }
+    else
+    {
+        six::Executor::get(numThreads)->parallelFor(numElements, swap,
+                                                    MIN_ELEMENTS_PER_THREAD);
     }
 }
 
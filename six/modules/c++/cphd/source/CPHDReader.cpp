@@ -42,7 +42,7 @@ CPHDReader::CPHDReader(std::shared_ptr<io::SeekableInputStream> inStream,
                        const std::vector<std::string>& schemaPaths,
                        std::shared_ptr<logging::Logger> logger)
 {
-    initialize(inStream, numThreads, logger, schemaPaths);
+    initialize(inStream, "", numThreads, logger, schemaPaths);
 }
 
 CPHDReader::CPHDReader(const std::string& fromFile,
@@ -50,11 +50,12 @@ CPHDReader::CPHDReader(const std::string& fromFile,
                        const std::vector<std::string>& schemaPaths,
                        std::shared_ptr<logging::Logger> logger)
 {
-    initialize(std::make_shared<io::FileInputStream>(fromFile),
+    initialize(std::make_shared<io::FileInputStream>(fromFile), fromFile,
         numThreads, logger, schemaPaths);
 }
 
 void CPHDReader::initialize(std::shared_ptr<io::SeekableInputStream> inStream,
+                            const std::string& pathname,
                             size_t numThreads,
                             std::shared_ptr<logging::Logger> logger,
                             const std::vector<std::string>& schemaPaths_)
@@ -84,8 +85,17 @@ void CPHDReader::initialize(std::shared_ptr<io::SeekableInputStream> inStream,
     mPVPBlock = PVPBlock(mMetadata);
     mPVPBlock.load(*inStream, mFileHeader, numThreads);
 
-    // Setup for wideband reading
-    mWideband = std::make_unique<Wideband>(inStream, mMetadata,
-        mFileHeader.getSignalBlockByteOffset(), mFileHeader.getSignalBlockSize());
+    // Setup for wideband reading.  Given a file, read it by offset so the
+    // wideband can be read from several threads at once.
+    if (pathname.empty())
+    {
+        mWideband = std::make_unique<Wideband>(inStream, mMetadata,
+            mFileHeader.getSignalBlockByteOffset(), mFileHeader.getSignalBlockSize());
+    }
+    else
+    {
+        mWideband = std::make_unique<Wideband>(pathname, mMetadata,
+            mFileHeader.getSignalBlockByteOffset(), mFileHeader.getSignalBlockSize());
+    }
 }
 }
@@ -21,11 +21,13 @@
  */
 #include <cphd/CPHDWriter.h>
 
+#include <algorithm>
 #include <thread>
 #include <std/bit>
 #include <std/memory>
 
 #include <except/Exception.h>
+#include <six/Executor.h>
 
 #include <cphd/ByteSwap.h>
 #include <cphd/CPHDXMLControl.h>
@@ -54,33 +56,75 @@ DataWriterLittleEndian::DataWriterLittleEndian(
         std::shared_ptr<io::SeekableOutputStream> stream,
         size_t numThreads,
         size_t scratchSize) :
-    DataWriter(stream, numThreads),
-    mScratch(scratchSize)
+    DataWriter(stream, numThreads)
 {
+    for (auto& scratch : mScratch)
+    {
+        scratch.resize(std::max<size_t>(scratchSize / 2, 1));
+    }
 }
 
 void DataWriterLittleEndian::operator()(const sys::ubyte* data,
                                         size_t numElements,
                                         size_t elementSize)
 {
-    size_t dataProcessed = 0;
-    const size_t dataSize = numElements * elementSize;
-    while (dataProcessed < dataSize)
+    // Chunks have to be whole elements
+    const size_t elementsPerChunk =
+            std::max<size_t>(mScratch[0].size() / elementSize, 1);
+    for (auto& scratch : mScratch)
     {
-        const size_t dataToProcess =
-                std::min(mScratch.size(), dataSize - dataProcessed);
-
-        memcpy(mScratch.data(), data + dataProcessed, dataToProcess);
+        if (scratch.size() < elementsPerChunk * elementSize)
+        {
+            scratch.resize(elementsPerChunk * elementSize);
+        }
+    }
 
-        cphd::byteSwap(mScratch.data(),
+    const size_t numChunks =
+            (numElements + elementsPerChunk - 1) / elementsPerChunk;
+    const auto swap = [&](size_t chunk)
+    {
+        const size_t first = chunk * elementsPerChunk;
+        cphd::byteSwap(data + first * elementSize,
                        elementSize,
-                       dataToProcess / elementSize,
-                       mNumThreads);
+                       std::min(elementsPerChunk, numElements - first),
+                       mNumThreads,
+                       mScratch[chunk % 2].data());
+    };
+    const auto write = [&](size_t chunk)
+    {
+        const size_t first = chunk * elementsPerChunk;
+        mStream->write(mScratch[chunk % 2].data(),
+                       std::min(elementsPerChunk, numElements - first) *
+                               elementSize);
+    };
 
-        mStream->write(mScratch.data(), dataToProcess);
+    if (numChunks == 0)
+    {
+        return;
+    }
 
-        dataProcessed += dataToProcess;
+    // Swap each chunk while the one before it is being written, using the
+    // executor's threads rather than starting one per chunk
+    swap(0);
+    if (numChunks > 1)
+    {
+        auto executor = six::Executor::get(std::max<size_t>(mNumThreads, 2));
+        for (size_t chunk = 1; chunk < numChunks; ++chunk)
+        {
+            executor->parallelFor(2, [&](size_t begin, size_t)
+            {
+                if (begin == 0)
+                {
+                    write(chunk - 1);
+                }
+                else
+                {
+                    swap(chunk);
+                }
+            });
+        }
     }
+    write(numChunks - 1);
 }
 
 DataWriterBigEndian::DataWriterBigEndian(
@@ -320,6 +364,205 @@ void CPHDWriter::writeMetadata(const PVPBlock& pvpBlock)
     writeMetadata(totalSupportSize, totalPVPSize, totalCPHDSize);
 }
 
+void CPHDWriter::writeMetadata()
+{
+    if (mMetadata.data.isCompressed())
+    {
+        throw except::Exception(Ctxt(
+                "Vectors can't be appended to compressed signal arrays"));
+    }
+    const size_t numBytesPVP = mMetadata.data.getNumBytesPVPSet();
+    if (numBytesPVP == 0 || numBytesPVP % 8 != 0)
+    {
+        std::ostringstream ostr;
+        ostr << "Invalid number of pvp block bytes in metadata: "
+             << numBytesPVP;
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    const size_t numChannels = mMetadata.data.getNumChannels();
+    size_t totalPVPSize = 0;
+    size_t totalCPHDSize = 0;
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        totalPVPSize += mMetadata.data.getNumVectors(ii) * numBytesPVP;
+        totalCPHDSize += mMetadata.data.getNumVectors(ii) *
+                mMetadata.data.getNumSamples(ii) * mElementSize;
+    }
+
+    writeMetadata(mMetadata.data.getAllSupportSize(), totalPVPSize,
+                  totalCPHDSize);
+
+    // Channels are one after the other, as writePVPData() and
+    // writeCPHDData() write them
+    mPVPOffsets.resize(numChannels);
+    mSignalOffsets.resize(numChannels);
+    mNumVectorsAppended.assign(numChannels, 0);
+    int64_t pvpOffset = mHeader.getPvpBlockByteOffset();
+    int64_t signalOffset = mHeader.getSignalBlockByteOffset();
+    for (size_t ii = 0; ii < numChannels; ++ii)
+    {
+        mPVPOffsets[ii] = pvpOffset;
+        mSignalOffsets[ii] = signalOffset;
+        pvpOffset += mMetadata.data.getNumVectors(ii) * numBytesPVP;
+        signalOffset += mMetadata.data.getNumVectors(ii) *
+                mMetadata.data.getNumSamples(ii) * mElementSize;
+    }
+}
+
+template <typename T>
+void CPHDWriter::appendVectors(size_t channel,
+                               const PVPBlock& pvpSets,
+                               const T* samples)
+{
+    if (pvpSets.getNumBytesPVPSet() != mMetadata.data.getNumBytesPVPSet())
+    {
+        std::ostringstream ostr;
+        ostr << "Number of pvp block bytes in metadata: "
+             << mMetadata.data.getNumBytesPVPSet()
+             << " does not match size of pvp sets: "
+             << pvpSets.getNumBytesPVPSet();
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+    pvpSets.getPVPdata(0, mPVPScratch);
+    appendVectors(channel,
+                  mPVPScratch.size() / pvpSets.getNumBytesPVPSet(),
+                  mPVPScratch.data(),
+                  samples);
+}
+
+template <typename T>
+void CPHDWriter::appendVectors(size_t channel,
+                               size_t numVectors,
+                               const std::byte* pvpData,
+                               const T* samples)
+{
+    if (mElementSize != sizeof(T))
+    {
+        throw except::Exception(
+                Ctxt("Incorrect buffer data type used for metadata!"));
+    }
+    appendVectorsImpl(channel, numVectors, pvpData,
+                      reinterpret_cast<const std::byte*>(samples));
+}
+
+void CPHDWriter::appendVectorsImpl(size_t channel,
+                                   size_t numVectors,
+                                   const std::byte* pvpData,
+                                   const std::byte* samples)
+{
+    if (mNumVectorsAppended.empty())
+    {
+        throw except::Exception(Ctxt(
+                "writeMetadata() must be called before appendVectors()"));
+    }
+    if (channel >= mNumVectorsAppended.size())
+    {
+        throw except::Exception(Ctxt(
+                "Invalid channel number: " + std::to_string(channel)));
+    }
+
+    const size_t firstVector = mNumVectorsAppended[channel];
+    if (numVectors > mMetadata.data.getNumVectors(channel) - firstVector)
+    {
+        std::ostringstream ostr;
+        ostr << "Channel " << channel << " has room for "
+             << mMetadata.data.getNumVectors(channel) - firstVector
+             << " more vectors, not " << numVectors;
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    const size_t numBytesPVP = mMetadata.data.getNumBytesPVPSet();
+    mStream->seek(mPVPOffsets[channel] + firstVector * numBytesPVP,
+                  io::SeekableOutputStream::START);
+    //! The vector based parameters are always 64 bit
+    (*mDataWriter)(pvpData, numVectors * numBytesPVP / 8, 8);
+
+    const size_t numSamples = mMetadata.data.getNumSamples(channel);
+    mStream->seek(mSignalOffsets[channel] +
+                          firstVector * numSamples * mElementSize,
+                  io::SeekableOutputStream::START);
+    writeCPHDDataImpl(samples, numVectors * numSamples);
+
+    mNumVectorsAppended[channel] += numVectors;
+}
+
+size_t CPHDWriter::getNumVectorsAppended(size_t channel) const
+{
+    if (channel >= mMetadata.data.getNumChannels())
+    {
+        throw except::Exception(Ctxt(
+                "Invalid channel number: " + std::to_string(channel)));
+    }
+    return mNumVectorsAppended.empty() ? 0 : mNumVectorsAppended[channel];
+}
+
+template void CPHDWriter::appendVectors<std::complex<int8_t>>(
+        size_t channel,
+        const PVPBlock& pvpSets,
+        const std::complex<int8_t>* samples);
+
+template void CPHDWriter::appendVectors<std::complex<int16_t>>(
+        size_t channel,
+        const PVPBlock& pvpSets,
+        const std::complex<int16_t>* samples);
+
+template void CPHDWriter::appendVectors<std::complex<float>>(
+        size_t channel,
+        const PVPBlock& pvpSets,
+        const std::complex<float>* samples);
+
+template void CPHDWriter::appendVectors<std::complex<int8_t>>(
+        size_t channel,
+        size_t numVectors,
+        const std::byte* pvpData,
+        const std::complex<int8_t>* samples);
+
+template void CPHDWriter::appendVectors<std::complex<int16_t>>(
+        size_t channel,
+        size_t numVectors,
+        const std::byte* pvpData,
+        const std::complex<int16_t>* samples);
+
+template void CPHDWriter::appendVectors<std::complex<float>>(
+        size_t channel,
+        size_t numVectors,
+        const std::byte* pvpData,
+        const std::complex<float>* samples);
+
+void CPHDWriter::close()
+{
+    if (!mNumVectorsAppended.empty())
+    {
+        for (size_t ii = 0; ii < mNumVectorsAppended.size(); ++ii)
+        {
+            if (mNumVectorsAppended[ii] != mMetadata.data.getNumVectors(ii))
+            {
+                std::ostringstream ostr;
+                ostr << "Only " << mNumVectorsAppended[ii] << " of the "
+                     << mMetadata.data.getNumVectors(ii)
+                     << " vectors of channel " << ii << " were appended";
+                throw except::Exception(Ctxt(ostr.str()));
+            }
+        }
+
+        // The padding writePVPData() would have written
+        const std::vector<char> padding(
+                static_cast<size_t>(mHeader.getPvpPadBytes()));
+        mStream->seek(mHeader.getPvpBlockByteOffset() -
+                              mHeader.getPvpPadBytes(),
+                      io::SeekableOutputStream::START);
+        if (!padding.empty())
+        {
+            mStream->write(padding.data(), padding.size());
+        }
+        mStream->seek(mHeader.getSignalBlockByteOffset() +
+                              mHeader.getSignalBlockSize(),
+                      io::SeekableOutputStream::START);
+    }
+    mStream->close();
+}
+
 void CPHDWriter::writePVPData(const PVPBlock& pvpBlock)
 {
     // Add padding
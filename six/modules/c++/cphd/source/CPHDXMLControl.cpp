@@ -57,6 +57,14 @@ std::u8string CPHDXMLControl::toXMLString(
     const std::vector<std::filesystem::path>* pSchemaPaths,
     bool prettyPrint)
 {
+    io::U8StringStream ss;
+    if (!prettyPrint)
+    {
+        toXML(metadata, ss, pSchemaPaths);
+        return ss.stream().str();
+    }
+
+    // There's no pretty-printing a block at a time
     std::vector<std::string> schemaPaths;
     if (pSchemaPaths != nullptr)
     {
@@ -65,10 +73,7 @@ std::u8string CPHDXMLControl::toXMLString(
     }
 
     std::unique_ptr<xml::lite::Document> doc(toXML(metadata, schemaPaths));
-    io::U8StringStream ss;
-    (prettyPrint) ?
-        doc->getRootElement()->prettyPrint(ss) :
-        doc->getRootElement()->print(ss);
+    doc->getRootElement()->prettyPrint(ss);
     return ss.stream().str();
 }
 std::string CPHDXMLControl::toXMLString(
@@ -105,18 +110,26 @@ std::unordered_map<std::string, xml::lite::Uri> CPHDXMLControl::getVersionUriMap
     };
 }
 
-std::unique_ptr<xml::lite::Document> CPHDXMLControl::toXMLImpl(const Metadata& metadata)
+void CPHDXMLControl::toXML(const Metadata& metadata, io::OutputStream& os,
+                           const std::vector<std::filesystem::path>* pSchemaPaths)
 {
-    const auto versionUriMap = getVersionUriMap();
-    if (versionUriMap.find(metadata.getVersion()) != versionUriMap.end())
+    const auto uri = versionToUri(metadata.getVersion());
+    if ((pSchemaPaths == nullptr) || pSchemaPaths->empty())
     {
-      return getParser(versionUriMap.find(metadata.getVersion())->second)->toXML(metadata);
+        getParser(uri)->toXML(metadata, os);
+        return;
     }
-    std::ostringstream ostr;
-    ostr << "The version " << metadata.getVersion() << " is invalid. "
-         << "Check if version is valid or "
-         << "add a <version, URI> entry to versionUriMap";
-    throw except::Exception(Ctxt(ostr.str()));
+
+    io::StringStream xmlStream;
+    getParser(uri)->toXML(metadata, xmlStream);
+    const auto xml = xmlStream.stream().str();
+    six::XMLControl::validate(xml, uri.value, pSchemaPaths, mLog);
+    os.write(xml);
+}
+
+std::unique_ptr<xml::lite::Document> CPHDXMLControl::toXMLImpl(const Metadata& metadata)
+{
+    return getParser(versionToUri(metadata.getVersion()))->toXML(metadata);
 }
 
 /* FROM XML */
@@ -173,6 +186,21 @@ CPHDXMLControl::getParser(const xml::lite::Uri& uri) const
     return std::make_unique<CPHDXMLParser>(uri.value, false, mLog);
 }
 
+xml::lite::Uri CPHDXMLControl::versionToUri(const std::string& version)
+{
+    const auto versionUriMap = getVersionUriMap();
+    const auto it = versionUriMap.find(version);
+    if (it != versionUriMap.end())
+    {
+        return it->second;
+    }
+    std::ostringstream ostr;
+    ostr << "The version " << version << " is invalid. "
+         << "Check if version is valid or "
+         << "add a <version, URI> entry to versionUriMap";
+    throw except::Exception(Ctxt(ostr.str()));
+}
+
 std::string CPHDXMLControl::uriToVersion(const xml::lite::Uri& uri) const
 {
     const auto versionUriMap = getVersionUriMap();
@@ -58,51 +58,72 @@ CPHDXMLParser::CPHDXMLParser(
 std::unique_ptr<xml::lite::Document> CPHDXMLParser::toXML(
         const Metadata& metadata)
 {
-    std::unique_ptr<xml::lite::Document> doc(new xml::lite::Document());
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    return blocksToXML("CPHD", getXMLBlocks(metadata), setNamespaces);
+}
+
+void CPHDXMLParser::toXML(const Metadata& metadata, io::OutputStream& os)
+{
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    writeBlocks(os, "CPHD", getXMLBlocks(metadata), setNamespaces);
+}
+
+std::vector<six::XMLParser::XMLBlock> CPHDXMLParser::getXMLBlocks(
+        const Metadata& metadata)
+{
+    std::vector<XMLBlock> blocks;
+    blocks.push_back([&](XMLElem root) { toXML(metadata.collectionID, root); });
+    blocks.push_back([&](XMLElem root) { toXML(metadata.global, root); });
+    blocks.push_back([&](XMLElem root) { toXML(metadata.sceneCoordinates, root); });
+    blocks.push_back([&](XMLElem root) { toXML(metadata.data, root); });
 
-    XMLElem root = newElement("CPHD");
-    doc->setRootElement(root);
+    // Each channel's Parameters can be big, so they're made one at a time
+    std::vector<XMLBlock> channelBlocks;
+    for (const auto& parameter : metadata.channel.parameters)
+    {
+        channelBlocks.push_back([&](XMLElem channelXML) { toXML(parameter, channelXML); });
+    }
+    channelBlocks.push_back([&](XMLElem channelXML) { addAddedParameters(metadata.channel, channelXML); });
+    blocks.push_back(splitBlock([&](XMLElem root) { createChannel(metadata.channel, root); }, channelBlocks));
 
-    toXML(metadata.collectionID, root);
-    toXML(metadata.global, root);
-    toXML(metadata.sceneCoordinates, root);
-    toXML(metadata.data, root);
-    toXML(metadata.channel, root);
-    toXML(metadata.pvp, root);
+    blocks.push_back([&](XMLElem root) { toXML(metadata.pvp, root); });
     if (metadata.supportArray.get())
     {
-        toXML(*(metadata.supportArray), root);
+        blocks.push_back([&](XMLElem root) { toXML(*(metadata.supportArray), root); });
     }
-    toXML(metadata.dwell, root);
-    toXML(metadata.referenceGeometry, root);
+    blocks.push_back([&](XMLElem root) { toXML(metadata.dwell, root); });
+    blocks.push_back([&](XMLElem root) { toXML(metadata.referenceGeometry, root); });
     if (metadata.antenna.get())
     {
-        toXML(*(metadata.antenna), root);
+        blocks.push_back([&](XMLElem root) { toXML(*(metadata.antenna), root); });
     }
     if (metadata.txRcv.get())
     {
-        toXML(*(metadata.txRcv), root);
+        blocks.push_back([&](XMLElem root) { toXML(*(metadata.txRcv), root); });
     }
     if (metadata.errorParameters.get())
     {
-        toXML(*(metadata.errorParameters), root);
+        blocks.push_back([&](XMLElem root) { toXML(*(metadata.errorParameters), root); });
     }
     if (metadata.productInfo.get())
     {
-        toXML(*(metadata.productInfo), root);
+        blocks.push_back([&](XMLElem root) { toXML(*(metadata.productInfo), root); });
     }
     for (const auto& geoInfo : metadata.geoInfo)
     {
-        toXML(geoInfo, root);
+        blocks.push_back([&](XMLElem root) { toXML(geoInfo, root); });
     }
     if (metadata.matchInfo.get())
     {
-        toXML(*(metadata.matchInfo), root);
+        blocks.push_back([&](XMLElem root) { toXML(*(metadata.matchInfo), root); });
     }
+    return blocks;
+}
+
+void CPHDXMLParser::setNamespaces(XMLElem root) const
+{
     //set the XMLNS
     root->setNamespacePrefix("", getDefaultURI());
-
-    return doc;
 }
 
 XMLElem CPHDXMLParser::toXML(const CollectionInformation& collectionID, XMLElem parent)
@@ -328,114 +349,119 @@ XMLElem CPHDXMLParser::toXML(const Data& data, XMLElem parent)
     return dataXML;
 }
 
-XMLElem CPHDXMLParser::toXML(const Channel& channel, XMLElem parent)
+XMLElem CPHDXMLParser::createChannel(const Channel& channel, XMLElem parent)
 {
     XMLElem channelXML = newElement("Channel", parent);
     createString("RefChId", channel.refChId, channelXML);
     createBooleanType("FXFixedCPHD", channel.fxFixedCphd, channelXML);
     createBooleanType("TOAFixedCPHD", channel.toaFixedCphd, channelXML);
     createBooleanType("SRPFixedCPHD", channel.srpFixedCphd, channelXML);
+    return channelXML;
+}
 
-    for (size_t ii = 0; ii < channel.parameters.size(); ++ii)
-    {
-        XMLElem parametersXML = newElement("Parameters", channelXML);
-        createString("Identifier", channel.parameters[ii].identifier, parametersXML);
-        createInt("RefVectorIndex", channel.parameters[ii].refVectorIndex, parametersXML);
-        createBooleanType("FXFixed", channel.parameters[ii].fxFixed, parametersXML);
-        createBooleanType("TOAFixed", channel.parameters[ii].toaFixed, parametersXML);
-        createBooleanType("SRPFixed", channel.parameters[ii].srpFixed, parametersXML);
-        if (!six::Init::isUndefined(channel.parameters[ii].signalNormal))
+XMLElem CPHDXMLParser::toXML(const ChannelParameter& parameter, XMLElem parent)
+{
+    XMLElem parametersXML = newElement("Parameters", parent);
+    createString("Identifier", parameter.identifier, parametersXML);
+    createInt("RefVectorIndex", parameter.refVectorIndex, parametersXML);
+    createBooleanType("FXFixed", parameter.fxFixed, parametersXML);
+    createBooleanType("TOAFixed", parameter.toaFixed, parametersXML);
+    createBooleanType("SRPFixed", parameter.srpFixed, parametersXML);
+    if (!six::Init::isUndefined(parameter.signalNormal))
+    {
+        createBooleanType("SignalNormal", parameter.signalNormal, parametersXML);
+    }
+    XMLElem polXML = newElement("Polarization", parametersXML);
+    createString("TxPol", parameter.polarization.txPol, polXML);
+    createString("RcvPol", parameter.polarization.rcvPol, polXML);
+    createDouble("FxC", parameter.fxC, parametersXML);
+    createDouble("FxBW", parameter.fxBW, parametersXML);
+    createOptionalDouble("FxBWNoise", parameter.fxBWNoise, parametersXML);
+    createDouble("TOASaved", parameter.toaSaved, parametersXML);
+
+    if(parameter.toaExtended.get())
+    {
+        XMLElem toaExtendedXML = newElement("TOAExtended", parametersXML);
+        createDouble("TOAExtSaved", parameter.toaExtended->toaExtSaved, toaExtendedXML);
+        if(parameter.toaExtended->lfmEclipse.get())
         {
-            createBooleanType("SignalNormal", channel.parameters[ii].signalNormal, parametersXML);
+            XMLElem lfmEclipseXML = newElement("LFMEclipse", toaExtendedXML);
+            createDouble("FxEarlyLow", parameter.toaExtended->lfmEclipse->fxEarlyLow, lfmEclipseXML);
+            createDouble("FxEarlyHigh", parameter.toaExtended->lfmEclipse->fxEarlyHigh, lfmEclipseXML);
+            createDouble("FxLateLow", parameter.toaExtended->lfmEclipse->fxLateLow, lfmEclipseXML);
+            createDouble("FxLateHigh", parameter.toaExtended->lfmEclipse->fxLateHigh, lfmEclipseXML);
         }
-        XMLElem polXML = newElement("Polarization", parametersXML);
-        createString("TxPol", channel.parameters[ii].polarization.txPol, polXML);
-        createString("RcvPol", channel.parameters[ii].polarization.rcvPol, polXML);
-        createDouble("FxC", channel.parameters[ii].fxC, parametersXML);
-        createDouble("FxBW", channel.parameters[ii].fxBW, parametersXML);
-        createOptionalDouble("FxBWNoise", channel.parameters[ii].fxBWNoise, parametersXML);
-        createDouble("TOASaved", channel.parameters[ii].toaSaved, parametersXML);
-
-        if(channel.parameters[ii].toaExtended.get())
+    }
+    XMLElem dwellTimesXML = newElement("DwellTimes", parametersXML);
+    createString("CODId", parameter.dwellTimes.codId, dwellTimesXML);
+    createString("DwellId", parameter.dwellTimes.dwellId, dwellTimesXML);
+    if(!six::Init::isUndefined(parameter.imageArea))
+    {
+        XMLElem imageAreaXML = newElement("ImageArea", parametersXML);
+        mCommon.createVector2D("X1Y1", parameter.imageArea.x1y1, imageAreaXML);
+        mCommon.createVector2D("X2Y2", parameter.imageArea.x2y2, imageAreaXML);
+        if(!parameter.imageArea.polygon.empty())
         {
-            XMLElem toaExtendedXML = newElement("TOAExtended", parametersXML);
-            createDouble("TOAExtSaved", channel.parameters[ii].toaExtended->toaExtSaved, toaExtendedXML);
-            if(channel.parameters[ii].toaExtended->lfmEclipse.get())
+            XMLElem polygonXML = newElement("Polygon", imageAreaXML);
+            setAttribute(polygonXML, "size", parameter.imageArea.polygon.size());
+            for (size_t jj = 0; jj < parameter.imageArea.polygon.size(); ++jj)
             {
-                XMLElem lfmEclipseXML = newElement("LFMEclipse", toaExtendedXML);
-                createDouble("FxEarlyLow", channel.parameters[ii].toaExtended->lfmEclipse->fxEarlyLow, lfmEclipseXML);
-                createDouble("FxEarlyHigh", channel.parameters[ii].toaExtended->lfmEclipse->fxEarlyHigh, lfmEclipseXML);
-                createDouble("FxLateLow", channel.parameters[ii].toaExtended->lfmEclipse->fxLateLow, lfmEclipseXML);
-                createDouble("FxLateHigh", channel.parameters[ii].toaExtended->lfmEclipse->fxLateHigh, lfmEclipseXML);
+                XMLElem vertexXML = mCommon.createVector2D("Vertex", parameter.imageArea.polygon[jj], polygonXML);
+                setAttribute(vertexXML, "index", jj+1);
             }
         }
-        XMLElem dwellTimesXML = newElement("DwellTimes", parametersXML);
-        createString("CODId", channel.parameters[ii].dwellTimes.codId, dwellTimesXML);
-        createString("DwellId", channel.parameters[ii].dwellTimes.dwellId, dwellTimesXML);
-        if(!six::Init::isUndefined(channel.parameters[ii].imageArea))
-        {
-            XMLElem imageAreaXML = newElement("ImageArea", parametersXML);
-            mCommon.createVector2D("X1Y1", channel.parameters[ii].imageArea.x1y1, imageAreaXML);
-            mCommon.createVector2D("X2Y2", channel.parameters[ii].imageArea.x2y2, imageAreaXML);
-            if(!channel.parameters[ii].imageArea.polygon.empty())
-            {
-                XMLElem polygonXML = newElement("Polygon", imageAreaXML);
-                setAttribute(polygonXML, "size", channel.parameters[ii].imageArea.polygon.size());
-                for (size_t jj = 0; jj < channel.parameters[ii].imageArea.polygon.size(); ++jj)
-                {
-                    XMLElem vertexXML = mCommon.createVector2D("Vertex", channel.parameters[ii].imageArea.polygon[jj], polygonXML);
-                    setAttribute(vertexXML, "index", jj+1);
-                }
-            }
-        }
-        if(channel.parameters[ii].antenna.get())
-        {
-            XMLElem antennaXML = newElement("Antenna", parametersXML);
-            createString("TxAPCId", channel.parameters[ii].antenna->txAPCId, antennaXML);
-            createString("TxAPATId", channel.parameters[ii].antenna->txAPATId, antennaXML);
-            createString("RcvAPCId", channel.parameters[ii].antenna->rcvAPCId, antennaXML);
-            createString("RcvAPATId", channel.parameters[ii].antenna->rcvAPATId, antennaXML);
-        }
-        if(channel.parameters[ii].txRcv.get())
+    }
+    if(parameter.antenna.get())
+    {
+        XMLElem antennaXML = newElement("Antenna", parametersXML);
+        createString("TxAPCId", parameter.antenna->txAPCId, antennaXML);
+        createString("TxAPATId", parameter.antenna->txAPATId, antennaXML);
+        createString("RcvAPCId", parameter.antenna->rcvAPCId, antennaXML);
+        createString("RcvAPATId", parameter.antenna->rcvAPATId, antennaXML);
+    }
+    if(parameter.txRcv.get())
+    {
+        XMLElem txRcvXML = newElement("TxRcv", parametersXML);
+        for (size_t jj = 0; jj < parameter.txRcv->txWFId.size(); ++jj)
         {
-            XMLElem txRcvXML = newElement("TxRcv", parametersXML);
-            for (size_t jj = 0; jj < channel.parameters[ii].txRcv->txWFId.size(); ++jj)
-            {
-                createString("TxWFId", channel.parameters[ii].txRcv->txWFId[jj], txRcvXML);
-            }
-            for (size_t jj = 0; jj < channel.parameters[ii].txRcv->rcvId.size(); ++jj)
-            {
-                createString("RcvId", channel.parameters[ii].txRcv->rcvId[jj], txRcvXML);
-            }
+            createString("TxWFId", parameter.txRcv->txWFId[jj], txRcvXML);
         }
-        if(channel.parameters[ii].tgtRefLevel.get())
+        for (size_t jj = 0; jj < parameter.txRcv->rcvId.size(); ++jj)
         {
-            XMLElem tgtRefXML = newElement("TgtRefLevel", parametersXML);
-            createDouble("PTRef", channel.parameters[ii].tgtRefLevel->ptRef, tgtRefXML);
+            createString("RcvId", parameter.txRcv->rcvId[jj], txRcvXML);
         }
-        if(channel.parameters[ii].noiseLevel.get())
+    }
+    if(parameter.tgtRefLevel.get())
+    {
+        XMLElem tgtRefXML = newElement("TgtRefLevel", parametersXML);
+        createDouble("PTRef", parameter.tgtRefLevel->ptRef, tgtRefXML);
+    }
+    if(parameter.noiseLevel.get())
+    {
+        XMLElem noiseLevelXML = newElement("NoiseLevel", parametersXML);
+        createDouble("PNRef", parameter.noiseLevel->pnRef, noiseLevelXML);
+        createDouble("BNRef", parameter.noiseLevel->bnRef, noiseLevelXML);
+        if(parameter.noiseLevel->fxNoiseProfile.get())
         {
-            XMLElem noiseLevelXML = newElement("NoiseLevel", parametersXML);
-            createDouble("PNRef", channel.parameters[ii].noiseLevel->pnRef, noiseLevelXML);
-            createDouble("BNRef", channel.parameters[ii].noiseLevel->bnRef, noiseLevelXML);
-            if(channel.parameters[ii].noiseLevel->fxNoiseProfile.get())
+            XMLElem fxNoiseProfileXML = newElement("FxNoiseProfile", noiseLevelXML);
+            for (size_t jj = 0; jj < parameter.noiseLevel->fxNoiseProfile->point.size(); ++jj)
             {
-                XMLElem fxNoiseProfileXML = newElement("FxNoiseProfile", noiseLevelXML);
-                for (size_t jj = 0; jj < channel.parameters[ii].noiseLevel->fxNoiseProfile->point.size(); ++jj)
-                {
-                    XMLElem pointXML = newElement("Point", fxNoiseProfileXML);
-                    createDouble("Fx", channel.parameters[ii].noiseLevel->fxNoiseProfile->point[jj].fx, pointXML);
-                    createDouble("PN", channel.parameters[ii].noiseLevel->fxNoiseProfile->point[jj].pn, pointXML);
-                }
+                XMLElem pointXML = newElement("Point", fxNoiseProfileXML);
+                createDouble("Fx", parameter.noiseLevel->fxNoiseProfile->point[jj].fx, pointXML);
+                createDouble("PN", parameter.noiseLevel->fxNoiseProfile->point[jj].pn, pointXML);
             }
         }
     }
+    return parametersXML;
+}
+
+void CPHDXMLParser::addAddedParameters(const Channel& channel, XMLElem channelXML)
+{
     if(!channel.addedParameters.empty())
     {
         XMLElem addedParamsXML = newElement("AddedParameters", channelXML);
         mCommon.addParameters("Parameter", getDefaultURI(), channel.addedParameters, addedParamsXML);
     }
-    return channelXML;
 }
 
 XMLElem CPHDXMLParser::toXML(const Pvp& pvp, XMLElem parent)
@@ -22,16 +22,20 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <ostream>
 #include <vector>
 #include <typeinfo>
 #include <string>
+#include <complex>
 
 #include <std/bit>
 
 #include <nitf/coda-oss.hpp>
 #include <six/Init.h>
+#include <six/Executor.h>
 #include <sys/Conf.h>
+#include <str/Convert.h>
 
 #include <cphd/Types.h>
 #include <cphd/PVPBlock.h>
@@ -102,340 +106,511 @@ inline void getData(std::byte* dest_,
     getData(&(dest[1]), value[1]);
     getData(&(dest[2]), value[2]);
 }
-}
 
-namespace cphd
-{
+// Vectors are handed out to threads this many at a time when loading
+const size_t MIN_VECTORS_PER_THREAD = 1024;
 
-PVPBlock::PVPSet::PVPSet() :
-    txTime(six::Init::undefined<double>()),
-    txPos(six::Init::undefined<Vector3>()),
-    txVel(six::Init::undefined<Vector3>()),
-    rcvTime(six::Init::undefined<double>()),
-    rcvPos(six::Init::undefined<Vector3>()),
-    rcvVel(six::Init::undefined<Vector3>()),
-    srpPos(six::Init::undefined<Vector3>()),
-    aFDOP(six::Init::undefined<double>()),
-    aFRR1(six::Init::undefined<double>()),
-    aFRR2(six::Init::undefined<double>()),
-    fx1(six::Init::undefined<double>()),
-    fx2(six::Init::undefined<double>()),
-    toa1(six::Init::undefined<double>()),
-    toa2(six::Init::undefined<double>()),
-    tdTropoSRP(six::Init::undefined<double>()),
-    sc0(six::Init::undefined<double>()),
-    scss(six::Init::undefined<double>())
+template <typename T>
+std::span<const T> toSpan(const std::vector<T>& values)
 {
+    return std::span<const T>(values.data(), values.size());
 }
 
-void PVPBlock::PVPSet::write(const PVPBlock& pvpBlock, const Pvp& p, const sys::byte* input)
+// Copy one parameter of vectors [begin, end) from PVP data laid out as in the
+// file.  input points at the parameter in vector begin.
+template <typename T>
+void setColumn(const std::byte* input, size_t numBytesPerVector,
+               size_t begin, size_t end, std::vector<T>& dest)
+{
+    for (size_t ii = begin; ii < end; ++ii, input += numBytesPerVector)
+    {
+        setData(input, dest[ii]);
+    }
+}
+template <typename TOptional>
+void setOptionalColumn(const std::byte* input, size_t numBytesPerVector,
+                       size_t begin, size_t end, TOptional& dest)
 {
-    ::setData(input + p.txTime.getByteOffset(), txTime);
-    ::setData(input + p.txPos.getByteOffset(), txPos);
-    ::setData(input + p.txVel.getByteOffset(), txVel);
-    ::setData(input + p.rcvTime.getByteOffset(), rcvTime);
-    ::setData(input + p.rcvPos.getByteOffset(), rcvPos);
-    ::setData(input + p.rcvVel.getByteOffset(), rcvVel);
-    ::setData(input + p.srpPos.getByteOffset(), srpPos);
-    ::setData(input + p.aFDOP.getByteOffset(), aFDOP);
-    ::setData(input + p.aFRR1.getByteOffset(), aFRR1);
-    ::setData(input + p.aFRR2.getByteOffset(), aFRR2);
-    ::setData(input + p.fx1.getByteOffset(), fx1);
-    ::setData(input + p.fx2.getByteOffset(), fx2);
-    ::setData(input + p.toa1.getByteOffset(), toa1);
-    ::setData(input + p.toa2.getByteOffset(), toa2);
-    ::setData(input + p.tdTropoSRP.getByteOffset(), tdTropoSRP);
-    ::setData(input + p.sc0.getByteOffset(), sc0);
-    ::setData(input + p.scss.getByteOffset(), scss);
+    setColumn(input, numBytesPerVector, begin, end, dest.values);
+    std::fill(dest.isSet.begin() + begin, dest.isSet.begin() + end, 1);
+}
 
-    if (pvpBlock.hasAmpSF())
+// Copy vectors [begin, end) of an added parameter of type T into values,
+// converting to how the parameter is held.
+template <typename T, typename TStored>
+void setAddedValues(const std::byte* input, size_t numBytesPerVector,
+                    size_t begin, size_t end, std::vector<TStored>& values)
+{
+    for (size_t ii = begin; ii < end; ++ii, input += numBytesPerVector)
     {
-        ampSF.reset(new double());
-        ::setData(input + p.ampSF.getByteOffset(), *ampSF);
+        T val;
+        setData(input, val);
+        values[ii] = static_cast<TStored>(val);
     }
-    if (pvpBlock.hasFxN1())
+}
+template <typename T, typename TStored>
+void setAddedComplexValues(const std::byte* input, size_t numBytesPerVector,
+                           size_t begin, size_t end,
+                           std::vector<TStored>& values)
+{
+    for (size_t ii = begin; ii < end; ++ii, input += numBytesPerVector)
     {
-        fxN1.reset(new double());
-        ::setData(input + p.fxN1.getByteOffset(), *fxN1);
+        std::complex<T> val;
+        setData(input, val);
+        values[2 * ii] = static_cast<TStored>(val.real());
+        values[2 * ii + 1] = static_cast<TStored>(val.imag());
     }
-    if (pvpBlock.hasFxN2())
+}
+template <typename TAdded>
+void setAddedColumn(const cphd::APVPType& type, const std::byte* input,
+                    size_t numBytesPerVector, size_t begin, size_t end,
+                    TAdded& dest)
+{
+    const std::string format = type.getFormat();
+    auto& reals = dest.reals;
+    auto& integers = dest.integers;
+    if (format == "F4")
     {
-        fxN2.reset(new double());
-        ::setData(input + p.fxN2.getByteOffset(), *fxN2);
+        setAddedValues<float>(input, numBytesPerVector, begin, end, reals);
     }
-    if (pvpBlock.hasToaE1())
+    else if (format == "F8")
     {
-        toaE1.reset(new double());
-        ::setData(input + p.toaE1.getByteOffset(), *toaE1);
+        setAddedValues<double>(input, numBytesPerVector, begin, end, reals);
     }
-    if (pvpBlock.hasToaE2())
+    else if (format == "U1")
     {
-        toaE2.reset(new double());
-        ::setData(input + p.toaE2.getByteOffset(), *toaE2);
+        setAddedValues<std::uint8_t>(input, numBytesPerVector, begin, end, integers);
     }
-    if (pvpBlock.hasTDIonoSRP())
+    else if (format == "U2")
     {
-        tdIonoSRP.reset(new double());
-        ::setData(input + p.tdIonoSRP.getByteOffset(), *tdIonoSRP);
+        setAddedValues<std::uint16_t>(input, numBytesPerVector, begin, end, integers);
     }
-    if (pvpBlock.hasSignal())
+    else if (format == "U4")
     {
-        signal.reset(new std::int64_t());
-        ::setData(input + p.signal.getByteOffset(), *signal);
+        setAddedValues<std::uint32_t>(input, numBytesPerVector, begin, end, integers);
     }
-    for (auto it = p.addedPVP.begin(); it != p.addedPVP.end(); ++it)
+    else if (format == "U8")
     {
-        if (it->second.getFormat() == "F4")
-        {
-            float val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "F8")
-        {
-            double val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "U1")
-        {
-            std::uint8_t val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "U2")
-        {
-            std::uint16_t val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "U4")
-        {
-            std::uint32_t val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "U8")
-        {
-            std::uint64_t val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "I1")
-        {
-            std::int8_t val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "I2")
-        {
-            std::int16_t val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "I4")
-        {
-            std::int32_t val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "I8")
-        {
-            std::int64_t val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "CI2")
-        {
-            std::complex<std::int8_t> val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "CI4")
-        {
-            std::complex<std::int16_t> val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "CI8")
-        {
-            std::complex<std::int32_t> val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "CI16")
-        {
-            std::complex<std::int64_t> val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "CF8")
-        {
-            std::complex<float> val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
-        }
-        else if (it->second.getFormat() == "CF16")
+        setAddedValues<std::uint64_t>(input, numBytesPerVector, begin, end, integers);
+    }
+    else if (format == "I1")
+    {
+        setAddedValues<std::int8_t>(input, numBytesPerVector, begin, end, integers);
+    }
+    else if (format == "I2")
+    {
+        setAddedValues<std::int16_t>(input, numBytesPerVector, begin, end, integers);
+    }
+    else if (format == "I4")
+    {
+        setAddedValues<std::int32_t>(input, numBytesPerVector, begin, end, integers);
+    }
+    else if (format == "I8")
+    {
+        setAddedValues<std::int64_t>(input, numBytesPerVector, begin, end, integers);
+    }
+    else if (format == "CI2")
+    {
+        setAddedComplexValues<std::int8_t>(
+                input, numBytesPerVector, begin, end, integers);
+    }
+    else if (format == "CI4")
+    {
+        setAddedComplexValues<std::int16_t>(
+                input, numBytesPerVector, begin, end, integers);
+    }
+    else if (format == "CI8")
+    {
+        setAddedComplexValues<std::int32_t>(
+                input, numBytesPerVector, begin, end, integers);
+    }
+    else if (format == "CI16")
+    {
+        setAddedComplexValues<std::int64_t>(
+                input, numBytesPerVector, begin, end, integers);
+    }
+    else if (format == "CF8")
+    {
+        setAddedComplexValues<float>(
+                input, numBytesPerVector, begin, end, reals);
+    }
+    else if (format == "CF16")
+    {
+        setAddedComplexValues<double>(
+                input, numBytesPerVector, begin, end, reals);
+    }
+    else
+    {
+        for (size_t ii = begin; ii < end; ++ii, input += numBytesPerVector)
         {
-            std::complex<double> val;
-            ::setData(input + it->second.getByteOffset(), val);
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
+            dest.strings[ii].assign(reinterpret_cast<const char*>(input),
+                                    type.getByteSize());
         }
-        else
+    }
+    std::fill(dest.isSet.begin() + begin, dest.isSet.begin() + end, 1);
+}
+
+// Copy one parameter of every vector into PVP data laid out as in the file.
+// output points at the parameter in the first vector.
+template <typename T>
+void getColumn(const std::vector<T>& src, size_t numBytesPerVector,
+               std::byte* output)
+{
+    for (size_t ii = 0; ii < src.size(); ++ii, output += numBytesPerVector)
+    {
+        getData(output, src[ii]);
+    }
+}
+template <typename TOptional>
+void getOptionalColumn(const TOptional& src, size_t numBytesPerVector,
+                       std::byte* output)
+{
+    for (size_t ii = 0; ii < src.values.size();
+         ++ii, output += numBytesPerVector)
+    {
+        if (src.isSet[ii])
         {
-            const auto pVal = input + it->second.getByteOffset();
-            std::string val;
-            val.assign(reinterpret_cast<const char*>(pVal),
-                       it->second.getByteSize());
-            addedPVP[it->first] = six::Parameter();
-            addedPVP.find(it->first)->second.setValue(val);
+            getData(output, src.values[ii]);
         }
     }
 }
 
-void PVPBlock::PVPSet::read(const Pvp& p, sys::ubyte* dest_) const
+template <typename T, typename TStored>
+void getAddedValues(const std::vector<TStored>& values,
+                    size_t numBytesPerVector, std::byte* output)
+{
+    for (size_t ii = 0; ii < values.size();
+         ++ii, output += numBytesPerVector)
+    {
+        getData(output, static_cast<T>(values[ii]));
+    }
+}
+template <typename T, typename TStored>
+void getAddedComplexValues(const std::vector<TStored>& values,
+                           size_t numBytesPerVector, std::byte* output)
 {
-    auto dest = reinterpret_cast<std::byte*>(dest_);
-    ::getData(dest + p.txTime.getByteOffset(), txTime);
-    ::getData(dest + p.txPos.getByteOffset(), txPos);
-    ::getData(dest + p.txVel.getByteOffset(), txVel);
-    ::getData(dest + p.rcvTime.getByteOffset(), rcvTime);
-    ::getData(dest + p.rcvPos.getByteOffset(), rcvPos);
-    ::getData(dest + p.rcvVel.getByteOffset(), rcvVel);
-    ::getData(dest + p.srpPos.getByteOffset(), srpPos);
-    ::getData(dest + p.aFDOP.getByteOffset(), aFDOP);
-    ::getData(dest + p.aFRR1.getByteOffset(), aFRR1);
-    ::getData(dest + p.aFRR2.getByteOffset(), aFRR2);
-    ::getData(dest + p.fx1.getByteOffset(), fx1);
-    ::getData(dest + p.fx2.getByteOffset(), fx2);
-    ::getData(dest + p.toa1.getByteOffset(), toa1);
-    ::getData(dest + p.toa2.getByteOffset(), toa2);
-    ::getData(dest + p.tdTropoSRP.getByteOffset(), tdTropoSRP);
-    ::getData(dest + p.sc0.getByteOffset(), sc0);
-    ::getData(dest + p.scss.getByteOffset(), scss);
+    for (size_t ii = 0; ii < values.size();
+         ii += 2, output += numBytesPerVector)
+    {
+        getData(output, std::complex<T>(static_cast<T>(values[ii]),
+                                        static_cast<T>(values[ii + 1])));
+    }
+}
+template <typename TAdded>
+void getAddedColumn(const cphd::APVPType& type, const TAdded& src,
+                    size_t numBytesPerVector, std::byte* output)
+{
+    if (std::find(src.isSet.begin(), src.isSet.end(), 0) != src.isSet.end())
+    {
+        throw except::Exception(Ctxt(
+            "Incorrect number of additional parameters instantiated"));
+    }
 
-    if (ampSF.get())
+    const std::string format = type.getFormat();
+    const auto& reals = src.reals;
+    const auto& integers = src.integers;
+    if (format == "F4")
     {
-        ::getData(dest + p.ampSF.getByteOffset(), *ampSF);
+        getAddedValues<float>(reals, numBytesPerVector, output);
     }
-    if (fxN1.get())
+    else if (format == "F8")
     {
-        ::getData(dest + p.fxN1.getByteOffset(), *fxN1);
+        getAddedValues<double>(reals, numBytesPerVector, output);
     }
-    if (fxN2.get())
+    else if (format == "U1")
     {
-        ::getData(dest + p.fxN2.getByteOffset(), *fxN2);
+        getAddedValues<std::uint8_t>(integers, numBytesPerVector, output);
     }
-    if (toaE1.get())
+    else if (format == "U2")
     {
-        ::getData(dest + p.toaE1.getByteOffset(), *toaE1);
+        getAddedValues<std::uint16_t>(integers, numBytesPerVector, output);
     }
-    if (toaE2.get())
+    else if (format == "U4")
     {
-        ::getData(dest + p.toaE2.getByteOffset(), *toaE2);
+        getAddedValues<std::uint32_t>(integers, numBytesPerVector, output);
     }
-    if (tdIonoSRP.get())
+    else if (format == "U8")
     {
-        ::getData(dest + p.tdIonoSRP.getByteOffset(), *tdIonoSRP);
+        getAddedValues<std::uint64_t>(integers, numBytesPerVector, output);
     }
-    if (signal.get())
+    else if (format == "I1")
     {
-        ::getData(dest + p.signal.getByteOffset(), *signal);
+        getAddedValues<std::int8_t>(integers, numBytesPerVector, output);
     }
-    if (addedPVP.size() != p.addedPVP.size())
+    else if (format == "I2")
     {
-        throw except::Exception(Ctxt(
-            "Incorrect number of additional parameters instantiated"));
+        getAddedValues<std::int16_t>(integers, numBytesPerVector, output);
     }
-    for (auto it = p.addedPVP.begin(); it != p.addedPVP.end(); ++it)
+    else if (format == "I4")
     {
-        if (it->second.getFormat() == "F4")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<float>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "F8")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<double>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "U1")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<std::uint8_t>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "U2")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<std::uint16_t>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "U4")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<std::uint32_t>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "U8")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<std::uint64_t>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "I1")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<std::int8_t>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "I2")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<std::int16_t>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "I4")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<std::int32_t>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "I8")
-        {
-            ::getData(dest + it->second.getByteOffset(), static_cast<std::int64_t>(addedPVP.find(it->first)->second));
-        }
-        else if (it->second.getFormat() == "CI2")
-        {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.getComplex<std::int8_t>());
-        }
-        else if (it->second.getFormat() == "CI4")
-        {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.getComplex<std::int16_t>());
-        }
-        else if (it->second.getFormat() == "CI8")
-        {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.getComplex<std::int32_t>());
-        }
-        else if (it->second.getFormat() == "CI16")
-        {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.getComplex<std::int64_t>());
-        }
-        else if (it->second.getFormat() == "CF8")
-        {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.getComplex<float>());
-        }
-        else if (it->second.getFormat() == "CF16")
-        {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.getComplex<double>());
-        }
-        else
+        getAddedValues<std::int32_t>(integers, numBytesPerVector, output);
+    }
+    else if (format == "I8")
+    {
+        getAddedValues<std::int64_t>(integers, numBytesPerVector, output);
+    }
+    else if (format == "CI2")
+    {
+        getAddedComplexValues<std::int8_t>(integers, numBytesPerVector, output);
+    }
+    else if (format == "CI4")
+    {
+        getAddedComplexValues<std::int16_t>(integers, numBytesPerVector, output);
+    }
+    else if (format == "CI8")
+    {
+        getAddedComplexValues<std::int32_t>(integers, numBytesPerVector, output);
+    }
+    else if (format == "CI16")
+    {
+        getAddedComplexValues<std::int64_t>(integers, numBytesPerVector, output);
+    }
+    else if (format == "CF8")
+    {
+        getAddedComplexValues<float>(reals, numBytesPerVector, output);
+    }
+    else if (format == "CF16")
+    {
+        getAddedComplexValues<double>(reals, numBytesPerVector, output);
+    }
+    else
+    {
+        for (size_t ii = 0; ii < src.strings.size();
+             ++ii, output += numBytesPerVector)
         {
-            ::getData(dest + it->second.getByteOffset(), addedPVP.find(it->first)->second.str().c_str(), it->second.getByteSize());
+            const std::string& val = src.strings[ii];
+            const size_t size = std::min(val.size(), type.getByteSize());
+            getData(output, val.c_str(), size);
+            std::fill(output + size, output + type.getByteSize(),
+                      static_cast<std::byte>(0));
         }
     }
 }
 
+// Convert a value handed to setAddedPVP() to T, the way an added parameter
+// of T's kind is held.  Strings are parsed like six::Parameter does.
+template <typename T>
+struct AddedValue
+{
+    template <typename TFrom>
+    static T from(TFrom value)
+    {
+        return static_cast<T>(value);
+    }
+    template <typename TFrom>
+    static T from(const std::complex<TFrom>&)
+    {
+        throw except::Exception(Ctxt(
+                "Complex value given for a real additional parameter"));
+    }
+    static T from(const std::string& value)
+    {
+        return str::toType<T>(value);
+    }
+};
+template <typename T>
+struct AddedValue<std::complex<T> >
+{
+    template <typename TFrom>
+    static std::complex<T> from(TFrom value)
+    {
+        return std::complex<T>(static_cast<T>(value));
+    }
+    template <typename TFrom>
+    static std::complex<T> from(const std::complex<TFrom>& value)
+    {
+        return std::complex<T>(static_cast<T>(value.real()),
+                               static_cast<T>(value.imag()));
+    }
+    static std::complex<T> from(const std::string& value)
+    {
+        return str::toType<std::complex<T> >(value);
+    }
+};
+
+template <typename TOptional>
+auto getOptional(const TOptional& param, size_t vector)
+        -> decltype(param.values[vector])
+{
+    if (!param.isSet.empty() && param.isSet[vector])
+    {
+        return param.values[vector];
+    }
+    throw except::Exception(Ctxt(
+                    "Parameter was not set"));
+}
+
+template <typename TOptional, typename T>
+void setOptional(bool enabled, TOptional& param, T value, size_t vector)
+{
+    if (enabled)
+    {
+        param.set(vector, value);
+        return;
+    }
+    throw except::Exception(Ctxt(
+                            "Parameter was not specified in XML"));
+}
+}
+
+namespace cphd
+{
+
+void PVPBlock::PVPArrays::resize(size_t numVectors)
+{
+    txTime.resize(numVectors, six::Init::undefined<double>());
+    txPos.resize(numVectors, six::Init::undefined<Vector3>());
+    txVel.resize(numVectors, six::Init::undefined<Vector3>());
+    rcvTime.resize(numVectors, six::Init::undefined<double>());
+    rcvPos.resize(numVectors, six::Init::undefined<Vector3>());
+    rcvVel.resize(numVectors, six::Init::undefined<Vector3>());
+    srpPos.resize(numVectors, six::Init::undefined<Vector3>());
+    aFDOP.resize(numVectors, six::Init::undefined<double>());
+    aFRR1.resize(numVectors, six::Init::undefined<double>());
+    aFRR2.resize(numVectors, six::Init::undefined<double>());
+    fx1.resize(numVectors, six::Init::undefined<double>());
+    fx2.resize(numVectors, six::Init::undefined<double>());
+    toa1.resize(numVectors, six::Init::undefined<double>());
+    toa2.resize(numVectors, six::Init::undefined<double>());
+    tdTropoSRP.resize(numVectors, six::Init::undefined<double>());
+    sc0.resize(numVectors, six::Init::undefined<double>());
+    scss.resize(numVectors, six::Init::undefined<double>());
+}
+
+void PVPBlock::AddedPVPArray::resize(const std::string& format,
+                                     size_t numVectors)
+{
+    if (format == "F4" || format == "F8")
+    {
+        storage = REAL;
+        reals.resize(numVectors, six::Init::undefined<double>());
+    }
+    else if (format == "U8")
+    {
+        storage = UNSIGNED;
+        integers.resize(numVectors, six::Init::undefined<std::int64_t>());
+    }
+    else if (format == "U1" || format == "U2" || format == "U4" ||
+             format == "I1" || format == "I2" || format == "I4" ||
+             format == "I8")
+    {
+        storage = INTEGER;
+        integers.resize(numVectors, six::Init::undefined<std::int64_t>());
+    }
+    else if (format == "CI2" || format == "CI4" || format == "CI8" ||
+             format == "CI16")
+    {
+        storage = COMPLEX_INTEGER;
+        integers.resize(2 * numVectors,
+                        six::Init::undefined<std::int64_t>());
+    }
+    else if (format == "CF8" || format == "CF16")
+    {
+        storage = COMPLEX_REAL;
+        reals.resize(2 * numVectors, six::Init::undefined<double>());
+    }
+    else
+    {
+        storage = STRING;
+        strings.resize(numVectors);
+    }
+    isSet.resize(numVectors, false);
+}
+
+six::Parameter PVPBlock::AddedPVPArray::getParameter(size_t vector) const
+{
+    six::Parameter parameter;
+    switch (storage)
+    {
+    case REAL:
+        parameter.setValue(reals[vector]);
+        break;
+    case INTEGER:
+        parameter.setValue(integers[vector]);
+        break;
+    case UNSIGNED:
+        parameter.setValue(static_cast<std::uint64_t>(integers[vector]));
+        break;
+    case COMPLEX_REAL:
+        parameter.setValue(std::complex<double>(reals[2 * vector],
+                                                reals[2 * vector + 1]));
+        break;
+    case COMPLEX_INTEGER:
+        parameter.setValue(std::complex<std::int64_t>(
+                integers[2 * vector], integers[2 * vector + 1]));
+        break;
+    case STRING:
+        parameter.setValue(strings[vector]);
+        break;
+    }
+    return parameter;
+}
+
+template <typename T>
+void PVPBlock::AddedPVPArray::store(size_t vector, const T& value)
+{
+    switch (storage)
+    {
+    case REAL:
+        reals[vector] = AddedValue<double>::from(value);
+        break;
+    case INTEGER:
+        integers[vector] = AddedValue<std::int64_t>::from(value);
+        break;
+    case UNSIGNED:
+        integers[vector] = static_cast<std::int64_t>(
+                AddedValue<std::uint64_t>::from(value));
+        break;
+    case COMPLEX_REAL:
+    {
+        const auto complex = AddedValue<std::complex<double> >::from(value);
+        reals[2 * vector] = complex.real();
+        reals[2 * vector + 1] = complex.imag();
+        break;
+    }
+    case COMPLEX_INTEGER:
+    {
+        const auto complex =
+                AddedValue<std::complex<std::int64_t> >::from(value);
+        integers[2 * vector] = complex.real();
+        integers[2 * vector + 1] = complex.imag();
+        break;
+    }
+    case STRING:
+        strings[vector] = str::toString(value);
+        break;
+    }
+    isSet[vector] = true;
+}
+
+void PVPBlock::AddedPVPArray::setValue(size_t vector, double value)
+{
+    store(vector, value);
+}
+void PVPBlock::AddedPVPArray::setValue(size_t vector, std::int64_t value)
+{
+    store(vector, value);
+}
+void PVPBlock::AddedPVPArray::setValue(size_t vector, std::uint64_t value)
+{
+    store(vector, value);
+}
+void PVPBlock::AddedPVPArray::setValue(size_t vector,
+                                       const std::complex<double>& value)
+{
+    store(vector, value);
+}
+void PVPBlock::AddedPVPArray::setValue(
+        size_t vector, const std::complex<std::int64_t>& value)
+{
+    store(vector, value);
+}
+void PVPBlock::AddedPVPArray::setValue(size_t vector,
+                                       const std::string& value)
+{
+    store(vector, value);
+}
+
 /*
  * Initialize PVP Array with a data object
  */
@@ -450,11 +625,12 @@ PVPBlock::PVPBlock(const Pvp& p, const Data& d) :
 {
     mPvp = p;
     mNumBytesPerVector = d.getNumBytesPVPSet();
-    mData.resize(d.getNumChannels());
+    std::vector<size_t> numVectors(d.getNumChannels());
     for (size_t ii = 0; ii < d.getNumChannels(); ++ii)
     {
-        mData[ii].resize(d.getNumVectors(ii));
+        numVectors[ii] = d.getNumVectors(ii);
     }
+    allocate(numVectors);
     size_t calculateBytesPerVector = mPvp.getReqSetSize()*sizeof(double);
     if (six::Init::isUndefined<size_t>(mNumBytesPerVector) ||
         calculateBytesPerVector > mNumBytesPerVector)
@@ -487,48 +663,311 @@ PVPBlock::PVPBlock(size_t numChannels,
     mTDIonoSRPEnabled(!six::Init::isUndefined<size_t>(p.tdIonoSRP.getOffset())),
     mSignalEnabled(!six::Init::isUndefined<size_t>(p.signal.getOffset()))
 {
-    mData.resize(numChannels);
-    if(numChannels != numVectors.size())
+    if(numChannels != numVectors.size())
+    {
+        throw except::Exception(Ctxt(
+                "number of vector dims provided does not match number of channels"));
+    }
+    allocate(numVectors);
+    size_t calculateBytesPerVector = mPvp.getReqSetSize()*sizeof(double);
+    if (six::Init::isUndefined<size_t>(mNumBytesPerVector) ||
+        calculateBytesPerVector > mNumBytesPerVector)
+    {
+        mNumBytesPerVector = calculateBytesPerVector;
+    }
+}
+
+PVPBlock::PVPBlock(size_t numChannels,
+                   const std::vector<size_t>& numVectors,
+                   const Pvp& pvp,
+                   const std::vector<const void*>& data) :
+    PVPBlock(numChannels, numVectors, pvp)
+{
+    if (data.size() != numChannels)
+    {
+        std::ostringstream msg;
+        msg << "<" << numChannels << "> channels specified, "
+            << "but `data` argument has <" << data.size() << "> channels";
+        throw except::Exception(Ctxt(msg.str()));
+    }
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
+    {
+        setVectors(getArrays(channel),
+                   static_cast<const std::byte*>(data[channel]),
+                   mPvp.sizeInBytes(), 0, numVectors[channel]);
+    }
+}
+
+PVPBlock::Channel::Channel(const Channel& other)
+{
+    *this = other;
+}
+
+PVPBlock::Channel& PVPBlock::Channel::operator=(const Channel& other)
+{
+    if (this != &other)
+    {
+        // other's arrays may be getting filled in
+        std::lock_guard<std::mutex> lock(other.mutex);
+        numVectors = other.numVectors;
+        loaded = other.loaded;
+        arrays = other.arrays;
+        ready = other.ready.load();
+    }
+    return *this;
+}
+
+PVPBlock::Channel::Channel(Channel&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+PVPBlock::Channel& PVPBlock::Channel::operator=(Channel&& other) noexcept
+{
+    numVectors = other.numVectors;
+    loaded = std::move(other.loaded);
+    arrays = std::move(other.arrays);
+    ready = other.ready.load();
+    return *this;
+}
+
+bool PVPBlock::operator==(const PVPBlock& other) const
+{
+    if (mData.size() != other.mData.size() ||
+        mNumBytesPerVector != other.mNumBytesPerVector)
+    {
+        return false;
+    }
+    for (size_t ii = 0; ii < mData.size(); ++ii)
+    {
+        if (getArrays(ii) != other.getArrays(ii))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PVPBlock::allocate(const std::vector<size_t>& numVectors)
+{
+    // std::map keeps these sorted
+    mAddedPVPNames.clear();
+    for (auto it = mPvp.addedPVP.begin(); it != mPvp.addedPVP.end(); ++it)
+    {
+        mAddedPVPNames.push_back(it->first);
+    }
+
+    mData.resize(numVectors.size());
+    for (size_t ii = 0; ii < numVectors.size(); ++ii)
+    {
+        mData[ii].numVectors = numVectors[ii];
+    }
+}
+
+void PVPBlock::allocate(PVPArrays& arrays, size_t numVectors) const
+{
+    arrays.resize(numVectors);
+    if (mAmpSFEnabled)
+    {
+        arrays.ampSF.resize(numVectors);
+    }
+    if (mFxN1Enabled)
+    {
+        arrays.fxN1.resize(numVectors);
+    }
+    if (mFxN2Enabled)
+    {
+        arrays.fxN2.resize(numVectors);
+    }
+    if (mToaE1Enabled)
+    {
+        arrays.toaE1.resize(numVectors);
+    }
+    if (mToaE2Enabled)
+    {
+        arrays.toaE2.resize(numVectors);
+    }
+    if (mTDIonoSRPEnabled)
+    {
+        arrays.tdIonoSRP.resize(numVectors);
+    }
+    if (mSignalEnabled)
+    {
+        arrays.signal.resize(numVectors);
+    }
+    arrays.addedPVP.resize(mAddedPVPNames.size());
+    size_t field = 0;
+    for (auto it = mPvp.addedPVP.begin(); it != mPvp.addedPVP.end();
+         ++it, ++field)
+    {
+        arrays.addedPVP[field].resize(it->second.getFormat(), numVectors);
+    }
+}
+
+const PVPBlock::PVPArrays& PVPBlock::getArrays(size_t channel) const
+{
+    const Channel& data = mData[channel];
+    if (!data.ready.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(data.mutex);
+        if (!data.ready.load(std::memory_order_relaxed))
+        {
+            allocate(data.arrays, data.numVectors);
+            if (!data.loaded.empty())
+            {
+                six::Executor::get(mNumThreads)->parallelFor(data.numVectors,
+                        [&](size_t begin, size_t end)
+                        {
+                            setVectors(data.arrays, data.loaded.data(),
+                                       getNumBytesPVPSet(), begin, end);
+                        },
+                        MIN_VECTORS_PER_THREAD);
+            }
+            data.ready.store(true, std::memory_order_release);
+
+            // Nothing reads it once the arrays are ready
+            std::vector<std::byte>().swap(data.loaded);
+        }
+    }
+    return data.arrays;
+}
+
+PVPBlock::PVPArrays& PVPBlock::getArrays(size_t channel)
+{
+    static_cast<const PVPBlock&>(*this).getArrays(channel);
+    return mData[channel].arrays;
+}
+
+template <typename TFunc>
+bool PVPBlock::readLoadedVector(size_t channel, size_t vector,
+                                TFunc read) const
+{
+    const Channel& data = mData[channel];
+    if (data.ready.load(std::memory_order_acquire))
     {
-        throw except::Exception(Ctxt(
-                "number of vector dims provided does not match number of channels"));
+        return false;
     }
-    for (size_t ii = 0; ii < numChannels; ++ii)
+    std::lock_guard<std::mutex> lock(data.mutex);
+    if (data.ready.load(std::memory_order_relaxed) || data.loaded.empty())
     {
-        mData[ii].resize(numVectors[ii]);
+        return false;
     }
-    size_t calculateBytesPerVector = mPvp.getReqSetSize()*sizeof(double);
-    if (six::Init::isUndefined<size_t>(mNumBytesPerVector) ||
-        calculateBytesPerVector > mNumBytesPerVector)
+    read(data.loaded.data() + vector * getNumBytesPVPSet());
+    return true;
+}
+
+template <typename T>
+T PVPBlock::getRequiredPVP(size_t channel, size_t vector,
+                           const PVPType& param,
+                           const std::vector<T> PVPArrays::* values) const
+{
+    verifyChannelVector(channel, vector);
+    T value;
+    if (readLoadedVector(channel, vector, [&](const std::byte* loaded)
+        {
+            setData(loaded + param.getByteOffset(), value);
+        }))
     {
-        mNumBytesPerVector = calculateBytesPerVector;
+        return value;
     }
+    return (getArrays(channel).*values)[vector];
 }
 
-PVPBlock::PVPBlock(size_t numChannels,
-                   const std::vector<size_t>& numVectors,
-                   const Pvp& pvp,
-                   const std::vector<const void*>& data) :
-    PVPBlock(numChannels, numVectors, pvp)
+template <typename T>
+T PVPBlock::getOptionalPVP(size_t channel, size_t vector, bool enabled,
+                           const PVPType& param,
+                           const OptionalPVP<T> PVPArrays::* values) const
 {
-    if (data.size() != numChannels)
+    verifyChannelVector(channel, vector);
+    if (!enabled)
     {
-        std::ostringstream msg;
-        msg << "<" << numChannels << "> channels specified, "
-            << "but `data` argument has <" << data.size() << "> channels";
-        throw except::Exception(Ctxt(msg.str()));
+        throw except::Exception(Ctxt(
+                        "Parameter was not set"));
     }
+    T value;
+    if (readLoadedVector(channel, vector, [&](const std::byte* loaded)
+        {
+            setData(loaded + param.getByteOffset(), value);
+        }))
+    {
+        return value;
+    }
+    return ::getOptional(getArrays(channel).*values, vector);
+}
+
+void PVPBlock::setVectors(PVPArrays& arrays, const std::byte* input,
+                          size_t numBytesPerVector, size_t begin,
+                          size_t end) const
+{
+    const Pvp& p = mPvp;
+    const size_t stride = numBytesPerVector;
+    input += begin * stride;
+
+    ::setColumn(input + p.txTime.getByteOffset(), stride, begin, end, arrays.txTime);
+    ::setColumn(input + p.txPos.getByteOffset(), stride, begin, end, arrays.txPos);
+    ::setColumn(input + p.txVel.getByteOffset(), stride, begin, end, arrays.txVel);
+    ::setColumn(input + p.rcvTime.getByteOffset(), stride, begin, end, arrays.rcvTime);
+    ::setColumn(input + p.rcvPos.getByteOffset(), stride, begin, end, arrays.rcvPos);
+    ::setColumn(input + p.rcvVel.getByteOffset(), stride, begin, end, arrays.rcvVel);
+    ::setColumn(input + p.srpPos.getByteOffset(), stride, begin, end, arrays.srpPos);
+    ::setColumn(input + p.aFDOP.getByteOffset(), stride, begin, end, arrays.aFDOP);
+    ::setColumn(input + p.aFRR1.getByteOffset(), stride, begin, end, arrays.aFRR1);
+    ::setColumn(input + p.aFRR2.getByteOffset(), stride, begin, end, arrays.aFRR2);
+    ::setColumn(input + p.fx1.getByteOffset(), stride, begin, end, arrays.fx1);
+    ::setColumn(input + p.fx2.getByteOffset(), stride, begin, end, arrays.fx2);
+    ::setColumn(input + p.toa1.getByteOffset(), stride, begin, end, arrays.toa1);
+    ::setColumn(input + p.toa2.getByteOffset(), stride, begin, end, arrays.toa2);
+    ::setColumn(input + p.tdTropoSRP.getByteOffset(), stride, begin, end, arrays.tdTropoSRP);
+    ::setColumn(input + p.sc0.getByteOffset(), stride, begin, end, arrays.sc0);
+    ::setColumn(input + p.scss.getByteOffset(), stride, begin, end, arrays.scss);
 
-    for (size_t channel = 0; channel < numChannels; ++channel)
+    if (hasAmpSF())
+    {
+        ::setOptionalColumn(input + p.ampSF.getByteOffset(), stride, begin, end, arrays.ampSF);
+    }
+    if (hasFxN1())
     {
-        const std::byte* buf = static_cast<const std::byte*>(data[channel]);
+        ::setOptionalColumn(input + p.fxN1.getByteOffset(), stride, begin, end, arrays.fxN1);
+    }
+    if (hasFxN2())
+    {
+        ::setOptionalColumn(input + p.fxN2.getByteOffset(), stride, begin, end, arrays.fxN2);
+    }
+    if (hasToaE1())
+    {
+        ::setOptionalColumn(input + p.toaE1.getByteOffset(), stride, begin, end, arrays.toaE1);
+    }
+    if (hasToaE2())
+    {
+        ::setOptionalColumn(input + p.toaE2.getByteOffset(), stride, begin, end, arrays.toaE2);
+    }
+    if (hasTDIonoSRP())
+    {
+        ::setOptionalColumn(input + p.tdIonoSRP.getByteOffset(), stride, begin, end, arrays.tdIonoSRP);
+    }
+    if (hasSignal())
+    {
+        ::setOptionalColumn(input + p.signal.getByteOffset(), stride, begin, end, arrays.signal);
+    }
 
-        for (size_t vector = 0; vector < numVectors[channel]; ++vector)
-        {
-            mData[channel][vector].write(*this, mPvp, buf);
-            buf += mPvp.sizeInBytes();
-        }
+    size_t field = 0;
+    for (auto it = p.addedPVP.begin(); it != p.addedPVP.end(); ++it, ++field)
+    {
+        ::setAddedColumn(it->second, input + it->second.getByteOffset(),
+                         stride, begin, end, arrays.addedPVP[field]);
+    }
+}
+
+size_t PVPBlock::getAddedPVPField(const std::string& name) const
+{
+    const auto it = std::lower_bound(mAddedPVPNames.begin(),
+                                     mAddedPVPNames.end(), name);
+    if (it != mAddedPVPNames.end() && *it == name)
+    {
+        return it - mAddedPVPNames.begin();
     }
+    return mAddedPVPNames.size();
 }
 
 size_t PVPBlock::getNumBytesPVPSet() const
@@ -536,24 +975,38 @@ size_t PVPBlock::getNumBytesPVPSet() const
     return mNumBytesPerVector;
 }
 
-void PVPBlock::verifyChannelVector(size_t channel, size_t vector) const
+void PVPBlock::verifyChannel(size_t channel) const
 {
     if (channel >= mData.size())
     {
         throw except::Exception(Ctxt(
                 "Invalid channel number: " + std::to_string(channel)));
     }
-    if (vector >= mData[channel].size())
+}
+
+void PVPBlock::verifyChannelVector(size_t channel, size_t vector) const
+{
+    verifyChannel(channel);
+    if (vector >= mData[channel].numVectors)
     {
         throw except::Exception(Ctxt(
                 "Invalid vector number: " + std::to_string(vector)));
     }
 }
 
+void PVPBlock::verifyOptional(bool enabled) const
+{
+    if (!enabled)
+    {
+        throw except::Exception(Ctxt(
+                                "Parameter was not specified in XML"));
+    }
+}
+
 size_t PVPBlock::getPVPsize(size_t channel) const
 {
     verifyChannelVector(channel, 0);
-    return getNumBytesPVPSet() * mData[channel].size();
+    return getNumBytesPVPSet() * mData[channel].numVectors;
 }
 
 void PVPBlock::getPVPdata(size_t channel,
@@ -570,14 +1023,53 @@ void PVPBlock::getPVPdata(size_t channel,
                           void* data) const
 {
     verifyChannelVector(channel, 0);
-    const size_t numBytes = getNumBytesPVPSet();
-    auto ptr = static_cast<std::byte*>(data);
+    if (readLoadedVector(channel, 0, [&](const std::byte* loaded)
+        {
+            // Already laid out as in the file
+            std::copy(loaded, loaded + getPVPsize(channel),
+                      static_cast<std::byte*>(data));
+        }))
+    {
+        return;
+    }
 
-    for (size_t ii = 0;
-         ii < mData[channel].size();
-         ++ii, ptr += numBytes)
+    const PVPArrays& arrays = getArrays(channel);
+    const Pvp& p = mPvp;
+    const size_t stride = getNumBytesPVPSet();
+    auto dest = static_cast<std::byte*>(data);
+
+    ::getColumn(arrays.txTime, stride, dest + p.txTime.getByteOffset());
+    ::getColumn(arrays.txPos, stride, dest + p.txPos.getByteOffset());
+    ::getColumn(arrays.txVel, stride, dest + p.txVel.getByteOffset());
+    ::getColumn(arrays.rcvTime, stride, dest + p.rcvTime.getByteOffset());
+    ::getColumn(arrays.rcvPos, stride, dest + p.rcvPos.getByteOffset());
+    ::getColumn(arrays.rcvVel, stride, dest + p.rcvVel.getByteOffset());
+    ::getColumn(arrays.srpPos, stride, dest + p.srpPos.getByteOffset());
+    ::getColumn(arrays.aFDOP, stride, dest + p.aFDOP.getByteOffset());
+    ::getColumn(arrays.aFRR1, stride, dest + p.aFRR1.getByteOffset());
+    ::getColumn(arrays.aFRR2, stride, dest + p.aFRR2.getByteOffset());
+    ::getColumn(arrays.fx1, stride, dest + p.fx1.getByteOffset());
+    ::getColumn(arrays.fx2, stride, dest + p.fx2.getByteOffset());
+    ::getColumn(arrays.toa1, stride, dest + p.toa1.getByteOffset());
+    ::getColumn(arrays.toa2, stride, dest + p.toa2.getByteOffset());
+    ::getColumn(arrays.tdTropoSRP, stride, dest + p.tdTropoSRP.getByteOffset());
+    ::getColumn(arrays.sc0, stride, dest + p.sc0.getByteOffset());
+    ::getColumn(arrays.scss, stride, dest + p.scss.getByteOffset());
+
+    // Optional parameters not in the metadata are empty
+    ::getOptionalColumn(arrays.ampSF, stride, dest + p.ampSF.getByteOffset());
+    ::getOptionalColumn(arrays.fxN1, stride, dest + p.fxN1.getByteOffset());
+    ::getOptionalColumn(arrays.fxN2, stride, dest + p.fxN2.getByteOffset());
+    ::getOptionalColumn(arrays.toaE1, stride, dest + p.toaE1.getByteOffset());
+    ::getOptionalColumn(arrays.toaE2, stride, dest + p.toaE2.getByteOffset());
+    ::getOptionalColumn(arrays.tdIonoSRP, stride, dest + p.tdIonoSRP.getByteOffset());
+    ::getOptionalColumn(arrays.signal, stride, dest + p.signal.getByteOffset());
+
+    size_t field = 0;
+    for (auto it = p.addedPVP.begin(); it != p.addedPVP.end(); ++it, ++field)
     {
-        mData[channel][ii].read(mPvp, ptr);
+        ::getAddedColumn(it->second, arrays.addedPVP[field], stride,
+                         dest + it->second.getByteOffset());
     }
 }
 
@@ -609,13 +1101,13 @@ int64_t PVPBlock::load(io::SeekableInputStream& inStream,
     // Seek to start of PVPBlock
     size_t totalBytesRead(0);
     inStream.seek(startPVP, io::Seekable::START);
-    std::vector<std::byte> readBuf;
-    const size_t numBytesPerVector = getNumBytesPVPSet();
+    mNumThreads = numThreads;
 
-    // Read the data for each channel
+    // Read the data for each channel.  It's unpacked when it's needed.
     for (size_t ii = 0; ii < mData.size(); ++ii)
     {
-        readBuf.resize(getPVPsize(ii));
+        Channel& data = mData[ii];
+        std::vector<std::byte> readBuf(getPVPsize(ii));
         if (!readBuf.empty())
         {
             auto const buf = readBuf.data();
@@ -637,13 +1129,10 @@ int64_t PVPBlock::load(io::SeekableInputStream& inStream,
                          readBuf.size() / sizeof(double),
                          numThreads);
             }
-
-            std::byte* ptr = buf;
-            for (size_t jj = 0; jj < mData[ii].size(); ++jj, ptr += numBytesPerVector)
-            {
-                mData[ii][jj].write(*this, mPvp, ptr);
-            }
         }
+        data.loaded.swap(readBuf);
+        data.arrays = PVPArrays();
+        data.ready = false;
     }
     return totalBytesRead;
 }
@@ -655,426 +1144,419 @@ int64_t PVPBlock::load(io::SeekableInputStream& inStream, const FileHeader& file
 
 double PVPBlock::getTxTime(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].txTime;
+    return getRequiredPVP(channel, set, mPvp.txTime, &PVPArrays::txTime);
 }
 
 Vector3 PVPBlock::getTxPos(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].txPos;
+    return getRequiredPVP(channel, set, mPvp.txPos, &PVPArrays::txPos);
 }
 
 Vector3 PVPBlock::getTxVel(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].txVel;
+    return getRequiredPVP(channel, set, mPvp.txVel, &PVPArrays::txVel);
 }
 
 double PVPBlock::getRcvTime(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].rcvTime;
+    return getRequiredPVP(channel, set, mPvp.rcvTime, &PVPArrays::rcvTime);
 }
 
 Vector3 PVPBlock::getRcvPos(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].rcvPos;
+    return getRequiredPVP(channel, set, mPvp.rcvPos, &PVPArrays::rcvPos);
 }
 
 Vector3 PVPBlock::getRcvVel(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].rcvVel;
+    return getRequiredPVP(channel, set, mPvp.rcvVel, &PVPArrays::rcvVel);
 }
 
 Vector3 PVPBlock::getSRPPos(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].srpPos;
+    return getRequiredPVP(channel, set, mPvp.srpPos, &PVPArrays::srpPos);
 }
 
 double PVPBlock::getaFDOP(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].aFDOP;
+    return getRequiredPVP(channel, set, mPvp.aFDOP, &PVPArrays::aFDOP);
 }
 
 double PVPBlock::getaFRR1(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].aFRR1;
+    return getRequiredPVP(channel, set, mPvp.aFRR1, &PVPArrays::aFRR1);
 }
 
 double PVPBlock::getaFRR2(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].aFRR2;
+    return getRequiredPVP(channel, set, mPvp.aFRR2, &PVPArrays::aFRR2);
 }
 
 double PVPBlock::getFx1(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].fx1;
+    return getRequiredPVP(channel, set, mPvp.fx1, &PVPArrays::fx1);
 }
 
 double PVPBlock::getFx2(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].fx2;
+    return getRequiredPVP(channel, set, mPvp.fx2, &PVPArrays::fx2);
 }
 
 double PVPBlock::getTOA1(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].toa1;
+    return getRequiredPVP(channel, set, mPvp.toa1, &PVPArrays::toa1);
 }
 
 double PVPBlock::getTOA2(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].toa2;
+    return getRequiredPVP(channel, set, mPvp.toa2, &PVPArrays::toa2);
 }
 
 double PVPBlock::getTdTropoSRP(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].tdTropoSRP;
+    return getRequiredPVP(channel, set, mPvp.tdTropoSRP, &PVPArrays::tdTropoSRP);
 }
 
 double PVPBlock::getSC0(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].sc0;
+    return getRequiredPVP(channel, set, mPvp.sc0, &PVPArrays::sc0);
 }
 
 double PVPBlock::getSCSS(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    return mData[channel][set].scss;
+    return getRequiredPVP(channel, set, mPvp.scss, &PVPArrays::scss);
 }
 
 double PVPBlock::getAmpSF(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    if (mData[channel][set].ampSF.get())
-    {
-        return *mData[channel][set].ampSF;
-    }
-    throw except::Exception(Ctxt(
-                    "Parameter was not set"));
+    return getOptionalPVP(channel, set, hasAmpSF(), mPvp.ampSF, &PVPArrays::ampSF);
 }
 
 double PVPBlock::getFxN1(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    if (mData[channel][set].fxN1.get())
-    {
-        return *mData[channel][set].fxN1;
-    }
-    throw except::Exception(Ctxt(
-                    "Parameter was not set"));
+    return getOptionalPVP(channel, set, hasFxN1(), mPvp.fxN1, &PVPArrays::fxN1);
 }
 
 double PVPBlock::getFxN2(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    if (mData[channel][set].fxN2.get())
-    {
-        return *mData[channel][set].fxN2;
-    }
-    throw except::Exception(Ctxt(
-                    "Parameter was not set"));
+    return getOptionalPVP(channel, set, hasFxN2(), mPvp.fxN2, &PVPArrays::fxN2);
 }
 
 double PVPBlock::getTOAE1(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    if (mData[channel][set].toaE1.get())
-    {
-        return *mData[channel][set].toaE1;
-    }
-    throw except::Exception(Ctxt(
-                    "Parameter was not set"));
+    return getOptionalPVP(channel, set, hasToaE1(), mPvp.toaE1, &PVPArrays::toaE1);
 }
 
 double PVPBlock::getTOAE2(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    if (mData[channel][set].toaE2.get())
-    {
-        return *mData[channel][set].toaE2;
-    }
-    throw except::Exception(Ctxt(
-                    "Parameter was not set"));
+    return getOptionalPVP(channel, set, hasToaE2(), mPvp.toaE2, &PVPArrays::toaE2);
 }
 
 double PVPBlock::getTdIonoSRP(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    if (mData[channel][set].tdIonoSRP.get())
-    {
-        return *mData[channel][set].tdIonoSRP;
-    }
-    throw except::Exception(Ctxt(
-                    "Parameter was not set"));
+    return getOptionalPVP(channel, set, hasTDIonoSRP(), mPvp.tdIonoSRP, &PVPArrays::tdIonoSRP);
 }
 
 std::int64_t PVPBlock::getSignal(size_t channel, size_t set) const
 {
-    verifyChannelVector(channel, set);
-    if (mData[channel][set].signal.get())
-    {
-        return *mData[channel][set].signal;
-    }
-    throw except::Exception(Ctxt(
-                    "Parameter was not set"));
+    return getOptionalPVP(channel, set, hasSignal(), mPvp.signal, &PVPArrays::signal);
+}
+
+std::span<const double> PVPBlock::getTxTime(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).txTime);
+}
+
+std::span<const Vector3> PVPBlock::getTxPos(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).txPos);
+}
+
+std::span<const Vector3> PVPBlock::getTxVel(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).txVel);
+}
+
+std::span<const double> PVPBlock::getRcvTime(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).rcvTime);
+}
+
+std::span<const Vector3> PVPBlock::getRcvPos(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).rcvPos);
+}
+
+std::span<const Vector3> PVPBlock::getRcvVel(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).rcvVel);
+}
+
+std::span<const Vector3> PVPBlock::getSRPPos(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).srpPos);
+}
+
+std::span<const double> PVPBlock::getaFDOP(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).aFDOP);
+}
+
+std::span<const double> PVPBlock::getaFRR1(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).aFRR1);
+}
+
+std::span<const double> PVPBlock::getaFRR2(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).aFRR2);
+}
+
+std::span<const double> PVPBlock::getFx1(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).fx1);
+}
+
+std::span<const double> PVPBlock::getFx2(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).fx2);
+}
+
+std::span<const double> PVPBlock::getTOA1(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).toa1);
+}
+
+std::span<const double> PVPBlock::getTOA2(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).toa2);
+}
+
+std::span<const double> PVPBlock::getTdTropoSRP(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).tdTropoSRP);
+}
+
+std::span<const double> PVPBlock::getSC0(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).sc0);
+}
+
+std::span<const double> PVPBlock::getSCSS(size_t channel) const
+{
+    verifyChannel(channel);
+    return ::toSpan(getArrays(channel).scss);
+}
+
+std::span<const double> PVPBlock::getAmpSF(size_t channel) const
+{
+    verifyChannel(channel);
+    verifyOptional(hasAmpSF());
+    return ::toSpan(getArrays(channel).ampSF.values);
+}
+
+std::span<const double> PVPBlock::getFxN1(size_t channel) const
+{
+    verifyChannel(channel);
+    verifyOptional(hasFxN1());
+    return ::toSpan(getArrays(channel).fxN1.values);
+}
+
+std::span<const double> PVPBlock::getFxN2(size_t channel) const
+{
+    verifyChannel(channel);
+    verifyOptional(hasFxN2());
+    return ::toSpan(getArrays(channel).fxN2.values);
+}
+
+std::span<const double> PVPBlock::getTOAE1(size_t channel) const
+{
+    verifyChannel(channel);
+    verifyOptional(hasToaE1());
+    return ::toSpan(getArrays(channel).toaE1.values);
+}
+
+std::span<const double> PVPBlock::getTOAE2(size_t channel) const
+{
+    verifyChannel(channel);
+    verifyOptional(hasToaE2());
+    return ::toSpan(getArrays(channel).toaE2.values);
+}
+
+std::span<const double> PVPBlock::getTdIonoSRP(size_t channel) const
+{
+    verifyChannel(channel);
+    verifyOptional(hasTDIonoSRP());
+    return ::toSpan(getArrays(channel).tdIonoSRP.values);
+}
+
+std::span<const std::int64_t> PVPBlock::getSignal(size_t channel) const
+{
+    verifyChannel(channel);
+    verifyOptional(hasSignal());
+    return ::toSpan(getArrays(channel).signal.values);
 }
 
 void PVPBlock::setTxTime(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].txTime = value;
+    getArrays(channel).txTime[vector] = value;
 }
 
 void PVPBlock::setTxPos(const cphd::Vector3& value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].txPos = value;
+    getArrays(channel).txPos[vector] = value;
 }
 
 void PVPBlock::setTxVel(const cphd::Vector3& value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].txVel = value;
+    getArrays(channel).txVel[vector] = value;
 }
 
 void PVPBlock::setRcvTime(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].rcvTime = value;
+    getArrays(channel).rcvTime[vector] = value;
 }
 
 void PVPBlock::setRcvPos(const cphd::Vector3& value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].rcvPos = value;
+    getArrays(channel).rcvPos[vector] = value;
 }
 
 void PVPBlock::setRcvVel(const cphd::Vector3& value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].rcvVel = value;
+    getArrays(channel).rcvVel[vector] = value;
 }
 
 void PVPBlock::setSRPPos(const cphd::Vector3& value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].srpPos = value;
+    getArrays(channel).srpPos[vector] = value;
 }
 
 void PVPBlock::setaFDOP(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].aFDOP = value;
+    getArrays(channel).aFDOP[vector] = value;
 }
 
 void PVPBlock::setaFRR1(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].aFRR1 = value;
+    getArrays(channel).aFRR1[vector] = value;
 }
 
 void PVPBlock::setaFRR2(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].aFRR2 = value;
+    getArrays(channel).aFRR2[vector] = value;
 }
 
 void PVPBlock::setFx1(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].fx1 = value;
+    getArrays(channel).fx1[vector] = value;
 }
 
 void PVPBlock::setFx2(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].fx2 = value;
+    getArrays(channel).fx2[vector] = value;
 }
 
 void PVPBlock::setTOA1(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].toa1 = value;
+    getArrays(channel).toa1[vector] = value;
 }
 
 void PVPBlock::setTOA2(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].toa2 = value;
+    getArrays(channel).toa2[vector] = value;
 }
 
 void PVPBlock::setTdTropoSRP(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].tdTropoSRP = value;
+    getArrays(channel).tdTropoSRP[vector] = value;
 }
 
 void PVPBlock::setSC0(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].sc0 = value;
+    getArrays(channel).sc0[vector] = value;
 }
 
 void PVPBlock::setSCSS(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    mData[channel][vector].scss = value;
+    getArrays(channel).scss[vector] = value;
 }
 
 void PVPBlock::setAmpSF(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    if (hasAmpSF())
-    {
-        mData[channel][vector].ampSF.reset(new double(value));
-        return;
-    }
-    throw except::Exception(Ctxt(
-                            "Parameter was not specified in XML"));
+    ::setOptional(hasAmpSF(), getArrays(channel).ampSF, value, vector);
 }
 
 void PVPBlock::setFxN1(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    if (hasFxN1())
-    {
-        mData[channel][vector].fxN1.reset(new double(value));
-        return;
-    }
-    throw except::Exception(Ctxt(
-                            "Parameter was not specified in XML"));
+    ::setOptional(hasFxN1(), getArrays(channel).fxN1, value, vector);
 }
 
 void PVPBlock::setFxN2(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    if (hasFxN2())
-    {
-        mData[channel][vector].fxN2.reset(new double(value));
-        return;
-    }
-    throw except::Exception(Ctxt(
-                            "Parameter was not specified in XML"));
+    ::setOptional(hasFxN2(), getArrays(channel).fxN2, value, vector);
 }
 
 void PVPBlock::setTOAE1(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    if (hasToaE1())
-    {
-        mData[channel][vector].toaE1.reset(new double(value));
-        return;
-    }
-    throw except::Exception(Ctxt(
-                            "Parameter was not specified in XML"));
+    ::setOptional(hasToaE1(), getArrays(channel).toaE1, value, vector);
 }
 
 void PVPBlock::setTOAE2(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    if (hasToaE2())
-    {
-        mData[channel][vector].toaE2.reset(new double(value));
-        return;
-    }
-    throw except::Exception(Ctxt(
-                            "Parameter was not specified in XML"));
+    ::setOptional(hasToaE2(), getArrays(channel).toaE2, value, vector);
 }
 
 void PVPBlock::setTdIonoSRP(double value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    if (hasTDIonoSRP())
-    {
-        mData[channel][vector].tdIonoSRP.reset(new double(value));
-        return;
-    }
-    throw except::Exception(Ctxt(
-                            "Parameter was not specified in XML"));
+    ::setOptional(hasTDIonoSRP(), getArrays(channel).tdIonoSRP, value, vector);
 }
 
 void PVPBlock::setSignal(std::int64_t value, size_t channel, size_t vector)
 {
     verifyChannelVector(channel, vector);
-    if (hasSignal())
-    {
-        mData[channel][vector].signal.reset(new std::int64_t(value));
-        return;
-    }
-    throw except::Exception(Ctxt(
-                            "Parameter was not specified in XML"));
-}
-
-std::ostream& operator<< (std::ostream& os, const PVPBlock::PVPSet& p)
-{
-    os << "  TxTime         : " << p.txTime << "\n"
-        << "  TxPos         : " << p.txPos << "\n"
-        << "  TxVel         : " << p.txVel << "\n"
-        << "  RcvTime       : " << p.rcvTime << "\n"
-        << "  RcvPos        : " << p.rcvPos << "\n"
-        << "  RcvVel        : " << p.rcvVel << "\n"
-        << "  SRPPos        : " << p.srpPos << "\n"
-        << "  aFDOP         : " << p.aFDOP << "\n"
-        << "  aFRR1         : " << p.aFRR1 << "\n"
-        << "  aFRR2         : " << p.aFRR2 << "\n"
-        << "  Fx1           : " << p.fx1 << "\n"
-        << "  Fx2           : " << p.fx2 << "\n"
-        << "  TOA1          : " << p.toa1 << "\n"
-        << "  TOA2          : " << p.toa2 << "\n"
-        << "  TdTropoSRP    : " << p.tdTropoSRP << "\n"
-        << "  SC0           : " << p.sc0 << "\n"
-        << "  SCSS          : " << p.scss << "\n";
-
-    if (p.ampSF.get())
-    {
-        os << "  AmpSF         : " << *p.ampSF << "\n";
-    }
-    if (p.fxN1.get())
-    {
-        os << "  FxN1          : " << *p.fxN1 << "\n";
-    }
-    if (p.fxN2.get())
-    {
-        os << "  FxN2          : " << *p.fxN2 << "\n";
-    }
-    if (p.toaE1.get())
-    {
-        os << "  TOAE1         : " << *p.toaE1 << "\n";
-    }
-    if (p.toaE2.get())
-    {
-        os << "  TOAE2         : " << *p.toaE2 << "\n";
-    }
-    if (p.tdIonoSRP.get())
-    {
-        os << "  TdIonoSRP     : " << *p.tdIonoSRP << "\n";
-    }
-    if (p.signal.get())
-    {
-        os << "  SIGNAL     : " << *p.signal << "\n";
-    }
-
-    for (auto it = p.addedPVP.begin(); it != p.addedPVP.end(); ++it)
-    {
-        os << "  Additional Parameter : " << it->second.str() << "\n";
-    }
-    return os;
+    ::setOptional(hasSignal(), getArrays(channel).signal, value, vector);
 }
 
-
 std::ostream& operator<< (std::ostream& os, const PVPBlock& p)
 {
     os << "PVPBlock:: \n";
@@ -1092,22 +1574,72 @@ std::ostream& operator<< (std::ostream& os, const PVPBlock& p)
 
         for (size_t ii = 0; ii < p.mData.size(); ++ii)
         {
-            if (p.mData[ii].empty())
+            const PVPBlock::PVPArrays& arrays = p.getArrays(ii);
+            if (arrays.size() == 0)
             {
                 os << "[" << ii << "] mData: (empty)\n";
+                continue;
             }
-            else
+
+            for (size_t jj = 0; jj < arrays.size(); ++jj)
             {
-                for (size_t jj = 0; jj < p.mData[ii].size(); ++jj)
+                os << "[" << ii << "] [" << jj << "] mData: "
+                   << "  TxTime         : " << arrays.txTime[jj] << "\n"
+                   << "  TxPos         : " << arrays.txPos[jj] << "\n"
+                   << "  TxVel         : " << arrays.txVel[jj] << "\n"
+                   << "  RcvTime       : " << arrays.rcvTime[jj] << "\n"
+                   << "  RcvPos        : " << arrays.rcvPos[jj] << "\n"
+                   << "  RcvVel        : " << arrays.rcvVel[jj] << "\n"
+                   << "  SRPPos        : " << arrays.srpPos[jj] << "\n"
+                   << "  aFDOP         : " << arrays.aFDOP[jj] << "\n"
+                   << "  aFRR1         : " << arrays.aFRR1[jj] << "\n"
+                   << "  aFRR2         : " << arrays.aFRR2[jj] << "\n"
+                   << "  Fx1           : " << arrays.fx1[jj] << "\n"
+                   << "  Fx2           : " << arrays.fx2[jj] << "\n"
+                   << "  TOA1          : " << arrays.toa1[jj] << "\n"
+                   << "  TOA2          : " << arrays.toa2[jj] << "\n"
+                   << "  TdTropoSRP    : " << arrays.tdTropoSRP[jj] << "\n"
+                   << "  SC0           : " << arrays.sc0[jj] << "\n"
+                   << "  SCSS          : " << arrays.scss[jj] << "\n";
+
+                if (!arrays.ampSF.isSet.empty() && arrays.ampSF.isSet[jj])
                 {
-                    if (p.mData[ii].empty())
+                    os << "  AmpSF         : " << arrays.ampSF.values[jj] << "\n";
+                }
+                if (!arrays.fxN1.isSet.empty() && arrays.fxN1.isSet[jj])
+                {
+                    os << "  FxN1          : " << arrays.fxN1.values[jj] << "\n";
+                }
+                if (!arrays.fxN2.isSet.empty() && arrays.fxN2.isSet[jj])
+                {
+                    os << "  FxN2          : " << arrays.fxN2.values[jj] << "\n";
+                }
+                if (!arrays.toaE1.isSet.empty() && arrays.toaE1.isSet[jj])
+                {
+                    os << "  TOAE1         : " << arrays.toaE1.values[jj] << "\n";
+                }
+                if (!arrays.toaE2.isSet.empty() && arrays.toaE2.isSet[jj])
+                {
+                    os << "  TOAE2         : " << arrays.toaE2.values[jj] << "\n";
+                }
+                if (!arrays.tdIonoSRP.isSet.empty() && arrays.tdIonoSRP.isSet[jj])
+                {
+                    os << "  TdIonoSRP     : " << arrays.tdIonoSRP.values[jj] << "\n";
+                }
+                if (!arrays.signal.isSet.empty() && arrays.signal.isSet[jj])
+                {
+                    os << "  SIGNAL     : " << arrays.signal.values[jj] << "\n";
+                }
+
+                for (const auto& addedPVP : arrays.addedPVP)
+                {
+                    if (addedPVP.isSet[jj])
                     {
-                        os << "[" << ii << "] [" << jj << "] mData: (empty)\n";
-                    }
-                    else {
-                        os << "[" << ii << "] [" << jj << "] mData: " << p.mData[ii][jj] << "\n";
+                        os << "  Additional Parameter : "
+                           << addedPVP.getParameter(jj).str() << "\n";
                     }
                 }
+                os << "\n";
             }
         }
     }
@@ -20,19 +20,35 @@
  *
  */
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include <string.h>
+
+#include <algorithm>
 #include <limits>
+#include <mutex>
 #include <sstream>
 #include <thread>
 #include <string>
+#include <vector>
 #include <std/memory>
 
 #include <nitf/coda-oss.hpp>
 #include <except/Exception.h>
+#include <sys/SystemException.h>
 #include <io/FileInputStream.h>
-#include <mt/ThreadGroup.h>
-#include <mt/ThreadPlanner.h>
 
 #include <six/Init.h>
+#include <six/ComplexConversion.h>
+#include <six/Executor.h>
 #include <cphd/ByteSwap.h>
 #include <cphd/Wideband.h>
 #include <cphd/FileHeader.h>
@@ -59,14 +75,11 @@ public:
 
     virtual void run()
     {
-        for (size_t row = 0, idx = 0; row < mDims.row; ++row)
-        {
-            for (size_t col = 0; col < mDims.col; ++col, ++idx)
-            {
-                const std::complex<InT>& input(mInput[idx]);
-                mOutput[idx] = std::complex<float>(input.real(), input.imag());
-            }
-        }
+        six::promoteToComplexFloat(mInput,
+                                   sizeof(std::complex<InT>),
+                                   mDims.area(),
+                                   false,
+                                   mOutput);
     }
 
 private:
@@ -94,15 +107,14 @@ public:
 
     virtual void run()
     {
-        for (size_t row = 0, idx = 0; row < mDims.row; ++row)
+        for (size_t row = 0; row < mDims.row; ++row)
         {
-            const double scaleFactor(mScaleFactors[row]);
-            for (size_t col = 0; col < mDims.col; ++col, ++idx)
-            {
-                const std::complex<InT>& input(mInput[idx]);
-                mOutput[idx] = std::complex<float>(static_cast<float>(input.real() * scaleFactor),
-                                                   static_cast<float>(input.imag() * scaleFactor));
-            }
+            six::scaleToComplexFloat(mInput + row * mDims.col,
+                                     sizeof(std::complex<InT>),
+                                     mDims.col,
+                                     false,
+                                     mScaleFactors[row],
+                                     mOutput + row * mDims.col);
         }
     }
 
@@ -130,24 +142,16 @@ void promote(const void* input,
     }
     else
     {
-        mt::ThreadGroup threads;
-        const mt::ThreadPlanner planner(dims.row, numThreads);
-
-        size_t threadNum(0);
-        size_t startRow(0);
-        size_t numRowsThisThread(0);
-        while (planner.getThreadInfo(threadNum++, startRow, numRowsThisThread))
-        {
-           auto scaler = std::make_unique<PromoteRunnable<InT>>(
-                    static_cast<const std::complex<InT>*>(input),
-                    startRow,
-                    numRowsThisThread,
-                    dims.col,
-                    output);
-            threads.createThread(std::move(scaler));
-        }
-
-        threads.joinAll();
+        six::Executor::get(numThreads)->parallelFor(dims.row,
+                [&](size_t startRow, size_t endRow)
+                {
+                    PromoteRunnable<InT>(
+                            static_cast<const std::complex<InT>*>(input),
+                            startRow,
+                            endRow - startRow,
+                            dims.col,
+                            output).run();
+                });
     }
 }
 
@@ -192,25 +196,17 @@ void scale(const void* input,
     }
     else
     {
-        mt::ThreadGroup threads;
-        const mt::ThreadPlanner planner(dims.row, numThreads);
-
-        size_t threadNum(0);
-        size_t startRow(0);
-        size_t numRowsThisThread(0);
-        while (planner.getThreadInfo(threadNum++, startRow, numRowsThisThread))
-        {
-           auto scaler = std::make_unique<ScaleRunnable<InT>>(
-                    static_cast<const std::complex<InT>*>(input),
-                    startRow,
-                    numRowsThisThread,
-                    dims.col,
-                    scaleFactors,
-                    output);
-            threads.createThread(std::move(scaler));
-        }
-
-        threads.joinAll();
+        six::Executor::get(numThreads)->parallelFor(dims.row,
+                [&](size_t startRow, size_t endRow)
+                {
+                    ScaleRunnable<InT>(
+                            static_cast<const std::complex<InT>*>(input),
+                            startRow,
+                            endRow - startRow,
+                            dims.col,
+                            scaleFactors,
+                            output).run();
+                });
     }
 }
 
@@ -239,15 +235,257 @@ void scale(const void* input,
 }
 }
 
+namespace
+{
+// A strided read reads the gaps between runs too, rather than making a call
+// per run, as long as the gaps are no bigger than this.  From the page cache,
+// copying a gap much bigger than this costs more than the call it saves.
+const size_t MAX_COALESCED_GAP = 2 * 1024;
+
+// How much a coalesced read reads at once when it has to go through a
+// buffer and be compacted
+const size_t COALESCED_BUFFER_SIZE = 4 * 1024 * 1024;
+
+#if !defined(_WIN32)
+#if defined(IOV_MAX)
+const size_t MAX_IOVECS = IOV_MAX;
+#else
+const size_t MAX_IOVECS = 1024;
+#endif
+#endif
+}
+
 namespace cphd
 {
 const size_t Wideband::ALL = std::numeric_limits<size_t>::max();
 
+/*
+ *  Reads from an offset rather than from a shared cursor, so any number of
+ *  threads can read at once.  Files get the OS's positional read; a stream
+ *  only has the one cursor, so reads from it take turns.
+ */
+struct Wideband::Reader final
+{
+    explicit Reader(const std::string& pathname) :
+        mPathname(pathname)
+    {
+#if defined(_WIN32)
+        mFile = ::CreateFileA(pathname.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+        if (mFile == INVALID_HANDLE_VALUE)
+        {
+            throw sys::SystemException(Ctxt("Unable to open " + pathname));
+        }
+#else
+        mFile = ::open(pathname.c_str(), O_RDONLY);
+        if (mFile < 0)
+        {
+            throw sys::SystemException(Ctxt("Unable to open " + pathname));
+        }
+#endif
+    }
+
+    explicit Reader(std::shared_ptr<io::SeekableInputStream> inStream) :
+        mInStream(inStream)
+    {
+    }
+
+    ~Reader()
+    {
+        if (mInStream)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        ::CloseHandle(mFile);
+#else
+        ::close(mFile);
+#endif
+    }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    void readAt(int64_t offset, void* data, size_t size) const
+    {
+        if (mInStream)
+        {
+            std::lock_guard<std::mutex> lock(mStreamMutex);
+            mInStream->seek(offset, io::FileInputStream::START);
+            mInStream->read(static_cast<std::byte*>(data), size);
+            return;
+        }
+
+        auto dataPtr = static_cast<std::byte*>(data);
+        while (size > 0)
+        {
+#if defined(_WIN32)
+            const DWORD toRead = static_cast<DWORD>(std::min<size_t>(
+                    size, std::numeric_limits<DWORD>::max()));
+            OVERLAPPED overlapped = {};
+            overlapped.Offset = static_cast<DWORD>(offset);
+            overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+            DWORD numRead = 0;
+            if (!::ReadFile(mFile, dataPtr, toRead, &numRead, &overlapped) &&
+                ::GetLastError() != ERROR_HANDLE_EOF)
+            {
+                throw sys::SystemException(Ctxt("Unable to read " + mPathname));
+            }
+#else
+            const ssize_t numRead = ::pread(mFile, dataPtr, size, offset);
+            if (numRead < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw sys::SystemException(Ctxt("Unable to read " + mPathname));
+            }
+#endif
+            if (numRead == 0)
+            {
+                throw except::Exception(Ctxt(
+                        "Unexpected end of file reading " + mPathname));
+            }
+            dataPtr += numRead;
+            offset += numRead;
+            size -= numRead;
+        }
+    }
+
+    /*
+     *  Reads count runs of size bytes, each stride bytes after the last,
+     *  back to back into data.  Small gaps between the runs are read and
+     *  thrown away so it takes a few big reads rather than one per run.
+     */
+    void readStrided(int64_t offset, size_t stride, size_t size, size_t count,
+                     void* data) const
+    {
+        auto dataPtr = static_cast<std::byte*>(data);
+        const size_t gap = stride - size;
+        if (count < 2 || gap > MAX_COALESCED_GAP)
+        {
+            for (size_t ii = 0; ii < count; ++ii)
+            {
+                readAt(offset, dataPtr, size);
+                dataPtr += size;
+                offset += stride;
+            }
+            return;
+        }
+
+#if !defined(_WIN32)
+        if (!mInStream && size >= gap)
+        {
+            // Scatter the runs straight to where they go and the gaps into
+            // a scratch buffer.  This saves copying the runs afterwards, but
+            // each piece has its own overhead, so it only pays when the runs
+            // are big.
+            std::vector<std::byte> gapBuffer(gap);
+            const size_t maxRunsPerRead = std::max<size_t>(MAX_IOVECS / 2, 1);
+            std::vector<iovec> iovecs;
+            for (size_t ii = 0; ii < count; ii += maxRunsPerRead)
+            {
+                const size_t numRuns = std::min(maxRunsPerRead, count - ii);
+                iovecs.clear();
+                for (size_t jj = 0; jj < numRuns; ++jj)
+                {
+                    if (jj > 0 && gap > 0)
+                    {
+                        iovecs.push_back({gapBuffer.data(), gap});
+                    }
+                    iovecs.push_back({dataPtr, size});
+                    dataPtr += size;
+                }
+                readvAt(offset, iovecs);
+                offset += numRuns * stride;
+            }
+            return;
+        }
+#endif
+
+        // Read as many runs as fit in the buffer at once, then compact them.
+        // A run that doesn't fit on its own is read by itself.
+        const size_t runsPerRead = (size >= COALESCED_BUFFER_SIZE) ? 1 :
+                (COALESCED_BUFFER_SIZE - size) / stride + 1;
+        std::vector<std::byte> buffer(
+                std::min(runsPerRead, count) * stride - gap);
+        for (size_t ii = 0; ii < count; ii += runsPerRead)
+        {
+            const size_t numRuns = std::min(runsPerRead, count - ii);
+            readAt(offset, buffer.data(), (numRuns - 1) * stride + size);
+            for (size_t jj = 0; jj < numRuns; ++jj)
+            {
+                ::memcpy(dataPtr, buffer.data() + jj * stride, size);
+                dataPtr += size;
+            }
+            offset += numRuns * stride;
+        }
+    }
+
+private:
+#if !defined(_WIN32)
+    // preadv(), retried until the iovecs are full
+    void readvAt(int64_t offset, std::vector<iovec>& iovecs) const
+    {
+        size_t first = 0;
+        while (first < iovecs.size())
+        {
+            const size_t numIovecs = iovecs.size() - first;
+            const ssize_t numRead = ::preadv(mFile, &iovecs[first],
+                                             static_cast<int>(numIovecs),
+                                             offset);
+            if (numRead < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw sys::SystemException(Ctxt("Unable to read " + mPathname));
+            }
+            if (numRead == 0)
+            {
+                throw except::Exception(Ctxt(
+                        "Unexpected end of file reading " + mPathname));
+            }
+            offset += numRead;
+
+            // Skip what's been filled, picking up partway through an iovec
+            // if need be
+            size_t remaining = static_cast<size_t>(numRead);
+            while (first < iovecs.size() && remaining >= iovecs[first].iov_len)
+            {
+                remaining -= iovecs[first].iov_len;
+                ++first;
+            }
+            if (remaining > 0)
+            {
+                iovecs[first].iov_base =
+                        static_cast<std::byte*>(iovecs[first].iov_base) +
+                        remaining;
+                iovecs[first].iov_len -= remaining;
+            }
+        }
+    }
+#endif
+
+    const std::shared_ptr<io::SeekableInputStream> mInStream;
+    mutable std::mutex mStreamMutex;
+
+    const std::string mPathname;
+#if defined(_WIN32)
+    HANDLE mFile = INVALID_HANDLE_VALUE;
+#else
+    int mFile = -1;
+#endif
+};
+
 Wideband::Wideband(const std::string& pathname,
                    const cphd::MetadataBase& metadata,
                    int64_t startWB,
                    int64_t sizeWB) :
-    mInStream(std::make_shared<io::FileInputStream>(pathname)),
+    mReader(new Reader(pathname)),
     mMetadata(metadata),
     mWBOffset(startWB),
     mWBSize(sizeWB),
@@ -261,7 +499,7 @@ Wideband::Wideband(std::shared_ptr<io::SeekableInputStream> inStream,
                    const cphd::MetadataBase& metadata,
                    int64_t startWB,
                    int64_t sizeWB) :
-    mInStream(inStream),
+    mReader(new Reader(inStream)),
     mMetadata(metadata),
     mWBOffset(startWB),
     mWBSize(sizeWB),
@@ -271,6 +509,8 @@ Wideband::Wideband(std::shared_ptr<io::SeekableInputStream> inStream,
     initialize();
 }
 
+Wideband::~Wideband() = default;
+
 void Wideband::initialize()
 {
     mOffsets[0] = mWBOffset;
@@ -417,25 +657,17 @@ void Wideband::readImpl(size_t channel,
     auto dataPtr = static_cast<std::byte*>(data);
     if (dims.col == mMetadata.getNumSamples(channel))
     {
-        // Life is easy - can do a single seek and read
-        mInStream->seek(inOffset, io::FileInputStream::START);
-        mInStream->read(dataPtr, dims.row * dims.col * mElementSize);
+        // Life is easy - can do a single read
+        mReader->readAt(inOffset, dataPtr, dims.row * dims.col * mElementSize);
     }
     else
     {
-        // We're stuck reading a row at a time since we're only reading some
-        // of the columns
+        // Only some of the samples of each vector
         const size_t bytesPerVectorAOI = dims.col * mElementSize;
         const size_t bytesPerVectorFile =
                 mMetadata.getNumSamples(channel) * mElementSize;
-
-        for (size_t row = 0; row < dims.row; ++row)
-        {
-            mInStream->seek(inOffset, io::FileInputStream::START);
-            mInStream->read(dataPtr, bytesPerVectorAOI);
-            dataPtr += bytesPerVectorAOI;
-            inOffset += bytesPerVectorFile;
-        }
+        mReader->readStrided(inOffset, bytesPerVectorFile, bytesPerVectorAOI,
+                             dims.row, dataPtr);
     }
 }
 
@@ -446,8 +678,7 @@ void Wideband::readImpl(size_t channel, void* data) const
     int64_t inOffset = getFileOffset(channel);
 
     auto dataPtr = static_cast<std::byte*>(data);
-    mInStream->seek(inOffset, io::FileInputStream::START);
-    mInStream->read(dataPtr, getBytesRequiredForRead(channel));
+    mReader->readAt(inOffset, dataPtr, getBytesRequiredForRead(channel));
 }
 
 void Wideband::read(size_t channel,
@@ -0,0 +1,198 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <std/span>
+
+#include <cli/ArgumentParser.h>
+#include <io/FileOutputStream.h>
+#include <io/TempFile.h>
+#include <types/RowCol.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include <cphd/Wideband.h>
+
+/*!
+ * Times writing a large CPHD, a block of vectors at a time, through
+ * CPHDWriter.  The file can be many GB, so the wideband data is generated a
+ * block at a time rather than held in memory.  Optionally reads the file
+ * back to check a few blocks of it.
+ */
+namespace
+{
+typedef std::complex<float> Sample;
+
+void fillBlock(size_t firstRow, std::vector<Sample>& block)
+{
+    for (size_t ii = 0; ii < block.size(); ++ii)
+    {
+        const auto value = static_cast<float>((firstRow + ii) % 65521);
+        block[ii] = Sample(value, -value);
+    }
+}
+
+double elapsedSince(std::chrono::steady_clock::time_point start)
+{
+    const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+bool checkBlocks(const std::string& pathname,
+                 const types::RowCol<size_t>& dims,
+                 size_t blockRows)
+{
+    const cphd::CPHDReader reader(pathname, 1);
+    const cphd::Wideband& wideband = reader.getWideband();
+    std::vector<Sample> expected(blockRows * dims.col);
+    std::vector<Sample> actual(expected.size());
+
+    // First, middle and last blocks
+    const size_t numBlocks = (dims.row + blockRows - 1) / blockRows;
+    for (size_t block : {size_t(0), numBlocks / 2, numBlocks - 1})
+    {
+        const size_t firstRow = block * blockRows;
+        const size_t numRows = std::min(blockRows, dims.row - firstRow);
+        expected.resize(numRows * dims.col);
+        actual.resize(expected.size());
+        fillBlock(firstRow * dims.col, expected);
+        wideband.read(0, firstRow, firstRow + numRows - 1, 0,
+                      cphd::Wideband::ALL, 1,
+                      std::span<std::byte>(
+                              reinterpret_cast<std::byte*>(actual.data()),
+                              actual.size() * sizeof(Sample)));
+        if (actual != expected)
+        {
+            std::cerr << "Data mismatch in block " << block << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Parse the command line
+        cli::ArgumentParser parser;
+        parser.setDescription("Time writing a large CPHD.");
+        parser.addArgument("-r --rows", "Number of vectors to generate",
+                           cli::STORE, "rows", "NUM")->setDefault(32768);
+        parser.addArgument("-c --cols", "Number of samples per vector",
+                           cli::STORE, "cols", "NUM")->setDefault(16384);
+        parser.addArgument("-b --block",
+                           "Number of vectors to write per call",
+                           cli::STORE, "block", "NUM")->setDefault(1024);
+        parser.addArgument("-t --threads", "Number of threads to use",
+                           cli::STORE, "threads", "NUM")->setDefault(0);
+        parser.addArgument("-s --scratch", "Scratch space, in MB",
+                           cli::STORE, "scratch", "NUM")->setDefault(4);
+        parser.addArgument("--check", "Read the file back to check it",
+                           cli::STORE_TRUE, "check");
+        parser.addArgument("-o --output",
+                           "Where to generate the CPHD (default is a temporary "
+                           "file)",
+                           cli::STORE, "output", "CPHD");
+        const std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+        const types::RowCol<size_t> dims(options->get<size_t>("rows"),
+                                         options->get<size_t>("cols"));
+        const size_t blockRows =
+                std::max<size_t>(options->get<size_t>("block"), 1);
+        const size_t numThreads = options->get<size_t>("threads");
+        const size_t scratchSize =
+                options->get<size_t>("scratch") * 1024 * 1024;
+
+        io::TempFile tempFile;
+        const std::string pathname = options->hasValue("output") ?
+                options->get<std::string>("output") : tempFile.pathname();
+
+        std::vector<Sample> block(blockRows * dims.col);
+        cphd::Metadata metadata;
+        cphd::setUpData(metadata, dims, block);
+        cphd::setPVPXML(metadata.pvp);
+        cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+        for (size_t ii = 0; ii < dims.row; ++ii)
+        {
+            cphd::setVectorParameters(0, ii, pvpBlock);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        double generating = 0.0;
+        {
+            cphd::CPHDWriter writer(metadata,
+                                    std::make_shared<io::FileOutputStream>(
+                                            pathname),
+                                    std::vector<std::string>(),
+                                    numThreads,
+                                    scratchSize);
+            writer.writeMetadata(pvpBlock);
+            writer.writePVPData(pvpBlock);
+            for (size_t row = 0; row < dims.row; row += blockRows)
+            {
+                const size_t numRows = std::min(blockRows, dims.row - row);
+                const auto generate = std::chrono::steady_clock::now();
+                fillBlock(row * dims.col, block);
+                generating += elapsedSince(generate);
+                writer.writeCPHDData(block.data(), numRows * dims.col);
+            }
+            writer.close();
+        }
+        const double writing = elapsedSince(start) - generating;
+
+        const double gb = static_cast<double>(dims.area() * sizeof(Sample)) /
+                (1024.0 * 1024.0 * 1024.0);
+        std::cout << "Wrote " << dims.row << " x " << dims.col << " CPHD ("
+                  << gb << " GB of samples): " << pathname << "\n"
+                  << "Write (s): " << writing << "\n"
+                  << "Throughput (GB/s): " << gb / writing << "\n";
+
+        if (options->get<bool>("check"))
+        {
+            return checkBlocks(pathname, dims, blockRows) ? 0 : 1;
+        }
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+    }
+    return 1;
+}
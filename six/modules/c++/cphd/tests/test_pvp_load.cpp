@@ -0,0 +1,159 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cli/ArgumentParser.h>
+#include <io/TempFile.h>
+#include <types/RowCol.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+
+/*!
+ * Times opening a CPHD with many vectors, which loads its PVP block, and
+ * then getting at its PVPs: one value, which is read straight out of the
+ * PVP data as loaded, and then a whole parameter, which unpacks the data.
+ * The file is generated first; the PVPs read are checked against it.
+ */
+namespace
+{
+typedef std::complex<int16_t> Sample;
+
+cphd::PVPBlock writeCPHD(const std::string& pathname,
+                         const types::RowCol<size_t>& dims)
+{
+    const std::vector<Sample> writeData(dims.area());
+
+    cphd::Metadata metadata;
+    cphd::setUpData(metadata, dims, writeData);
+    cphd::setPVPXML(metadata.pvp);
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    for (size_t ii = 0; ii < dims.row; ++ii)
+    {
+        cphd::setVectorParameters(0, ii, pvpBlock);
+    }
+
+    cphd::CPHDWriter writer(metadata, pathname);
+    writer.writeMetadata(pvpBlock);
+    writer.writePVPData(pvpBlock);
+    writer.writeCPHDData(writeData.data(), dims.area());
+    return pvpBlock;
+}
+
+double elapsedSince(std::chrono::steady_clock::time_point start)
+{
+    const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Parse the command line
+        cli::ArgumentParser parser;
+        parser.setDescription("Time opening a CPHD and reading its PVPs.");
+        parser.addArgument("-r --rows", "Number of vectors to generate",
+                           cli::STORE, "rows", "NUM")->setDefault(1000000);
+        parser.addArgument("-t --threads", "Number of threads to use",
+                           cli::STORE, "threads", "NUM")->setDefault(1);
+        parser.addArgument("-p --passes", "Number of times to open the CPHD",
+                           cli::STORE, "passes", "NUM")->setDefault(3);
+        parser.addArgument("-o --output",
+                           "Where to generate the CPHD (default is a temporary "
+                           "file)",
+                           cli::STORE, "output", "CPHD");
+        const std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+        const types::RowCol<size_t> dims(options->get<size_t>("rows"), 4);
+        const size_t numThreads = options->get<size_t>("threads");
+        const size_t numPasses =
+                std::max<size_t>(options->get<size_t>("passes"), 1);
+
+        io::TempFile tempFile;
+        const std::string pathname = options->hasValue("output") ?
+                options->get<std::string>("output") : tempFile.pathname();
+
+        const cphd::PVPBlock written = writeCPHD(pathname, dims);
+        std::cout << "Generated CPHD with " << dims.row << " vectors, "
+                  << written.getPVPsize(0) << " bytes of PVPs: " << pathname
+                  << "\n";
+
+        double open = 0.0;
+        double single = 0.0;
+        double unpack = 0.0;
+        for (size_t pass = 0; pass < numPasses; ++pass)
+        {
+            auto start = std::chrono::steady_clock::now();
+            const cphd::CPHDReader reader(pathname, numThreads);
+            open += elapsedSince(start);
+
+            const cphd::PVPBlock& pvpBlock = reader.getPVPBlock();
+            const size_t last = dims.row - 1;
+            start = std::chrono::steady_clock::now();
+            const double txTime = pvpBlock.getTxTime(0, last);
+            single += elapsedSince(start);
+            if (txTime != written.getTxTime(0, last))
+            {
+                std::cerr << "TxTime mismatch in vector " << last << std::endl;
+                return 1;
+            }
+
+            start = std::chrono::steady_clock::now();
+            const auto txTimes = pvpBlock.getTxTime(0);
+            unpack += elapsedSince(start);
+            if (!(pvpBlock == written))
+            {
+                std::cerr << "PVP mismatch after unpacking" << std::endl;
+                return 1;
+            }
+            (void)txTimes;
+        }
+
+        std::cout << "Open (s): " << open / numPasses << "\n"
+                  << "One PVP (s): " << single / numPasses << "\n"
+                  << "Unpack (s): " << unpack / numPasses << "\n";
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+    }
+    return 1;
+}
@@ -0,0 +1,275 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <std/span>
+
+#include <cli/ArgumentParser.h>
+#include <io/FileInputStream.h>
+#include <io/TempFile.h>
+#include <types/RowCol.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include <cphd/Wideband.h>
+
+/*!
+ * Times reading a CPHD's wideband in blocks of vectors from many threads
+ * sharing one CPHDReader, against reading the same blocks from one thread.
+ * The file is generated first; the blocks read are checked against it.
+ */
+namespace
+{
+typedef std::complex<int16_t> Sample;
+
+void writeCPHD(const std::string& pathname,
+               const types::RowCol<size_t>& dims,
+               std::vector<Sample>& writeData)
+{
+    writeData.resize(dims.area());
+    for (size_t ii = 0; ii < writeData.size(); ++ii)
+    {
+        writeData[ii] = Sample(static_cast<int16_t>(ii % 32749),
+                               static_cast<int16_t>(ii % 7919));
+    }
+
+    cphd::Metadata metadata;
+    cphd::setUpData(metadata, dims, writeData);
+    cphd::setPVPXML(metadata.pvp);
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    for (size_t ii = 0; ii < dims.row; ++ii)
+    {
+        cphd::setVectorParameters(0, ii, pvpBlock);
+    }
+
+    cphd::CPHDWriter writer(metadata, pathname);
+    writer.writeMetadata(pvpBlock);
+    writer.writePVPData(pvpBlock);
+    writer.writeCPHDData(writeData.data(), dims.area());
+}
+
+/*
+ * Reads each block of vectors [firstVector, firstVector + blockSize) of
+ * samples [firstSample, lastSample] into its place in readData, numThreads
+ * blocks at a time
+ */
+double readBlocks(const cphd::Wideband& wideband,
+                  const types::RowCol<size_t>& dims,
+                  size_t blockSize,
+                  size_t firstSample,
+                  size_t lastSample,
+                  size_t numThreads,
+                  std::vector<Sample>& readData)
+{
+    const size_t numBlocks = (dims.row + blockSize - 1) / blockSize;
+    const size_t numSamples = lastSample - firstSample + 1;
+    readData.assign(dims.row * numSamples, Sample());
+
+    std::atomic<size_t> nextBlock(0);
+    auto readSome = [&]()
+    {
+        for (size_t block = nextBlock++; block < numBlocks; block = nextBlock++)
+        {
+            const size_t firstVector = block * blockSize;
+            const size_t lastVector =
+                    std::min(firstVector + blockSize, dims.row) - 1;
+            Sample* const out = readData.data() + firstVector * numSamples;
+            const size_t size =
+                    (lastVector - firstVector + 1) * numSamples * sizeof(Sample);
+
+            wideband.read(0, firstVector, lastVector, firstSample, lastSample,
+                          1, std::span<std::byte>(
+                                  reinterpret_cast<std::byte*>(out), size));
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t ii = 1; ii < numThreads; ++ii)
+    {
+        threads.emplace_back(readSome);
+    }
+    readSome();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+bool checkBlocks(const std::vector<Sample>& writeData,
+                 const types::RowCol<size_t>& dims,
+                 size_t firstSample,
+                 size_t lastSample,
+                 const std::vector<Sample>& readData)
+{
+    const size_t numSamples = lastSample - firstSample + 1;
+    for (size_t row = 0; row < dims.row; ++row)
+    {
+        if (::memcmp(&writeData[row * dims.col + firstSample],
+                     &readData[row * numSamples],
+                     numSamples * sizeof(Sample)) != 0)
+        {
+            std::cerr << "Data mismatch in vector " << row << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool runCase(const std::string& name,
+             const cphd::Wideband& wideband,
+             const std::vector<Sample>& writeData,
+             const types::RowCol<size_t>& dims,
+             size_t blockSize,
+             size_t firstSample,
+             size_t lastSample,
+             size_t numThreads,
+             size_t numPasses)
+{
+    std::vector<Sample> readData;
+    double serial = 0.0;
+    double concurrent = 0.0;
+    for (size_t pass = 0; pass < numPasses; ++pass)
+    {
+        serial += readBlocks(wideband, dims, blockSize, firstSample, lastSample,
+                             1, readData);
+        if (!checkBlocks(writeData, dims, firstSample, lastSample, readData))
+        {
+            return false;
+        }
+
+        concurrent += readBlocks(wideband, dims, blockSize, firstSample,
+                                 lastSample, numThreads, readData);
+        if (!checkBlocks(writeData, dims, firstSample, lastSample, readData))
+        {
+            return false;
+        }
+    }
+
+    const double megabytes = static_cast<double>(dims.row) *
+            (lastSample - firstSample + 1) * sizeof(Sample) * numPasses /
+            (1024.0 * 1024.0);
+    std::cout << name << "\n"
+              << "    1 thread:   " << megabytes / serial << " MB/s\n"
+              << "    " << numThreads << " threads:  "
+              << megabytes / concurrent << " MB/s ("
+              << serial / concurrent << "x)\n";
+    return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Parse the command line
+        cli::ArgumentParser parser;
+        parser.setDescription(
+                "Time concurrent reads of CPHD wideband data from one reader.");
+        parser.addArgument("-t --threads",
+                           "Number of threads reading at once",
+                           cli::STORE,
+                           "threads",
+                           "NUM")->setDefault(std::thread::hardware_concurrency());
+        parser.addArgument("-r --rows", "Number of vectors to generate",
+                           cli::STORE, "rows", "NUM")->setDefault(8192);
+        parser.addArgument("-c --cols", "Number of samples per vector",
+                           cli::STORE, "cols", "NUM")->setDefault(8192);
+        parser.addArgument("-b --block", "Number of vectors per read",
+                           cli::STORE, "block", "NUM")->setDefault(64);
+        parser.addArgument("-p --passes", "Number of times to read the file",
+                           cli::STORE, "passes", "NUM")->setDefault(3);
+        parser.addArgument("-o --output",
+                           "Where to generate the CPHD (default is a temporary "
+                           "file)",
+                           cli::STORE, "output", "CPHD");
+        const std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+        const size_t numThreads =
+                std::max<size_t>(options->get<size_t>("threads"), 1);
+        const types::RowCol<size_t> dims(options->get<size_t>("rows"),
+                                         options->get<size_t>("cols"));
+        const size_t blockSize =
+                std::max<size_t>(options->get<size_t>("block"), 1);
+        const size_t numPasses =
+                std::max<size_t>(options->get<size_t>("passes"), 1);
+
+        io::TempFile tempFile;
+        const std::string pathname = options->hasValue("output") ?
+                options->get<std::string>("output") : tempFile.pathname();
+
+        std::vector<Sample> writeData;
+        writeCPHD(pathname, dims, writeData);
+        std::cout << "Generated " << dims.row << " x " << dims.col
+                  << " CPHD: " << pathname << "\n";
+
+        // A file: positional reads, no shared cursor
+        const cphd::CPHDReader fileReader(pathname, numThreads);
+        // A stream: one cursor, so reads take turns
+        const cphd::CPHDReader streamReader(
+                std::make_shared<io::FileInputStream>(pathname), numThreads);
+
+        const size_t lastSample = dims.col - 1;
+        const size_t firstWindowSample = dims.col / 4;
+        const size_t lastWindowSample = dims.col - dims.col / 4 - 1;
+        const bool ok =
+                runCase("Full vectors, file", fileReader.getWideband(),
+                        writeData, dims, blockSize, 0, lastSample,
+                        numThreads, numPasses) &&
+                runCase("Full vectors, stream", streamReader.getWideband(),
+                        writeData, dims, blockSize, 0, lastSample,
+                        numThreads, numPasses) &&
+                runCase("Half the samples, file", fileReader.getWideband(),
+                        writeData, dims, blockSize, firstWindowSample,
+                        lastWindowSample, numThreads, numPasses) &&
+                runCase("Half the samples, stream", streamReader.getWideband(),
+                        writeData, dims, blockSize, firstWindowSample,
+                        lastWindowSample, numThreads, numPasses);
+        return ok ? 0 : 1;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+    }
+    return 1;
+}
@@ -0,0 +1,224 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <std/span>
+
+#include <cli/ArgumentParser.h>
+#include <io/FileInputStream.h>
+#include <io/TempFile.h>
+#include <types/RowCol.h>
+#include <cphd/CPHDReader.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include <cphd/Wideband.h>
+
+/*!
+ * Times reading a window of samples from every vector of a CPHD, sweeping
+ * the window from one sample up to the full vector.  Each window is read in
+ * one call, which coalesces the per-vector reads, and one vector per call,
+ * which can't.  The file is generated first; the windows read are checked
+ * against it.
+ */
+namespace
+{
+typedef std::complex<int16_t> Sample;
+
+void writeCPHD(const std::string& pathname,
+               const types::RowCol<size_t>& dims,
+               std::vector<Sample>& writeData)
+{
+    writeData.resize(dims.area());
+    for (size_t ii = 0; ii < writeData.size(); ++ii)
+    {
+        writeData[ii] = Sample(static_cast<int16_t>(ii % 32749),
+                               static_cast<int16_t>(ii % 7919));
+    }
+
+    cphd::Metadata metadata;
+    cphd::setUpData(metadata, dims, writeData);
+    cphd::setPVPXML(metadata.pvp);
+    cphd::PVPBlock pvpBlock(metadata.pvp, metadata.data);
+    for (size_t ii = 0; ii < dims.row; ++ii)
+    {
+        cphd::setVectorParameters(0, ii, pvpBlock);
+    }
+
+    cphd::CPHDWriter writer(metadata, pathname);
+    writer.writeMetadata(pvpBlock);
+    writer.writePVPData(pvpBlock);
+    writer.writeCPHDData(writeData.data(), dims.area());
+}
+
+double elapsedSince(std::chrono::steady_clock::time_point start)
+{
+    const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+bool checkWindow(const std::vector<Sample>& writeData,
+                 const types::RowCol<size_t>& dims,
+                 size_t firstSample,
+                 size_t numSamples,
+                 const std::vector<Sample>& readData)
+{
+    for (size_t row = 0; row < dims.row; ++row)
+    {
+        if (::memcmp(&writeData[row * dims.col + firstSample],
+                     &readData[row * numSamples],
+                     numSamples * sizeof(Sample)) != 0)
+        {
+            std::cerr << "Data mismatch in vector " << row << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sweepWindows(const std::string& name,
+                  const cphd::Wideband& wideband,
+                  const std::vector<Sample>& writeData,
+                  const types::RowCol<size_t>& dims,
+                  size_t numPasses)
+{
+    std::cout << name << "\n"
+              << "    samples   coalesced (s)   per vector (s)\n";
+    for (size_t numSamples = 1; ; numSamples = std::min(numSamples * 2, dims.col))
+    {
+        // Centered, so there are gaps on both sides
+        const size_t firstSample = (dims.col - numSamples) / 2;
+        const size_t lastSample = firstSample + numSamples - 1;
+        std::vector<Sample> readData(dims.row * numSamples);
+        const std::span<std::byte> bytes(
+                reinterpret_cast<std::byte*>(readData.data()),
+                readData.size() * sizeof(Sample));
+
+        double coalesced = 0.0;
+        double perVector = 0.0;
+        for (size_t pass = 0; pass < numPasses; ++pass)
+        {
+            auto start = std::chrono::steady_clock::now();
+            wideband.read(0, 0, dims.row - 1, firstSample, lastSample, 1,
+                          bytes);
+            coalesced += elapsedSince(start);
+            if (!checkWindow(writeData, dims, firstSample, numSamples,
+                             readData))
+            {
+                return false;
+            }
+
+            const size_t bytesPerVector = numSamples * sizeof(Sample);
+            start = std::chrono::steady_clock::now();
+            for (size_t row = 0; row < dims.row; ++row)
+            {
+                wideband.read(0, row, row, firstSample, lastSample, 1,
+                              std::span<std::byte>(
+                                      bytes.data() + row * bytesPerVector,
+                                      bytesPerVector));
+            }
+            perVector += elapsedSince(start);
+            if (!checkWindow(writeData, dims, firstSample, numSamples,
+                             readData))
+            {
+                return false;
+            }
+        }
+
+        std::cout << "    " << numSamples << "\t" << coalesced / numPasses
+                  << "\t" << perVector / numPasses << "\n";
+        if (numSamples == dims.col)
+        {
+            break;
+        }
+    }
+    return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Parse the command line
+        cli::ArgumentParser parser;
+        parser.setDescription(
+                "Time reading windows of samples from CPHD wideband data.");
+        parser.addArgument("-r --rows", "Number of vectors to generate",
+                           cli::STORE, "rows", "NUM")->setDefault(100000);
+        parser.addArgument("-c --cols", "Number of samples per vector",
+                           cli::STORE, "cols", "NUM")->setDefault(1024);
+        parser.addArgument("-p --passes", "Number of times to read each window",
+                           cli::STORE, "passes", "NUM")->setDefault(3);
+        parser.addArgument("-o --output",
+                           "Where to generate the CPHD (default is a temporary "
+                           "file)",
+                           cli::STORE, "output", "CPHD");
+        const std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+        const types::RowCol<size_t> dims(options->get<size_t>("rows"),
+                                         options->get<size_t>("cols"));
+        const size_t numPasses =
+                std::max<size_t>(options->get<size_t>("passes"), 1);
+
+        io::TempFile tempFile;
+        const std::string pathname = options->hasValue("output") ?
+                options->get<std::string>("output") : tempFile.pathname();
+
+        std::vector<Sample> writeData;
+        writeCPHD(pathname, dims, writeData);
+        std::cout << "Generated " << dims.row << " x " << dims.col
+                  << " CPHD: " << pathname << "\n";
+
+        const cphd::CPHDReader fileReader(pathname, 1);
+        const cphd::CPHDReader streamReader(
+                std::make_shared<io::FileInputStream>(pathname), 1);
+
+        const bool ok =
+                sweepWindows("File", fileReader.getWideband(), writeData,
+                             dims, numPasses) &&
+                sweepWindows("Stream", streamReader.getWideband(), writeData,
+                             dims, numPasses);
+        return ok ? 0 : 1;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+    }
+    return 1;
+}
@@ -0,0 +1,163 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2019, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <complex>
+#include <string>
+#include <memory>
+#include <vector>
+
+#include <io/FileInputStream.h>
+#include <io/FileOutputStream.h>
+#include <io/TempFile.h>
+#include <types/RowCol.h>
+#include <cphd/CPHDWriter.h>
+#include <cphd/Metadata.h>
+#include <cphd/PVPBlock.h>
+#include <cphd/TestDataGenerator.h>
+#include "TestCase.h"
+
+namespace
+{
+typedef std::complex<int16_t> Sample;
+
+// Two channels, of different sizes
+const types::RowCol<size_t> DIMS0(7, 16);
+const types::RowCol<size_t> DIMS1(5, 12);
+
+void setUp(cphd::Metadata& metadata,
+           std::vector<Sample>& samples,
+           std::unique_ptr<cphd::PVPBlock>& pvpBlock)
+{
+    samples.resize(DIMS0.area() + DIMS1.area());
+    for (size_t ii = 0; ii < samples.size(); ++ii)
+    {
+        samples[ii] = Sample(static_cast<int16_t>(ii),
+                             static_cast<int16_t>(-3 * ii));
+    }
+
+    cphd::setUpData(metadata, DIMS0, samples);
+    metadata.data.channels.push_back(
+            cphd::Data::Channel(DIMS1.row, DIMS1.col));
+    cphd::setPVPXML(metadata.pvp);
+    pvpBlock.reset(new cphd::PVPBlock(metadata.pvp, metadata.data));
+    for (size_t ii = 0; ii < DIMS0.row; ++ii)
+    {
+        cphd::setVectorParameters(0, ii, *pvpBlock);
+    }
+    for (size_t ii = 0; ii < DIMS1.row; ++ii)
+    {
+        cphd::setVectorParameters(1, ii, *pvpBlock);
+    }
+}
+
+std::vector<std::byte> readFile(const std::string& pathname)
+{
+    io::FileInputStream stream(pathname);
+    std::vector<std::byte> contents(static_cast<size_t>(stream.available()));
+    stream.read(contents.data(), contents.size());
+    return contents;
+}
+
+// The PVPs of vectors [first, first + num) of a channel, as a PVPBlock of
+// their own
+cphd::PVPBlock getPVPSets(const cphd::PVPBlock& pvpBlock,
+                          const cphd::Pvp& pvp,
+                          size_t channel, size_t first, size_t num)
+{
+    std::vector<std::byte> data;
+    pvpBlock.getPVPdata(channel, data);
+    const std::vector<const void*> sets{
+            data.data() + first * pvpBlock.getNumBytesPVPSet()};
+    return cphd::PVPBlock(1, std::vector<size_t>{num}, pvp, sets);
+}
+}
+
+TEST_CASE(testAppendMatchesWrite)
+{
+    cphd::Metadata metadata;
+    std::vector<Sample> samples;
+    std::unique_ptr<cphd::PVPBlock> pvpBlock;
+    setUp(metadata, samples, pvpBlock);
+
+    io::TempFile expected;
+    {
+        cphd::CPHDWriter writer(metadata, expected.pathname());
+        writer.writeMetadata(*pvpBlock);
+        writer.writePVPData(*pvpBlock);
+        writer.writeCPHDData(samples.data(), DIMS0.area(), 0);
+        writer.writeCPHDData(samples.data() + DIMS0.area(), DIMS1.area(), 1);
+        writer.close();
+    }
+
+    // Interleave the channels, a few vectors at a time
+    io::TempFile actual;
+    cphd::CPHDWriter writer(metadata, actual.pathname());
+    writer.writeMetadata();
+    const Sample* const samples1 = samples.data() + DIMS0.area();
+    writer.appendVectors(1, getPVPSets(*pvpBlock, metadata.pvp, 1, 0, 2),
+                         samples1);
+    writer.appendVectors(0, getPVPSets(*pvpBlock, metadata.pvp, 0, 0, 3),
+                         samples.data());
+    TEST_EXCEPTION(writer.close()); // Not done yet
+    writer.appendVectors(0, getPVPSets(*pvpBlock, metadata.pvp, 0, 3, 4),
+                         samples.data() + 3 * DIMS0.col);
+    std::vector<std::byte> pvpData;
+    pvpBlock->getPVPdata(1, pvpData);
+    writer.appendVectors(1, 3,
+                         pvpData.data() + 2 * pvpBlock->getNumBytesPVPSet(),
+                         samples1 + 2 * DIMS1.col);
+    TEST_ASSERT_EQ(writer.getNumVectorsAppended(0), DIMS0.row);
+    TEST_ASSERT_EQ(writer.getNumVectorsAppended(1), DIMS1.row);
+    writer.close();
+
+    TEST_ASSERT_TRUE(readFile(actual.pathname()) ==
+                     readFile(expected.pathname()));
+}
+
+TEST_CASE(testAppendTooMany)
+{
+    cphd::Metadata metadata;
+    std::vector<Sample> samples;
+    std::unique_ptr<cphd::PVPBlock> pvpBlock;
+    setUp(metadata, samples, pvpBlock);
+
+    io::TempFile tempFile;
+    cphd::CPHDWriter writer(metadata, tempFile.pathname());
+    const cphd::PVPBlock pvpSets =
+            getPVPSets(*pvpBlock, metadata.pvp, 1, 0, DIMS1.row);
+    TEST_EXCEPTION(writer.appendVectors(1, pvpSets, samples.data()));
+
+    writer.writeMetadata();
+    TEST_EXCEPTION(writer.appendVectors(2, pvpSets, samples.data()));
+    writer.appendVectors(1, pvpSets, samples.data());
+    TEST_EXCEPTION(writer.appendVectors(1, pvpSets, samples.data()));
+    TEST_EXCEPTION(writer.appendVectors(
+            0, pvpSets, reinterpret_cast<const std::complex<float>*>(
+                                samples.data())));
+    TEST_ASSERT_EQ(writer.getNumVectorsAppended(1), DIMS1.row);
+    TEST_ASSERT_EQ(writer.getNumVectorsAppended(0), static_cast<size_t>(0));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testAppendMatchesWrite);
+    TEST_CHECK(testAppendTooMany);
+    )
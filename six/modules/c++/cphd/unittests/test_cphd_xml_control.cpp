@@ -1172,7 +1172,44 @@ TEST_CASE(testReadXML)
     }
 }
 
+TEST_CASE(testStreamedXML)
+{
+    for (auto pair : cphd::CPHDXMLControl::getVersionUriMap())
+    {
+        const auto xmlString = testCPHDXML(pair.first);
+        io::StringStream cphdStream;
+        cphdStream.write(xmlString.c_str(), xmlString.size());
+
+        xml::lite::MinidomParser xmlParser;
+        xmlParser.preserveCharacterData(true);
+        xmlParser.parse(cphdStream, cphdStream.available());
+        cphd::CPHDXMLControl xmlControl;
+        const std::unique_ptr<cphd::Metadata> metadata =
+                xmlControl.fromXML(xmlParser.getDocument());
+
+        // Writing straight to a stream has to match printing the DOM
+        const auto assertStreamedMatchesDOM = [&]()
+        {
+            io::StringStream domStream;
+            xmlControl.toXML(*metadata)->getRootElement()->print(domStream);
+            io::StringStream xmlStream;
+            xmlControl.toXML(*metadata, xmlStream);
+            TEST_ASSERT_EQ(xmlStream.stream().str(), domStream.stream().str());
+        };
+        assertStreamedMatchesDOM();
+
+        // Channel is written one Parameters at a time
+        auto& channel = metadata->channel;
+        channel.parameters.push_back(channel.parameters[0]);
+        channel.parameters.back().identifier = "CPI2";
+        assertStreamedMatchesDOM();
+        channel.addedParameters.clear();
+        assertStreamedMatchesDOM();
+    }
+}
+
 TEST_MAIN(
     TEST_CHECK(testVersions);
     TEST_CHECK(testReadXML);
+    TEST_CHECK(testStreamedXML);
 )
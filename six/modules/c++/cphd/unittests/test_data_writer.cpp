@@ -0,0 +1,92 @@
+/* =========================================================================
+ * This file is part of cphd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2019, MDA Information Systems LLC
+ *
+ * cphd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include <sys/Conf.h>
+#include <io/ByteStream.h>
+#include <cphd/CPHDWriter.h>
+#include "TestCase.h"
+
+namespace
+{
+// Writes numElements of elementSize through a DataWriterLittleEndian with
+// a small scratch space, so it takes several chunks, and checks that what
+// comes out is the input byte swapped.
+bool writesSwapped(size_t numElements, size_t elementSize,
+                   size_t scratchSize, size_t numThreads)
+{
+    std::vector<std::byte> input(numElements * elementSize);
+    for (size_t ii = 0; ii < input.size(); ++ii)
+    {
+        input[ii] = static_cast<std::byte>(ii * 7 + ii / 251);
+    }
+
+    auto stream = std::make_shared<io::ByteStream>();
+    cphd::DataWriterLittleEndian writer(stream, numThreads, scratchSize);
+    writer(input.data(), numElements, elementSize);
+    // Data written afterwards has to land after all of it
+    writer(input.data(), 1, elementSize);
+
+    std::vector<std::byte> expected(input);
+    expected.insert(expected.end(), input.begin(),
+                    input.begin() + elementSize);
+    if (elementSize > 1)
+    {
+        sys::byteSwap(expected.data(), static_cast<unsigned short>(elementSize),
+                      numElements + 1);
+    }
+
+    std::vector<std::byte> actual(static_cast<size_t>(stream->getSize()));
+    stream->seek(0, io::Seekable::START);
+    stream->read(actual.data(), actual.size());
+    return actual == expected;
+}
+}
+
+TEST_CASE(testWriteOneChunk)
+{
+    TEST_ASSERT_TRUE(writesSwapped(10, 4, 1024, 1));
+}
+
+TEST_CASE(testWriteManyChunks)
+{
+    TEST_ASSERT_TRUE(writesSwapped(1001, 8, 64, 1));
+    TEST_ASSERT_TRUE(writesSwapped(1001, 2, 64, 4));
+    TEST_ASSERT_TRUE(writesSwapped(1001, 1, 64, 2));
+}
+
+TEST_CASE(testWriteUnevenScratch)
+{
+    // Chunks are rounded down to whole elements, or up to one element
+    TEST_ASSERT_TRUE(writesSwapped(100, 8, 30, 1));
+    TEST_ASSERT_TRUE(writesSwapped(100, 8, 6, 1));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testWriteOneChunk);
+    TEST_CHECK(testWriteManyChunks);
+    TEST_CHECK(testWriteUnevenScratch);
+    )
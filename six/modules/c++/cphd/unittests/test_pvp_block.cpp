@@ -21,9 +21,15 @@
  */
 
 #include <complex>
+#include <limits>
+#include <string>
 #include <thread>
 #include <tuple>
 
+#include <std/bit>
+
+#include <io/ByteStream.h>
+#include <cphd/ByteSwap.h>
 #include <cphd/PVP.h>
 #include <cphd/PVPBlock.h>
 #include <cphd/TestDataGenerator.h>
@@ -350,10 +356,258 @@ TEST_CASE(testLoadPVPBlockFromMemory)
     TEST_ASSERT_EQ(pvpBlock.getTxPos(0, 0)[2], 9);
 }
 
+TEST_CASE(testPvpBulkAccess)
+{
+    call_srand();
+    cphd::Pvp pvp;
+    cphd::setPVPXML(pvp);
+    pvp.setOffset(28, pvp.ampSF);
+    cphd::PVPBlock pvpBlock(NUM_CHANNELS,
+                            std::vector<size_t>(NUM_CHANNELS, NUM_VECTORS),
+                            pvp);
+
+    for (size_t channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        for (size_t vector = 0; vector < NUM_VECTORS; ++vector)
+        {
+            cphd::setVectorParameters(channel, vector, pvpBlock);
+            pvpBlock.setAmpSF(cphd::getRandom(), channel, vector);
+        }
+    }
+
+    for (size_t channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        const auto txTime = pvpBlock.getTxTime(channel);
+        const auto txPos = pvpBlock.getTxPos(channel);
+        const auto ampSF = pvpBlock.getAmpSF(channel);
+        TEST_ASSERT_EQ(txTime.size(), NUM_VECTORS);
+        TEST_ASSERT_EQ(txPos.size(), NUM_VECTORS);
+        TEST_ASSERT_EQ(ampSF.size(), NUM_VECTORS);
+        for (size_t vector = 0; vector < NUM_VECTORS; ++vector)
+        {
+            TEST_ASSERT_EQ(txTime[vector], pvpBlock.getTxTime(channel, vector));
+            TEST_ASSERT_EQ(txPos[vector], pvpBlock.getTxPos(channel, vector));
+            TEST_ASSERT_EQ(ampSF[vector], pvpBlock.getAmpSF(channel, vector));
+        }
+    }
+
+    TEST_EXCEPTION(pvpBlock.getTxTime(NUM_CHANNELS));
+    TEST_EXCEPTION(pvpBlock.getFxN1(0)); // Not in the XML
+}
+
+TEST_CASE(testLoadPVPBlockFromStream)
+{
+    call_srand();
+    cphd::Pvp pvp;
+    cphd::setPVPXML(pvp);
+    pvp.setOffset(27, pvp.ampSF);
+    pvp.setCustomParameter(1, 28, "F8", "Param1");
+    cphd::PVPBlock pvpBlock(NUM_CHANNELS,
+                            std::vector<size_t>(NUM_CHANNELS, NUM_VECTORS),
+                            pvp);
+
+    // Write it out as it would be in a file: big endian
+    io::ByteStream stream;
+    for (size_t channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        for (size_t vector = 0; vector < NUM_VECTORS; ++vector)
+        {
+            cphd::setVectorParameters(channel, vector, pvpBlock);
+            pvpBlock.setAmpSF(cphd::getRandom(), channel, vector);
+            pvpBlock.setAddedPVP(cphd::getRandom(), channel, vector, "Param1");
+        }
+
+        std::vector<std::byte> data;
+        pvpBlock.getPVPdata(channel, data);
+        if (std::endian::native == std::endian::little)
+        {
+            cphd::byteSwap(data.data(), sizeof(double),
+                           data.size() / sizeof(double), 1);
+        }
+        stream.write(data.data(), data.size());
+    }
+
+    cphd::PVPBlock loaded(NUM_CHANNELS,
+                          std::vector<size_t>(NUM_CHANNELS, NUM_VECTORS),
+                          pvp);
+    TEST_ASSERT_EQ(loaded.load(stream, 0, stream.getSize(), 2),
+                   static_cast<int64_t>(stream.getSize()));
+
+    // Single values come from the data as loaded
+    for (size_t channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        for (size_t vector = 0; vector < NUM_VECTORS; ++vector)
+        {
+            TEST_ASSERT_EQ(loaded.getTxTime(channel, vector),
+                           pvpBlock.getTxTime(channel, vector));
+            TEST_ASSERT_EQ(loaded.getSRPPos(channel, vector),
+                           pvpBlock.getSRPPos(channel, vector));
+            TEST_ASSERT_EQ(loaded.getAmpSF(channel, vector),
+                           pvpBlock.getAmpSF(channel, vector));
+            TEST_EXCEPTION(loaded.getFxN1(channel, vector));
+        }
+    }
+
+    std::vector<std::byte> expected;
+    std::vector<std::byte> actual;
+    pvpBlock.getPVPdata(0, expected);
+    loaded.getPVPdata(0, actual);
+    TEST_ASSERT(expected == actual);
+
+    // These unpack it, concurrently
+    std::vector<std::thread> threads;
+    for (size_t channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        threads.emplace_back([&loaded, channel]()
+        {
+            loaded.getTxTime(channel);
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    TEST_ASSERT_EQ(loaded.getAddedPVP<double>(1, 1, "Param1"),
+                   pvpBlock.getAddedPVP<double>(1, 1, "Param1"));
+    TEST_ASSERT_TRUE(loaded == pvpBlock);
+
+    // Copies and changes don't affect the original
+    cphd::PVPBlock copy(loaded);
+    copy.setTxTime(-1.0, 0, 0);
+    TEST_ASSERT_EQ(copy.getTxTime(0, 0), -1.0);
+    TEST_ASSERT_TRUE(loaded == pvpBlock);
+}
+
+TEST_CASE(testAddedPVPFormats)
+{
+    call_srand();
+    cphd::Pvp pvp;
+    cphd::setPVPXML(pvp);
+    pvp.setCustomParameter(1, 27, "U8", "Count");
+    pvp.setCustomParameter(1, 28, "I2", "Index");
+    pvp.setCustomParameter(1, 29, "CF8", "Phase");
+    pvp.setCustomParameter(1, 30, "S8", "Tag");
+    cphd::PVPBlock pvpBlock(NUM_CHANNELS,
+                            std::vector<size_t>(NUM_CHANNELS, NUM_VECTORS),
+                            pvp);
+
+    const std::uint64_t count = std::numeric_limits<std::uint64_t>::max();
+    const std::complex<float> phase(1.5f, -2.5f);
+    for (size_t channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        for (size_t vector = 0; vector < NUM_VECTORS; ++vector)
+        {
+            cphd::setVectorParameters(channel, vector, pvpBlock);
+
+            // Values are converted to the parameter's format
+            TEST_EXCEPTION(pvpBlock.setAddedPVP(phase, channel, vector,
+                                                "Count"));
+            pvpBlock.setAddedPVP(count - vector, channel, vector, "Count");
+            pvpBlock.setAddedPVP(std::to_string(-12 - static_cast<int>(vector)),
+                                 channel, vector, "Index");
+            pvpBlock.setAddedPVP(phase, channel, vector, "Phase");
+            pvpBlock.setAddedPVP("Vector0" + std::to_string(vector),
+                                 channel, vector, "Tag");
+        }
+    }
+
+    TEST_ASSERT_EQ(pvpBlock.getAddedPVP<std::uint64_t>(1, 1, "Count"),
+                   count - 1);
+    TEST_ASSERT_EQ(pvpBlock.getAddedPVP<int>(1, 1, "Index"), -13);
+    TEST_ASSERT_EQ(pvpBlock.getAddedPVP<std::complex<float> >(1, 1, "Phase"),
+                   phase);
+    TEST_ASSERT_EQ(pvpBlock.getAddedPVP<std::string>(1, 1, "Tag"),
+                   "Vector01");
+
+    // And written out and read back as they are in a file
+    std::vector<std::vector<std::byte> > data(NUM_CHANNELS);
+    std::vector<const void*> pvpData(NUM_CHANNELS);
+    for (size_t channel = 0; channel < NUM_CHANNELS; ++channel)
+    {
+        pvpBlock.getPVPdata(channel, data[channel]);
+        pvpData[channel] = data[channel].data();
+    }
+    const cphd::PVPBlock loaded(NUM_CHANNELS,
+                                std::vector<size_t>(NUM_CHANNELS, NUM_VECTORS),
+                                pvp,
+                                pvpData);
+    TEST_ASSERT_EQ(loaded.getAddedPVP<std::uint64_t>(2, 0, "Count"), count);
+    TEST_ASSERT_EQ(loaded.getAddedPVP<int>(2, 0, "Index"), -12);
+    TEST_ASSERT_TRUE(loaded == pvpBlock);
+}
+
+TEST_CASE(testLoadedChannelFromManyThreads)
+{
+    call_srand();
+    // Enough vectors that readers and unpacking overlap
+    constexpr size_t numVectors = 10000;
+    cphd::Pvp pvp;
+    cphd::setPVPXML(pvp);
+    cphd::PVPBlock pvpBlock(1, std::vector<size_t>(1, numVectors), pvp);
+    for (size_t vector = 0; vector < numVectors; ++vector)
+    {
+        cphd::setVectorParameters(0, vector, pvpBlock);
+    }
+    std::vector<std::byte> data;
+    pvpBlock.getPVPdata(0, data);
+    if (std::endian::native == std::endian::little)
+    {
+        cphd::byteSwap(data.data(), sizeof(double),
+                       data.size() / sizeof(double), 1);
+    }
+    io::ByteStream stream;
+    stream.write(data.data(), data.size());
+
+    // Several threads read single values from the loaded data while
+    // others unpack it, all on the one channel
+    for (size_t round = 0; round < 10; ++round)
+    {
+        cphd::PVPBlock loaded(1, std::vector<size_t>(1, numVectors), pvp);
+        loaded.load(stream, 0, stream.getSize(), 1);
+
+        constexpr size_t numThreads = 8;
+        std::vector<int> matched(numThreads, 0);
+        std::vector<std::thread> threads;
+        for (size_t ii = 0; ii < numThreads; ++ii)
+        {
+            threads.emplace_back([&, ii]()
+            {
+                bool ok = true;
+                for (size_t vector = 0; vector < numVectors; ++vector)
+                {
+                    ok = ok && loaded.getTxTime(0, vector) ==
+                            pvpBlock.getTxTime(0, vector);
+                    ok = ok && loaded.getSRPPos(0, vector) ==
+                            pvpBlock.getSRPPos(0, vector);
+                    if (ii % 2 && vector == numVectors / 2)
+                    {
+                        ok = ok && loaded.getRcvTime(0)[vector] ==
+                                pvpBlock.getRcvTime(0, vector);
+                    }
+                }
+                matched[ii] = ok;
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (const auto ok : matched)
+        {
+            TEST_ASSERT_TRUE(ok);
+        }
+        TEST_ASSERT_TRUE(loaded == pvpBlock);
+    }
+}
+
 TEST_MAIN(
     TEST_CHECK(testPvpRequired);
     TEST_CHECK(testPvpOptional);
     TEST_CHECK(testPvpThrow);
     TEST_CHECK(testPvpEquality);
     TEST_CHECK(testLoadPVPBlockFromMemory);
+    TEST_CHECK(testPvpBulkAccess);
+    TEST_CHECK(testLoadPVPBlockFromStream);
+    TEST_CHECK(testAddedPVPFormats);
+    TEST_CHECK(testLoadedChannelFromManyThreads);
     )
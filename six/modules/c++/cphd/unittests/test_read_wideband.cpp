@@ -21,6 +21,9 @@
  */
 #include <cphd/Wideband.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <cphd/Metadata.h>
 #include <io/ByteStream.h>
 #include "TestCase.h"
@@ -161,9 +164,55 @@ TEST_CASE(testCannotDoPartialReadOfCompressedChannel)
     TEST_EXCEPTION(wideband.getBytesRequiredForRead(0, 0, 0, 1, 1));
 }
 
+TEST_CASE(testReadWideWindow)
+{
+    // Each vector's window is more than the 4MB a coalesced read buffers at
+    // once, with a small gap between windows
+    const size_t numSamples = 600000;
+    const size_t numVectors = 3;
+    const size_t firstSample = 50;
+    const size_t lastSample = numSamples - 51;
+    const size_t numBytesPerSample = 8;
+
+    cphd::Metadata metadata;
+    metadata.data.channels.resize(1);
+    metadata.data.channels[0].numSamples = numSamples;
+    metadata.data.channels[0].numVectors = numVectors;
+    metadata.data.signalArrayFormat = cphd::SignalArrayFormat::CF8;
+
+    const size_t numBytes = numVectors * numSamples * numBytesPerSample;
+    std::vector<std::byte> signal(numBytes);
+    for (size_t ii = 0; ii < numBytes; ++ii)
+    {
+        signal[ii] = static_cast<std::byte>(ii % 251);
+    }
+    auto input = std::make_shared<io::ByteStream>();
+    input->write(signal.data(), signal.size());
+    input->seek(0, io::Seekable::START);
+
+    cphd::Wideband wideband(input, metadata, 0, numBytes);
+    const auto readData = wideband.read(0, 0, numVectors - 1,
+                                        firstSample, lastSample, 1);
+
+    const size_t numWindowBytes =
+            (lastSample - firstSample + 1) * numBytesPerSample;
+    bool matches = true;
+    for (size_t vector = 0; vector < numVectors; ++vector)
+    {
+        const size_t fileOffset = (vector * numSamples + firstSample) *
+                numBytesPerSample;
+        matches = matches && std::equal(
+                signal.begin() + fileOffset,
+                signal.begin() + fileOffset + numWindowBytes,
+                readData.get() + vector * numWindowBytes);
+    }
+    TEST_ASSERT(matches);
+}
+
 TEST_MAIN(
     TEST_CHECK(testReadCompressedChannel);
     TEST_CHECK(testReadUncompressedChannel);
     TEST_CHECK(testReadChannelSubset);
     TEST_CHECK(testCannotDoPartialReadOfCompressedChannel);
+    TEST_CHECK(testReadWideWindow);
     )
@@ -136,6 +136,11 @@ int main(int argc, char** argv)
                            "in bounds.",
                            cli::STORE_TRUE,
                            "requireAoiInBounds")->setDefault(false);
+        parser.addArgument("--rows-per-strip",
+                           "Number of rows to copy at a time; 0 picks as "
+                           "many as fit in about 32 MB",
+                           cli::STORE,
+                           "rowsPerStrip", "#")->setDefault(0);
         parser.addArgument("input", "Input SICD pathname", cli::STORE,
                            "input", "<input SICD pathname>", 1, 1);
         parser.addArgument("output", "Output SICD pathname", cli::STORE,
@@ -146,6 +151,7 @@ int main(int argc, char** argv)
         const std::string outPathname(options->get<std::string> ("output"));
         const bool trimCornersIfNeeded =
                 !options->get<bool>("requireAoiInBounds");
+        const size_t numRowsPerStrip(options->get<size_t>("rowsPerStrip"));
 
         std::vector<std::string> schemaPaths;
         const std::string schemaPath(options->get<std::string>("schema"));
@@ -162,14 +168,16 @@ int main(int argc, char** argv)
             std::vector<scene::Vector3> corners;
             parseECEF(*options, corners);
             six::sicd::cropSICD(inPathname, schemaPaths, corners,
-                                outPathname, trimCornersIfNeeded);
+                                outPathname, trimCornersIfNeeded,
+                                numRowsPerStrip);
         }
         else if (options->hasValue("latlon"))
         {
             std::vector<scene::LatLonAlt> corners;
             parseLatLon(*options, corners);
             six::sicd::cropSICD(inPathname, schemaPaths, corners,
-                                outPathname, trimCornersIfNeeded);
+                                outPathname, trimCornersIfNeeded,
+                                numRowsPerStrip);
         }
         else
         {
@@ -185,7 +193,8 @@ int main(int argc, char** argv)
                                 schemaPaths,
                                 aoiOffset,
                                 aoiDims,
-                                outPathname);
+                                outPathname,
+                                numRowsPerStrip);
         }
 
         return 0;
@@ -54,6 +54,11 @@ int main(int argc, char** argv)
                            "Specify a schema or directory of schemas",
                            cli::STORE,
                            "schema", "<directory>");
+        parser.addArgument("--rows-per-strip",
+                           "Number of rows to copy at a time; 0 picks as "
+                           "many as fit in about 32 MB",
+                           cli::STORE,
+                           "rowsPerStrip", "#")->setDefault(0);
         parser.addArgument("input", "Input SIDD pathname", cli::STORE,
                            "input", "<input SIDD pathname>", 1, 1);
         parser.addArgument("output", "Output SIDD pathname", cli::STORE,
@@ -66,6 +71,7 @@ int main(int argc, char** argv)
                                             options->get<size_t>("numCols"));
         const std::string inPathname(options->get<std::string> ("input"));
         const std::string outPathname(options->get<std::string> ("output"));
+        const size_t numRowsPerStrip(options->get<size_t>("rowsPerStrip"));
         std::vector<std::string> schemaPaths;
         getSchemaPaths(*options, "--schema", "schema", schemaPaths);
 
@@ -77,7 +83,8 @@ int main(int argc, char** argv)
                             schemaPaths,
                             aoiOffset,
                             aoiDims,
-                            outPathname);
+                            outPathname,
+                            numRowsPerStrip);
     }
     catch (const std::exception& ex)
     {
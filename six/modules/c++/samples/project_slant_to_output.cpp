@@ -21,13 +21,17 @@
  */
 
 /*
- * This program gets a rough output plane from the SICD, and writes it as
- * an SIO. No filtering is done. As a result, the output plane contains
- * some massive values that skew the image. Therefore, when viewing the
- * image, you will have to mitigate this. When viewing in MATLAB,
+ * This program resamples the SICD's detected image into its output plane,
+ * and writes it as an SIO. No filtering is done. As a result, the output
+ * plane contains some massive values that skew the image. Therefore, when
+ * viewing the image, you will have to mitigate this. When viewing in MATLAB,
  * for example, this may be done by
  * img = read_sio('outputPlane.sio');
  * imagesc(img, [0, mean(img(:))]);
+ *
+ * Given --polyOrderX or --polyOrderY, it instead projects each output pixel
+ * through polynomials of those orders fitted to the output-to-slant mapping,
+ * as it used to.
  */
 
 #include <scene/ProjectionPolynomialFitter.h>
@@ -36,10 +40,12 @@
 #include <cli/Results.h>
 #include <math/Round.h>
 #include <sio/lite/FileWriter.h>
+#include <six/Executor.h>
 #include <six/XMLControl.h>
 #include <six/XMLControlFactory.h>
 #include <six/sicd/AreaPlaneUtility.h>
 #include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/OutputPlaneResampler.h>
 #include <six/sicd/Utilities.h>
 #include "utils.h"
 
@@ -67,6 +73,47 @@ void findOutputToSlantPolynomials(const six::sicd::ComplexData& complexData,
             toSlantRow,
             toSlantCol);
 }
+
+// Nearest slant plane pixel for each output pixel, via fitted polynomials
+void projectWithPolynomials(const six::sicd::ComplexData& complexData,
+        const std::vector<std::complex<float> >& buffer,
+        size_t polyOrderX, size_t polyOrderY,
+        const types::RowCol<size_t>& outputDims,
+        std::vector<float>& outputArray)
+{
+    six::Poly2D toSlantRow;
+    six::Poly2D toSlantCol;
+    findOutputToSlantPolynomials(complexData, polyOrderX, polyOrderY,
+            toSlantRow, toSlantCol);
+
+    toSlantRow = toSlantRow.flipXY();
+    toSlantCol = toSlantCol.flipXY();
+    outputArray.resize(outputDims.area());
+    // Iterate over output plane, grabbing the appropriate input point
+    for (size_t outRow = 0; outRow < outputDims.row; ++outRow)
+    {
+        const six::Poly1D rowPoly = toSlantRow.atY(outRow);
+        const six::Poly1D colPoly = toSlantCol.atY(outRow);
+        for (size_t outCol = 0; outCol < outputDims.col; ++outCol)
+        {
+            const size_t outIdx = (outRow * outputDims.col) + outCol;
+            const double inRowInitial = rowPoly(outCol);
+            const double inColInitial = colPoly(outCol);
+            if (inRowInitial < 0 || inColInitial < 0)
+            {
+                // Out of bounds values just get assigned to 0
+                outputArray[outIdx] = 0;
+                continue;
+            }
+            const size_t inRow = math::round(inRowInitial);
+            const size_t inCol = math::round(inColInitial);
+            const size_t inIdx = (inRow * complexData.getNumCols()) + inCol;
+            const float outputValue = inIdx >= buffer.size() ? 0 :
+                    std::abs(buffer[inIdx]);
+            outputArray[outIdx] = outputValue;
+        }
+    }
+}
 }
 
 int main(int argc, char** argv)
@@ -79,12 +126,23 @@ int main(int argc, char** argv)
         parser.addArgument("-s --schema",
                            "Specify a schema or directory of schemas",
                            cli::STORE);
-        parser.addArgument("-x --polyOrderX", "Order for x-direction polynomials",
-                           cli::STORE, "polyOrderX", "POLY_ORDER_X", 1, 1)->
-                           setDefault(3);
-        parser.addArgument("-y --polyOrderY", "Order for y-direction polynomials",
-                           cli::STORE, "polyOrderY", "POLY_ORDER_Y", 1, 1)->
-                           setDefault(3);
+        parser.addArgument("-g --gridSpacing",
+                           "Output pixels between projected grid points",
+                           cli::STORE, "gridSpacing", "GRID_SPACING", 1, 1)->
+                           setDefault(six::sicd::OutputPlaneResampler::
+                                      DEFAULT_GRID_SPACING);
+        parser.addArgument("-t --threads",
+                           "Number of threads to use (0 is one per core)",
+                           cli::STORE, "threads", "NUM", 1, 1)->
+                           setDefault(0);
+        parser.addArgument("-x --polyOrderX",
+                           "Order for x-direction polynomials; projects "
+                           "through polynomials rather than resampling",
+                           cli::STORE, "polyOrderX", "POLY_ORDER_X", 1, 1);
+        parser.addArgument("-y --polyOrderY",
+                           "Order for y-direction polynomials; projects "
+                           "through polynomials rather than resampling",
+                           cli::STORE, "polyOrderY", "POLY_ORDER_Y", 1, 1);
         parser.addArgument("input", "Input SICD", cli::STORE, "input", "INPUT",
                             1, 1);
         parser.addArgument("output", "Output SIO Pathname", cli::STORE,
@@ -94,8 +152,8 @@ int main(int argc, char** argv)
 
         const std::string sicdPathname(options->get<std::string>("input"));
         const std::string outputPathname(options->get<std::string>("output"));
-        const size_t polyOrderX(options->get<size_t>("polyOrderX"));
-        const size_t polyOrderY(options->get<size_t>("polyOrderY"));
+        const size_t gridSpacing(options->get<size_t>("gridSpacing"));
+        const size_t numThreads(options->get<size_t>("threads"));
         std::vector<std::string> schemaPaths;
         getSchemaPaths(*options, "--schema", "schema", schemaPaths);
 
@@ -112,50 +170,41 @@ int main(int argc, char** argv)
         {
             six::sicd::AreaPlaneUtility::setAreaPlane(*complexData);
         }
-        const six::sicd::AreaPlane& plane =
-                *complexData->radarCollection->area->plane;
-
-        // Grab outputToSlant plane polynomials
-        six::Poly2D toSlantRow;
-        six::Poly2D toSlantCol;
-        findOutputToSlantPolynomials(*complexData, polyOrderX, polyOrderY,
-                toSlantRow, toSlantCol);
-
-        toSlantRow = toSlantRow.flipXY();
-        toSlantCol = toSlantCol.flipXY();
-        std::unique_ptr<float[]> outputArray(new float[
-                plane.xDirection->elements * plane.yDirection->elements]);
-        // Iterate over output plane, grabbing the appropriate input point
-        for (size_t outRow = 0; outRow < plane.xDirection->elements; ++outRow)
+
+        types::RowCol<size_t> outputDims;
+        std::vector<float> outputArray;
+        if (options->hasValue("polyOrderX") || options->hasValue("polyOrderY"))
+        {
+            const size_t polyOrderX(options->hasValue("polyOrderX") ?
+                    options->get<size_t>("polyOrderX") : 3);
+            const size_t polyOrderY(options->hasValue("polyOrderY") ?
+                    options->get<size_t>("polyOrderY") : 3);
+            const six::sicd::AreaPlane& plane =
+                    *complexData->radarCollection->area->plane;
+            outputDims = types::RowCol<size_t>(plane.xDirection->elements,
+                                               plane.yDirection->elements);
+            projectWithPolynomials(*complexData, buffer, polyOrderX,
+                                   polyOrderY, outputDims, outputArray);
+        }
+        else
         {
-            const six::Poly1D rowPoly = toSlantRow.atY(outRow);
-            const six::Poly1D colPoly = toSlantCol.atY(outRow);
-            for (size_t outCol = 0;
-                    outCol < plane.yDirection->elements; ++outCol)
-            {
-                const size_t outIdx = (outRow * plane.yDirection->elements) +
-                        outCol;
-                const double inRowInitial = rowPoly(outCol);
-                const double inColInitial = colPoly(outCol);
-                if (inRowInitial < 0 || inColInitial < 0)
-                {
-                    // Out of bounds values just get assigned to 0
-                    outputArray[outIdx] = 0;
-                    continue;
-                }
-                const size_t inRow = math::round(inRowInitial);
-                const size_t inCol = math::round(inColInitial);
-                const size_t inIdx = (inRow * complexData->getNumCols()) +
-                        inCol;
-                const float outputValue = inIdx >= buffer.size() ? 0 :
-                        std::abs(buffer[inIdx]);
-                outputArray[outIdx] = outputValue;
-            }
+            six::Executor executor(numThreads);
+            const six::sicd::OutputPlaneResampler resampler(*complexData,
+                                                            gridSpacing,
+                                                            &executor);
+            outputDims = resampler.getOutputDims();
+            outputArray.resize(outputDims.area());
+            resampler.resampleDetected(
+                    std::span<const std::complex<float> >(buffer.data(),
+                                                          buffer.size()),
+                    std::span<float>(outputArray.data(), outputArray.size()),
+                    &executor);
         }
 
         sio::lite::FileWriter writer(outputPathname);
-        writer.write(plane.xDirection->elements, plane.yDirection->elements,
-                sizeof(float), sio::lite::FileHeader::FLOAT, outputArray.get());
+        writer.write(outputDims.row, outputDims.col,
+                sizeof(float), sio::lite::FileHeader::FLOAT,
+                outputArray.data());
 
         return 0;
     }
@@ -25,13 +25,19 @@
  * This test serves as an example to show how one can use CompressedSIDDByteProvider
  * to create a SIDD with J2K compression.
  *
- * While this demonstrates use of CompressedSIDDByteProvider, the module for
- * actually compressing the image data is not a part of SIX. Actual data will
- * be uncompressed. Search for COMPRESSION comments to see an explanation
- * of what will change with a compressor.
+ * By default the image data is written uncompressed; search for COMPRESSION
+ * comments to see an explanation of what changes with a compressor.  With
+ * --compress, the image is J2K compressed with J2KTileCompressor, one tile
+ * per NITF block.  With --benchmark, a larger synthetic image is compressed
+ * on one thread and then on several, and the throughputs are reported.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
 #include <string>
+#include <vector>
 
 #include <six/sidd/CompressedSIDDByteProvider.h>
 
@@ -42,9 +48,11 @@
 #include <nitf/NITFBufferList.hpp>
 #include <nitf/Reader.hpp>
 #include <nitf/Record.hpp>
+#include <six/Executor.h>
 #include <six/Types.h>
 #include <six/sidd/DerivedData.h>
 #include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/J2KTileCompressor.h>
 #include <six/sidd/Utilities.h>
 
 #ifdef _MSC_VER
@@ -1013,8 +1021,58 @@ createData(const types::RowCol<size_t>& dims)
     return data;
 }
 
-void writeSIDD(const std::string& filename, bool /*shouldCompress*/)
+// The J2K tiles are the NITF blocks
+const types::RowCol<size_t> TILE_DIMS(16, 64);
+
+std::span<const std::byte> getImage()
+{
+    return std::span<const std::byte>(
+            reinterpret_cast<const std::byte*>(NITRO_IMAGE.data),
+            NITRO_IMAGE.width * NITRO_IMAGE.height);
+}
+
+void writeBuffers(const std::string& filename,
+                  const nitf::NITFBufferList& buffers)
+{
+    io::FileOutputStream outputStream(filename);
+    for (const auto& buffer : buffers.mBuffers)
+    {
+        outputStream.write(buffer.mData, buffer.mNumBytes);
+    }
+}
+
+void writeCompressedSIDD(const std::string& filename)
 {
+    const types::RowCol<size_t> dims(NITRO_IMAGE.height, NITRO_IMAGE.width);
+    const std::vector<std::string> schemaPaths;
+    std::unique_ptr<six::sidd::DerivedData> data = createData(dims);
+
+    // The tiles are compressed in parallel, and come back as one codestream
+    // along with the compressed size of each tile (block)
+    const six::sidd::J2KTileCompressor compressor(dims, TILE_DIMS);
+    std::vector<std::byte> codestream;
+    std::vector<std::vector<size_t> > bytesPerBlock(1);
+    compressor.compress(getImage(), codestream, bytesPerBlock[0]);
+
+    // Here the ByteProvider can do all the NITFWriteControl setup
+    const six::sidd::CompressedSIDDByteProvider byteProvider(
+            *data, schemaPaths, bytesPerBlock,
+            true /*isNumericallyLossless*/, TILE_DIMS.row, TILE_DIMS.col);
+    nitf::Off fileOffset;
+    nitf::NITFBufferList buffers;
+    byteProvider.getBytes(codestream.data(), 0, dims.row, fileOffset,
+                          buffers);
+    writeBuffers(filename, buffers);
+}
+
+void writeSIDD(const std::string& filename, bool shouldCompress)
+{
+    if (shouldCompress)
+    {
+        writeCompressedSIDD(filename);
+        return;
+    }
+
     const size_t NUM_BANDS = 1;
     /*
      * COMPRESSION:
@@ -1029,7 +1087,7 @@ void writeSIDD(const std::string& filename, bool /*shouldCompress*/)
      * If you are compressing to multiple tiles (blocks), each tile will have
      * a different size, hence the need for a vector.
      * Once you have CompressedByteProvider constructed, everything else
-     * should work the same
+     * should work the same.  See writeCompressedSIDD().
      */
     std::vector<std::vector<size_t> > bytesPerBlock(1);
     std::vector<std::string> schemaPaths;
@@ -1057,11 +1115,37 @@ void writeSIDD(const std::string& filename, bool /*shouldCompress*/)
     nitf::NITFBufferList buffers;
     byteProvider.getBytes(NITRO_IMAGE.data, 0, NITRO_IMAGE.height,
             fileOffset, buffers);
-    io::FileOutputStream outputStream(filename);
-    for (const auto& buffer : buffers.mBuffers)
+    writeBuffers(filename, buffers);
+}
+
+bool testCompressedRead(const std::string& pathname)
+{
+    // Decompressing needs a J2K plugin, so just make sure the file is laid
+    // out as a compressed, blocked SIDD
+    nitf::IOHandle handle(pathname, NITF_ACCESS_READONLY, NITF_OPEN_EXISTING);
+    nitf::Reader reader;
+    nitf::Record record = reader.read(handle);
+    if (record.getNumImages() != 1)
     {
-        outputStream.write(buffer.mData, buffer.mNumBytes);
+        std::cerr << "Expected one image segment" << std::endl;
+        return false;
+    }
+
+    nitf::ImageSegment segment = record.getImages()[0];
+    nitf::ImageSubheader subheader = segment.getSubheader();
+    const std::string compression = subheader.imageCompressionString();
+    if (compression != "C8" && compression != "M8")
+    {
+        std::cerr << "Image isn't J2K compressed" << std::endl;
+        return false;
     }
+    if (subheader.numPixelsPerVertBlock() != TILE_DIMS.row ||
+        subheader.numPixelsPerHorizBlock() != TILE_DIMS.col)
+    {
+        std::cerr << "Blocks don't match the J2K tiles" << std::endl;
+        return false;
+    }
+    return true;
 }
 
 bool testRead(const std::string& pathname)
@@ -1092,6 +1176,71 @@ bool testRead(const std::string& pathname)
     return true;
 }
 
+// Best of numTrials, in Mpixels/s
+double timeCompression(const six::sidd::J2KTileCompressor& compressor,
+                       const std::vector<std::byte>& image,
+                       six::Executor& executor,
+                       size_t numTrials,
+                       std::vector<std::byte>& codestream)
+{
+    const std::span<const std::byte> pixels(image.data(), image.size());
+    std::vector<size_t> bytesPerTile;
+    double bestSec = 0.0;
+    for (size_t trial = 0; trial < numTrials; ++trial)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        compressor.compress(pixels, codestream, bytesPerTile, &executor);
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double sec = std::chrono::duration<double>(stop - start).count();
+        bestSec = (trial == 0) ? sec : std::min(bestSec, sec);
+    }
+    return image.size() / bestSec / 1e6;
+}
+
+void benchmark(const types::RowCol<size_t>& dims,
+               const types::RowCol<size_t>& tileDims,
+               size_t numThreads,
+               size_t numTilesInFlight,
+               size_t numTrials)
+{
+    // Some sort of pattern so compression has something to work with
+    std::vector<std::byte> image(dims.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = static_cast<std::byte>((ii / 100 + ii % 7) % 128);
+    }
+
+    const six::sidd::J2KTileCompressor compressor(dims, tileDims, 1.0,
+                                                  numTilesInFlight);
+    six::Executor serial(1);
+    six::Executor parallel(numThreads);
+
+    std::vector<std::byte> serialCodestream;
+    std::vector<std::byte> parallelCodestream;
+    const double serialRate = timeCompression(compressor, image, serial,
+                                              numTrials, serialCodestream);
+    const double parallelRate = timeCompression(
+            compressor, image, parallel, numTrials, parallelCodestream);
+    if (serialCodestream != parallelCodestream)
+    {
+        throw except::Exception(Ctxt(
+                "Serial and parallel codestreams differ"));
+    }
+
+    std::cout << "Compressed " << dims.row << " x " << dims.col
+              << " pixels as " << compressor.getNumTiles() << " "
+              << tileDims.row << " x " << tileDims.col << " tiles into "
+              << parallelCodestream.size() << " bytes\n\n"
+              << std::fixed << std::setprecision(2)
+              << std::setw(12) << "threads" << std::setw(12) << "Mpixels/s"
+              << "\n"
+              << std::setw(12) << 1 << std::setw(12) << serialRate << "\n"
+              << std::setw(12) << parallel.getNumThreads()
+              << std::setw(12) << parallelRate << "\n\n"
+              << "Speedup: " << parallelRate / serialRate << "x\n";
+}
+
 int main(int argc, char **argv)
 {
     try
@@ -1101,24 +1250,44 @@ int main(int argc, char **argv)
             "This program creates a sample NITF file.");
         parser.addArgument("-c --compress", "Compress file", cli::STORE_TRUE,
             "shouldCompress");
+        parser.addArgument("--benchmark", "Report J2K compression throughput "
+            "instead of creating a file", cli::STORE_TRUE, "benchmark");
+        parser.addArgument("--rows", "Benchmark image rows", cli::STORE,
+            "rows", "INT")->setDefault(4096);
+        parser.addArgument("--cols", "Benchmark image columns", cli::STORE,
+            "cols", "INT")->setDefault(4096);
+        parser.addArgument("--tile", "Benchmark tile (block) size", cli::STORE,
+            "tile", "INT")->setDefault(512);
+        parser.addArgument("-t --threads", "Benchmark threads; 0 is one per "
+            "core", cli::STORE, "threads", "INT")->setDefault(0);
+        parser.addArgument("--in-flight", "Most tiles held at once while "
+            "benchmarking; 0 is twice the threads", cli::STORE, "inFlight",
+            "INT")->setDefault(0);
+        parser.addArgument("--trials", "Best of this many compressions is "
+            "reported", cli::STORE, "trials", "INT")->setDefault(3);
         parser.addArgument("output", "Output filename", cli::STORE, "output",
             "OUTPUT", 1, 1, true)->setDefault("test_create.nitf");
 
         std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
-        // We can't actually compress. This is just for illustration.
-        const bool shouldCompress(options->get<bool>("shouldCompress"));
-        if (shouldCompress)
+        if (options->get<bool>("benchmark"))
         {
-            throw except::Exception(Ctxt("Compression not implemented"));
+            const size_t tileSize = options->get<size_t>("tile");
+            benchmark(types::RowCol<size_t>(options->get<size_t>("rows"),
+                                            options->get<size_t>("cols")),
+                      types::RowCol<size_t>(tileSize, tileSize),
+                      options->get<size_t>("threads"),
+                      options->get<size_t>("inFlight"),
+                      std::max<size_t>(options->get<size_t>("trials"), 1));
+            return 0;
         }
+
+        const bool shouldCompress(options->get<bool>("shouldCompress"));
         const std::string outname(options->get<std::string>("output"));
 
         writeSIDD(outname, shouldCompress);
-        if (testRead(outname))
-        {
-            return 0;
-        }
-        return 1;
+        const bool success = shouldCompress ? testCompressedRead(outname) :
+                                              testRead(outname);
+        return success ? 0 : 1;
     }
 
     catch (const std::exception& ex)
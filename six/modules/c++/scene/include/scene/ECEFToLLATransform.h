@@ -22,6 +22,8 @@
 #ifndef __SCENE_ECEF_TO_LLA_TRANSFORM_H__
 #define __SCENE_ECEF_TO_LLA_TRANSFORM_H__
 
+#include <std/span>
+
 #include "scene/CoordinateTransform.h"
 
 namespace scene
@@ -55,6 +57,31 @@ struct ECEFToLLATransform : public CoordinateTransform
      */
     LatLonAlt transform(const Vector3& ecef) const;
 
+    /**
+     * This function transforms many ECEF coordinates at once.  The
+     * coordinates are given one component per span (structure of arrays),
+     * and all six spans have to be the same size.
+     *
+     * The ellipsoid constants are looked up once for the whole batch, and
+     * every point goes through the same fixed number of Bowring iterations
+     * with no branches, so the loop can be vectorized.  The results agree
+     * with transform() to well under a millimeter for points anywhere near
+     * the Earth's surface.
+     *
+     * @param x     The ECEF X coordinates, in meters
+     * @param y     The ECEF Y coordinates, in meters
+     * @param z     The ECEF Z coordinates, in meters
+     * @param lat   Output latitudes, in degrees
+     * @param lon   Output longitudes, in degrees
+     * @param alt   Output altitudes, in meters
+     */
+    void transform(std::span<const double> x,
+                   std::span<const double> y,
+                   std::span<const double> z,
+                   std::span<double> lat,
+                   std::span<double> lon,
+                   std::span<double> alt) const;
+
 private:
     static double computeLongitude(const Vector3& ecef);
     double computeAltitude(const Vector3& ecef, double latitude) const;
@@ -24,6 +24,7 @@
 
 #include "scene/CoordinateTransform.h"
 #include <sstream>
+#include <std/span>
 
 namespace scene
 {
@@ -55,6 +56,28 @@ struct LLAToECEFTransform : public CoordinateTransform
      * @return      A Vector3
      */
     Vector3 transform(const LatLonAlt& lla) const;
+
+    /**
+     * This function transforms many LatLonAlts at once.  The coordinates
+     * are given one component per span (structure of arrays), and all six
+     * spans have to be the same size.  The ellipsoid constants are looked
+     * up once for the whole batch.
+     *
+     * @param lat   The latitudes, in degrees
+     * @param lon   The longitudes, in degrees
+     * @param alt   The altitudes, in meters
+     * @param x     Output ECEF X coordinates, in meters
+     * @param y     Output ECEF Y coordinates, in meters
+     * @param z     Output ECEF Z coordinates, in meters
+     * @throws except::InvalidFormatException if any coordinate is invalid;
+     *         nothing is written in that case
+     */
+    void transform(std::span<const double> lat,
+                   std::span<const double> lon,
+                   std::span<const double> alt,
+                   std::span<double> x,
+                   std::span<double> y,
+                   std::span<double> z) const;
 private:
 
     double computeRadius(const LatLonAlt& lla) const;
@@ -23,6 +23,7 @@
 #define __SCENE_PROJECTION_MODEL_H__
 
 #include <std/optional>
+#include <std/span>
 
 #include <math/poly/OneD.h>
 #include <math/poly/TwoD.h>
@@ -207,6 +208,53 @@ public:
                          double heightThreshold = 1.0,
                          size_t maxNumIters = 3) const;
 
+    /*!
+     *  Batch version of sceneToImage().  Points are worked through in
+     *  blocks, with TimeCOAPoly, ARPPoly and ARPVelPoly evaluated for a
+     *  whole block at a time with Horner's method, and the blocks are
+     *  split across numThreads threads.
+     *
+     *  A point that fails to converge doesn't stop the others: its image
+     *  point is set to NaNs instead.
+     *
+     *  \param scenePoints Scene (ground) points in 3-space
+     *  \param imageGridPoints [output] The continuous surface image point
+     *  for each scene point.  Must be the same size as scenePoints.
+     *  \param delta Delta values to apply for the adjustable parameters
+     *  \param numThreads Number of threads to use
+     *  \return The number of points that converged
+     */
+    size_t sceneToImage(std::span<const Vector3> scenePoints,
+                        std::span<types::RowCol<double>> imageGridPoints,
+                        const AdjustableParams& delta = AdjustableParams(),
+                        size_t numThreads = 1) const;
+
+    /*!
+     *  Batch version of imageToScene(imageGridPoint, height, ...), worked
+     *  through in blocks like the batch sceneToImage().
+     *
+     *  A point with no solution doesn't stop the others: its scene point
+     *  is set to NaNs instead.
+     *
+     *  \param imageGridPoints Points (meters) in the image surface
+     *  \param heights Surface height (meters) above the WGS-84 reference
+     *  ellipsoid for each image point, or a single height for all of them
+     *  \param scenePoints [output] The scene (ground) point for each image
+     *  point.  Must be the same size as imageGridPoints.
+     *  \param delta Delta values to apply for the adjustable parameters
+     *  \param heightThreshold See imageToScene()
+     *  \param maxNumIters See imageToScene()
+     *  \param numThreads Number of threads to use
+     *  \return The number of points that were projected
+     */
+    size_t imageToScene(std::span<const types::RowCol<double>> imageGridPoints,
+                        std::span<const double> heights,
+                        std::span<Vector3> scenePoints,
+                        const AdjustableParams& delta = AdjustableParams(),
+                        double heightThreshold = 1.0,
+                        size_t maxNumIters = 3,
+                        size_t numThreads = 1) const;
+
     math::linear::MatrixMxN<2, 2> slantToImagePartials(
             const types::RowCol<double>& imageGridPoint,
             double delta = 0.0001) const;
@@ -354,6 +402,19 @@ protected:
                                 Vector3& arpCOA,
                                 Vector3& velCOA) const;
 
+    // Steps 2 through 7 of imageToScene(imageGridPoint, height, ...): from
+    // the (adjusted) R/Rdot contour down to the constant height surface,
+    // starting from the ground plane tangent at the SCP.
+    Vector3 contourToHeightSurface(double r,
+                                   double rDot,
+                                   const Vector3& arpCOA,
+                                   const Vector3& velCOA,
+                                   double height,
+                                   const LatLonAlt& scpLatLon,
+                                   const Vector3& scpNormal,
+                                   double heightThreshold,
+                                   size_t maxNumIters) const;
+
 protected:
     Vector3 mSlantPlaneNormal{};
     Vector3 mImagePlaneNormal{};
@@ -40,6 +40,32 @@ class ProjectionPolynomialFitter
 public:
     static const size_t DEFAULTS_POINTS_1D;
 
+    /*!
+     * \struct AdaptiveSampling
+     * \brief How to grow the sample grid until it's dense enough
+     *
+     * Sampling starts with a minPoints1D x minPoints1D grid (or however
+     * many more points it takes to fit the polynomials).  Each pass
+     * fits polynomials of the given order to the grid's scene coordinates,
+     * then adds a sample between every pair of neighbors (so the grid goes
+     * from N to 2N - 1 points per side and every earlier sample is kept).
+     * If the fit from the previous pass predicts all of the new samples
+     * to within tolerance, the grid is dense enough.  Otherwise it's grown
+     * again, up to maxPoints1D.
+     */
+    struct AdaptiveSampling final
+    {
+        //! Polynomial orders the grid needs to support
+        size_t polyOrderX = 3;
+        size_t polyOrderY = 3;
+
+        //! Largest acceptable error in scene coordinates (meters)
+        double tolerance = 0.01;
+
+        size_t minPoints1D = 5;
+        size_t maxPoints1D = 65;
+    };
+
 
     /* Samples a numPoints1D x numPoints1D grid of points that spans
      * outExtent using sceneToImage().
@@ -55,13 +81,28 @@ public:
      * \param outExtent Output extent in pixels
      * \param numPoints1D Number of points to use in each direction when
      * sampling the grid.  Defaults to 10.
+     * \param numThreads Number of threads to sample the grid with.  The
+     * samples are the same no matter how many threads are used.
+     */
+    ProjectionPolynomialFitter(
+            const ProjectionModel& projModel,
+            const GridECEFTransform& gridTransform,
+            const types::RowCol<double>& outPixelStart,
+            const types::RowCol<size_t>& outExtent,
+            size_t numPoints1D = DEFAULTS_POINTS_1D,
+            size_t numThreads = 1);
+
+    /* Same as above, but the number of points in the grid is picked by
+     * growing it as described by sampling, rather than fixed up front.
+     * getNumPoints1D() gives the final size.
      */
     ProjectionPolynomialFitter(
             const ProjectionModel& projModel,
             const GridECEFTransform& gridTransform,
             const types::RowCol<double>& outPixelStart,
             const types::RowCol<size_t>& outExtent,
-            size_t numPoints1D = DEFAULTS_POINTS_1D);
+            const AdaptiveSampling& sampling,
+            size_t numThreads = 1);
 
     /* Samples a numPoints1D x numPoints1D grid of points that spans
      * the extent of a polygon using sceneToImage().
@@ -80,6 +121,8 @@ public:
      * determine the grid of points.
      * \param numPoints1D Number of points to use in each direction when
      * sampling the grid.  Defaults to 10.
+     * \param numThreads Number of threads to sample the grid with.  The
+     * samples are the same no matter how many threads are used.
      */
     ProjectionPolynomialFitter(
             const ProjectionModel& projModel,
@@ -88,13 +131,20 @@ public:
             const types::RowCol<double>& outPixelStart,
             const types::RowCol<size_t>& outExtent,
             const std::vector<types::RowCol<double> >& polygon,
-            size_t numPoints1D = DEFAULTS_POINTS_1D);
+            size_t numPoints1D = DEFAULTS_POINTS_1D,
+            size_t numThreads = 1);
 
 
     ProjectionPolynomialFitter(const ProjectionPolynomialFitter&) = delete;
     ProjectionPolynomialFitter& operator=(const ProjectionPolynomialFitter&) = delete;
     ProjectionPolynomialFitter& operator=(ProjectionPolynomialFitter&&) = delete;
 
+    // Returns the number of points sampled in each direction
+    size_t getNumPoints1D() const
+    {
+        return mNumPoints1D;
+    }
+
     // Returns the output plane rows used during sampling in case you want to
     // do your own polynomial fitting
     const math::linear::Matrix2D<double>& getOutputPlaneRows() const
@@ -323,12 +373,20 @@ public:
     }
 
 private:
-    void projectToSlantPlane(const ProjectionModel& projModel,
-                             const GridECEFTransform& gridTransform,
-                             const types::RowCol<double>& outPixelStart,
-                             const types::RowCol<double>& currentOffset,
-                             size_t row,
-                             size_t col);
+    // Projects the output plane pixel at each offset into the slant plane,
+    // filling in the samples.  With skipEvenSamples, samples at even rows
+    // and even columns are left as they are.
+    void projectToSlantPlane(
+            const ProjectionModel& projModel,
+            const GridECEFTransform& gridTransform,
+            const types::RowCol<double>& outPixelStart,
+            const math::linear::Matrix2D<types::RowCol<double> >& offsets,
+            size_t numThreads,
+            bool skipEvenSamples = false);
+
+    // Grows the grid from N to 2N - 1 points in each direction, moving the
+    // current samples to the even rows and columns
+    void expandSamples();
 
     void getSlantPlaneSamples(
             const types::RowCol<size_t>& inPixelStart,
@@ -339,7 +397,7 @@ private:
             math::linear::Matrix2D<double>& slantPlaneCols) const;
 
 private:
-    const size_t mNumPoints1D;
+    size_t mNumPoints1D;
     math::linear::Matrix2D<double> mOutputPlaneRows;
     math::linear::Matrix2D<double> mOutputPlaneCols;
     math::linear::Matrix2D<types::RowCol<double> > mSceneCoordinates;
@@ -22,6 +22,8 @@
 #ifndef __SCENE_UTILITIES_H__
 #define __SCENE_UTILITIES_H__
 
+#include <std/span>
+
 #include "scene/Types.h"
 
 namespace scene
@@ -53,6 +55,33 @@ struct Utilities
     static LatLonAlt ecefToLatLon(Vector3 vec);
     static LatLonAlt ecefToLatLon(const GeographicGridECEFTransform&, size_t row, size_t col);
 
+    /*!
+     *  Batch versions of the above, on the WGS84 ellipsoid.  Each component
+     *  has its own span (structure of arrays) and all of the spans have to
+     *  be the same size.  Lat/lon are in degrees; see
+     *  LLAToECEFTransform::transform() and ECEFToLLATransform::transform().
+     */
+    static void latLonToECEF(std::span<const double> lat,
+                             std::span<const double> lon,
+                             std::span<const double> alt,
+                             std::span<double> x,
+                             std::span<double> y,
+                             std::span<double> z);
+    static void ecefToLatLon(std::span<const double> x,
+                             std::span<const double> y,
+                             std::span<const double> z,
+                             std::span<double> lat,
+                             std::span<double> lon,
+                             std::span<double> alt);
+
+    /*!
+     *  As above, for points that are already Vector3s; they're split into
+     *  components on the way in and gathered back up on the way out.
+     *  ecef and latLons have to be the same size.
+     */
+    static void ecefToLatLon(std::span<const Vector3> ecef,
+                             std::span<LatLonAlt> latLons);
+
     /*!
      *  Remaps angles into [0:360]
      *
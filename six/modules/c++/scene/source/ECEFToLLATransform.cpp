@@ -22,6 +22,13 @@
 #include "scene/ECEFToLLATransform.h"
 #include <math/Utilities.h>
 
+namespace
+{
+// Bowring's method converges cubically; two passes from the initial
+// reduced latitude are good to far below a millimeter near the Earth.
+constexpr size_t BATCH_ITERATIONS = 2;
+}
+
 scene::ECEFToLLATransform::ECEFToLLATransform(const EllipsoidModel *initVals)
  : CoordinateTransform(initVals)
 {
@@ -69,6 +76,66 @@ scene::ECEFToLLATransform::transform(const Vector3& ecef) const
    return lla;
 }
 
+void scene::ECEFToLLATransform::transform(std::span<const double> x,
+                                          std::span<const double> y,
+                                          std::span<const double> z,
+                                          std::span<double> lat,
+                                          std::span<double> lon,
+                                          std::span<double> alt) const
+{
+    const size_t size = x.size();
+    if (y.size() != size || z.size() != size || lat.size() != size ||
+        lon.size() != size || alt.size() != size)
+    {
+        throw except::Exception(Ctxt(
+                "ECEF and lat/lon/alt spans must all be the same size"));
+    }
+
+    // Everything that only depends on the ellipsoid, up front
+    const double r = model->getEquatorialRadius();
+    const double oneMinusF = 1.0 - model->calculateFlattening();
+    const double e_squared = 1.0 - math::square(oneMinusF);
+    const double e_squared_r = e_squared * r;
+    const double ep_squared_b = e_squared * oneMinusF / (1.0 - e_squared) * r;
+
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        const double s = std::sqrt(x[ii] * x[ii] + y[ii] * y[ii]);
+
+        // Latitudes are carried as unnormalized (cos, sin) pairs so there's
+        // no trig (or division by zero at the poles) until the end.
+        double cosReduced = oneMinusF * s;
+        double sinReduced = z[ii];
+        double numerator = 0.0;
+        double denominator = 0.0;
+        for (size_t iteration = 0; iteration < BATCH_ITERATIONS; ++iteration)
+        {
+            const double norm = 1.0 / std::sqrt(cosReduced * cosReduced +
+                                                sinReduced * sinReduced);
+            const double cosBeta = cosReduced * norm;
+            const double sinBeta = sinReduced * norm;
+            numerator = z[ii] + ep_squared_b * sinBeta * sinBeta * sinBeta;
+            denominator = s - e_squared_r * cosBeta * cosBeta * cosBeta;
+            cosReduced = denominator;
+            sinReduced = oneMinusF * numerator;
+        }
+
+        const double norm = 1.0 / std::sqrt(numerator * numerator +
+                                            denominator * denominator);
+        const double sin_latitude = numerator * norm;
+        const double cos_latitude = denominator * norm;
+        const double radius_curvature =
+                r / std::sqrt(1.0 - e_squared * sin_latitude * sin_latitude);
+
+        lat[ii] = std::atan2(numerator, denominator) *
+                math::Constants::RADIANS_TO_DEGREES;
+        lon[ii] = std::atan2(y[ii], x[ii]) *
+                math::Constants::RADIANS_TO_DEGREES;
+        alt[ii] = (e_squared * radius_curvature * sin_latitude + z[ii]) *
+                sin_latitude + s * cos_latitude - radius_curvature;
+    }
+}
+
 double scene::ECEFToLLATransform::computeLongitude(const Vector3& ecef)
 {
     double longitude = 0;
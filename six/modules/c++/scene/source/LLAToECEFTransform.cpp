@@ -75,6 +75,57 @@ scene::Vector3 scene::LLAToECEFTransform::transform(const LatLonAlt& lla) const
     return ecef;
 }
 
+void scene::LLAToECEFTransform::transform(std::span<const double> lat,
+                                          std::span<const double> lon,
+                                          std::span<const double> alt,
+                                          std::span<double> x,
+                                          std::span<double> y,
+                                          std::span<double> z) const
+{
+    const size_t size = lat.size();
+    if (lon.size() != size || alt.size() != size || x.size() != size ||
+        y.size() != size || z.size() != size)
+    {
+        throw except::Exception(Ctxt(
+                "Lat/lon/alt and ECEF spans must all be the same size"));
+    }
+
+    // Check everything first so the conversion loop has no branches
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        if (!(std::abs(lat[ii]) <= 90.0) || !(std::abs(lon[ii]) <= 180.0))
+        {
+            std::ostringstream str;
+            str << "Invalid lla coordinate " << ii << ": lat=" << lat[ii]
+                << ", lon=" << lon[ii] << ", alt=" << alt[ii];
+            throw except::InvalidFormatException(str.str());
+        }
+    }
+
+    const double r = model->getEquatorialRadius();
+    const double e_squared =
+            1.0 - math::square(1.0 - model->calculateFlattening());
+
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        double sinlat, coslat;
+        math::SinCos(lat[ii] * math::Constants::DEGREES_TO_RADIANS,
+                     sinlat, coslat);
+        double sinlon, coslon;
+        math::SinCos(lon[ii] * math::Constants::DEGREES_TO_RADIANS,
+                     sinlon, coslon);
+
+        // Prime vertical radius of curvature
+        const double radius =
+                r / std::sqrt(1.0 - e_squared * sinlat * sinlat);
+        const double horizontal = (radius + alt[ii]) * coslat;
+
+        x[ii] = horizontal * coslon;
+        y[ii] = horizontal * sinlon;
+        z[ii] = (radius * (1.0 - e_squared) + alt[ii]) * sinlat;
+    }
+}
+
 double scene::LLAToECEFTransform::computeRadius(const LatLonAlt& lla) const
 {
     const double f = model->calculateFlattening();
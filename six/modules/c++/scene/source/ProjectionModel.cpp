@@ -22,10 +22,15 @@
 #include "scene/ProjectionModel.h"
 
 #include <assert.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include <math/Utilities.h>
+#include <mt/Runnable1D.h>
 #include "scene/ECEFToLLATransform.h"
 #include "scene/Utilities.h"
 
@@ -57,6 +62,105 @@ scene::Vector3 computeUnitVector(const scene::LatLonAlt& latLon)
     return unitVector;
 }
 
+// Points the batch projections work through at a time
+constexpr size_t BLOCK_SIZE = 256;
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+scene::Vector3 nanVector()
+{
+    scene::Vector3 vector;
+    vector[0] = vector[1] = vector[2] = NaN;
+    return vector;
+}
+
+// The polynomials every projection starts with, with their coefficients
+// pulled out once so a block of points can be run through them together
+// with Horner's method
+class BlockPolynomials final
+{
+public:
+    BlockPolynomials(const math::poly::TwoD<double>& timeCOAPoly,
+                     const math::poly::OneD<scene::Vector3>& arpPoly,
+                     const math::poly::OneD<scene::Vector3>& arpVelPoly) :
+        mTimeCOAOrderY(timeCOAPoly.orderY())
+    {
+        for (size_t ii = 0; ii <= timeCOAPoly.orderX(); ++ii)
+        {
+            for (size_t jj = 0; jj <= mTimeCOAOrderY; ++jj)
+            {
+                mTimeCOA.push_back(timeCOAPoly[ii][jj]);
+            }
+        }
+        for (size_t dim = 0; dim < 3; ++dim)
+        {
+            for (size_t ii = 0; ii < arpPoly.size(); ++ii)
+            {
+                mARP[dim].push_back(arpPoly[ii][dim]);
+            }
+            for (size_t ii = 0; ii < arpVelPoly.size(); ++ii)
+            {
+                mARPVel[dim].push_back(arpVelPoly[ii][dim]);
+            }
+        }
+    }
+
+    void operator()(const types::RowCol<double>* imageGridPoints,
+                    size_t size,
+                    double* timeCOA,
+                    scene::Vector3* arpCOA,
+                    scene::Vector3* velCOA) const
+    {
+        const size_t strideX = mTimeCOAOrderY + 1;
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            const double row = imageGridPoints[ii].row;
+            const double col = imageGridPoints[ii].col;
+            double time = 0.0;
+            for (size_t xx = mTimeCOA.size(); xx > 0; xx -= strideX)
+            {
+                const double* const coef = &mTimeCOA[xx - strideX];
+                double term = 0.0;
+                for (size_t yy = strideX; yy > 0; --yy)
+                {
+                    term = term * col + coef[yy - 1];
+                }
+                time = time * row + term;
+            }
+            timeCOA[ii] = time;
+        }
+
+        for (size_t dim = 0; dim < 3; ++dim)
+        {
+            evaluate(mARP[dim], timeCOA, size, arpCOA, dim);
+            evaluate(mARPVel[dim], timeCOA, size, velCOA, dim);
+        }
+    }
+
+private:
+    static void evaluate(const std::vector<double>& coef,
+                         const double* at,
+                         size_t size,
+                         scene::Vector3* values,
+                         size_t dim)
+    {
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            double value = 0.0;
+            for (size_t cc = coef.size(); cc > 0; --cc)
+            {
+                value = value * at[ii] + coef[cc - 1];
+            }
+            values[ii][dim] = value;
+        }
+    }
+
+    const size_t mTimeCOAOrderY;
+    std::vector<double> mTimeCOA;
+    std::array<std::vector<double>, 3> mARP;
+    std::array<std::vector<double>, 3> mARPVel;
+};
+
 template<typename PolyType>
 PolyType verboseDerivative(const PolyType& polynomial, const std::string& name)
 {
@@ -280,10 +384,7 @@ Vector3 ProjectionModel::imageToScene(
     //    section 5.1 for details)
     const ECEFToLLATransform ecefToLatLon;
     const LatLonAlt scpLatLon = ecefToLatLon.transform(mSCP);
-    Vector3 groundPlaneNormal = computeUnitVector(scpLatLon);
-
-    Vector3 groundRefPoint =
-            mSCP + (height - scpLatLon.getAlt()) * groundPlaneNormal;
+    const Vector3 scpNormal = computeUnitVector(scpLatLon);
 
     // Compute contour just once
     const double timeCOA = mTimeCOAPoly(imageGridPoint.row,
@@ -297,6 +398,26 @@ Vector3 ProjectionModel::imageToScene(
     // Adjustable parameters do not affect Rdot
     imageToSceneAdjustment(delta, timeCOA, r, arpCOA, velCOA);
 
+    return contourToHeightSurface(r, rDot, arpCOA, velCOA, height,
+                                  scpLatLon, scpNormal,
+                                  heightThreshold, maxNumIters);
+}
+
+Vector3 ProjectionModel::contourToHeightSurface(double r,
+                                                double rDot,
+                                                const Vector3& arpCOA,
+                                                const Vector3& velCOA,
+                                                double height,
+                                                const LatLonAlt& scpLatLon,
+                                                const Vector3& scpNormal,
+                                                double heightThreshold,
+                                                size_t maxNumIters) const
+{
+    const ECEFToLLATransform ecefToLatLon;
+    Vector3 groundPlaneNormal = scpNormal;
+    Vector3 groundRefPoint =
+            mSCP + (height - scpLatLon.getAlt()) * groundPlaneNormal;
+
     Vector3 gppECEF{};
     Vector3 uUP{};
     double deltaHeight(std::numeric_limits<double>::max());
@@ -362,6 +483,187 @@ Vector3 ProjectionModel::imageToScene(
     return scene::Utilities::latLonToECEF(SPP);
 }
 
+size_t ProjectionModel::sceneToImage(
+        std::span<const Vector3> scenePoints,
+        std::span<types::RowCol<double>> imageGridPoints,
+        const AdjustableParams& delta,
+        size_t numThreads) const
+{
+    if (imageGridPoints.size() != scenePoints.size())
+    {
+        throw except::Exception(Ctxt(
+                "Expected " + std::to_string(scenePoints.size()) +
+                " image grid points but got " +
+                std::to_string(imageGridPoints.size())));
+    }
+
+    const BlockPolynomials polynomials(mTimeCOAPoly, mARPPoly, mARPVelPoly);
+    const size_t numBlocks = (scenePoints.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::atomic<size_t> numConverged(0);
+    mt::run1D(numBlocks, numThreads, [&](size_t block)
+    {
+        const size_t begin = block * BLOCK_SIZE;
+        const size_t size = std::min(BLOCK_SIZE, scenePoints.size() - begin);
+
+        // Same as sceneToImage(), but every point still converging takes
+        // each iteration together
+        std::array<Vector3, BLOCK_SIZE> groundPlanePoints;
+        std::array<size_t, BLOCK_SIZE> active;
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            groundPlanePoints[ii] = scenePoints[begin + ii];
+            active[ii] = ii;
+        }
+
+        std::array<types::RowCol<double>, BLOCK_SIZE> guesses;
+        std::array<double, BLOCK_SIZE> timeCOA;
+        std::array<Vector3, BLOCK_SIZE> arpCOA;
+        std::array<Vector3, BLOCK_SIZE> velCOA;
+        size_t numActive = size;
+        size_t converged = 0;
+        for (size_t iter = 0; iter < MAX_ITER && numActive > 0; ++iter)
+        {
+            for (size_t jj = 0; jj < numActive; ++jj)
+            {
+                const Vector3& groundPlanePoint = groundPlanePoints[active[jj]];
+                const double dist = (mSCP - groundPlanePoint).dot(
+                        mImagePlaneNormal) * mScaleFactor;
+                guesses[jj] = computeImageCoordinates(
+                        groundPlanePoint + mSlantPlaneNormal * dist);
+            }
+            polynomials(guesses.data(), numActive, timeCOA.data(),
+                        arpCOA.data(), velCOA.data());
+
+            size_t stillActive = 0;
+            for (size_t jj = 0; jj < numActive; ++jj)
+            {
+                const size_t ii = active[jj];
+                const Vector3& scenePoint = scenePoints[begin + ii];
+                double r, rDot;
+                computeContour(arpCOA[jj], velCOA[jj], timeCOA[jj],
+                               guesses[jj], &r, &rDot);
+                imageToSceneAdjustment(delta, timeCOA[jj], r,
+                                       arpCOA[jj], velCOA[jj]);
+
+                Vector3 groundPlaneNormal(scenePoint);
+                groundPlaneNormal.normalize();
+                Vector3 diff;
+                try
+                {
+                    diff = scenePoint - contourToGroundPlane(
+                            r, rDot, arpCOA[jj], velCOA[jj],
+                            groundPlaneNormal, scenePoint);
+                }
+                catch (const except::Exception&)
+                {
+                    imageGridPoints[begin + ii] =
+                            types::RowCol<double>(NaN, NaN);
+                    continue;
+                }
+
+                if (diff.norm() < DELTA_GP_MAX)
+                {
+                    imageGridPoints[begin + ii] = guesses[jj];
+                    ++converged;
+                }
+                else
+                {
+                    groundPlanePoints[ii] += diff;
+                    active[stillActive++] = ii;
+                }
+            }
+            numActive = stillActive;
+        }
+
+        for (size_t jj = 0; jj < numActive; ++jj)
+        {
+            imageGridPoints[begin + active[jj]] =
+                    types::RowCol<double>(NaN, NaN);
+        }
+        numConverged += converged;
+    });
+    return numConverged;
+}
+
+size_t ProjectionModel::imageToScene(
+        std::span<const types::RowCol<double>> imageGridPoints,
+        std::span<const double> heights,
+        std::span<Vector3> scenePoints,
+        const AdjustableParams& delta,
+        double heightThreshold,
+        size_t maxNumIters,
+        size_t numThreads) const
+{
+    if (scenePoints.size() != imageGridPoints.size())
+    {
+        throw except::Exception(Ctxt(
+                "Expected " + std::to_string(imageGridPoints.size()) +
+                " scene points but got " +
+                std::to_string(scenePoints.size())));
+    }
+    if (heights.size() != imageGridPoints.size() && heights.size() != 1)
+    {
+        throw except::Exception(Ctxt(
+                "Expected 1 or " + std::to_string(imageGridPoints.size()) +
+                " heights but got " + std::to_string(heights.size())));
+    }
+    if (heightThreshold <= 0)
+    {
+        throw except::Exception(Ctxt("Height threshold must be positive"));
+    }
+    if (maxNumIters < 1)
+    {
+        throw except::Exception(Ctxt(
+                "Max number of iterations must be positive"));
+    }
+
+    const LatLonAlt scpLatLon = ECEFToLLATransform().transform(mSCP);
+    const Vector3 scpNormal = computeUnitVector(scpLatLon);
+
+    const BlockPolynomials polynomials(mTimeCOAPoly, mARPPoly, mARPVelPoly);
+    const size_t numBlocks =
+            (imageGridPoints.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::atomic<size_t> numProjected(0);
+    mt::run1D(numBlocks, numThreads, [&](size_t block)
+    {
+        const size_t begin = block * BLOCK_SIZE;
+        const size_t size =
+                std::min(BLOCK_SIZE, imageGridPoints.size() - begin);
+
+        std::array<double, BLOCK_SIZE> timeCOA;
+        std::array<Vector3, BLOCK_SIZE> arpCOA;
+        std::array<Vector3, BLOCK_SIZE> velCOA;
+        polynomials(&imageGridPoints[begin], size, timeCOA.data(),
+                    arpCOA.data(), velCOA.data());
+
+        size_t projected = 0;
+        for (size_t jj = 0; jj < size; ++jj)
+        {
+            const size_t ii = begin + jj;
+            double r, rDot;
+            computeContour(arpCOA[jj], velCOA[jj], timeCOA[jj],
+                           imageGridPoints[ii], &r, &rDot);
+            imageToSceneAdjustment(delta, timeCOA[jj], r,
+                                   arpCOA[jj], velCOA[jj]);
+            try
+            {
+                const double height =
+                        heights.size() == 1 ? heights[0] : heights[ii];
+                scenePoints[ii] = contourToHeightSurface(
+                        r, rDot, arpCOA[jj], velCOA[jj], height,
+                        scpLatLon, scpNormal, heightThreshold, maxNumIters);
+                ++projected;
+            }
+            catch (const except::Exception&)
+            {
+                scenePoints[ii] = nanVector();
+            }
+        }
+        numProjected += projected;
+    });
+    return numProjected;
+}
+
 void ProjectionModel::imageToSceneAdjustment(const AdjustableParams& delta,
                                              double timeCOA,
                                              double& r,
@@ -20,10 +20,14 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include <gsl/gsl.h>
 
 #include <scene/ProjectionPolynomialFitter.h>
 #include <polygon/PolygonMask.h>
+#include <mt/Runnable1D.h>
 
 #undef min
 #undef max
@@ -47,6 +51,29 @@ struct Shift final
 private:
     const double mShift;
 };
+
+// Evenly spaced points spanning [outPixelStart, outPixelStart + outExtent).
+// Each one is computed from its index rather than accumulated so that a
+// grid with 2N - 1 points per side lands exactly on this one's points.
+void getGridOffsets(const types::RowCol<double>& outPixelStart,
+                    const types::RowCol<size_t>& outExtent,
+                    math::linear::Matrix2D<types::RowCol<double> >& offsets)
+{
+    const size_t numPoints1D = offsets.rows();
+    const types::RowCol<double> skip(
+        static_cast<double>(outExtent.row - 1) / static_cast<double>(numPoints1D - 1),
+        static_cast<double>(outExtent.col - 1) / static_cast<double>(numPoints1D - 1));
+
+    for (size_t ii = 0; ii < numPoints1D; ++ii)
+    {
+        for (size_t jj = 0; jj < numPoints1D; ++jj)
+        {
+            offsets(ii, jj) = types::RowCol<double>(
+                    outPixelStart.row + static_cast<double>(ii) * skip.row,
+                    outPixelStart.col + static_cast<double>(jj) * skip.col);
+        }
+    }
+}
 }
 
 namespace scene
@@ -58,7 +85,8 @@ ProjectionPolynomialFitter::ProjectionPolynomialFitter(
     const GridECEFTransform& gridTransform,
     const types::RowCol<double>& outPixelStart,
     const types::RowCol<size_t>& outExtent,
-    size_t numPoints1D) :
+    size_t numPoints1D,
+    size_t numThreads) :
     mNumPoints1D(numPoints1D),
     mOutputPlaneRows(numPoints1D, numPoints1D),
     mOutputPlaneCols(numPoints1D, numPoints1D),
@@ -67,29 +95,79 @@ ProjectionPolynomialFitter::ProjectionPolynomialFitter(
                       types::RowCol<double>(0.0, 0.0)),
     mTimeCOA(numPoints1D, numPoints1D)
 {
-    // Want to sample [outPixelStart, outPixelStart + outExtent) in the loop
-    // below.  That is, we are marching through the portion of interest of the
-    // output grid in pixel space.  In the case of multi-segment SICDs, we'll
-    // only sample our part of the grid defined by outPixelStart and
-    // outExtent.
-    const types::RowCol<double> skip(
-        static_cast<double>(outExtent.row - 1) / static_cast<double>(mNumPoints1D - 1),
-        static_cast<double>(outExtent.col - 1) / static_cast<double>(mNumPoints1D - 1));
-
-    types::RowCol<double> currentOffset(outPixelStart);
+    // Want to sample [outPixelStart, outPixelStart + outExtent).  That is,
+    // we are marching through the portion of interest of the output grid in
+    // pixel space.  In the case of multi-segment SICDs, we'll only sample
+    // our part of the grid defined by outPixelStart and outExtent.
+    math::linear::Matrix2D<types::RowCol<double> > offsets(
+            mNumPoints1D, mNumPoints1D, types::RowCol<double>(0.0, 0.0));
+    getGridOffsets(outPixelStart, outExtent, offsets);
+    projectToSlantPlane(projModel, gridTransform, outPixelStart, offsets,
+                        numThreads);
+}
 
-    for (size_t ii = 0;
-         ii < mNumPoints1D;
-         ++ii, currentOffset.row += skip.row)
+ProjectionPolynomialFitter::ProjectionPolynomialFitter(
+    const ProjectionModel& projModel,
+    const GridECEFTransform& gridTransform,
+    const types::RowCol<double>& outPixelStart,
+    const types::RowCol<size_t>& outExtent,
+    const AdaptiveSampling& sampling,
+    size_t numThreads) :
+    ProjectionPolynomialFitter(projModel, gridTransform, outPixelStart,
+                               outExtent,
+                               std::max({sampling.minPoints1D,
+                                         sampling.polyOrderX + 1,
+                                         sampling.polyOrderY + 1,
+                                         static_cast<size_t>(2)}),
+                               numThreads)
+{
+    while (2 * mNumPoints1D - 1 <= sampling.maxPoints1D)
     {
-        currentOffset.col = outPixelStart.col;
-
-        for (size_t jj = 0;
-             jj < mNumPoints1D;
-             ++jj, currentOffset.col += skip.col)
+        // Fit the samples we have...
+        math::linear::Matrix2D<double> sceneRows(mNumPoints1D, mNumPoints1D);
+        math::linear::Matrix2D<double> sceneCols(mNumPoints1D, mNumPoints1D);
+        for (size_t ii = 0; ii < mNumPoints1D; ++ii)
         {
-            projectToSlantPlane(projModel, gridTransform, outPixelStart,
-                                currentOffset, ii, jj);
+            for (size_t jj = 0; jj < mNumPoints1D; ++jj)
+            {
+                sceneRows(ii, jj) = mSceneCoordinates(ii, jj).row;
+                sceneCols(ii, jj) = mSceneCoordinates(ii, jj).col;
+            }
+        }
+        const math::poly::TwoD<double> rowPoly = math::poly::fit(
+                mOutputPlaneRows, mOutputPlaneCols, sceneRows,
+                sampling.polyOrderX, sampling.polyOrderY);
+        const math::poly::TwoD<double> colPoly = math::poly::fit(
+                mOutputPlaneRows, mOutputPlaneCols, sceneCols,
+                sampling.polyOrderX, sampling.polyOrderY);
+
+        // ...sample halfway between each of them...
+        expandSamples();
+        math::linear::Matrix2D<types::RowCol<double> > offsets(
+                mNumPoints1D, mNumPoints1D, types::RowCol<double>(0.0, 0.0));
+        getGridOffsets(outPixelStart, outExtent, offsets);
+        projectToSlantPlane(projModel, gridTransform, outPixelStart, offsets,
+                            numThreads, true);
+
+        // ...and stop once the fit already predicted the new ones
+        double maxError(0.0);
+        for (size_t ii = 0; ii < mNumPoints1D; ++ii)
+        {
+            for (size_t jj = (ii % 2 == 0) ? 1 : 0; jj < mNumPoints1D;
+                 jj += (ii % 2 == 0) ? 2 : 1)
+            {
+                const double row(mOutputPlaneRows(ii, jj));
+                const double col(mOutputPlaneCols(ii, jj));
+                const types::RowCol<double>& sceneCoord =
+                        mSceneCoordinates(ii, jj);
+                maxError = std::max(maxError, std::max(
+                        std::abs(sceneCoord.row - rowPoly(row, col)),
+                        std::abs(sceneCoord.col - colPoly(row, col))));
+            }
+        }
+        if (maxError <= sampling.tolerance)
+        {
+            break;
         }
     }
 }
@@ -101,7 +179,8 @@ ProjectionPolynomialFitter::ProjectionPolynomialFitter(
         const types::RowCol<double>& outPixelStart,
         const types::RowCol<size_t>& /*outExtent*/,
         const std::vector<types::RowCol<double> >& polygon,
-        size_t numPoints1D) :
+        size_t numPoints1D,
+        size_t numThreads) :
     mNumPoints1D(numPoints1D),
     mOutputPlaneRows(numPoints1D, numPoints1D),
     mOutputPlaneCols(numPoints1D, numPoints1D),
@@ -194,6 +273,8 @@ ProjectionPolynomialFitter::ProjectionPolynomialFitter(
          static_cast<double>(newExtentRow - 1) / 
          static_cast<double>(numPoints1D - 1);
 
+    math::linear::Matrix2D<types::RowCol<double> > offsets(
+            numPoints1D, numPoints1D, types::RowCol<double>(0.0, 0.0));
     double currentOffsetRow = static_cast<double>(newStartRow);
     for (size_t ii = 0; ii < numPoints1D; ++ii, currentOffsetRow += newDeltaRow)
     {
@@ -220,34 +301,76 @@ ProjectionPolynomialFitter::ProjectionPolynomialFitter(
         double currentCol = static_cast<double>(colRange.mStartElement);
         for (size_t jj = 0; jj < numPoints1D; ++jj, currentCol += newDeltaCol)
         {
-            const types::RowCol<double> currentOffset(currentRow, currentCol);
-            projectToSlantPlane(projModel, gridTransform, outPixelStart,
-                currentOffset, ii, jj);
+            offsets(ii, jj) = types::RowCol<double>(currentRow, currentCol);
         }
     }
+
+    projectToSlantPlane(projModel, gridTransform, outPixelStart, offsets,
+                        numThreads);
 }
 
 void ProjectionPolynomialFitter::projectToSlantPlane(
     const ProjectionModel& projModel,
     const GridECEFTransform& gridTransform,
     const types::RowCol<double>& outPixelStart,
-    const types::RowCol<double>& currentOffset,
-    size_t row,
-    size_t col)
+    const math::linear::Matrix2D<types::RowCol<double> >& offsets,
+    size_t numThreads,
+    bool skipEvenSamples)
+{
+    // Every sample is independent, so rows can go to any thread and the
+    // results don't depend on how many there are
+    mt::run1D(mNumPoints1D, numThreads, [&](size_t row)
+    {
+        for (size_t col = 0; col < mNumPoints1D; ++col)
+        {
+            if (skipEvenSamples && row % 2 == 0 && col % 2 == 0)
+            {
+                continue;
+            }
+            const types::RowCol<double>& currentOffset = offsets(row, col);
+
+            // Get the coordinate relative to the outPixelStart.
+            mOutputPlaneRows(row, col) = currentOffset.row - outPixelStart.row;
+            mOutputPlaneCols(row, col) = currentOffset.col - outPixelStart.col;
+
+            // Find ECEF of the output plane pixel.
+            const scene::Vector3 ecef =
+                gridTransform.rowColToECEF(currentOffset);
+
+            // Project ECEF coordinate into the slant plane and get meters
+            // from the slant plane scene center point.
+            double timeCOA(0.0);
+            mSceneCoordinates(row, col) =
+                projModel.sceneToImage(ecef, &timeCOA);
+            mTimeCOA(row, col) = timeCOA;
+        }
+    });
+}
+
+void ProjectionPolynomialFitter::expandSamples()
 {
-    // Get the coordinate relative to the outPixelStart.
-    mOutputPlaneRows(row, col) = currentOffset.row - outPixelStart.row;
-    mOutputPlaneCols(row, col) = currentOffset.col - outPixelStart.col;
-
-    // Find ECEF of the output plane pixel.
-    const scene::Vector3 ecef =
-        gridTransform.rowColToECEF(currentOffset);
-
-    // Project ECEF coordinate into the slant plane and get meters from
-    // the slant plane scene center point.
-    double timeCOA(0.0);
-    mSceneCoordinates(row, col) = projModel.sceneToImage(ecef, &timeCOA);
-    mTimeCOA(row, col) = timeCOA;
+    const size_t numPoints1D = 2 * mNumPoints1D - 1;
+    math::linear::Matrix2D<double> outputPlaneRows(numPoints1D, numPoints1D);
+    math::linear::Matrix2D<double> outputPlaneCols(numPoints1D, numPoints1D);
+    math::linear::Matrix2D<types::RowCol<double> > sceneCoordinates(
+            numPoints1D, numPoints1D, types::RowCol<double>(0.0, 0.0));
+    math::linear::Matrix2D<double> timeCOA(numPoints1D, numPoints1D);
+    for (size_t ii = 0; ii < mNumPoints1D; ++ii)
+    {
+        for (size_t jj = 0; jj < mNumPoints1D; ++jj)
+        {
+            outputPlaneRows(2 * ii, 2 * jj) = mOutputPlaneRows(ii, jj);
+            outputPlaneCols(2 * ii, 2 * jj) = mOutputPlaneCols(ii, jj);
+            sceneCoordinates(2 * ii, 2 * jj) = mSceneCoordinates(ii, jj);
+            timeCOA(2 * ii, 2 * jj) = mTimeCOA(ii, jj);
+        }
+    }
+
+    mNumPoints1D = numPoints1D;
+    mOutputPlaneRows = outputPlaneRows;
+    mOutputPlaneCols = outputPlaneCols;
+    mSceneCoordinates = sceneCoordinates;
+    mTimeCOA = timeCOA;
 }
 
 void ProjectionPolynomialFitter::getSlantPlaneSamples(
@@ -22,6 +22,7 @@
 #include <scene/Utilities.h>
 
 #include <string>
+#include <vector>
 
 #include <scene/sys_Conf.h>
 #include <except/Exception.h>
@@ -57,6 +58,65 @@ LatLonAlt Utilities::ecefToLatLon(const GeographicGridECEFTransform& gridTransfo
         gridTransform.rowColToECEF(static_cast<double>(row), static_cast<double>(col)));
 }
 
+void Utilities::latLonToECEF(std::span<const double> lat,
+                             std::span<const double> lon,
+                             std::span<const double> alt,
+                             std::span<double> x,
+                             std::span<double> y,
+                             std::span<double> z)
+{
+    scene::LLAToECEFTransform toECEF;
+    toECEF.transform(lat, lon, alt, x, y, z);
+}
+
+void Utilities::ecefToLatLon(std::span<const double> x,
+                             std::span<const double> y,
+                             std::span<const double> z,
+                             std::span<double> lat,
+                             std::span<double> lon,
+                             std::span<double> alt)
+{
+    scene::ECEFToLLATransform toLLA;
+    toLLA.transform(x, y, z, lat, lon, alt);
+}
+
+void Utilities::ecefToLatLon(std::span<const Vector3> ecef,
+                             std::span<LatLonAlt> latLons)
+{
+    if (ecef.size() != latLons.size())
+    {
+        throw except::Exception(Ctxt(
+                "Expected " + std::to_string(ecef.size()) +
+                " lat/lons but got " + std::to_string(latLons.size())));
+    }
+
+    const size_t size = ecef.size();
+    std::vector<double> components(size * 6);
+    double* const x = components.data();
+    double* const y = x + size;
+    double* const z = y + size;
+    double* const lat = z + size;
+    double* const lon = lat + size;
+    double* const alt = lon + size;
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        x[ii] = ecef[ii][0];
+        y[ii] = ecef[ii][1];
+        z[ii] = ecef[ii][2];
+    }
+
+    ecefToLatLon(std::span<const double>(x, size),
+                 std::span<const double>(y, size),
+                 std::span<const double>(z, size),
+                 std::span<double>(lat, size),
+                 std::span<double>(lon, size),
+                 std::span<double>(alt, size));
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        latLons[ii] = LatLonAlt(lat[ii], lon[ii], alt[ii]);
+    }
+}
+
 double Utilities::remapZeroTo360(double degree)
 {
     double delta = degree;
@@ -0,0 +1,162 @@
+/* =========================================================================
+ * This file is part of scene-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * scene-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <cli/ArgumentParser.h>
+#include <scene/ECEFToLLATransform.h>
+#include <scene/LLAToECEFTransform.h>
+
+/*!
+ * Times converting points between ECEF and lat/lon/alt one at a time and
+ * through the batch (structure of arrays) transforms, and reports how far
+ * apart the two answers are.
+ */
+namespace
+{
+double elapsedSince(std::chrono::steady_clock::time_point start)
+{
+    const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+template <typename T>
+std::span<T> span(std::vector<T>& values)
+{
+    return std::span<T>(values.data(), values.size());
+}
+template <typename T>
+std::span<const T> cspan(const std::vector<T>& values)
+{
+    return std::span<const T>(values.data(), values.size());
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        // Parse the command line
+        cli::ArgumentParser parser;
+        parser.setDescription(
+                "Time scalar and batch ECEF <-> lat/lon/alt conversion.");
+        parser.addArgument("-n --points", "Number of points to convert",
+                           cli::STORE, "points", "NUM")->setDefault(1000000);
+        const std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+        const size_t size = std::max<size_t>(options->get<size_t>("points"), 2);
+
+        std::vector<double> lat(size), lon(size), alt(size);
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            lat[ii] = -89.0 + 178.0 * ii / (size - 1);
+            lon[ii] = -179.0 + std::fmod(ii * 0.37, 358.0);
+            alt[ii] = std::fmod(ii * 0.79, 10000.0);
+        }
+
+        const scene::LLAToECEFTransform toECEF;
+        const scene::ECEFToLLATransform toLLA;
+
+        // LLA -> ECEF
+        std::vector<scene::Vector3> ecef(size);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            ecef[ii] = toECEF.transform(
+                    scene::LatLonAlt(lat[ii], lon[ii], alt[ii]));
+        }
+        const double scalarToECEF = elapsedSince(start);
+
+        std::vector<double> x(size), y(size), z(size);
+        start = std::chrono::steady_clock::now();
+        toECEF.transform(cspan(lat), cspan(lon), cspan(alt),
+                         span(x), span(y), span(z));
+        const double batchToECEF = elapsedSince(start);
+
+        double maxECEFDiff = 0.0;
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            maxECEFDiff = std::max({maxECEFDiff,
+                                    std::abs(x[ii] - ecef[ii][0]),
+                                    std::abs(y[ii] - ecef[ii][1]),
+                                    std::abs(z[ii] - ecef[ii][2])});
+        }
+
+        // ECEF -> LLA
+        std::vector<scene::LatLonAlt> lla(size);
+        start = std::chrono::steady_clock::now();
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            lla[ii] = toLLA.transform(ecef[ii]);
+        }
+        const double scalarToLLA = elapsedSince(start);
+
+        std::vector<double> outLat(size), outLon(size), outAlt(size);
+        start = std::chrono::steady_clock::now();
+        toLLA.transform(cspan(x), cspan(y), cspan(z),
+                        span(outLat), span(outLon), span(outAlt));
+        const double batchToLLA = elapsedSince(start);
+
+        double maxAngleDiff = 0.0;
+        double maxAltDiff = 0.0;
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            maxAngleDiff = std::max({maxAngleDiff,
+                                     std::abs(outLat[ii] - lla[ii].getLat()),
+                                     std::abs(outLon[ii] - lla[ii].getLon())});
+            maxAltDiff = std::max(maxAltDiff,
+                                  std::abs(outAlt[ii] - lla[ii].getAlt()));
+        }
+
+        const double millions = size / 1.0e6;
+        std::cout << "LLA -> ECEF scalar (Mpoints/s): "
+                  << millions / scalarToECEF << "\n"
+                  << "LLA -> ECEF batch (Mpoints/s): "
+                  << millions / batchToECEF << "\n"
+                  << "Max ECEF difference (m): " << maxECEFDiff << "\n"
+                  << "ECEF -> LLA scalar (Mpoints/s): "
+                  << millions / scalarToLLA << "\n"
+                  << "ECEF -> LLA batch (Mpoints/s): "
+                  << millions / batchToLLA << "\n"
+                  << "Max lat/lon difference (deg): " << maxAngleDiff << "\n"
+                  << "Max altitude difference (m): " << maxAltDiff << "\n";
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << ex.toString() << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception\n";
+    }
+    return 1;
+}
@@ -0,0 +1,193 @@
+/* =========================================================================
+ * This file is part of scene-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * scene-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <scene/ProjectionModel.h>
+#include <scene/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+// A ground plane image of a scene at 40N, 80W, collected by a platform
+// flying north 15 km to the west of it, 8 km up
+std::unique_ptr<scene::ProjectionModel> makeModel()
+{
+    const scene::LatLonAlt scpLatLon(40.0, -80.0, 0.0);
+    const scene::Vector3 scp = scene::Utilities::latLonToECEF(scpLatLon);
+
+    const double lat = scpLatLon.getLatRadians();
+    const double lon = scpLatLon.getLonRadians();
+    const scene::Vector3 up({std::cos(lat) * std::cos(lon),
+                             std::cos(lat) * std::sin(lon),
+                             std::sin(lat)});
+    const scene::Vector3 east({-std::sin(lon), std::cos(lon), 0.0});
+    const scene::Vector3 north = math::linear::cross(up, east);
+
+    math::poly::OneD<scene::Vector3> arpPoly(2);
+    arpPoly[0] = scp + up * 8000.0 - east * 15000.0;
+    arpPoly[1] = north * 200.0 + up * 0.5;
+    arpPoly[2] = east * 0.01;
+
+    // Broadside to each column, give or take
+    math::poly::TwoD<double> timeCOAPoly(1, 1);
+    timeCOAPoly[0][1] = 0.005;
+    timeCOAPoly[1][0] = 1e-6;
+    timeCOAPoly[1][1] = 1e-9;
+
+    scene::Errors errors;
+    errors.mFrameType = scene::FrameType::RIC_ECF;
+    return std::make_unique<scene::PlaneProjectionModel>(
+            up, east, north, scp, arpPoly, timeCOAPoly, -1, errors);
+}
+
+std::vector<types::RowCol<double>> makeImagePoints(size_t size)
+{
+    std::vector<types::RowCol<double>> points(size);
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        points[ii] = types::RowCol<double>(-2000.0 + 7.3 * (ii % 500),
+                                           -1500.0 + 11.9 * (ii / 500));
+    }
+    return points;
+}
+
+template<typename T>
+std::span<const T> cspan(const std::vector<T>& values)
+{
+    return std::span<const T>(values.data(), values.size());
+}
+template<typename T>
+std::span<T> span(std::vector<T>& values)
+{
+    return std::span<T>(values.data(), values.size());
+}
+}
+
+TEST_CASE(testImageToSceneMatchesScalar)
+{
+    const auto model = makeModel();
+    const auto imagePoints = makeImagePoints(1234);
+    std::vector<double> heights(imagePoints.size());
+    for (size_t ii = 0; ii < heights.size(); ++ii)
+    {
+        heights[ii] = static_cast<double>(ii % 37) * 10.0;
+    }
+
+    for (size_t numThreads = 1; numThreads <= 3; numThreads += 2)
+    {
+        std::vector<scene::Vector3> scenePoints(imagePoints.size());
+        const size_t numProjected = model->imageToScene(
+                cspan(imagePoints), cspan(heights), span(scenePoints),
+                scene::AdjustableParams(), 1.0, 3, numThreads);
+        TEST_ASSERT_EQ(numProjected, imagePoints.size());
+
+        for (size_t ii = 0; ii < imagePoints.size(); ++ii)
+        {
+            const scene::Vector3 expected =
+                    model->imageToScene(imagePoints[ii], heights[ii]);
+            TEST_ASSERT_LESSER((scenePoints[ii] - expected).norm(), 1e-6);
+        }
+    }
+}
+
+TEST_CASE(testSceneToImageMatchesScalar)
+{
+    const auto model = makeModel();
+    const auto imagePoints = makeImagePoints(600);
+    std::vector<scene::Vector3> scenePoints(imagePoints.size());
+    const std::vector<double> height(1, 100.0);
+    model->imageToScene(cspan(imagePoints), cspan(height), span(scenePoints));
+
+    for (size_t numThreads = 1; numThreads <= 3; numThreads += 2)
+    {
+        std::vector<types::RowCol<double>> results(scenePoints.size());
+        const size_t numConverged = model->sceneToImage(
+                cspan(scenePoints), span(results),
+                scene::AdjustableParams(), numThreads);
+        TEST_ASSERT_EQ(numConverged, scenePoints.size());
+
+        for (size_t ii = 0; ii < scenePoints.size(); ++ii)
+        {
+            const types::RowCol<double> expected =
+                    model->sceneToImage(scenePoints[ii]);
+            TEST_ASSERT_ALMOST_EQ_EPS(results[ii].row, expected.row, 1e-6);
+            TEST_ASSERT_ALMOST_EQ_EPS(results[ii].col, expected.col, 1e-6);
+
+            // Which is also where we started
+            TEST_ASSERT_ALMOST_EQ_EPS(results[ii].row, imagePoints[ii].row,
+                                      1e-3);
+            TEST_ASSERT_ALMOST_EQ_EPS(results[ii].col, imagePoints[ii].col,
+                                      1e-3);
+        }
+    }
+}
+
+TEST_CASE(testFailuresDontStopTheBatch)
+{
+    const auto model = makeModel();
+    const auto imagePoints = makeImagePoints(300);
+
+    // Far above the platform, so there's no solution
+    std::vector<double> heights(imagePoints.size(), 0.0);
+    heights[7] = 1.0e6;
+    std::vector<scene::Vector3> scenePoints(imagePoints.size());
+    TEST_ASSERT_EQ(model->imageToScene(cspan(imagePoints), cspan(heights),
+                                       span(scenePoints)),
+                   imagePoints.size() - 1);
+    TEST_ASSERT_TRUE(std::isnan(scenePoints[7][0]));
+    TEST_ASSERT_FALSE(std::isnan(scenePoints[8][0]));
+
+    const scene::Vector3 up = scenePoints[0] / scenePoints[0].norm();
+    scenePoints[7] = scenePoints[0] + up * 1.0e6;
+    std::vector<types::RowCol<double>> results(scenePoints.size());
+    TEST_ASSERT_EQ(model->sceneToImage(cspan(scenePoints), span(results)),
+                   scenePoints.size() - 1);
+    TEST_ASSERT_TRUE(std::isnan(results[7].row));
+    TEST_ASSERT_FALSE(std::isnan(results[8].row));
+}
+
+TEST_CASE(testBadSpans)
+{
+    const auto model = makeModel();
+    const auto imagePoints = makeImagePoints(10);
+    std::vector<scene::Vector3> scenePoints(9);
+    const std::vector<double> heights(10);
+    TEST_EXCEPTION(model->imageToScene(cspan(imagePoints), cspan(heights),
+                                       span(scenePoints)));
+    scenePoints.resize(10);
+    const std::vector<double> twoHeights(2);
+    TEST_EXCEPTION(model->imageToScene(cspan(imagePoints), cspan(twoHeights),
+                                       span(scenePoints)));
+
+    std::vector<types::RowCol<double>> results(11);
+    TEST_EXCEPTION(model->sceneToImage(cspan(scenePoints), span(results)));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testImageToSceneMatchesScalar);
+    TEST_CHECK(testSceneToImageMatchesScalar);
+    TEST_CHECK(testFailuresDontStopTheBatch);
+    TEST_CHECK(testBadSpans);
+    )
@@ -0,0 +1,151 @@
+/* =========================================================================
+ * This file is part of scene-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * scene-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <scene/ECEFToLLATransform.h>
+#include <scene/LLAToECEFTransform.h>
+#include <scene/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+std::span<const double> cspan(const std::vector<double>& values)
+{
+    return std::span<const double>(values.data(), values.size());
+}
+std::span<double> span(std::vector<double>& values)
+{
+    return std::span<double>(values.data(), values.size());
+}
+
+// Structure-of-arrays points spread over the globe, from just below the
+// surface up to orbital altitudes
+struct Points
+{
+    explicit Points(size_t size) : lat(size), lon(size), alt(size)
+    {
+        for (size_t ii = 0; ii < size; ++ii)
+        {
+            lat[ii] = -90.0 + 180.0 * ii / (size - 1);
+            lon[ii] = -179.5 + std::fmod(ii * 37.3, 359.0);
+            alt[ii] = -500.0 + std::fmod(ii * 7919.0, 800000.0);
+        }
+    }
+
+    std::vector<double> lat;
+    std::vector<double> lon;
+    std::vector<double> alt;
+};
+}
+
+TEST_CASE(testECEFToLLAMatchesScalar)
+{
+    const Points points(1001);
+    const size_t size = points.lat.size();
+    std::vector<double> x(size), y(size), z(size);
+    const scene::LLAToECEFTransform toECEF;
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        const scene::Vector3 ecef = toECEF.transform(scene::LatLonAlt(
+                points.lat[ii], points.lon[ii], points.alt[ii]));
+        x[ii] = ecef[0];
+        y[ii] = ecef[1];
+        z[ii] = ecef[2];
+    }
+
+    std::vector<double> lat(size), lon(size), alt(size);
+    const scene::ECEFToLLATransform toLLA;
+    toLLA.transform(cspan(x), cspan(y), cspan(z),
+                    span(lat), span(lon), span(alt));
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        const scene::LatLonAlt expected =
+                toLLA.transform(scene::Vector3({x[ii], y[ii], z[ii]}));
+        TEST_ASSERT_ALMOST_EQ_EPS(lat[ii], expected.getLat(), 1e-9);
+        TEST_ASSERT_ALMOST_EQ_EPS(lon[ii], expected.getLon(), 1e-9);
+        TEST_ASSERT_ALMOST_EQ_EPS(alt[ii], expected.getAlt(), 1e-4);
+
+        // And we get back where we started
+        TEST_ASSERT_ALMOST_EQ_EPS(lat[ii], points.lat[ii], 1e-9);
+        TEST_ASSERT_ALMOST_EQ_EPS(lon[ii], points.lon[ii], 1e-9);
+        TEST_ASSERT_ALMOST_EQ_EPS(alt[ii], points.alt[ii], 1e-4);
+    }
+}
+
+TEST_CASE(testLLAToECEFMatchesScalar)
+{
+    const Points points(1001);
+    const size_t size = points.lat.size();
+    std::vector<double> x(size), y(size), z(size);
+    scene::Utilities::latLonToECEF(cspan(points.lat), cspan(points.lon),
+                                   cspan(points.alt),
+                                   span(x), span(y), span(z));
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+        const scene::Vector3 expected = scene::Utilities::latLonToECEF(
+                scene::LatLonAlt(points.lat[ii], points.lon[ii],
+                                 points.alt[ii]));
+        TEST_ASSERT_ALMOST_EQ_EPS(x[ii], expected[0], 1e-6);
+        TEST_ASSERT_ALMOST_EQ_EPS(y[ii], expected[1], 1e-6);
+        TEST_ASSERT_ALMOST_EQ_EPS(z[ii], expected[2], 1e-6);
+    }
+}
+
+TEST_CASE(testPoles)
+{
+    const std::vector<double> x{0.0, 0.0};
+    const std::vector<double> y{0.0, 0.0};
+    const std::vector<double> z{6356852.3142, -6356752.3142};
+    std::vector<double> lat(2), lon(2), alt(2);
+    scene::Utilities::ecefToLatLon(cspan(x), cspan(y), cspan(z),
+                                   span(lat), span(lon), span(alt));
+    TEST_ASSERT_EQ(lat[0], 90.0);
+    TEST_ASSERT_EQ(lat[1], -90.0);
+    TEST_ASSERT_ALMOST_EQ_EPS(alt[0], 100.0, 1e-4);
+    TEST_ASSERT_ALMOST_EQ_EPS(alt[1], 0.0, 1e-4);
+}
+
+TEST_CASE(testBadSpans)
+{
+    const std::vector<double> values(4);
+    std::vector<double> out(4), shortOut(3);
+    TEST_EXCEPTION(scene::Utilities::ecefToLatLon(
+            cspan(values), cspan(values), cspan(values),
+            span(out), span(shortOut), span(out)));
+    TEST_EXCEPTION(scene::Utilities::latLonToECEF(
+            cspan(values), cspan(values), cspan(values),
+            span(out), span(out), span(shortOut)));
+
+    const std::vector<double> badLat{0.0, 90.5, 0.0, 0.0};
+    TEST_EXCEPTION(scene::Utilities::latLonToECEF(
+            cspan(badLat), cspan(values), cspan(values),
+            span(out), span(out), span(out)));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testECEFToLLAMatchesScalar);
+    TEST_CHECK(testLLAToECEFMatchesScalar);
+    TEST_CHECK(testPoles);
+    TEST_CHECK(testBadSpans);
+    )
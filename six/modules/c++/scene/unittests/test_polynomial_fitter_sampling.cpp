@@ -0,0 +1,173 @@
+/* =========================================================================
+ * This file is part of scene-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * scene-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <memory>
+
+#include <scene/ProjectionPolynomialFitter.h>
+#include <scene/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+// A ground plane image of a scene at 40N, 80W, collected by a platform
+// flying north 15 km to the west of it, and an output plane tilted a bit
+// away from it
+struct Geometry final
+{
+    Geometry()
+    {
+        const scene::LatLonAlt scpLatLon(40.0, -80.0, 0.0);
+        const scene::Vector3 scp = scene::Utilities::latLonToECEF(scpLatLon);
+
+        const double lat = scpLatLon.getLatRadians();
+        const double lon = scpLatLon.getLonRadians();
+        const scene::Vector3 up({std::cos(lat) * std::cos(lon),
+                                 std::cos(lat) * std::sin(lon),
+                                 std::sin(lat)});
+        const scene::Vector3 east({-std::sin(lon), std::cos(lon), 0.0});
+        const scene::Vector3 north = math::linear::cross(up, east);
+
+        math::poly::OneD<scene::Vector3> arpPoly(1);
+        arpPoly[0] = scp + up * 8000.0 - east * 15000.0;
+        arpPoly[1] = north * 200.0;
+
+        math::poly::TwoD<double> timeCOAPoly(1, 1);
+        timeCOAPoly[0][1] = 0.005;
+
+        scene::Errors errors;
+        errors.mFrameType = scene::FrameType::RIC_ECF;
+        model = std::make_unique<scene::PlaneProjectionModel>(
+                up, east, north, scp, arpPoly, timeCOAPoly, -1, errors);
+
+        scene::Vector3 outRow = east + up * 0.2;
+        outRow.normalize();
+        grid = std::make_unique<scene::PlanarGridECEFTransform>(
+                types::RowCol<double>(2.0, 2.0),
+                types::RowCol<double>(1000.0, 1000.0),
+                outRow, north, scp);
+    }
+
+    std::unique_ptr<scene::ProjectionModel> model;
+    std::unique_ptr<scene::GridECEFTransform> grid;
+};
+
+bool sameSamples(const scene::ProjectionPolynomialFitter& lhs,
+                 const scene::ProjectionPolynomialFitter& rhs)
+{
+    if (lhs.getNumPoints1D() != rhs.getNumPoints1D())
+    {
+        return false;
+    }
+    for (size_t ii = 0; ii < lhs.getNumPoints1D(); ++ii)
+    {
+        for (size_t jj = 0; jj < lhs.getNumPoints1D(); ++jj)
+        {
+            if (lhs.getOutputPlaneRows()(ii, jj) !=
+                        rhs.getOutputPlaneRows()(ii, jj) ||
+                lhs.getOutputPlaneCols()(ii, jj) !=
+                        rhs.getOutputPlaneCols()(ii, jj) ||
+                lhs.getSceneCoordinates()(ii, jj) !=
+                        rhs.getSceneCoordinates()(ii, jj) ||
+                lhs.getTimeCOA()(ii, jj) != rhs.getTimeCOA()(ii, jj))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const types::RowCol<double> OUT_PIXEL_START(0.0, 0.0);
+const types::RowCol<size_t> OUT_EXTENT(2001, 2001);
+}
+
+TEST_CASE(testThreadsGiveSameSamples)
+{
+    const Geometry geometry;
+    const scene::ProjectionPolynomialFitter serial(
+            *geometry.model, *geometry.grid, OUT_PIXEL_START, OUT_EXTENT,
+            12, 1);
+    const scene::ProjectionPolynomialFitter threaded(
+            *geometry.model, *geometry.grid, OUT_PIXEL_START, OUT_EXTENT,
+            12, 3);
+    TEST_ASSERT_TRUE(sameSamples(serial, threaded));
+}
+
+TEST_CASE(testAdaptiveStopsWhenFitIsGood)
+{
+    const Geometry geometry;
+    scene::ProjectionPolynomialFitter::AdaptiveSampling sampling;
+    sampling.minPoints1D = 5;
+    sampling.maxPoints1D = 33;
+
+    // The new samples always get checked, so this takes one pass
+    sampling.tolerance = 1000.0;
+    const scene::ProjectionPolynomialFitter loose(
+            *geometry.model, *geometry.grid, OUT_PIXEL_START, OUT_EXTENT,
+            sampling, 2);
+    TEST_ASSERT_EQ(loose.getNumPoints1D(), static_cast<size_t>(9));
+
+    // Which sampled the same points a fixed grid that size would have
+    const scene::ProjectionPolynomialFitter fixed(
+            *geometry.model, *geometry.grid, OUT_PIXEL_START, OUT_EXTENT, 9);
+    TEST_ASSERT_TRUE(sameSamples(loose, fixed));
+
+    // Can't be met, so this grows until it can't anymore
+    sampling.tolerance = 0.0;
+    const scene::ProjectionPolynomialFitter tight(
+            *geometry.model, *geometry.grid, OUT_PIXEL_START, OUT_EXTENT,
+            sampling, 2);
+    TEST_ASSERT_EQ(tight.getNumPoints1D(), static_cast<size_t>(33));
+}
+
+TEST_CASE(testAdaptiveFitsWithinTolerance)
+{
+    const Geometry geometry;
+    scene::ProjectionPolynomialFitter::AdaptiveSampling sampling;
+    sampling.polyOrderX = sampling.polyOrderY = 4;
+    sampling.tolerance = 0.05;
+    const scene::ProjectionPolynomialFitter fitter(
+            *geometry.model, *geometry.grid, OUT_PIXEL_START, OUT_EXTENT,
+            sampling);
+    TEST_ASSERT_LESSER(fitter.getNumPoints1D(), sampling.maxPoints1D);
+
+    math::poly::TwoD<double> outputToSlantRow;
+    math::poly::TwoD<double> outputToSlantCol;
+    double errorRow(0.0);
+    double errorCol(0.0);
+    fitter.fitOutputToSlantPolynomials(
+            types::RowCol<size_t>(0, 0),
+            types::RowCol<double>(1000.0, 1000.0),
+            types::RowCol<double>(1000.0, 1000.0),
+            types::RowCol<double>(1.0, 1.0),
+            4, 4, outputToSlantRow, outputToSlantCol,
+            &errorRow, &errorCol);
+    TEST_ASSERT_LESSER(std::sqrt(errorRow), sampling.tolerance);
+    TEST_ASSERT_LESSER(std::sqrt(errorCol), sampling.tolerance);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testThreadsGiveSameSamples);
+    TEST_CHECK(testAdaptiveStopsWhenFitIsGood);
+    TEST_CHECK(testAdaptiveFitsWithinTolerance);
+    )
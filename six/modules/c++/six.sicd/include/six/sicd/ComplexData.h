@@ -163,6 +163,7 @@ struct ComplexData: public Data
         imageData->pixelType = pixelType;
     }
     bool convertPixels_(std::span<const std::byte>, std::span<std::byte>, ptrdiff_t cutoff) const override;
+    bool convertPixelsWith_(std::span<const std::byte>, std::span<std::byte>, ptrdiff_t cutoff, Executor*) const override;
 
     /*!
      *  Maps to: /SICD/ImageData/NumRows,
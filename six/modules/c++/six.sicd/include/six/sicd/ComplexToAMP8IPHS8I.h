@@ -64,6 +64,16 @@ public:
      */
     AMP8I_PHS8I_t nearest_neighbor(const std::complex<float>& v) const;
 
+    /*!
+     * Same as nearest_neighbor(), but always computed in long double.
+     * nearest_neighbor() works in double and only falls back to this when a
+     * value is too close to a phase or magnitude boundary to be sure of the
+     * answer; the results are identical.
+     * @param v complex value to query with
+     * @return nearest amplitude and phase value
+     */
+    AMP8I_PHS8I_t nearest_neighbor_exact(const std::complex<float>& v) const;
+
 private:
     //! The sorted set of possible magnitudes order from small to large.
     std::vector<long double> uncached_magnitudes; // Order is important! This must be ...
@@ -73,6 +83,15 @@ private:
     long double phase_delta;
     //! Unit vector rays that represent each direction that phase can point.
     std::array<std::complex<long double>, UINT8_MAX + 1> phase_directions;
+
+    //! 1 / phase_delta, and the phase_directions, in double for nearest_neighbor().
+    double phase_scale;
+    std::array<double, UINT8_MAX + 1> phase_directions_real;
+    std::array<double, UINT8_MAX + 1> phase_directions_imag;
+
+    //! Midpoints between consecutive magnitudes, bracketed by -inf and +inf.
+    //! Empty if the magnitudes aren't strictly increasing (possible with an amplitude table).
+    std::vector<double> magnitude_thresholds;
 };
 }
 }
@@ -57,6 +57,17 @@ struct ComplexXMLControl : public XMLControl
 
     static const six::DataType dataType;
 
+    /*!
+     *  Creates the parser for the SICD version of a document, e.g. to parse
+     *  only some of its blocks (see LazyComplexData)
+     *
+     *  \param doc A SICD XML document
+     *  \param version [output] The SICD version, e.g. "1.2.1"
+     *  \return The parser
+     */
+    std::unique_ptr<ComplexXMLParser> getParser(const xml::lite::Document& doc,
+                                                std::string& version) const;
+
 protected:
     /*!
      *  This function takes in a ComplexData object and converts
@@ -68,6 +79,9 @@ protected:
     virtual xml::lite::Document* toXMLImpl(const Data* data);
     virtual std::unique_ptr<xml::lite::Document> toXMLImpl(const Data&) const override;
 
+    //! Writes the XML a top-level block at a time, without a full DOM
+    void toXMLImpl(const Data&, io::OutputStream&) const override;
+
     /*!
      *  Function takes a DOM Document* node and creates a new-allocated
      *  ComplexData* populated by the DOM.  
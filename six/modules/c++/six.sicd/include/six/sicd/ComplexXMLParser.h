@@ -23,6 +23,8 @@
 #define __SIX_SICD_COMPLEX_XML_PARSER_H__
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <six/XMLParser.h>
 #include <six/SICommonXMLParser.h>
@@ -55,9 +57,39 @@ public:
     xml::lite::Document* toXML(const ComplexData* data) const;
     std::unique_ptr<xml::lite::Document> toXML(const ComplexData&) const;
 
+    /*!
+     *  Writes the same XML as printing toXML()'s document, but without ever
+     *  holding more than one top-level block (e.g. "GeoData") as a DOM.
+     *
+     *  \param data The SICD
+     *  \param os Where the XML goes
+     */
+    void toXML(const ComplexData& data, io::OutputStream& os) const;
+
     ComplexData* fromXML(const xml::lite::Document* doc) const;
     std::unique_ptr<ComplexData> fromXML(const xml::lite::Document&) const;
 
+    /*!
+     *  Parses one top-level block of a SICD (e.g. "ImageData" or "Grid")
+     *  into the matching member of sicd, leaving the others alone.  An
+     *  optional block that isn't there leaves its member null.
+     *  ImageFormation is checked against sicd's RadarCollection, so that
+     *  needs to be parsed first.
+     *
+     *  \param root The SICD's root element
+     *  \param name The block's element name, one of getBlockNames()
+     *  \param sicd [output] Where to put the block
+     *
+     *  \throws except::Exception if name isn't a SICD block, or a required
+     *  block is missing
+     */
+    void parseBlockFromXML(const xml::lite::Element& root,
+                           const std::string& name,
+                           ComplexData& sicd) const;
+
+    //! The names of the top-level SICD blocks, in document order
+    static const std::vector<std::string>& getBlockNames();
+
 protected:
 
     virtual XMLElem convertGeoInfoToXML(const GeoInfo *obj,
@@ -174,6 +206,10 @@ protected:
     }
 
 private:
+    // What toXML() adds to the root, in order
+    std::vector<XMLBlock> getXMLBlocks(const ComplexData& sicd) const;
+    void setNamespaces(XMLElem root) const;
+
     XMLElem convertImageCreationToXML(const ImageCreation *obj,
                                       XMLElem parent = nullptr) const;
     XMLElem convertImageDataToXML(const ImageData *obj,
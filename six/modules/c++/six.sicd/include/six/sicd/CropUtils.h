@@ -38,17 +38,25 @@ namespace sicd
  * Reads in an AOI from a SICD and creates a cropped SICD, updating the
  * metadata as appropriate to reflect this
  *
+ * The pixels are copied as they are in the file (no conversion to
+ * complex<float>), so the crop is lossless for every pixel type.  They are
+ * read and written a strip of rows at a time, so only a couple of strips
+ * are ever in memory rather than the whole AOI.
+ *
  * \param inPathname Input SICD pathname
  * \param schemaPaths Schema paths to use for reading and writing
  * \param aoiOffset Upper left corner of AOI
  * \param aoiDims Size of AOI
  * \param outPathname Output cropped SICD pathname
+ * \param numRowsPerStrip Number of rows copied at a time.  If 0, each strip
+ * is as many rows as fit in about 32 MB.
  */
 void cropSICD(const std::string& inPathname,
               const std::vector<std::string>& schemaPaths,
               const types::RowCol<size_t>& aoiOffset,
               const types::RowCol<size_t>& aoiDims,
-              const std::string& outPathname);
+              const std::string& outPathname,
+              size_t numRowsPerStrip = 0);
 
 /*
  * Same as above but allow an already-opened reader to be used.
@@ -58,7 +66,8 @@ void cropSICD(six::NITFReadControl& reader,
               const std::vector<std::string>& schemaPaths,
               const types::RowCol<size_t>& aoiOffset,
               const types::RowCol<size_t>& aoiDims,
-              const std::string& outPathname);
+              const std::string& outPathname,
+              size_t numRowsPerStrip = 0);
 
 /*
  * Reads in an AOI from a SICD and creates a cropped SICD, updating the
@@ -73,12 +82,14 @@ void cropSICD(six::NITFReadControl& reader,
  * outside the image.  If this is true, the corner will be silently trimmed to
  * be in-bounds (and the SICD metadata will reflect this).  If this is false,
  * an exception will be thrown.
+ * \param numRowsPerStrip Number of rows copied at a time (see above)
  */
 void cropSICD(const std::string& inPathname,
               const std::vector<std::string>& schemaPaths,
               const std::vector<scene::Vector3>& corners,
               const std::string& outPathname,
-              bool trimCornersIfNeeded = true);
+              bool trimCornersIfNeeded = true,
+              size_t numRowsPerStrip = 0);
 
 /*
  * Same as above but allow an already-opened reader to be used.
@@ -88,7 +99,8 @@ void cropSICD(six::NITFReadControl& reader,
               const std::vector<std::string>& schemaPaths,
               const std::vector<scene::Vector3>& corners,
               const std::string& outPathname,
-              bool trimCornersIfNeeded = true);
+              bool trimCornersIfNeeded = true,
+              size_t numRowsPerStrip = 0);
 
 /*
  * Reads in an AOI from a SICD and creates a cropped SICD, updating the
@@ -99,12 +111,14 @@ void cropSICD(six::NITFReadControl& reader,
  * \param corners Exactly four corners in lat/lon.  If the corners are not
  * rectangular in the slant plane, an AOI will be exscribed from these
  * \param outPathname Output cropped SICD pathname
+ * \param numRowsPerStrip Number of rows copied at a time (see above)
  */
 void cropSICD(const std::string& inPathname,
               const std::vector<std::string>& schemaPaths,
               const std::vector<scene::LatLonAlt>& corners,
               const std::string& outPathname,
-              bool trimCornersIfNeeded = true);
+              bool trimCornersIfNeeded = true,
+              size_t numRowsPerStrip = 0);
 
 /*
  * Same as above but allow an already-opened reader to be used.
@@ -114,7 +128,8 @@ void cropSICD(six::NITFReadControl& reader,
               const std::vector<std::string>& schemaPaths,
               const std::vector<scene::LatLonAlt>& corners,
               const std::string& outPathname,
-              bool trimCornersIfNeeded = true);
+              bool trimCornersIfNeeded = true,
+              size_t numRowsPerStrip = 0);
 
 /*
  * Given a six::Sicd::ComplexData object and a cropping region,
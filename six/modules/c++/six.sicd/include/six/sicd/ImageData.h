@@ -37,6 +37,8 @@
 
 namespace six
 {
+class Executor;
+
 namespace sicd
 {
 using cx_float = std::complex<float>;
@@ -103,12 +105,17 @@ struct ImageData
     bool validate(const GeoData& geoData, logging::Logger& log) const;
 
     // It would be nice to cache the results, but amplitudeTable could change at any time.
+    // A negative cutoff converts on the calling thread.  Otherwise the work is spread over
+    // pExecutor (the process-wide six::Executor if nullptr); 0 lets it pick how many pixels each
+    // thread gets, any other value is the fewest pixels worth handing to a thread.
     cx_float from_AMP8I_PHS8I(const AMP8I_PHS8I_t&) const; // for unit-tests
-    static void to_AMP8I_PHS8I(const AmplitudeTable*, std::span<const cx_float>, std::span<AMP8I_PHS8I_t>, ptrdiff_t cutoff = -1); // for unit-tests
+    static void to_AMP8I_PHS8I(const AmplitudeTable*, std::span<const cx_float>, std::span<AMP8I_PHS8I_t>, ptrdiff_t cutoff = -1,
+        Executor* pExecutor = nullptr); // for unit-tests
 
-    static void from_AMP8I_PHS8I(const input_amplitudes_t& lookup, std::span<const AMP8I_PHS8I_t>, std::span<cx_float>, ptrdiff_t cutoff = -1);
-    void from_AMP8I_PHS8I(std::span<const AMP8I_PHS8I_t>, std::span<cx_float>, ptrdiff_t cutoff = -1) const;
-    void to_AMP8I_PHS8I(std::span<const cx_float>, std::span<AMP8I_PHS8I_t>, ptrdiff_t cutoff = -1) const;
+    static void from_AMP8I_PHS8I(const input_amplitudes_t& lookup, std::span<const AMP8I_PHS8I_t>, std::span<cx_float>, ptrdiff_t cutoff = -1,
+        Executor* pExecutor = nullptr);
+    void from_AMP8I_PHS8I(std::span<const AMP8I_PHS8I_t>, std::span<cx_float>, ptrdiff_t cutoff = -1, Executor* pExecutor = nullptr) const;
+    void to_AMP8I_PHS8I(std::span<const cx_float>, std::span<AMP8I_PHS8I_t>, ptrdiff_t cutoff = -1, Executor* pExecutor = nullptr) const;
 
     /*!
      * Create a lookup table for converting from AMP8I_PHS8I to complex.
@@ -0,0 +1,147 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __SIX_SICD_LAZY_COMPLEX_DATA_H__
+#define __SIX_SICD_LAZY_COMPLEX_DATA_H__
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <std/filesystem>
+#include <logging/Logger.h>
+#include <six/XmlLite.h>
+#include <six/sicd/ComplexData.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/ComplexXMLParser.h>
+
+namespace six
+{
+namespace sicd
+{
+/*!
+ *  \class LazyComplexData
+ *  \brief SICD metadata that's only parsed as it's asked for
+ *
+ *  Opening a SICD normally turns all of its XML into a ComplexData up front,
+ *  including blocks like ErrorStatistics or the RMA polynomials that a lot
+ *  of callers never look at.  This keeps the DOM instead, and parses each
+ *  top-level block the first time it's accessed.  Once every block has been
+ *  parsed, the DOM is freed.
+ *
+ *  The accessors are thread-safe, and what they return stays valid for the
+ *  lifetime of this object.  Optional blocks come back as nullptr if the
+ *  SICD doesn't have them.
+ */
+class LazyComplexData
+{
+public:
+    /*!
+     *  \param xml The SICD XML, e.g. the bytes of its DES
+     *  \param pSchemaPaths Schemas to validate the XML against.  If empty,
+     *  the default schema path is used.  If nullptr, there's no validation.
+     *  \param log Logger, or nullptr for none
+     *
+     *  \throws except::Exception if the XML isn't valid or isn't a SICD
+     */
+    LazyComplexData(const std::string& xml,
+                    const std::vector<std::filesystem::path>* pSchemaPaths = nullptr,
+                    logging::Logger* log = nullptr);
+
+    LazyComplexData(const LazyComplexData&) = delete;
+    LazyComplexData& operator=(const LazyComplexData&) = delete;
+
+    /*!
+     *  Reads the XML from the SICD DES of a NITF, without reading any of
+     *  the image.
+     *
+     *  \param pathname SICD NITF
+     *  \param pSchemaPaths As above
+     *  \param log As above
+     *
+     *  \throws except::Exception if the file doesn't have a SICD DES
+     */
+    static std::unique_ptr<LazyComplexData> fromNITF(
+            const std::filesystem::path& pathname,
+            const std::vector<std::filesystem::path>* pSchemaPaths = nullptr,
+            logging::Logger* log = nullptr);
+
+    //! The SICD version, e.g. "1.2.1"
+    const std::string& getVersion() const
+    {
+        return mVersion;
+    }
+
+    const CollectionInformation& getCollectionInformation() const;
+    const ImageCreation* getImageCreation() const;
+    const ImageData& getImageData() const;
+    const GeoData& getGeoData() const;
+    const Grid& getGrid() const;
+    const Timeline& getTimeline() const;
+    const Position& getPosition() const;
+    const RadarCollection& getRadarCollection() const;
+
+    //! Parses the RadarCollection too, as it's checked against it
+    const ImageFormation& getImageFormation() const;
+
+    const SCPCOA& getSCPCOA() const;
+    const Radiometric* getRadiometric() const;
+    const Antenna* getAntenna() const;
+    const ErrorStatistics* getErrorStatistics() const;
+    const MatchInformation* getMatchInformation() const;
+    const PFA* getPFA() const;
+    const RMA* getRMA() const;
+    const RgAzComp* getRgAzComp() const;
+
+    /*!
+     *  Parses any blocks that haven't been yet
+     *
+     *  \return A copy of the whole SICD
+     */
+    std::unique_ptr<ComplexData> getComplexData() const;
+
+    //! How many of the top-level blocks have been parsed so far
+    size_t getNumBlocksParsed() const;
+
+private:
+    // Parses the block if it hasn't been yet.  Once it has, its member of
+    // mData is never touched again.
+    void load(const std::string& name) const;
+
+    // Must hold the lock
+    void parse(const std::string& name) const;
+
+    const ComplexXMLControl mXMLControl;
+    std::string mVersion;
+    std::unique_ptr<ComplexXMLParser> mParser;
+
+    mutable std::mutex mMutex;
+    mutable std::unique_ptr<six::MinidomParser> mXMLParser;
+    mutable ComplexData mData;
+    mutable std::vector<bool> mIsParsed;
+    mutable size_t mNumBlocksParsed = 0;
+};
+}
+}
+
+#endif
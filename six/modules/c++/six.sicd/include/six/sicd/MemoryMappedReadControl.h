@@ -0,0 +1,168 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __SIX_SICD_MEMORY_MAPPED_READ_CONTROL_H__
+#define __SIX_SICD_MEMORY_MAPPED_READ_CONTROL_H__
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <std/cstddef>
+#include <std/filesystem>
+#include <std/span>
+
+#include <six/NITFReadControl.h>
+
+namespace six
+{
+namespace sicd
+{
+/*!
+ * \struct MappedImageSegment
+ * \brief The pixels of one SICD image segment, straight out of the file
+ */
+struct MappedImageSegment final
+{
+    //! First row of the segment in the overall image
+    size_t firstRow = 0;
+
+    //! Number of rows in the segment
+    size_t numRows = 0;
+
+    //! numRows full rows of pixels, in the byte order they are stored in
+    std::span<const std::byte> pixels;
+};
+
+/*!
+ * \class MemoryMappedReadControl
+ * \brief NITF read control that memory maps a SICD and hands back views of
+ * its pixels
+ *
+ * NITFReadControl::interleaved() always copies pixels into a Region's buffer
+ * through NITRO.  When only small windows of a very large SICD are needed,
+ * that copy (on top of the one into the page cache) is pure overhead.  This
+ * class maps the whole file and returns std::span views of the pixel bytes
+ * of each image segment instead; nothing is read until the pages are
+ * touched.
+ *
+ * Only uncompressed, unblocked SICDs can be viewed this way; load() throws
+ * for anything else.  The pixels are exactly as stored in the file, i.e.
+ * big endian, so check needsByteSwap() before interpreting them.
+ *
+ * The file must be loaded through one of the pathname overloads of load();
+ * interleaved() still works as usual.  The views are valid until the next
+ * load() or until this object is destroyed.
+ */
+class MemoryMappedReadControl : public six::NITFReadControl
+{
+public:
+    MemoryMappedReadControl();
+    virtual ~MemoryMappedReadControl();
+
+    MemoryMappedReadControl(const MemoryMappedReadControl&) = delete;
+    MemoryMappedReadControl& operator=(const MemoryMappedReadControl&) = delete;
+
+    using ReadControl::load;
+
+    /*!
+     * Loads the SICD metadata and maps the file
+     *
+     * \param fromFile Input pathname
+     * \param pSchemaPaths Directories or files of schema locations
+     *
+     * \throws except::Exception if the image data is compressed or blocked
+     */
+    void load(const std::string& fromFile,
+              const std::vector<std::string>* pSchemaPaths);
+    void load(const std::string& fromFile,
+              const std::vector<std::string>& schemaPaths) override
+    {
+        load(fromFile, &schemaPaths);
+    }
+    void load(const std::filesystem::path& fromFile,
+              const std::vector<std::filesystem::path>* pSchemaPaths) override;
+    void load(const std::filesystem::path& fromFile,
+              const std::vector<std::filesystem::path>& schemaPaths)
+    {
+        load(fromFile, &schemaPaths);
+    }
+
+    /*!
+     * \return A view of each image segment, in row order.  Together these
+     * cover every row of the image.
+     */
+    const std::vector<MappedImageSegment>& getImageSegments() const;
+
+    /*!
+     * \param startRow First row in the overall image
+     * \param numRows Number of rows
+     *
+     * \return View of the requested rows
+     *
+     * \throws except::Exception if the rows cross an image segment boundary;
+     * use getImageSegments() to handle that case.
+     */
+    std::span<const std::byte> getRows(size_t startRow, size_t numRows) const;
+
+    //! \return View of a single row
+    std::span<const std::byte> getRow(size_t row) const
+    {
+        return getRows(row, 1);
+    }
+
+    //! \return Number of bytes in one row of pixels
+    size_t getNumBytesPerRow() const
+    {
+        return mNumBytesPerRow;
+    }
+
+    /*!
+     * \return Size in bytes of each real/imaginary (or amplitude/phase)
+     * component of a pixel.  This is the unit to byte swap in.
+     */
+    size_t getElementSize() const
+    {
+        return mElementSize;
+    }
+
+    /*!
+     * \return Whether the viewed pixels must be byte swapped before use on
+     * this machine.  SICD pixels are always stored big endian.
+     */
+    bool needsByteSwap() const;
+
+private:
+    void map(const std::string& pathname);
+
+private:
+    struct MappedFile;
+    std::unique_ptr<MappedFile> mFile;
+
+    std::vector<MappedImageSegment> mSegments;
+    size_t mNumBytesPerRow = 0;
+    size_t mElementSize = 0;
+};
+}
+}
+
+#endif
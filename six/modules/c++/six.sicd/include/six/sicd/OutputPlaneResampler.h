@@ -0,0 +1,154 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __SIX_SICD_OUTPUT_PLANE_RESAMPLER_H__
+#define __SIX_SICD_OUTPUT_PLANE_RESAMPLER_H__
+
+#include <complex>
+#include <vector>
+
+#include <std/span>
+#include <types/RowCol.h>
+#include <six/Executor.h>
+#include <six/sicd/ComplexData.h>
+
+namespace six
+{
+namespace sicd
+{
+/*!
+ *  \class OutputPlaneResampler
+ *  \brief Resamples a SICD's slant plane image into its output plane
+ *
+ *  The output plane is the SICD's AreaPlane (derived if the SICD doesn't
+ *  have one), with its xDirection along the rows.  Projecting every output
+ *  pixel is too slow for a whole image, so the slant plane pixel is only
+ *  projected on a coarse grid of output pixels, once, when this is
+ *  constructed; every other output pixel's slant plane location is
+ *  interpolated from that grid.  Samples are then interpolated bilinearly
+ *  from the slant plane image, a tile of the output at a time, with the
+ *  tiles spread across the threads of an Executor.
+ *
+ *  Output pixels that fall outside the slant plane image are set to 0.
+ */
+class OutputPlaneResampler
+{
+public:
+    //! Output pixels between grid points, in each direction
+    static const size_t DEFAULT_GRID_SPACING;
+
+    /*!
+     *  Projects the lookup grid.
+     *
+     *  \param complexData SICD metadata
+     *  \param gridSpacing Output pixels between the points of the lookup
+     *  grid, in each direction; the grid always covers the whole output
+     *  plane
+     *  \param pExecutor Executor to project the grid on, or nullptr for
+     *  the process-wide one
+     */
+    OutputPlaneResampler(const ComplexData& complexData,
+                         size_t gridSpacing = DEFAULT_GRID_SPACING,
+                         Executor* pExecutor = nullptr);
+
+    OutputPlaneResampler(const OutputPlaneResampler&) = delete;
+    OutputPlaneResampler& operator=(const OutputPlaneResampler&) = delete;
+
+    //! \return Output plane (rows, cols)
+    const types::RowCol<size_t>& getOutputDims() const
+    {
+        return mOutputDims;
+    }
+
+    //! \return Slant plane image (rows, cols) that resample() expects
+    const types::RowCol<size_t>& getSlantDims() const
+    {
+        return mSlantDims;
+    }
+
+    size_t getGridSpacing() const
+    {
+        return mGridSpacing;
+    }
+
+    /*!
+     *  \param outputPixel Output plane pixel
+     *  \return The slant plane pixel it comes from, interpolated from the
+     *  lookup grid.  NaN if the projection failed nearby.
+     */
+    types::RowCol<double>
+    toSlantPixel(const types::RowCol<double>& outputPixel) const;
+
+    /*!
+     *  Resamples complex samples into the output plane.
+     *
+     *  \param slantImage The whole slant plane image, getSlantDims() in
+     *  size
+     *  \param outputImage [output] The whole output plane, getOutputDims()
+     *  in size
+     *  \param pExecutor Executor to resample on, or nullptr for the
+     *  process-wide one
+     */
+    void resample(std::span<const std::complex<float>> slantImage,
+                  std::span<std::complex<float>> outputImage,
+                  Executor* pExecutor = nullptr) const;
+
+    //! As above, for samples that are already detected
+    void resample(std::span<const float> slantImage,
+                  std::span<float> outputImage,
+                  Executor* pExecutor = nullptr) const;
+
+    /*!
+     *  As above, but detects the complex samples, interpolating their
+     *  magnitudes rather than the complex values.
+     */
+    void resampleDetected(std::span<const std::complex<float>> slantImage,
+                          std::span<float> outputImage,
+                          Executor* pExecutor = nullptr) const;
+
+private:
+    template <typename InT, typename OutT, typename DetectT>
+    void resample(std::span<const InT> slantImage,
+                  std::span<OutT> outputImage,
+                  DetectT detect,
+                  Executor* pExecutor) const;
+
+    // Fills 'slantPixels' with the slant plane pixel of each output pixel
+    // in [startCol, endCol) of outputRow
+    void interpolateRow(size_t outputRow,
+                        size_t startCol,
+                        size_t endCol,
+                        types::RowCol<double>* slantPixels) const;
+
+    types::RowCol<size_t> mOutputDims;
+    types::RowCol<size_t> mSlantDims;
+    size_t mGridSpacing;
+
+    // Slant plane pixel of every mGridSpacing'th output pixel, row-major;
+    // the last grid row and column may be past the edge of the output
+    types::RowCol<size_t> mGridDims;
+    std::vector<types::RowCol<double> > mGrid;
+};
+}
+}
+
+#endif
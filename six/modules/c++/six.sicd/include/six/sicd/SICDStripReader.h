@@ -0,0 +1,130 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __SIX_SICD_SICD_STRIP_READER_H__
+#define __SIX_SICD_SICD_STRIP_READER_H__
+#pragma once
+
+#include <complex>
+#include <memory>
+#include <std/span>
+
+#include <six/NITFReadControl.h>
+#include <six/sicd/ComplexData.h>
+
+namespace six
+{
+namespace sicd
+{
+/*!
+ * \struct SICDStrip
+ * \brief A block of full-width rows of a SICD, as complex<float>
+ */
+struct SICDStrip final
+{
+    //! First row of the strip in the overall image
+    size_t firstRow = 0;
+
+    //! Number of rows in the strip
+    size_t numRows = 0;
+
+    //! numRows * numCols pixels, row-major
+    std::span<const std::complex<float> > pixels;
+};
+
+/*!
+ * \class SICDStripReader
+ * \brief Streams the wideband data of a SICD as fixed-height strips of
+ * complex<float>
+ *
+ * Utilities::getWidebandData() converts the whole image into one buffer,
+ * which doesn't scale to very large collects.  This class instead walks the
+ * image top to bottom, handing back one strip at a time from a small pool
+ * of reusable buffers.  A background thread reads and converts the next
+ * strips (RE32F_IM32F, RE16I_IM16I, or AMP8I_PHS8I) while the caller works
+ * on the current one, so peak memory is bounded by
+ * numBuffers * numRowsPerStrip rows of complex<float> (plus one strip of
+ * raw pixels), regardless of the image size.
+ *
+ * The reader must not be used by anything else while strips are being
+ * streamed from it.
+ *
+ * \code
+ *   SICDStripReader strips(reader, complexData, 1024);
+ *   SICDStrip strip;
+ *   while (strips.next(strip))
+ *   {
+ *       process(strip.firstRow, strip.numRows, strip.pixels);
+ *   }
+ * \endcode
+ */
+class SICDStripReader final
+{
+public:
+    /*!
+     * Starts reading ahead
+     *
+     * \param reader A loaded NITFReadControl associated with the SICD
+     * \param complexData ComplexData associated with the SICD
+     * \param numRowsPerStrip Number of rows in each strip.  The last strip
+     * may have fewer.
+     * \param numBuffers Number of strips that may be held in memory at once,
+     * including the one handed back by next().  Must be at least 2 for any
+     * read-ahead to happen.
+     *
+     * \throws except::Exception if the pixel type is unsupported or either
+     * count is 0
+     */
+    SICDStripReader(NITFReadControl& reader,
+                    const ComplexData& complexData,
+                    size_t numRowsPerStrip,
+                    size_t numBuffers = 2);
+
+    //! Stops reading ahead and waits for the background thread
+    ~SICDStripReader();
+
+    SICDStripReader(const SICDStripReader&) = delete;
+    SICDStripReader& operator=(const SICDStripReader&) = delete;
+
+    /*!
+     * Waits for the next strip.  The previous strip's buffer is returned to
+     * the pool, so any view of it is invalidated.
+     *
+     * \param[out] strip The next strip
+     *
+     * \return false once every row has been handed back
+     *
+     * \throws Any exception encountered while reading or converting
+     */
+    bool next(SICDStrip& strip);
+
+    //! \return Number of rows in each strip (except possibly the last)
+    size_t getNumRowsPerStrip() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> mImpl;
+};
+}
+}
+
+#endif
@@ -24,11 +24,14 @@
 #define __SIX_SICD_WRITE_CONTROL_H__
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <cstddef>
 
 #include <types/RowCol.h>
 #include <six/NITFWriteControl.h>
+#include <six/PositionalFileWriter.h>
 #include <six/sicd/ComplexData.h>
 
 #include <nitf/coda-oss.hpp>
@@ -48,6 +51,10 @@ namespace sicd
  * a use case where you will be getting/generating pixels gradually rather
  * than all at once, and you may get/generate them in an order other than the
  * order they'll be written to disk, you can use this class instead.
+ *
+ * Headers and pixels are written with positional writes on a single file
+ * handle rather than through a shared cursor, so several threads may call
+ * save() at once for different parts of the image.
  */
 class SICDWriteControl : public six::NITFWriteControl
 {
@@ -83,7 +90,8 @@ public:
     /*!
      * Writes a portion of the pixels to the file.  The first time this is
      * called, the headers will be written to the file.  This may be called
-     * as many times as desired with different AOIs in any order.
+     * as many times as desired with different AOIs in any order, including
+     * from several threads at once as long as their AOIs don't overlap.
      *
      * TODO: No sanity checks are done that the offset and dims are within the
      * global image dimensions.
@@ -96,11 +104,21 @@ public:
      *     the global pixel location (this class will take care of writing it
      *     to the appropriate image segment).
      * \param dims The dimensions of the image data pixels.
-     * \param restoreData Unless the OPT_BYTE_SWAP option has been set or this
-     *     is a big endian system, the incoming data needs to be endian swapped.
-     *     For memory efficiency, this is done in-place.  This flag controls
-     *     if the incoming data should be swapped back afterwards.  By default,
-     *     the data will be swapped back.
+     *
+     * Unless the OPT_BYTE_SWAP option has been set or this is a big endian
+     * system, the incoming data is endian swapped a piece at a time into a
+     * per-thread scratch buffer, spread over the threads of
+     * Executor::get(getOptions()); the caller's data is never modified.
+     */
+    void save(const void* imageData,
+              const types::RowCol<size_t>& offset,
+              const types::RowCol<size_t>& dims);
+
+    /*!
+     * Same as save() above.
+     *
+     * \param restoreData Deprecated and ignored; the caller's data is never
+     *     modified, so there's nothing to restore.
      */
     void save(void* imageData,
               const types::RowCol<size_t>& offset,
@@ -109,22 +127,24 @@ public:
 
     /*!
      * Closes the underlying IO interface.  This will occur implicitly in the
-     * destructor if it's not called.
+     * destructor if it's not called.  No save()s may be running, and any
+     * later ones will throw.
      */
     void close();
 
 private:
     void writeHeaders();
 
-    void write(const std::vector<sys::byte>& data);
-    void write(const std::vector<std::byte>& data);
+    void writeAt(nitf::Off offset, const std::vector<sys::byte>& data);
+    void writeAt(nitf::Off offset, const std::vector<std::byte>& data);
 
 private:
-    std::unique_ptr<nitf::IOInterface> mIO;
+    std::unique_ptr<PositionalFileWriter> mFileWriter;
     const std::vector<std::string> mSchemaPaths;
 
     std::vector<nitf::Off> mImageDataStart;
     std::vector<NITFSegmentInfo> mImageSegmentInfo;
+    std::mutex mHeaderMutex;
     bool mHaveWrittenHeaders;
 };
 }
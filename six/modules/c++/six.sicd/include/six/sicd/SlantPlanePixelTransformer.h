@@ -26,6 +26,7 @@
 #include <string>
 #include <vector>
 
+#include <std/span>
 #include <types/RowCol.h>
 #include <scene/Types.h>
 #include <scene/LLAToECEFTransform.h>
@@ -47,6 +48,15 @@ namespace sicd
 class SlantPlanePixelTransformer
 {
 public:
+    //! Default pixels between the points of the cache's grid
+    static const size_t DEFAULT_CACHE_SPACING;
+
+    //! Default bound, in meters, on the cache's interpolation error
+    static const double DEFAULT_CACHE_MAX_ERROR;
+
+    //! Closest the points of the cache's grid may be
+    static const size_t MIN_CACHE_SPACING;
+
     /*!
      *  \fn Constructor
      *  \param data       - ComplexData object
@@ -84,11 +94,75 @@ public:
      */
     scene::LatLon toLatLon(const types::RowCol<double>& pixel) const;
 
+    /*!
+     *  Batch versions of the above.  The ECEF to LLA conversion is done
+     *  for the whole batch at once.
+     *
+     *  \param pixels Slant Plane pixels with (row,col) indices
+     *  \param locations [output] The ground plane location of each pixel.
+     *  Must be the same size as pixels.
+     */
+    void toECEF(std::span<const types::RowCol<double>> pixels,
+                std::span<scene::Vector3> locations) const;
+    void toLLA(std::span<const types::RowCol<double>> pixels,
+               std::span<scene::LatLonAlt> locations) const;
+    void toLatLon(std::span<const types::RowCol<double>> pixels,
+                  std::span<scene::LatLon> locations) const;
+
+    /*!
+     *  Projects a grid of pixels over the whole image, every spacing
+     *  pixels in each direction.  From then on, pixels in the image are
+     *  interpolated bilinearly from the grid rather than projected, so
+     *  repeat lookups are a table read; pixels outside the image are still
+     *  projected.
+     *
+     *  The grid is checked against the projection at the center of every
+     *  cell.  While any of them is off by more than maxError, the spacing
+     *  is halved and the grid projected again, but never below
+     *  MIN_CACHE_SPACING: a grid that fine would take about as long to
+     *  build, and far more memory, than projecting every pixel.  If the
+     *  bound can't be met above that, the cache is left disabled.
+     *
+     *  \param spacing Pixels between grid points to start with; at least
+     *  MIN_CACHE_SPACING
+     *  \param maxError Bound, in meters, on the interpolation error
+     *  \return The spacing used, or 0 if the cache couldn't meet maxError
+     *  and is disabled
+     *  \throws except::Exception if spacing is below MIN_CACHE_SPACING
+     */
+    size_t enableCache(size_t spacing = DEFAULT_CACHE_SPACING,
+                       double maxError = DEFAULT_CACHE_MAX_ERROR);
+
+    //! Goes back to projecting every pixel
+    void disableCache();
+
+    bool hasCache() const
+    {
+        return !mCache.empty();
+    }
+
 private:
+    scene::Vector3 project(const types::RowCol<double>& pixel) const;
+
+    void buildCache(size_t spacing);
+
+    double getCacheError() const;
+
+    // Interpolates pixel from the cache if it's there and the pixel is in
+    // the image
+    bool interpolate(const types::RowCol<double>& pixel,
+                     scene::Vector3& ecef) const;
+
     const scene::SceneGeometry mGeom;
     const scene::ProjectionModel& mProjection;
     const six::sicd::ComplexData mSicdData;
     scene::Vector3 mGroundPlaneNormal;
+
+    // Ground plane location of every mCacheSpacing'th pixel, row-major;
+    // the last grid row and column may be past the edge of the image
+    size_t mCacheSpacing;
+    types::RowCol<size_t> mCacheDims;
+    std::vector<scene::Vector3> mCache;
 };
 
 }
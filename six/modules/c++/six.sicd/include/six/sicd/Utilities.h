@@ -275,6 +275,8 @@ public:
      * This function allows the user to provide a vector to be resized
      * to fit the whole image in.
      *
+     * For images too large to hold in memory at once, see SICDStripReader.
+     *
      * \param reader A loaded NITFReadControl associated with the SICD
      * \param complexData complexData associated with the SICD
      * \param buffer The functions output, will contain the image
@@ -392,6 +394,17 @@ public:
     static bool isClockwise(const std::vector<RowColInt>& vertices,
                             bool isUpPositive=false);
 
+    /*
+     * Number of points in a grid of cells 'gridSpacing' pixels across that
+     * covers 'numPixels' pixels.  There are always at least two, so every
+     * pixel is in a cell.
+     *
+     * \param numPixels Number of pixels along the direction
+     * \param gridSpacing Pixels between grid points
+     * \return Number of grid points along the direction
+     */
+    static size_t getNumGridPoints(size_t numPixels, size_t gridSpacing);
+
      /* Parses the XML in 'xmlStream' and converts it into a ComplexData object.
      * Throws if the underlying type is not complex.
      *
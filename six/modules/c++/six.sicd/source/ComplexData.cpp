@@ -369,7 +369,11 @@ inline std::span<T> make_span(std::span<U> bytes)
     return std::span<T>(static_cast<T*>(cast_to_pvoid(bytes)), size);
 }
 
-bool six::sicd::ComplexData::convertPixels_(std::span<const std::byte> from_, std::span<std::byte> to_, ptrdiff_t cutoff) const
+bool six::sicd::ComplexData::convertPixels_(std::span<const std::byte> from, std::span<std::byte> to, ptrdiff_t cutoff) const
+{
+    return convertPixelsWith_(from, to, cutoff, nullptr /*pExecutor*/);
+}
+bool six::sicd::ComplexData::convertPixelsWith_(std::span<const std::byte> from_, std::span<std::byte> to_, ptrdiff_t cutoff, Executor* pExecutor) const
 {
     if (getPixelType() != PixelType::AMP8I_PHS8I)
     {
@@ -378,6 +382,6 @@ bool six::sicd::ComplexData::convertPixels_(std::span<const std::byte> from_, st
 
     const auto from = make_span<const six::sicd::cx_float>(from_);
     const auto to = make_span<six::sicd::AMP8I_PHS8I_t>(to_);
-    imageData->to_AMP8I_PHS8I(from, to, cutoff);
+    imageData->to_AMP8I_PHS8I(from, to, cutoff, pExecutor);
     return true; // converted
 }
@@ -24,6 +24,9 @@
 #include <math.h>
 
 #include <cassert>
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <std/memory>
 
 #include <gsl/gsl.h>
@@ -114,6 +117,24 @@ six::sicd::details::ComplexToAMP8IPHS8I::ComplexToAMP8IPHS8I(const six::Amplitud
         long double y, x;
         SinCos(angle, y, x);
         phase_directions[i] = { x, y };
+
+        phase_directions_real[i] = static_cast<double>(x);
+        phase_directions_imag[i] = static_cast<double>(y);
+    }
+    phase_scale = static_cast<double>(1.0L / phase_delta);
+
+    // With repeated magnitudes, which of the duplicates wins depends on which side the value
+    // is on; leave that to nearest_neighbor_exact().
+    if (std::adjacent_find(magnitudes.begin(), magnitudes.end(), std::greater_equal<long double>()) == magnitudes.end())
+    {
+        magnitude_thresholds.resize(UINT8_MAX + 2);
+        magnitude_thresholds.front() = -std::numeric_limits<double>::infinity();
+        magnitude_thresholds.back() = std::numeric_limits<double>::infinity();
+        for (size_t i = 1; i <= UINT8_MAX; i++)
+        {
+            // nearest() picks the smaller magnitude on a tie
+            magnitude_thresholds[i] = static_cast<double>((magnitudes[i - 1] + magnitudes[i]) / 2);
+        }
     }
 }
 
@@ -138,14 +159,14 @@ static uint8_t nearest(const TIter& begin, const TIter& end, long double value)
     return gsl::narrow<uint8_t>(distance);
 }
 
-six::sicd::AMP8I_PHS8I_t six::sicd::details::ComplexToAMP8IPHS8I::nearest_neighbor(const std::complex<float> &v) const
+six::sicd::AMP8I_PHS8I_t six::sicd::details::ComplexToAMP8IPHS8I::nearest_neighbor_exact(const std::complex<float> &v) const
 {
     six::sicd::AMP8I_PHS8I_t retval;
 
     // Phase is determined via arithmetic because it's equally spaced.
     // There's an intentional conversion to zero when we cast 256 -> uint8. That wrap around
     // handles cases that are close to 2PI.
-    retval.second = gsl::narrow_cast<uint8_t>(std::round(GetPhase(v) / phase_delta));
+    retval.second = gsl::narrow_cast<uint8_t>(static_cast<int>(std::round(GetPhase(v) / phase_delta)));
 
     // We have to do a 1D nearest neighbor search for magnitude.
     // But it's not the magnitude of the input complex value - it's the projection of
@@ -158,6 +179,83 @@ six::sicd::AMP8I_PHS8I_t six::sicd::details::ComplexToAMP8IPHS8I::nearest_neighb
     return retval;
 }
 
+/*!
+ * arctan(x) for 0 <= x <= 1; Abramowitz and Stegun 4.4.47, |error| <= 2e-8.
+ */
+static inline double atan_0_1(double x)
+{
+    const auto x2 = x * x;
+    return x * (0.9999993329 + x2 * (-0.3332985605 + x2 * (0.1994653599 + x2 * (-0.1390853351 +
+        x2 * (0.0964200441 + x2 * (-0.0559098861 + x2 * (0.0218612288 + x2 * -0.0040540580)))))));
+}
+
+/*!
+ * Same as GetPhase(), but in double and without any (unpredictable) branches.
+ * @param x real part; x and y may not both be zero
+ * @param y imaginary part
+ * @return phase between [0, 2PI]
+ */
+static inline double GetPhase(double x, double y)
+{
+    // arctan() of the smaller over the larger component is in [0, PI/4]; each octant
+    // is then an offset plus or minus that.  Indexed by (y < 0, x < 0, |y| > |x|).
+    static constexpr double offsets[] = { 0.0, M_PI / 2.0, M_PI, M_PI / 2.0, M_PI * 2.0, M_PI * 1.5, M_PI, M_PI * 1.5 };
+    static constexpr double signs[] = { 1.0, -1.0, -1.0, 1.0, -1.0, 1.0, 1.0, -1.0 };
+
+    const auto ax = std::abs(x);
+    const auto ay = std::abs(y);
+    const auto octant = static_cast<size_t>(ay > ax) | (static_cast<size_t>(x < 0.0) << 1) | (static_cast<size_t>(y < 0.0) << 2);
+    return offsets[octant] + signs[octant] * atan_0_1(std::min(ax, ay) / std::max(ax, ay));
+}
+
+// nearest_neighbor() hands anything closer than this to a decision boundary over to
+// nearest_neighbor_exact().  Both are far larger than the errors of working in double:
+// ~1e-6 of a phase step for the arctan approximation, and a few ulps for the projection.
+static constexpr double phase_guard = 1e-4; // in phase steps
+static constexpr double magnitude_guard = 1e-12; // relative to |real| + |imag|
+
+six::sicd::AMP8I_PHS8I_t six::sicd::details::ComplexToAMP8IPHS8I::nearest_neighbor(const std::complex<float> &v) const
+{
+    const double x = v.real();
+    const double y = v.imag();
+
+    // Zeros (whose phase depends on their signs), infinities and NaNs are rare enough to not bother with.
+    if (magnitude_thresholds.empty() || !std::isfinite(x) || !std::isfinite(y) || ((x == 0.0) && (y == 0.0)))
+    {
+        return nearest_neighbor_exact(v);
+    }
+
+    // Same as nearest_neighbor_exact(), unless we're too close to halfway between two phases to be sure.
+    const auto phase = GetPhase(x, y) * phase_scale;
+    const auto nearest_phase = static_cast<int>(phase + 0.5); // phase is never negative, so this rounds
+    if (std::abs(phase - nearest_phase) > 0.5 - phase_guard)
+    {
+        return nearest_neighbor_exact(v);
+    }
+
+    // As above, 256 wraps around to 0.
+    six::sicd::AMP8I_PHS8I_t retval;
+    retval.second = gsl::narrow_cast<uint8_t>(nearest_phase);
+
+    const auto projection = phase_directions_real[retval.second] * x + phase_directions_imag[retval.second] * y;
+
+    // Branch-free binary search for the last threshold below the projection; that's the magnitude index.
+    const auto thresholds = magnitude_thresholds.data();
+    size_t index = 0;
+    for (size_t step = (UINT8_MAX + 1) / 2; step > 0; step /= 2)
+    {
+        index += step * static_cast<size_t>(thresholds[index + step] < projection);
+    }
+
+    const auto guard = magnitude_guard * (std::abs(x) + std::abs(y));
+    if ((projection - thresholds[index] <= guard) || (thresholds[index + 1] - projection <= guard))
+    {
+        return nearest_neighbor_exact(v);
+    }
+    retval.first = gsl::narrow<uint8_t>(index);
+    return retval;
+}
+
 const six::sicd::details::ComplexToAMP8IPHS8I* six::sicd::details::ComplexToAMP8IPHS8I::make(const six::AmplitudeTable* pAmplitudeTable,
     std::unique_ptr<ComplexToAMP8IPHS8I>& pTree)
 {
@@ -66,6 +66,24 @@ std::unique_ptr<xml::lite::Document> ComplexXMLControl::toXMLImpl(const Data& da
     auto parser = getParser(data.getVersion());
     return parser->toXML(dynamic_cast<const ComplexData&>(data));
 }
+void ComplexXMLControl::toXMLImpl(const Data& data, io::OutputStream& os) const
+{
+    if (data.getDataType() != DataType::COMPLEX)
+    {
+        throw except::Exception(Ctxt("Data must be SICD"));
+    }
+
+    auto parser = getParser(data.getVersion());
+    parser->toXML(dynamic_cast<const ComplexData&>(data), os);
+}
+
+std::unique_ptr<ComplexXMLParser>
+ComplexXMLControl::getParser(const xml::lite::Document& doc,
+                             std::string& version) const
+{
+    version = getVersionFromURI(&doc);
+    return getParser(version);
+}
 
 std::unique_ptr<ComplexXMLParser>
 ComplexXMLControl::getParser(const std::string& strVersion) const
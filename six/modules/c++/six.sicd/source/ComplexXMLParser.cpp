@@ -20,10 +20,11 @@
  *
  */
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <six/sicd/ComplexXMLParser.h>
-#include <six/sicd/ComplexDataBuilder.h>
 #include <six/Utilities.h>
 
 
@@ -56,157 +57,264 @@ ComplexXMLParser::ComplexXMLParser(const std::string& strVersion,
 }
 #endif
 
-ComplexData* ComplexXMLParser::fromXML(const xml::lite::Document* doc) const
+const std::vector<std::string>& ComplexXMLParser::getBlockNames()
 {
-    ComplexDataBuilder builder;
-    ComplexData *sicd = builder.steal();
-
-    const xml::lite::Element* const root = doc->getRootElement();
+    static const std::vector<std::string> names
+    {
+        "CollectionInfo", "ImageCreation", "ImageData", "GeoData", "Grid",
+        "Timeline", "Position", "RadarCollection", "ImageFormation", "SCPCOA",
+        "Radiometric", "Antenna", "ErrorStatistics", "MatchInfo", "PFA", "RMA",
+        "RgAzComp"
+    };
+    return names;
+}
 
-    XMLElem collectionInfoXML  = getFirstAndOnly(root, "CollectionInfo");
-    XMLElem imageCreationXML   = getOptional(root, "ImageCreation");
-    XMLElem imageDataXML       = getFirstAndOnly(root, "ImageData");
-    XMLElem geoDataXML         = getFirstAndOnly(root, "GeoData");
-    XMLElem gridXML            = getFirstAndOnly(root, "Grid");
-    XMLElem timelineXML        = getFirstAndOnly(root, "Timeline");
-    XMLElem positionXML        = getFirstAndOnly(root, "Position");
-    XMLElem radarCollectionXML = getFirstAndOnly(root, "RadarCollection");
-    XMLElem imageFormationXML  = getFirstAndOnly(root, "ImageFormation");
-    XMLElem scpcoaXML          = getFirstAndOnly(root, "SCPCOA");
-    XMLElem radiometricXML     = getOptional(root, "Radiometric");
-    XMLElem antennaXML         = getOptional(root, "Antenna");
-    XMLElem errorStatisticsXML = getOptional(root, "ErrorStatistics");
-    XMLElem matchInfoXML       = getOptional(root, "MatchInfo");
-    XMLElem pfaXML             = getOptional(root, "PFA");
-    XMLElem rmaXML             = getOptional(root, "RMA");
-    XMLElem rgAzCompXML        = getOptional(root, "RGAZCOMP");
-    if (rgAzCompXML != nullptr)
-    {
-        // In 0.5, the element was in all caps and contained additional
-        // elements that disappeared in 1.0.  For the time being at least,
-        // don't support this.
-        throw except::Exception(Ctxt(
-                "SIX library does not support RGAZCOMP element"));
+void ComplexXMLParser::parseBlockFromXML(const xml::lite::Element& root,
+                                         const std::string& name,
+                                         ComplexData& sicd) const
+{
+    if (name == "CollectionInfo")
+    {
+        common().parseCollectionInformationFromXML(
+                getFirstAndOnly(&root, name),
+                sicd.collectionInformation.get());
     }
-    rgAzCompXML                = getOptional(root, "RgAzComp"); // added in 1.0.0
-
-    common().parseCollectionInformationFromXML(collectionInfoXML,
-            sicd->collectionInformation.get());
-
-    if (imageCreationXML != nullptr)
+    else if (name == "ImageCreation")
     {
-        builder.addImageCreation();
-        parseImageCreationFromXML(imageCreationXML, sicd->imageCreation.get());
+        sicd.imageCreation.reset();
+        const xml::lite::Element* const imageCreationXML =
+                getOptional(&root, name);
+        if (imageCreationXML != nullptr)
+        {
+            sicd.imageCreation.reset(new ImageCreation());
+            parseImageCreationFromXML(imageCreationXML,
+                                      sicd.imageCreation.get());
+        }
     }
-
-    parseImageDataFromXML(imageDataXML, sicd->imageData.get());
-    parseGeoDataFromXML(geoDataXML, sicd->geoData.get());
-    parseGridFromXML(gridXML, sicd->grid.get());
-    parseTimelineFromXML(timelineXML, sicd->timeline.get());
-    parsePositionFromXML(positionXML, sicd->position.get());
-    parseRadarCollectionFromXML(radarCollectionXML, sicd->radarCollection.get());
-    parseImageFormationFromXML(imageFormationXML, *sicd->radarCollection, sicd->imageFormation.get());
-    parseSCPCOAFromXML(scpcoaXML, sicd->scpcoa.get());
-
-    if (radiometricXML != nullptr)
+    else if (name == "ImageData")
     {
-        builder.addRadiometric();
-        common().parseRadiometryFromXML(radiometricXML,
-                                       sicd->radiometric.get());
+        parseImageDataFromXML(getFirstAndOnly(&root, name),
+                              sicd.imageData.get());
     }
-
-    if (antennaXML != nullptr)
+    else if (name == "GeoData")
     {
-        builder.addAntenna();
-        parseAntennaFromXML(antennaXML, sicd->antenna.get());
+        parseGeoDataFromXML(getFirstAndOnly(&root, name), sicd.geoData.get());
     }
-
-    if (errorStatisticsXML != nullptr)
+    else if (name == "Grid")
     {
-        builder.addErrorStatistics();
-        common().parseErrorStatisticsFromXML(errorStatisticsXML,
-                                            sicd->errorStatistics.get());
+        parseGridFromXML(getFirstAndOnly(&root, name), sicd.grid.get());
     }
-
-    if (matchInfoXML != nullptr)
+    else if (name == "Timeline")
     {
-        builder.addMatchInformation();
-        parseMatchInformationFromXML(matchInfoXML, sicd->matchInformation.get());
+        parseTimelineFromXML(getFirstAndOnly(&root, name),
+                             sicd.timeline.get());
     }
-
-    if (pfaXML != nullptr)
+    else if (name == "Position")
     {
-        sicd->pfa.reset(new PFA());
-        parsePFAFromXML(pfaXML, sicd->pfa.get());
+        parsePositionFromXML(getFirstAndOnly(&root, name),
+                             sicd.position.get());
     }
-    if (rmaXML != nullptr)
+    else if (name == "RadarCollection")
     {
-        sicd->rma.reset(new RMA());
-        parseRMAFromXML(rmaXML, sicd->rma.get());
+        parseRadarCollectionFromXML(getFirstAndOnly(&root, name),
+                                    sicd.radarCollection.get());
     }
-    if (rgAzCompXML != nullptr)
+    else if (name == "ImageFormation")
     {
-        sicd->rgAzComp.reset(new RgAzComp());
-        parseRgAzCompFromXML(rgAzCompXML, sicd->rgAzComp.get());
+        parseImageFormationFromXML(getFirstAndOnly(&root, name),
+                                   *sicd.radarCollection,
+                                   sicd.imageFormation.get());
     }
-    return sicd;
-}
-std::unique_ptr<ComplexData> ComplexXMLParser::fromXML(const xml::lite::Document& doc) const
-{
-    return std::unique_ptr<ComplexData>(fromXML(&doc));
-}
-
-xml::lite::Document* ComplexXMLParser::toXML(const ComplexData* sicd) const
-{
-    xml::lite::Document* doc = new xml::lite::Document();
-
-    XMLElem root = newElement("SICD");
-    doc->setRootElement(root);
-
-    common().convertCollectionInformationToXML(
-            sicd->collectionInformation.get(), root);
-    if (sicd->imageCreation.get())
+    else if (name == "SCPCOA")
     {
-        convertImageCreationToXML(sicd->imageCreation.get(), root);
+        parseSCPCOAFromXML(getFirstAndOnly(&root, name), sicd.scpcoa.get());
     }
-    convertImageDataToXML(sicd->imageData.get(), root);
-    convertGeoDataToXML(sicd->geoData.get(), root);
-    convertGridToXML(sicd->grid.get(), root);
-    convertTimelineToXML(sicd->timeline.get(), root);
-    convertPositionToXML(sicd->position.get(), root);
-    convertRadarCollectionToXML(sicd->radarCollection.get(), root);
-    convertImageFormationToXML(sicd->imageFormation.get(), *sicd->radarCollection, root);
-    convertSCPCOAToXML(sicd->scpcoa.get(), root);
-    if (sicd->radiometric.get())
+    else if (name == "Radiometric")
     {
-        common().convertRadiometryToXML(sicd->radiometric.get(), root);
+        sicd.radiometric.reset();
+        const xml::lite::Element* const radiometricXML =
+                getOptional(&root, name);
+        if (radiometricXML != nullptr)
+        {
+            sicd.radiometric.reset(new Radiometric());
+            common().parseRadiometryFromXML(radiometricXML,
+                                            sicd.radiometric.get());
+        }
     }
-    if (sicd->antenna.get())
+    else if (name == "Antenna")
     {
-        convertAntennaToXML(sicd->antenna.get(), root);
+        sicd.antenna.reset();
+        const xml::lite::Element* const antennaXML = getOptional(&root, name);
+        if (antennaXML != nullptr)
+        {
+            sicd.antenna.reset(new Antenna());
+            parseAntennaFromXML(antennaXML, sicd.antenna.get());
+        }
     }
-    if (sicd->errorStatistics.get())
+    else if (name == "ErrorStatistics")
     {
-        common().convertErrorStatisticsToXML(sicd->errorStatistics.get(), root);
+        sicd.errorStatistics.reset();
+        const xml::lite::Element* const errorStatisticsXML =
+                getOptional(&root, name);
+        if (errorStatisticsXML != nullptr)
+        {
+            sicd.errorStatistics.reset(new ErrorStatistics());
+            common().parseErrorStatisticsFromXML(errorStatisticsXML,
+                                                 sicd.errorStatistics.get());
+        }
     }
-    if (sicd->matchInformation.get() && !sicd->matchInformation->types.empty())
+    else if (name == "MatchInfo")
     {
-        convertMatchInformationToXML(*sicd->matchInformation, root);
+        sicd.matchInformation.reset();
+        const xml::lite::Element* const matchInfoXML =
+                getOptional(&root, name);
+        if (matchInfoXML != nullptr)
+        {
+            sicd.matchInformation.reset(new MatchInformation());
+            parseMatchInformationFromXML(matchInfoXML,
+                                         sicd.matchInformation.get());
+        }
     }
+    else if (name == "RgAzComp")
+    {
+        if (getOptional(&root, "RGAZCOMP") != nullptr)
+        {
+            // In 0.5, the element was in all caps and contained additional
+            // elements that disappeared in 1.0.  For the time being at least,
+            // don't support this.
+            throw except::Exception(Ctxt(
+                    "SIX library does not support RGAZCOMP element"));
+        }
 
-    // parse the choice per version
-    convertImageFormationAlgoToXML(sicd->pfa.get(), sicd->rma.get(), sicd->rgAzComp.get(), root);
+        sicd.rgAzComp.reset();
+        const xml::lite::Element* const rgAzCompXML =
+                getOptional(&root, name); // added in 1.0.0
+        if (rgAzCompXML != nullptr)
+        {
+            sicd.rgAzComp.reset(new RgAzComp());
+            parseRgAzCompFromXML(rgAzCompXML, sicd.rgAzComp.get());
+        }
+    }
+    else if (name == "PFA")
+    {
+        sicd.pfa.reset();
+        const xml::lite::Element* const pfaXML = getOptional(&root, name);
+        if (pfaXML != nullptr)
+        {
+            sicd.pfa.reset(new PFA());
+            parsePFAFromXML(pfaXML, sicd.pfa.get());
+        }
+    }
+    else if (name == "RMA")
+    {
+        sicd.rma.reset();
+        const xml::lite::Element* const rmaXML = getOptional(&root, name);
+        if (rmaXML != nullptr)
+        {
+            sicd.rma.reset(new RMA());
+            parseRMAFromXML(rmaXML, sicd.rma.get());
+        }
+    }
+    else
+    {
+        throw except::Exception(Ctxt("Unknown SICD block: " + name));
+    }
+}
 
-    //set the XMLNS
-    root->setNamespacePrefix("", getDefaultURI());
-    //        root->setNamespacePrefix("si", common().getSICommonURI());
+ComplexData* ComplexXMLParser::fromXML(const xml::lite::Document* doc) const
+{
+    std::unique_ptr<ComplexData> sicd(new ComplexData());
+
+    const xml::lite::Element* const root = doc->getRootElement();
+    for (const auto& name : getBlockNames())
+    {
+        parseBlockFromXML(*root, name, *sicd);
+    }
+    return sicd.release();
+}
+std::unique_ptr<ComplexData> ComplexXMLParser::fromXML(const xml::lite::Document& doc) const
+{
+    return std::unique_ptr<ComplexData>(fromXML(&doc));
+}
 
-    return doc;
+xml::lite::Document* ComplexXMLParser::toXML(const ComplexData* sicd) const
+{
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    return blocksToXML("SICD", getXMLBlocks(*sicd), setNamespaces).release();
 }
 std::unique_ptr<xml::lite::Document> ComplexXMLParser::toXML(const ComplexData& data) const
 {
     return std::unique_ptr<xml::lite::Document>(toXML(&data));
 }
+void ComplexXMLParser::toXML(const ComplexData& data, io::OutputStream& os) const
+{
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    writeBlocks(os, "SICD", getXMLBlocks(data), setNamespaces);
+}
+
+std::vector<XMLParser::XMLBlock> ComplexXMLParser::getXMLBlocks(const ComplexData& sicd) const
+{
+    std::vector<XMLBlock> blocks;
+    blocks.push_back([&](XMLElem root) {
+        common().convertCollectionInformationToXML(
+                sicd.collectionInformation.get(), root); });
+    if (sicd.imageCreation.get())
+    {
+        blocks.push_back([&](XMLElem root) {
+            convertImageCreationToXML(sicd.imageCreation.get(), root); });
+    }
+    blocks.push_back([&](XMLElem root) {
+        convertImageDataToXML(sicd.imageData.get(), root); });
+    blocks.push_back([&](XMLElem root) {
+        convertGeoDataToXML(sicd.geoData.get(), root); });
+    blocks.push_back([&](XMLElem root) {
+        convertGridToXML(sicd.grid.get(), root); });
+    blocks.push_back([&](XMLElem root) {
+        convertTimelineToXML(sicd.timeline.get(), root); });
+    blocks.push_back([&](XMLElem root) {
+        convertPositionToXML(sicd.position.get(), root); });
+    blocks.push_back([&](XMLElem root) {
+        convertRadarCollectionToXML(sicd.radarCollection.get(), root); });
+    blocks.push_back([&](XMLElem root) {
+        convertImageFormationToXML(sicd.imageFormation.get(),
+                                   *sicd.radarCollection, root); });
+    blocks.push_back([&](XMLElem root) {
+        convertSCPCOAToXML(sicd.scpcoa.get(), root); });
+    if (sicd.radiometric.get())
+    {
+        blocks.push_back([&](XMLElem root) {
+            common().convertRadiometryToXML(sicd.radiometric.get(), root); });
+    }
+    if (sicd.antenna.get())
+    {
+        blocks.push_back([&](XMLElem root) {
+            convertAntennaToXML(sicd.antenna.get(), root); });
+    }
+    if (sicd.errorStatistics.get())
+    {
+        blocks.push_back([&](XMLElem root) {
+            common().convertErrorStatisticsToXML(sicd.errorStatistics.get(),
+                                                 root); });
+    }
+    if (sicd.matchInformation.get() && !sicd.matchInformation->types.empty())
+    {
+        blocks.push_back([&](XMLElem root) {
+            convertMatchInformationToXML(*sicd.matchInformation, root); });
+    }
+
+    // parse the choice per version
+    blocks.push_back([&](XMLElem root) {
+        convertImageFormationAlgoToXML(sicd.pfa.get(), sicd.rma.get(),
+                                       sicd.rgAzComp.get(), root); });
+    return blocks;
+}
+
+void ComplexXMLParser::setNamespaces(XMLElem root) const
+{
+    //set the XMLNS
+    root->setNamespacePrefix("", getDefaultURI());
+    //        root->setNamespacePrefix("si", common().getSICommonURI());
+}
 
 XMLElem ComplexXMLParser::createFFTSign(const std::string& name, six::FFTSign sign,
                                          XMLElem parent) const
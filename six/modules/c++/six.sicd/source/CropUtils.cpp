@@ -30,8 +30,7 @@
 #include <nitf/coda-oss.hpp>
 #include <except/Exception.h>
 #include <str/Convert.h>
-#include <mem/ScopedArray.h>
-#include <six/NITFWriteControl.h>
+#include <six/sicd/SICDWriteControl.h>
 #include <six/sicd/Utilities.h>
 #include <six/sicd/SlantPlanePixelTransformer.h>
 
@@ -89,13 +88,14 @@ six::sicd::ComplexData* const updateMetadata(
 }
 
 void cropSICD(six::NITFReadControl& reader,
-              const std::vector<std::string>& schemaPaths_,
+              const std::vector<std::string>& schemaPaths,
               const six::sicd::ComplexData& data,
               const scene::SceneGeometry& geom,
               const scene::ProjectionModel& projection,
               const types::RowCol<size_t>& aoiOffset,
               const types::RowCol<size_t>& aoiDims,
-              const std::string& outPathname)
+              const std::string& outPathname,
+              size_t numRowsPerStrip)
 {
     // Make sure the AOI is in bounds
     const auto origDims = getExtent(data);
@@ -111,24 +111,22 @@ void cropSICD(six::NITFReadControl& reader,
         throw except::Exception(Ctxt("AOI must be non-empty"));
     }
 
-    // Read in the AOI
-    //const size_t numBytesPerPixel(data.getNumBytesPerPixel());
-    six::Region region;
-    setOffset(region, aoiOffset);
-    setDims(region, aoiDims);
-    const auto buffer = region.setComplexBuffer(origDims.area());
-    reader.interleaved(region, 0);
-
-    std::unique_ptr<six::Data> aoiData(updateMetadata(
+    std::unique_ptr<six::sicd::ComplexData> aoiData(updateMetadata(
             data, geom,  projection,
             aoiOffset, aoiDims));
 
-    // Write the AOI SICD out
-    six::NITFWriteControl writer(std::move(aoiData));
-    const std::span<const std::complex<float>> image(buffer.get(), origDims.area());
-    std::vector<std::filesystem::path> schemaPaths;
-    std::transform(schemaPaths_.begin(), schemaPaths_.end(), std::back_inserter(schemaPaths), [](const std::string& s) { return s; });
-    writer.save_image(image, outPathname, schemaPaths);
+    // Copy the AOI a strip at a time, as the raw pixels, so it's lossless
+    // for every pixel type and only a couple of strips are ever in memory
+    six::sicd::SICDWriteControl writer(outPathname, schemaPaths);
+    writer.initialize(*aoiData);
+    reader.interleaved(aoiOffset, aoiDims, 0, numRowsPerStrip,
+            [&](const std::byte* strip,
+                const types::RowCol<size_t>& offset,
+                const types::RowCol<size_t>& dims)
+    {
+        writer.save(strip, offset, dims);
+    });
+    writer.close();
 }
 
 }
@@ -164,18 +162,21 @@ void cropSICD(const std::string& inPathname,
               const std::vector<std::string>& schemaPaths,
               const types::RowCol<size_t>& aoiOffset,
               const types::RowCol<size_t>& aoiDims,
-              const std::string& outPathname)
+              const std::string& outPathname,
+              size_t numRowsPerStrip)
 {
     six::NITFReadControl reader;
     reader.load(inPathname, schemaPaths);
-    cropSICD(reader, schemaPaths, aoiOffset, aoiDims, outPathname);
+    cropSICD(reader, schemaPaths, aoiOffset, aoiDims, outPathname,
+             numRowsPerStrip);
 }
 
 void cropSICD(six::NITFReadControl& reader,
               const std::vector<std::string>& schemaPaths,
               const types::RowCol<size_t>& aoiOffset,
               const types::RowCol<size_t>& aoiDims,
-              const std::string& outPathname)
+              const std::string& outPathname,
+              size_t numRowsPerStrip)
 {
     // Make sure it's a SICD
     const auto container = reader.getContainer();
@@ -199,25 +200,28 @@ void cropSICD(six::NITFReadControl& reader,
 
     // Actually do the cropping
     ::cropSICD(reader, schemaPaths, *data, *geom, *projection,
-               aoiOffset, aoiDims, outPathname);
+               aoiOffset, aoiDims, outPathname, numRowsPerStrip);
 }
 
 void cropSICD(const std::string& inPathname,
               const std::vector<std::string>& schemaPaths,
               const std::vector<scene::Vector3>& corners,
               const std::string& outPathname,
-              bool trimCornersIfNeeded)
+              bool trimCornersIfNeeded,
+              size_t numRowsPerStrip)
 {
     six::NITFReadControl reader;
     reader.load(inPathname, schemaPaths);
-    cropSICD(reader, schemaPaths, corners, outPathname, trimCornersIfNeeded);
+    cropSICD(reader, schemaPaths, corners, outPathname, trimCornersIfNeeded,
+             numRowsPerStrip);
 }
 
 void cropSICD(six::NITFReadControl& reader,
               const std::vector<std::string>& schemaPaths,
               const std::vector<scene::Vector3>& corners,
               const std::string& outPathname,
-              bool trimCornersIfNeeded)
+              bool trimCornersIfNeeded,
+              size_t numRowsPerStrip)
 {
     if (corners.size() != 4)
     {
@@ -303,25 +307,28 @@ void cropSICD(six::NITFReadControl& reader,
 
     // Actually do the cropping
     ::cropSICD(reader, schemaPaths, *data, *geom, *projection,
-               upperLeft, aoiDims, outPathname);
+               upperLeft, aoiDims, outPathname, numRowsPerStrip);
 }
 
 void cropSICD(const std::string& inPathname,
               const std::vector<std::string>& schemaPaths,
               const std::vector<scene::LatLonAlt>& corners,
               const std::string& outPathname,
-              bool trimCornersIfNeeded)
+              bool trimCornersIfNeeded,
+              size_t numRowsPerStrip)
 {
     six::NITFReadControl reader;
     reader.load(inPathname, schemaPaths);
-    cropSICD(reader, schemaPaths, corners, outPathname, trimCornersIfNeeded);
+    cropSICD(reader, schemaPaths, corners, outPathname, trimCornersIfNeeded,
+             numRowsPerStrip);
 }
 
 void cropSICD(six::NITFReadControl& reader,
               const std::vector<std::string>& schemaPaths,
               const std::vector<scene::LatLonAlt>& corners,
               const std::string& outPathname,
-              bool trimCornersIfNeeded)
+              bool trimCornersIfNeeded,
+              size_t numRowsPerStrip)
 {
 
     std::vector<scene::Vector3> ecefCorners(corners.size());
@@ -332,7 +339,7 @@ void cropSICD(six::NITFReadControl& reader,
     }
 
     cropSICD(reader, schemaPaths, ecefCorners, outPathname,
-             trimCornersIfNeeded);
+             trimCornersIfNeeded, numRowsPerStrip);
 }
 }
 }
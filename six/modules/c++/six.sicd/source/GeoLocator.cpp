@@ -20,6 +20,9 @@
  *
  */
 
+#include <vector>
+
+#include <scene/Utilities.h>
 #include <six/sicd/AreaPlaneUtility.h>
 #include <six/sicd/GeoLocator.h>
 
@@ -37,6 +40,18 @@ LatLonAlt GeoLocator::geolocate(const RowColDouble& rowCol) const
     return mEcefToLla.transform(mRowColToEcef.rowColToECEF(rowCol));
 }
 
+void GeoLocator::geolocate(std::span<const RowColDouble> rowCols,
+                           std::span<LatLonAlt> locations) const
+{
+    std::vector<Vector3> ecef(rowCols.size());
+    for (size_t ii = 0; ii < rowCols.size(); ++ii)
+    {
+        ecef[ii] = mRowColToEcef.rowColToECEF(rowCols[ii]);
+    }
+    scene::Utilities::ecefToLatLon(
+            std::span<const Vector3>(ecef.data(), ecef.size()), locations);
+}
+
 scene::PlanarGridECEFTransform
 GeoLocator::buildTransformer(const ComplexData& complexData, bool shadowsDown) const
 {
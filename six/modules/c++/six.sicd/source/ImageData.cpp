@@ -22,11 +22,12 @@
 #include "six/sicd/ImageData.h"
 
 #include <stdexcept>
+#include <algorithm>
 #include <array>
 #include <std/memory>
 
 #include <gsl/gsl.h>
-#include <mt/Algorithm.h>
+#include <six/Executor.h>
 
 #include "six/sicd/GeoData.h"
 #include "six/sicd/Utilities.h"
@@ -217,8 +218,33 @@ const input_amplitudes_t& ImageData::get_RE32F_IM32F_values(const six::Amplitude
     return *pValues;
 }
 
+// The fewest pixels worth handing to another thread when the caller doesn't say (a cutoff of 0).
+// Looking up a pixel is much cheaper than finding the nearest neighbor.
+constexpr ptrdiff_t from_AMP8I_PHS8I_min_grain_size = 64 * 1024;
+constexpr ptrdiff_t to_AMP8I_PHS8I_min_grain_size = 4 * 1024;
+
+template<typename TInput, typename TResult, typename TFunc>
+static void transform(std::span<const TInput> inputs, std::span<TResult> results, TFunc f,
+    ptrdiff_t cutoff, ptrdiff_t default_min_grain_size, Executor* pExecutor)
+{
+    if (cutoff < 0)
+    {
+        (void) std::transform(inputs.begin(), inputs.end(), results.begin(), f);
+        return;
+    }
+
+    std::shared_ptr<Executor> pDefaultExecutor;
+    if (pExecutor == nullptr)
+    {
+        pDefaultExecutor = Executor::get();
+        pExecutor = pDefaultExecutor.get();
+    }
+    const auto min_grain_size = cutoff == 0 ? default_min_grain_size : cutoff;
+    pExecutor->transform(inputs.begin(), inputs.end(), results.begin(), f, gsl::narrow<size_t>(min_grain_size));
+}
+
 void ImageData::from_AMP8I_PHS8I(std::span<const AMP8I_PHS8I_t> inputs, std::span<std::complex<float>> results,
-    ptrdiff_t cutoff_) const
+    ptrdiff_t cutoff_, Executor* pExecutor) const
 {
     if (pixelType != PixelType::AMP8I_PHS8I)
     {
@@ -227,67 +253,39 @@ void ImageData::from_AMP8I_PHS8I(std::span<const AMP8I_PHS8I_t> inputs, std::spa
 
     std::unique_ptr<input_amplitudes_t> pValues_;
     const auto& values = get_RE32F_IM32F_values(amplitudeTable.get(), pValues_);
-    from_AMP8I_PHS8I(values, inputs, results, cutoff_);
+    from_AMP8I_PHS8I(values, inputs, results, cutoff_, pExecutor);
 }
 
 void ImageData::from_AMP8I_PHS8I(const input_amplitudes_t& values, std::span<const AMP8I_PHS8I_t> inputs, std::span<std::complex<float>> results,
-    ptrdiff_t cutoff_)
+    ptrdiff_t cutoff_, Executor* pExecutor)
 {
     const auto get_RE32F_IM32F_value_f = [&values](const six::sicd::AMP8I_PHS8I_t& v)
     {
         return values[v.first][v.second];
     };
-
-    if (cutoff_ < 0)
-    {
-        (void) std::transform(inputs.begin(), inputs.end(), results.begin(),
-            get_RE32F_IM32F_value_f);
-    }
-    else
-    {
-        // The value of "default_cutoff" was determined by testing; there is nothing special about it, feel free to change it.
-        constexpr auto dimension = 128 * 8;
-        constexpr auto default_cutoff = dimension * dimension;
-        const auto cutoff = cutoff_ == 0 ? default_cutoff : cutoff_;
-        (void) mt::transform_async(inputs.begin(), inputs.end(), results.begin(),
-            get_RE32F_IM32F_value_f, cutoff, std::launch::async);
-    }
+    transform(inputs, results, get_RE32F_IM32F_value_f, cutoff_, from_AMP8I_PHS8I_min_grain_size, pExecutor);
 }
 
 template<typename TConverter>
 static void to_AMP8I_PHS8I_(std::span<const cx_float> inputs, std::span<AMP8I_PHS8I_t> results,
-    const TConverter& tree, ptrdiff_t cutoff_)
+    const TConverter& tree, ptrdiff_t cutoff_, Executor* pExecutor)
 {
     const auto nearest_neighbor_f = [&](const std::complex<float>& v)
     {
         return tree.nearest_neighbor(v);
     };
-
-    if (cutoff_ < 0)
-    {
-        (void) std::transform(inputs.begin(), inputs.end(), results.begin(),
-            nearest_neighbor_f);
-    }
-    else
-    {
-        // The value of "default_cutoff" was determined by testing; there is nothing special about it, feel free to change it.
-        constexpr auto dimension = 128 * 8;
-        constexpr auto default_cutoff = dimension * dimension;
-        const auto cutoff = cutoff_ == 0 ? default_cutoff : cutoff_;
-        (void) mt::transform_async(inputs.begin(), inputs.end(), results.begin(),
-            nearest_neighbor_f, cutoff, std::launch::async);
-    }
+    transform(inputs, results, nearest_neighbor_f, cutoff_, to_AMP8I_PHS8I_min_grain_size, pExecutor);
 }
 void ImageData::to_AMP8I_PHS8I(std::span<const cx_float> inputs, std::span<AMP8I_PHS8I_t> results,
-    ptrdiff_t cutoff) const
+    ptrdiff_t cutoff, Executor* pExecutor) const
 {
-    to_AMP8I_PHS8I(amplitudeTable.get(), inputs, results, cutoff);
+    to_AMP8I_PHS8I(amplitudeTable.get(), inputs, results, cutoff, pExecutor);
 }
 void  ImageData::to_AMP8I_PHS8I(const AmplitudeTable* pAmplitudeTable,
-    std::span<const cx_float> inputs, std::span<AMP8I_PHS8I_t> results, ptrdiff_t cutoff)
+    std::span<const cx_float> inputs, std::span<AMP8I_PHS8I_t> results, ptrdiff_t cutoff, Executor* pExecutor)
 {
     // make a structure to quickly find the nearest neighbor
     std::unique_ptr<six::sicd::details::ComplexToAMP8IPHS8I> pConvert; // not-cached, non-NULL amplitudeTable
     const auto& converter = *(six::sicd::details::ComplexToAMP8IPHS8I::make(pAmplitudeTable, pConvert));
-    to_AMP8I_PHS8I_(inputs, results, converter, cutoff);
+    to_AMP8I_PHS8I_(inputs, results, converter, cutoff, pExecutor);
 }
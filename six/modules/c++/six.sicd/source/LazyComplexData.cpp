@@ -0,0 +1,264 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include <except/Exception.h>
+#include <io/StringStream.h>
+#include <nitf/IOHandle.hpp>
+#include <nitf/Reader.hpp>
+#include <str/Manip.h>
+#include <six/NITFReadControl.h>
+#include <six/sicd/LazyComplexData.h>
+
+namespace
+{
+size_t getBlockIndex(const std::string& name)
+{
+    const auto& names = six::sicd::ComplexXMLParser::getBlockNames();
+    const auto it = std::find(names.begin(), names.end(), name);
+    if (it == names.end())
+    {
+        throw except::Exception(Ctxt("Unknown SICD block: " + name));
+    }
+    return static_cast<size_t>(std::distance(names.begin(), it));
+}
+}
+
+namespace six
+{
+namespace sicd
+{
+LazyComplexData::LazyComplexData(
+        const std::string& xml,
+        const std::vector<std::filesystem::path>* pSchemaPaths,
+        logging::Logger* log) :
+    mXMLControl(log),
+    mXMLParser(new six::MinidomParser()),
+    mIsParsed(ComplexXMLParser::getBlockNames().size(), false)
+{
+    io::StringStream xmlStream;
+    xmlStream.write(xml.data(), xml.size());
+    try
+    {
+        mXMLParser->parse(xmlStream);
+    }
+    catch (const except::Throwable& ex)
+    {
+        throw except::Exception(ex, Ctxt("Invalid XML data"));
+    }
+
+    const xml::lite::Document& doc = getDocument(*mXMLParser);
+    const xml::lite::Element* const root = doc.getRootElement();
+    if (!str::startsWith(root->getLocalName(), "SICD"))
+    {
+        throw except::Exception(Ctxt("Expected SICD XML but got " +
+                                     root->getLocalName()));
+    }
+
+    // Validation needs the whole document, so it still happens up front
+    XMLControl::validate(xml, root->getUri(), pSchemaPaths, log);
+
+    mParser = mXMLControl.getParser(doc, mVersion);
+    mData.setVersion(mVersion);
+}
+
+std::unique_ptr<LazyComplexData> LazyComplexData::fromNITF(
+        const std::filesystem::path& pathname,
+        const std::vector<std::filesystem::path>* pSchemaPaths,
+        logging::Logger* log)
+{
+    nitf::IOHandle handle(pathname.string());
+    nitf::Reader reader;
+    const nitf::Record record = reader.read(handle);
+
+    nitf::List des = record.getDataExtensions();
+    for (uint32_t ii = 0; ii < des.getSize(); ++ii)
+    {
+        const nitf::DESegment segment(des[ii]);
+        if (NITFReadControl::getDataType(segment) != DataType::COMPLEX)
+        {
+            continue;
+        }
+
+        std::string xml(segment.getSubheader().getDataLength(), '\0');
+        nitf::SegmentReader deReader =
+                reader.newDEReader(static_cast<int>(ii));
+        deReader.read(&xml[0], xml.size());
+        return std::unique_ptr<LazyComplexData>(
+                new LazyComplexData(xml, pSchemaPaths, log));
+    }
+
+    throw except::Exception(Ctxt(pathname.string() + " has no SICD DES"));
+}
+
+void LazyComplexData::parse(const std::string& name) const
+{
+    const size_t index = getBlockIndex(name);
+    if (mIsParsed[index])
+    {
+        return;
+    }
+
+    if (name == "ImageFormation")
+    {
+        parse("RadarCollection");
+    }
+
+    const xml::lite::Document& doc = getDocument(*mXMLParser);
+    mParser->parseBlockFromXML(*doc.getRootElement(), name, mData);
+    mIsParsed[index] = true;
+
+    // Nothing left to parse, so the DOM isn't needed anymore
+    if (++mNumBlocksParsed == mIsParsed.size())
+    {
+        mXMLParser.reset();
+    }
+}
+
+void LazyComplexData::load(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    parse(name);
+}
+
+const CollectionInformation& LazyComplexData::getCollectionInformation() const
+{
+    load("CollectionInfo");
+    return *mData.collectionInformation;
+}
+
+const ImageCreation* LazyComplexData::getImageCreation() const
+{
+    load("ImageCreation");
+    return mData.imageCreation.get();
+}
+
+const ImageData& LazyComplexData::getImageData() const
+{
+    load("ImageData");
+    return *mData.imageData;
+}
+
+const GeoData& LazyComplexData::getGeoData() const
+{
+    load("GeoData");
+    return *mData.geoData;
+}
+
+const Grid& LazyComplexData::getGrid() const
+{
+    load("Grid");
+    return *mData.grid;
+}
+
+const Timeline& LazyComplexData::getTimeline() const
+{
+    load("Timeline");
+    return *mData.timeline;
+}
+
+const Position& LazyComplexData::getPosition() const
+{
+    load("Position");
+    return *mData.position;
+}
+
+const RadarCollection& LazyComplexData::getRadarCollection() const
+{
+    load("RadarCollection");
+    return *mData.radarCollection;
+}
+
+const ImageFormation& LazyComplexData::getImageFormation() const
+{
+    load("ImageFormation");
+    return *mData.imageFormation;
+}
+
+const SCPCOA& LazyComplexData::getSCPCOA() const
+{
+    load("SCPCOA");
+    return *mData.scpcoa;
+}
+
+const Radiometric* LazyComplexData::getRadiometric() const
+{
+    load("Radiometric");
+    return mData.radiometric.get();
+}
+
+const Antenna* LazyComplexData::getAntenna() const
+{
+    load("Antenna");
+    return mData.antenna.get();
+}
+
+const ErrorStatistics* LazyComplexData::getErrorStatistics() const
+{
+    load("ErrorStatistics");
+    return mData.errorStatistics.get();
+}
+
+const MatchInformation* LazyComplexData::getMatchInformation() const
+{
+    load("MatchInfo");
+    return mData.matchInformation.get();
+}
+
+const PFA* LazyComplexData::getPFA() const
+{
+    load("PFA");
+    return mData.pfa.get();
+}
+
+const RMA* LazyComplexData::getRMA() const
+{
+    load("RMA");
+    return mData.rma.get();
+}
+
+const RgAzComp* LazyComplexData::getRgAzComp() const
+{
+    load("RgAzComp");
+    return mData.rgAzComp.get();
+}
+
+std::unique_ptr<ComplexData> LazyComplexData::getComplexData() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (const auto& name : ComplexXMLParser::getBlockNames())
+    {
+        parse(name);
+    }
+    return std::unique_ptr<ComplexData>(
+            static_cast<ComplexData*>(mData.clone()));
+}
+
+size_t LazyComplexData::getNumBlocksParsed() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mNumBlocksParsed;
+}
+}
+}
@@ -0,0 +1,302 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <six/sicd/MemoryMappedReadControl.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <std/bit>
+
+#include <except/Exception.h>
+#include <sys/SystemException.h>
+
+#undef min
+#undef max
+
+namespace six
+{
+namespace sicd
+{
+// Read-only mapping of an entire file
+struct MemoryMappedReadControl::MappedFile final
+{
+    explicit MappedFile(const std::string& pathname)
+    {
+#if defined(_WIN32)
+        mFile = ::CreateFileA(pathname.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+        if (mFile == INVALID_HANDLE_VALUE)
+        {
+            throw sys::SystemException(Ctxt("Unable to open " + pathname));
+        }
+
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(mFile, &size))
+        {
+            close();
+            throw sys::SystemException(Ctxt("Unable to size " + pathname));
+        }
+        mSize = static_cast<size_t>(size.QuadPart);
+
+        if (mSize > 0)
+        {
+            mMapping = ::CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0,
+                                            nullptr);
+            if (mMapping != nullptr)
+            {
+                mData = ::MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+            }
+            if (mData == nullptr)
+            {
+                close();
+                throw sys::SystemException(Ctxt("Unable to map " + pathname));
+            }
+        }
+#else
+        const int fd = ::open(pathname.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw sys::SystemException(Ctxt("Unable to open " + pathname));
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw sys::SystemException(Ctxt("Unable to stat " + pathname));
+        }
+        mSize = static_cast<size_t>(info.st_size);
+
+        if (mSize > 0)
+        {
+            void* const data = ::mmap(nullptr, mSize, PROT_READ, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                ::close(fd);
+                throw sys::SystemException(Ctxt("Unable to map " + pathname));
+            }
+            mData = data;
+        }
+
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::byte* data() const
+    {
+        return static_cast<const std::byte*>(mData);
+    }
+
+    size_t size() const
+    {
+        return mSize;
+    }
+
+private:
+    void close()
+    {
+#if defined(_WIN32)
+        if (mData != nullptr)
+        {
+            ::UnmapViewOfFile(mData);
+        }
+        if (mMapping != nullptr)
+        {
+            ::CloseHandle(mMapping);
+        }
+        if (mFile != INVALID_HANDLE_VALUE)
+        {
+            ::CloseHandle(mFile);
+        }
+        mMapping = nullptr;
+        mFile = INVALID_HANDLE_VALUE;
+#else
+        if (mData != nullptr)
+        {
+            ::munmap(mData, mSize);
+        }
+#endif
+        mData = nullptr;
+    }
+
+#if defined(_WIN32)
+    HANDLE mFile = INVALID_HANDLE_VALUE;
+    HANDLE mMapping = nullptr;
+#endif
+    void* mData = nullptr;
+    size_t mSize = 0;
+};
+
+MemoryMappedReadControl::MemoryMappedReadControl() = default;
+MemoryMappedReadControl::~MemoryMappedReadControl() = default;
+
+void MemoryMappedReadControl::load(
+        const std::string& fromFile,
+        const std::vector<std::string>* pSchemaPaths)
+{
+    mSegments.clear();
+    mFile.reset();
+
+    NITFReadControl::load(fromFile, pSchemaPaths);
+    map(fromFile);
+}
+
+void MemoryMappedReadControl::load(
+        const std::filesystem::path& fromFile,
+        const std::vector<std::filesystem::path>* pSchemaPaths)
+{
+    mSegments.clear();
+    mFile.reset();
+
+    NITFReadControl::load(fromFile, pSchemaPaths);
+    map(fromFile.string());
+}
+
+void MemoryMappedReadControl::map(const std::string& pathname)
+{
+    if (mContainer->getDataType() != DataType::COMPLEX)
+    {
+        throw except::Exception(Ctxt(
+                "Only SICDs can be memory mapped: " + pathname));
+    }
+
+    const NITFImageInfo& info = *mInfos.at(0);
+    const Data& data = *info.getData();
+    mNumBytesPerRow = data.getNumCols() * data.getNumBytesPerPixel();
+
+    // Two components (real/imaginary or amplitude/phase) per pixel
+    mElementSize = data.getNumBytesPerPixel() / 2;
+
+    std::unique_ptr<MappedFile> file(new MappedFile(pathname));
+
+    const std::vector<NITFSegmentInfo> imageSegments =
+            info.getImageSegments();
+    nitf::List images = mRecord.getImages();
+    std::vector<MappedImageSegment> segments;
+    for (size_t ii = 0; ii < imageSegments.size(); ++ii)
+    {
+        const size_t nitfSegmentIdx = info.getStartIndex() + ii;
+        const auto segment =
+                static_cast<nitf::ImageSegment>(images[nitfSegmentIdx]);
+        const auto subheader = segment.getSubheader();
+
+        if (subheader.imageCompressionString() != "NC")
+        {
+            throw except::Exception(Ctxt(
+                    "Image segment " + std::to_string(nitfSegmentIdx) +
+                    " is compressed; it can't be memory mapped"));
+        }
+        if (subheader.numBlocksPerRow() != 1 ||
+            subheader.numBlocksPerCol() != 1)
+        {
+            throw except::Exception(Ctxt(
+                    "Image segment " + std::to_string(nitfSegmentIdx) +
+                    " is blocked; it can't be memory mapped"));
+        }
+
+        MappedImageSegment mapped;
+        mapped.firstRow = imageSegments[ii].getFirstRow();
+        mapped.numRows = imageSegments[ii].getNumRows();
+
+        // Anything other than tightly packed rows (e.g. pad pixels) means
+        // the rows can't be viewed in place
+        const uint64_t offset = segment.getImageOffset();
+        const uint64_t numBytes =
+                static_cast<uint64_t>(mapped.numRows) * mNumBytesPerRow;
+        if (segment.getImageEnd() - offset != numBytes ||
+            offset + numBytes > file->size())
+        {
+            throw except::Exception(Ctxt(
+                    "Image segment " + std::to_string(nitfSegmentIdx) +
+                    " is not stored as contiguous rows of pixels"));
+        }
+
+        mapped.pixels = std::span<const std::byte>(
+                file->data() + offset, static_cast<size_t>(numBytes));
+        segments.push_back(mapped);
+    }
+
+    mFile = std::move(file);
+    mSegments = std::move(segments);
+}
+
+const std::vector<MappedImageSegment>&
+MemoryMappedReadControl::getImageSegments() const
+{
+    if (mFile.get() == nullptr)
+    {
+        throw except::Exception(Ctxt(
+                "No SICD has been mapped; load one by pathname first"));
+    }
+    return mSegments;
+}
+
+std::span<const std::byte>
+MemoryMappedReadControl::getRows(size_t startRow, size_t numRows) const
+{
+    for (const auto& segment : getImageSegments())
+    {
+        if (startRow >= segment.firstRow &&
+            startRow < segment.firstRow + segment.numRows)
+        {
+            if (startRow + numRows > segment.firstRow + segment.numRows)
+            {
+                throw except::Exception(Ctxt(
+                        "Rows [" + std::to_string(startRow) + ", " +
+                        std::to_string(startRow + numRows) +
+                        ") cross an image segment boundary"));
+            }
+
+            const size_t offset =
+                    (startRow - segment.firstRow) * mNumBytesPerRow;
+            return std::span<const std::byte>(segment.pixels.data() + offset,
+                                              numRows * mNumBytesPerRow);
+        }
+    }
+
+    throw except::Exception(Ctxt(
+            "Row " + std::to_string(startRow) + " is out of bounds"));
+}
+
+bool MemoryMappedReadControl::needsByteSwap() const
+{
+    return (mElementSize > 1) && (std::endian::native == std::endian::little);
+}
+}
+}
@@ -0,0 +1,330 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <six/sicd/OutputPlaneResampler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <sstream>
+
+#include <except/Exception.h>
+#include <scene/GridECEFTransform.h>
+#include <scene/ProjectionModel.h>
+#include <scene/SceneGeometry.h>
+#include <six/sicd/Utilities.h>
+
+namespace
+{
+// Output tiles are this many pixels on a side; big enough that handing one
+// to a thread is worth it, small enough that the slant plane samples a
+// tile reads stay in cache
+const size_t TILE_SIZE = 128;
+
+// Grid points projected by each call to the batch sceneToImage()
+const size_t MIN_PROJECTION_GRAIN_SIZE = 64;
+
+six::Executor& getExecutor(six::Executor* pExecutor,
+                           std::shared_ptr<six::Executor>& pDefaultExecutor)
+{
+    if (pExecutor == nullptr)
+    {
+        pDefaultExecutor = six::Executor::get();
+        pExecutor = pDefaultExecutor.get();
+    }
+    return *pExecutor;
+}
+
+types::RowCol<double> lerp(const types::RowCol<double>& lhs,
+                           const types::RowCol<double>& rhs,
+                           double fraction)
+{
+    return types::RowCol<double>(lhs.row + (rhs.row - lhs.row) * fraction,
+                                 lhs.col + (rhs.col - lhs.col) * fraction);
+}
+
+template <typename T>
+T identity(const T& sample)
+{
+    return sample;
+}
+
+float magnitude(const std::complex<float>& sample)
+{
+    return std::abs(sample);
+}
+}
+
+namespace six
+{
+namespace sicd
+{
+const size_t OutputPlaneResampler::DEFAULT_GRID_SPACING = 16;
+
+OutputPlaneResampler::OutputPlaneResampler(const ComplexData& complexData,
+                                           size_t gridSpacing,
+                                           Executor* pExecutor) :
+    mOutputDims(0, 0),
+    mSlantDims(complexData.getNumRows(), complexData.getNumCols()),
+    mGridSpacing(gridSpacing),
+    mGridDims(0, 0)
+{
+    if (mGridSpacing == 0)
+    {
+        throw except::Exception(Ctxt("Grid spacing must be positive"));
+    }
+
+    std::unique_ptr<scene::SceneGeometry> geometry;
+    std::unique_ptr<scene::ProjectionModel> projectionModel;
+    AreaPlane areaPlane;
+    Utilities::getModelComponents(complexData,
+                                  geometry,
+                                  projectionModel,
+                                  areaPlane);
+
+    mOutputDims.row = areaPlane.xDirection->elements;
+    mOutputDims.col = areaPlane.yDirection->elements;
+    mGridDims.row = Utilities::getNumGridPoints(mOutputDims.row,
+                                                mGridSpacing);
+    mGridDims.col = Utilities::getNumGridPoints(mOutputDims.col,
+                                                mGridSpacing);
+
+    // Grid points in ECEF, in the same way as
+    // Utilities::projectPixelsToSlantPlane()
+    const scene::PlanarGridECEFTransform ecefTransform(
+            types::RowCol<double>(areaPlane.xDirection->spacing,
+                                  areaPlane.yDirection->spacing),
+            areaPlane.referencePoint.rowCol,
+            areaPlane.xDirection->unitVector,
+            areaPlane.yDirection->unitVector,
+            areaPlane.referencePoint.ecef);
+    std::vector<scene::Vector3> gridECEF(mGridDims.area());
+    for (size_t row = 0, idx = 0; row < mGridDims.row; ++row)
+    {
+        for (size_t col = 0; col < mGridDims.col; ++col, ++idx)
+        {
+            gridECEF[idx] = ecefTransform.rowColToECEF(types::RowCol<double>(
+                    static_cast<double>(row * mGridSpacing),
+                    static_cast<double>(col * mGridSpacing)));
+        }
+    }
+
+    // Project to slant plane meters from the SCP.  Points that fail come
+    // back as NaNs, and so do the output pixels near them.
+    mGrid.resize(gridECEF.size());
+    std::shared_ptr<Executor> pDefaultExecutor;
+    getExecutor(pExecutor, pDefaultExecutor).parallelFor(
+            gridECEF.size(),
+            [&](size_t begin, size_t end)
+    {
+        projectionModel->sceneToImage(
+                std::span<const scene::Vector3>(gridECEF.data() + begin,
+                                                end - begin),
+                std::span<types::RowCol<double>>(mGrid.data() + begin,
+                                                 end - begin));
+    }, MIN_PROJECTION_GRAIN_SIZE);
+
+    // Convert to slant plane pixels
+    const types::RowCol<double> spSampleSpacing(
+            complexData.grid->row->sampleSpacing,
+            complexData.grid->col->sampleSpacing);
+    const types::RowCol<double> spSCP(complexData.imageData->scpPixel);
+    const types::RowCol<double> spOffset(
+            spSCP.row - static_cast<double>(complexData.imageData->firstRow),
+            spSCP.col - static_cast<double>(complexData.imageData->firstCol));
+    for (auto& spPixel : mGrid)
+    {
+        spPixel = spPixel / spSampleSpacing + spOffset;
+    }
+}
+
+types::RowCol<double> OutputPlaneResampler::toSlantPixel(
+        const types::RowCol<double>& outputPixel) const
+{
+    // Pixels off the edge of the grid are extrapolated from its edge cells
+    const types::RowCol<double> gridPixel(outputPixel.row / mGridSpacing,
+                                          outputPixel.col / mGridSpacing);
+    const double maxCellRow = static_cast<double>(mGridDims.row - 2);
+    const double maxCellCol = static_cast<double>(mGridDims.col - 2);
+    const size_t cellRow = static_cast<size_t>(
+            std::min(std::max(std::floor(gridPixel.row), 0.0), maxCellRow));
+    const size_t cellCol = static_cast<size_t>(
+            std::min(std::max(std::floor(gridPixel.col), 0.0), maxCellCol));
+
+    const types::RowCol<double>* const top =
+            &mGrid[cellRow * mGridDims.col + cellCol];
+    const types::RowCol<double>* const bottom = top + mGridDims.col;
+    const double rowFraction = gridPixel.row - cellRow;
+    const double colFraction = gridPixel.col - cellCol;
+    return lerp(lerp(top[0], top[1], colFraction),
+                lerp(bottom[0], bottom[1], colFraction),
+                rowFraction);
+}
+
+void OutputPlaneResampler::interpolateRow(
+        size_t outputRow,
+        size_t startCol,
+        size_t endCol,
+        types::RowCol<double>* slantPixels) const
+{
+    const size_t cellRow = std::min(outputRow / mGridSpacing,
+                                    mGridDims.row - 2);
+    const double rowFraction =
+            static_cast<double>(outputRow - cellRow * mGridSpacing) /
+            mGridSpacing;
+    const types::RowCol<double>* const top =
+            &mGrid[cellRow * mGridDims.col];
+    const types::RowCol<double>* const bottom = top + mGridDims.col;
+
+    // Interpolate down to this row at the grid columns on either side of
+    // each cell, then across the cell
+    size_t col = startCol;
+    while (col < endCol)
+    {
+        const size_t cellCol = std::min(col / mGridSpacing,
+                                        mGridDims.col - 2);
+        const size_t cellStart = cellCol * mGridSpacing;
+        const size_t cellEnd = cellCol + 2 == mGridDims.col ?
+                endCol : std::min(endCol, cellStart + mGridSpacing);
+        const types::RowCol<double> left =
+                lerp(top[cellCol], bottom[cellCol], rowFraction);
+        const types::RowCol<double> right =
+                lerp(top[cellCol + 1], bottom[cellCol + 1], rowFraction);
+        for (; col < cellEnd; ++col, ++slantPixels)
+        {
+            *slantPixels = lerp(left, right,
+                                static_cast<double>(col - cellStart) /
+                                        mGridSpacing);
+        }
+    }
+}
+
+template <typename InT, typename OutT, typename DetectT>
+void OutputPlaneResampler::resample(std::span<const InT> slantImage,
+                                    std::span<OutT> outputImage,
+                                    DetectT detect,
+                                    Executor* pExecutor) const
+{
+    if (slantImage.size() != mSlantDims.area())
+    {
+        std::ostringstream ostr;
+        ostr << "Expected " << mSlantDims.area()
+             << " slant plane samples but got " << slantImage.size();
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+    if (outputImage.size() != mOutputDims.area())
+    {
+        std::ostringstream ostr;
+        ostr << "Expected " << mOutputDims.area()
+             << " output plane samples but got " << outputImage.size();
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    const types::RowCol<size_t> numTiles(
+            (mOutputDims.row + TILE_SIZE - 1) / TILE_SIZE,
+            (mOutputDims.col + TILE_SIZE - 1) / TILE_SIZE);
+    const double maxRow = static_cast<double>(mSlantDims.row) - 1.0;
+    const double maxCol = static_cast<double>(mSlantDims.col) - 1.0;
+
+    std::shared_ptr<Executor> pDefaultExecutor;
+    getExecutor(pExecutor, pDefaultExecutor).parallelFor(
+            numTiles.area(),
+            [&](size_t begin, size_t end)
+    {
+        std::vector<types::RowCol<double> > slantPixels(TILE_SIZE);
+        for (size_t tile = begin; tile < end; ++tile)
+        {
+            const size_t startRow = (tile / numTiles.col) * TILE_SIZE;
+            const size_t startCol = (tile % numTiles.col) * TILE_SIZE;
+            const size_t endRow = std::min(startRow + TILE_SIZE,
+                                           mOutputDims.row);
+            const size_t endCol = std::min(startCol + TILE_SIZE,
+                                           mOutputDims.col);
+            for (size_t row = startRow; row < endRow; ++row)
+            {
+                interpolateRow(row, startCol, endCol, slantPixels.data());
+                OutT* const output =
+                        outputImage.data() + row * mOutputDims.col;
+                for (size_t col = startCol; col < endCol; ++col)
+                {
+                    // Written this way round so NaNs are out of bounds too
+                    const types::RowCol<double>& pixel =
+                            slantPixels[col - startCol];
+                    if (!(pixel.row >= 0.0 && pixel.row <= maxRow &&
+                          pixel.col >= 0.0 && pixel.col <= maxCol))
+                    {
+                        output[col] = OutT(0);
+                        continue;
+                    }
+
+                    const size_t row0 = static_cast<size_t>(pixel.row);
+                    const size_t col0 = static_cast<size_t>(pixel.col);
+                    const size_t row1 = std::min(row0 + 1, mSlantDims.row - 1);
+                    const size_t col1 = std::min(col0 + 1, mSlantDims.col - 1);
+                    const float rowFraction =
+                            static_cast<float>(pixel.row - row0);
+                    const float colFraction =
+                            static_cast<float>(pixel.col - col0);
+
+                    const InT* const top =
+                            slantImage.data() + row0 * mSlantDims.col;
+                    const InT* const bottom =
+                            slantImage.data() + row1 * mSlantDims.col;
+                    const OutT topLeft = detect(top[col0]);
+                    const OutT topRight = detect(top[col1]);
+                    const OutT bottomLeft = detect(bottom[col0]);
+                    const OutT bottomRight = detect(bottom[col1]);
+                    const OutT upper =
+                            topLeft + (topRight - topLeft) * colFraction;
+                    const OutT lower =
+                            bottomLeft + (bottomRight - bottomLeft) * colFraction;
+                    output[col] = upper + (lower - upper) * rowFraction;
+                }
+            }
+        }
+    });
+}
+
+void OutputPlaneResampler::resample(
+        std::span<const std::complex<float>> slantImage,
+        std::span<std::complex<float>> outputImage,
+        Executor* pExecutor) const
+{
+    resample(slantImage, outputImage, identity<std::complex<float> >,
+             pExecutor);
+}
+
+void OutputPlaneResampler::resample(std::span<const float> slantImage,
+                                    std::span<float> outputImage,
+                                    Executor* pExecutor) const
+{
+    resample(slantImage, outputImage, identity<float>, pExecutor);
+}
+
+void OutputPlaneResampler::resampleDetected(
+        std::span<const std::complex<float>> slantImage,
+        std::span<float> outputImage,
+        Executor* pExecutor) const
+{
+    resample(slantImage, outputImage, magnitude, pExecutor);
+}
+}
+}
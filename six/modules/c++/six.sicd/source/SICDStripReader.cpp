@@ -0,0 +1,277 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <six/sicd/SICDStripReader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <std/cstddef>
+
+#include <except/Exception.h>
+#include <mt/RequestQueue.h>
+#include <mt/ThreadGroup.h>
+#include <sys/Runnable.h>
+#include <six/ComplexConversion.h>
+#include <six/sicd/ImageData.h>
+#include <six/sicd/Utilities.h>
+
+namespace
+{
+// A buffer from the pool along with the rows it holds.  A null buffer marks
+// the end of the image (or a failure).
+struct FilledStrip final
+{
+    std::complex<float>* buffer = nullptr;
+    size_t firstRow = 0;
+    size_t numRows = 0;
+};
+}
+
+namespace six
+{
+namespace sicd
+{
+struct SICDStripReader::Impl final
+{
+    Impl(NITFReadControl& reader,
+         const ComplexData& complexData,
+         size_t numRowsPerStrip,
+         size_t numBuffers) :
+        reader(reader),
+        pixelType(complexData.getPixelType()),
+        dims(getExtent(complexData)),
+        numRowsPerStrip(std::min(numRowsPerStrip, dims.row)),
+        lookup(nullptr),
+        stop(false),
+        done(false),
+        current(nullptr)
+    {
+        if (numRowsPerStrip == 0 || numBuffers == 0)
+        {
+            throw except::Exception(Ctxt(
+                    "Strips must have at least one row and one buffer"));
+        }
+
+        if (pixelType == PixelType::AMP8I_PHS8I)
+        {
+            lookup = &ImageData::get_RE32F_IM32F_values(
+                    complexData.imageData->amplitudeTable.get(), lookupScope);
+        }
+        else if (pixelType != PixelType::RE32F_IM32F &&
+                 pixelType != PixelType::RE16I_IM16I)
+        {
+            throw except::Exception(Ctxt(
+                    complexData.getName() + " has an unknown pixel type"));
+        }
+
+        // RE32F_IM32F is read straight into the output buffer; everything
+        // else goes through one strip of raw pixels first
+        if (pixelType != PixelType::RE32F_IM32F)
+        {
+            raw.resize(this->numRowsPerStrip * dims.col *
+                       complexData.getNumBytesPerPixel());
+        }
+
+        buffers.resize(numBuffers);
+        for (auto& buffer : buffers)
+        {
+            buffer.reset(new std::complex<float>[
+                    this->numRowsPerStrip * dims.col]);
+            free.enqueue(buffer.get());
+        }
+    }
+
+    // Runs on the background thread
+    void readAhead()
+    {
+        try
+        {
+            for (size_t row = 0; row < dims.row; row += numRowsPerStrip)
+            {
+                std::complex<float>* buffer = nullptr;
+                free.dequeue(buffer);
+                if (stop)
+                {
+                    break;
+                }
+
+                FilledStrip strip;
+                strip.buffer = buffer;
+                strip.firstRow = row;
+                strip.numRows = std::min(numRowsPerStrip, dims.row - row);
+                read(strip);
+                filled.enqueue(strip);
+            }
+        }
+        catch (...)
+        {
+            // Wake up next(), which will rethrow via joinAll()
+            filled.enqueue(FilledStrip());
+            throw;
+        }
+
+        filled.enqueue(FilledStrip());
+    }
+
+    void read(const FilledStrip& strip)
+    {
+        const size_t numPixels = strip.numRows * dims.col;
+
+        six::Region region;
+        setOffset(region, types::RowCol<size_t>(strip.firstRow, 0));
+        setDims(region, types::RowCol<size_t>(strip.numRows, dims.col));
+
+        if (pixelType == PixelType::RE32F_IM32F)
+        {
+            void* const buffer = strip.buffer;
+            region.setBuffer(static_cast<std::byte*>(buffer));
+            reader.interleaved(region, 0);
+            return;
+        }
+
+        region.setBuffer(raw.data());
+        reader.interleaved(region, 0);
+
+        if (pixelType == PixelType::RE16I_IM16I)
+        {
+            promoteToComplexFloat(raw.data(), sizeof(std::complex<int16_t>),
+                                  numPixels, false, strip.buffer);
+        }
+        else
+        {
+            static_assert(sizeof(uint8_t) * 2 == sizeof(AMP8I_PHS8I_t),
+                          "expected packed layout in pair");
+            const void* const raw_ = raw.data();
+            const std::span<const AMP8I_PHS8I_t> input(
+                    static_cast<const AMP8I_PHS8I_t*>(raw_), numPixels);
+            const std::span<std::complex<float> > output(strip.buffer,
+                                                         numPixels);
+
+            // We're already off the caller's thread; don't fan out further
+            static const ptrdiff_t kDefaultCutoff = 0;
+            ImageData::from_AMP8I_PHS8I(*lookup, input, output,
+                                        kDefaultCutoff);
+        }
+    }
+
+    NITFReadControl& reader;
+    const PixelType pixelType;
+    const types::RowCol<size_t> dims;
+    const size_t numRowsPerStrip;
+
+    std::unique_ptr<input_amplitudes_t> lookupScope;
+    const input_amplitudes_t* lookup;
+
+    std::vector<std::byte> raw;
+    std::vector<std::unique_ptr<std::complex<float>[]> > buffers;
+    mt::RequestQueue<std::complex<float>*> free;
+    mt::RequestQueue<FilledStrip> filled;
+
+    std::atomic<bool> stop;
+    bool done;
+    std::complex<float>* current;
+
+    // Declared last so it's joined before anything it uses goes away
+    mt::ThreadGroup thread;
+
+    class ReadAheadRunnable final : public sys::Runnable
+    {
+    public:
+        explicit ReadAheadRunnable(Impl& impl) : mImpl(impl)
+        {
+        }
+
+        void run() override
+        {
+            mImpl.readAhead();
+        }
+
+    private:
+        Impl& mImpl;
+    };
+};
+
+SICDStripReader::SICDStripReader(NITFReadControl& reader,
+                                 const ComplexData& complexData,
+                                 size_t numRowsPerStrip,
+                                 size_t numBuffers) :
+    mImpl(new Impl(reader, complexData, numRowsPerStrip, numBuffers))
+{
+    mImpl->thread.createThread(std::unique_ptr<sys::Runnable>(
+            new Impl::ReadAheadRunnable(*mImpl)));
+}
+
+SICDStripReader::~SICDStripReader()
+{
+    if (!mImpl->done)
+    {
+        // The background thread is either reading, or waiting on a free
+        // buffer; either way, this gets it to stop
+        mImpl->stop = true;
+        mImpl->free.enqueue(nullptr);
+        try
+        {
+            mImpl->thread.joinAll();
+        }
+        catch (...)
+        {
+        }
+    }
+}
+
+bool SICDStripReader::next(SICDStrip& strip)
+{
+    if (mImpl->current != nullptr)
+    {
+        mImpl->free.enqueue(mImpl->current);
+        mImpl->current = nullptr;
+    }
+
+    if (mImpl->done)
+    {
+        return false;
+    }
+
+    FilledStrip filled;
+    mImpl->filled.dequeue(filled);
+    if (filled.buffer == nullptr)
+    {
+        mImpl->done = true;
+        mImpl->thread.joinAll();
+        return false;
+    }
+
+    mImpl->current = filled.buffer;
+    strip.firstRow = filled.firstRow;
+    strip.numRows = filled.numRows;
+    strip.pixels = std::span<const std::complex<float> >(
+            filled.buffer, filled.numRows * mImpl->dims.col);
+    return true;
+}
+
+size_t SICDStripReader::getNumRowsPerStrip() const
+{
+    return mImpl->numRowsPerStrip;
+}
+}
+}
@@ -23,14 +23,18 @@
 #include <six/sicd/SICDByteProvider.h>
 #include <six/sicd/SICDWriteControl.h>
 
+#include <std/cstddef>
+
+#include <except/Exception.h>
+#include <six/Executor.h>
+
 namespace six
 {
 namespace sicd
 {
 SICDWriteControl::SICDWriteControl(const std::string& outputPathname,
                                    const std::vector<std::string>& schemaPaths) :
-    mIO(new nitf::BufferedWriter(outputPathname,
-                                 NITFHeaderCreator::DEFAULT_BUFFER_SIZE)),
+    mFileWriter(new PositionalFileWriter(outputPathname)),
     mSchemaPaths(schemaPaths),
     mHaveWrittenHeaders(false)
 {
@@ -45,30 +49,24 @@ void SICDWriteControl::initialize(const ComplexData& data)
     initialize(container);
 }
 
-void SICDWriteControl::write(const std::vector<sys::byte>& data)
+void SICDWriteControl::writeAt(nitf::Off offset,
+                               const std::vector<sys::byte>& data)
 {
-    if (!data.empty())
-    {
-        mIO->write(data.data(), data.size());
-    }
+    mFileWriter->writeAt(offset, data.data(), data.size());
 }
-void SICDWriteControl::write(const std::vector<std::byte>& data)
+void SICDWriteControl::writeAt(nitf::Off offset,
+                               const std::vector<std::byte>& data)
 {
-    if (!data.empty())
-    {
-        mIO->write(data.data(), data.size());
-    }
+    mFileWriter->writeAt(offset, data.data(), data.size());
 }
 
 void SICDWriteControl::writeHeaders()
 {
-    mWriter.prepareIO(*mIO, getRecord());
-
     const SICDByteProvider byteProvider(*this, mSchemaPaths);
     mImageSegmentInfo = getInfos().at(0)->getImageSegments();
 
     // Write the file header
-    write(byteProvider.getFileHeader());
+    writeAt(0, byteProvider.getFileHeader());
 
     // Write image subheaders
     auto& imageSubheaders =
@@ -79,49 +77,54 @@ void SICDWriteControl::writeHeaders()
     mImageDataStart.resize(imageSubheaders.size());
     for (size_t ii = 0; ii < imageSubheaders.size(); ++ii)
     {
-        mIO->seek(imageSubheaderFileOffsets[ii], NITF_SEEK_SET);
-        write(imageSubheaders[ii]);
-        mImageDataStart[ii] = mIO->tell();
+        writeAt(imageSubheaderFileOffsets[ii], imageSubheaders[ii]);
+        mImageDataStart[ii] = imageSubheaderFileOffsets[ii] +
+                static_cast<nitf::Off>(imageSubheaders[ii].size());
     }
 
-    // Write DES subheader and data (i.e. XML)
-    mIO->seek(byteProvider.getDesSubheaderFileOffset(), NITF_SEEK_SET);
-    write(byteProvider.getDesSubheaderAndData());
+    // Write DES subheader and data (i.e. XML).  It goes last, so this makes
+    // the file its full length.
+    writeAt(byteProvider.getDesSubheaderFileOffset(),
+            byteProvider.getDesSubheaderAndData());
 }
 
 void SICDWriteControl::save(void* imageData,
                             const types::RowCol<size_t>& offset,
                             const types::RowCol<size_t>& dims,
-                            bool restoreData)
+                            bool /*restoreData*/)
+{
+    save(static_cast<const void*>(imageData), offset, dims);
+}
+
+void SICDWriteControl::save(const void* imageData,
+                            const types::RowCol<size_t>& offset,
+                            const types::RowCol<size_t>& dims)
 {
     if (getContainer().get() == nullptr)
     {
         throw except::Exception(Ctxt(
                 "initialize() must be called prior to calling save()"));
     }
+    if (mFileWriter.get() == nullptr)
+    {
+        throw except::Exception(Ctxt("save() can't be called after close()"));
+    }
 
     // The first time through we'll write out all the headers
-    if (!mHaveWrittenHeaders)
     {
-        writeHeaders();
-        mHaveWrittenHeaders = true;
+        std::lock_guard<std::mutex> lock(mHeaderMutex);
+        if (!mHaveWrittenHeaders)
+        {
+            writeHeaders();
+            mHaveWrittenHeaders = true;
+        }
     }
 
     const six::Data* const data = getContainer()->getData(0);
     constexpr size_t NUM_BANDS = 2;
     const size_t numBytesPerPixel = data->getNumBytesPerPixel() / NUM_BANDS;
-    const size_t numPixelsTotal = dims.area() * NUM_BANDS;
-    const bool doByteSwap = shouldByteSwap();
-
-    // Byte swap if needed
-    if (doByteSwap)
-    {
-        sys::byteSwap(imageData,
-                      static_cast<unsigned short>(numBytesPerPixel),
-                      numPixelsTotal);
-    }
-
     const size_t globalNumCols = data->getNumCols();
+    const auto executor = Executor::get(getOptions());
 
     for (size_t seg = 0; seg < mImageSegmentInfo.size(); ++seg)
     {
@@ -138,7 +141,7 @@ void SICDWriteControl::save(void* imageData,
                     startGlobalRowToWrite - offset.row;
             const size_t numBytesPerRow = dims.col * numBytesPerPixel * NUM_BANDS;
             const std::byte* imageDataPtr =
-                    static_cast<std::byte*>(imageData) +
+                    static_cast<const std::byte*>(imageData) +
                     startLocalRowToWrite * numBytesPerRow;
 
             // Now figure out our offset into the segment
@@ -147,49 +150,26 @@ void SICDWriteControl::save(void* imageData,
                     startGlobalRowToWrite - segStartRow;
             const size_t pixelOffset =
                     startRowInSegToWrite * globalNumCols + offset.col;
-            size_t byteOffset = mImageDataStart[seg] +
+            const size_t byteOffset = mImageDataStart[seg] +
                     pixelOffset * numBytesPerPixel * NUM_BANDS;
 
             // TODO: For SIDD we'll have to handle blocking too
 
-            if (dims.col == globalNumCols)
-            {
-                // Life is easy - one write
-                mIO->seek(static_cast<nitf::Off>(byteOffset), NITF_SEEK_SET);
-                mIO->write(imageDataPtr,
-                           numRowsToWrite * dims.col * NUM_BANDS *
-                               numBytesPerPixel);
-            }
-            else
-            {
-                // Need to write out partial rows
-                const size_t rowSeekStride =
-                        globalNumCols * numBytesPerPixel * NUM_BANDS;
-
-                for (size_t row = 0;
-                     row < numRowsToWrite;
-                     ++row, byteOffset += rowSeekStride,
-                         imageDataPtr += numBytesPerRow)
-                {
-                    mIO->seek(static_cast<nitf::Off>(byteOffset), NITF_SEEK_SET);
-                    mIO->write(imageDataPtr, numBytesPerRow);
-                }
-            }
+            mFileWriter->writeRows(
+                    static_cast<nitf::Off>(byteOffset),
+                    imageDataPtr,
+                    numRowsToWrite,
+                    numBytesPerRow,
+                    globalNumCols * numBytesPerPixel * NUM_BANDS,
+                    shouldByteSwap() ? numBytesPerPixel : 0,
+                    executor.get());
         }
     }
-
-    // Byte swap back if needed
-    if (doByteSwap && restoreData)
-    {
-        sys::byteSwap(imageData,
-                      static_cast<unsigned short>(numBytesPerPixel),
-                      numPixelsTotal);
-    }
 }
 
 void SICDWriteControl::close()
 {
-    mIO->close();
+    mFileWriter.reset();
 }
 }
 }
@@ -23,17 +23,43 @@
 
 #include <memory>
 #include <algorithm>
+#include <sstream>
+#include <string>
 
 #include <nitf/coda-oss.hpp>
 #include <except/Exception.h>
 #include <str/Convert.h>
 #include <mem/ScopedArray.h>
+#include <scene/Utilities.h>
+#include <six/Executor.h>
+#include <six/sicd/Utilities.h>
 
+namespace
+{
+// Pixels handed to a thread at a time by the batch calls and when
+// projecting the cache
+const size_t MIN_GRAIN_SIZE = 64;
+
+void checkSize(size_t numPixels, size_t numLocations)
+{
+    if (numPixels != numLocations)
+    {
+        std::ostringstream ostr;
+        ostr << "Expected " << numPixels << " locations but got "
+             << numLocations;
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+}
+}
 
 namespace six
 {
 namespace sicd
 {
+const size_t SlantPlanePixelTransformer::DEFAULT_CACHE_SPACING = 32;
+const double SlantPlanePixelTransformer::DEFAULT_CACHE_MAX_ERROR = 0.01;
+const size_t SlantPlanePixelTransformer::MIN_CACHE_SPACING = 4;
+
 
 SlantPlanePixelTransformer::SlantPlanePixelTransformer(
     const six::sicd::ComplexData& data,
@@ -42,13 +68,26 @@ SlantPlanePixelTransformer::SlantPlanePixelTransformer(
     mGeom(geom),
     mProjection(projection),
     mSicdData(*dynamic_cast<six::sicd::ComplexData*>(data.clone())),
-    mGroundPlaneNormal(mGeom.getReferencePosition())
+    mGroundPlaneNormal(mGeom.getReferencePosition()),
+    mCacheSpacing(0),
+    mCacheDims(0, 0)
 {
     mGroundPlaneNormal.normalize();
 }
 
 scene::Vector3 SlantPlanePixelTransformer::toECEF(
     const types::RowCol<double>& pixel) const
+{
+    scene::Vector3 ecef;
+    if (!interpolate(pixel, ecef))
+    {
+        ecef = project(pixel);
+    }
+    return ecef;
+}
+
+scene::Vector3 SlantPlanePixelTransformer::project(
+    const types::RowCol<double>& pixel) const
 {
     //! convert slant pixel to meters from scene center
     const types::RowCol<double> imagePt(mSicdData.pixelToImagePoint(pixel));
@@ -76,5 +115,155 @@ scene::LatLon SlantPlanePixelTransformer::toLatLon(
     return scene::LatLon(lla.getLat(), lla.getLon());
 }
 
+void SlantPlanePixelTransformer::toECEF(
+    std::span<const types::RowCol<double>> pixels,
+    std::span<scene::Vector3> locations) const
+{
+    checkSize(pixels.size(), locations.size());
+    Executor::get()->parallelFor(pixels.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t ii = begin; ii < end; ++ii)
+        {
+            locations[ii] = toECEF(pixels[ii]);
+        }
+    }, MIN_GRAIN_SIZE);
+}
+
+void SlantPlanePixelTransformer::toLLA(
+    std::span<const types::RowCol<double>> pixels,
+    std::span<scene::LatLonAlt> locations) const
+{
+    checkSize(pixels.size(), locations.size());
+    std::vector<scene::Vector3> ecef(pixels.size());
+    toECEF(pixels, std::span<scene::Vector3>(ecef.data(), ecef.size()));
+    scene::Utilities::ecefToLatLon(
+            std::span<const scene::Vector3>(ecef.data(), ecef.size()),
+            locations);
+}
+
+void SlantPlanePixelTransformer::toLatLon(
+    std::span<const types::RowCol<double>> pixels,
+    std::span<scene::LatLon> locations) const
+{
+    checkSize(pixels.size(), locations.size());
+    std::vector<scene::LatLonAlt> llas(pixels.size());
+    toLLA(pixels, std::span<scene::LatLonAlt>(llas.data(), llas.size()));
+    for (size_t ii = 0; ii < llas.size(); ++ii)
+    {
+        locations[ii] = scene::LatLon(llas[ii].getLat(), llas[ii].getLon());
+    }
+}
+
+size_t SlantPlanePixelTransformer::enableCache(size_t spacing,
+                                               double maxError)
+{
+    if (spacing < MIN_CACHE_SPACING)
+    {
+        throw except::Exception(Ctxt("Cache spacing must be at least " +
+                                     std::to_string(MIN_CACHE_SPACING)));
+    }
+
+    // Any finer than MIN_CACHE_SPACING and the grid costs about as much as
+    // projecting every pixel, so give up instead
+    for (; spacing >= MIN_CACHE_SPACING; spacing /= 2)
+    {
+        buildCache(spacing);
+        if (getCacheError() <= maxError)
+        {
+            return spacing;
+        }
+    }
+    disableCache();
+    return 0;
+}
+
+void SlantPlanePixelTransformer::disableCache()
+{
+    mCache.clear();
+    mCache.shrink_to_fit();
+    mCacheSpacing = 0;
+    mCacheDims = types::RowCol<size_t>(0, 0);
+}
+
+void SlantPlanePixelTransformer::buildCache(size_t spacing)
+{
+    disableCache();
+
+    const types::RowCol<size_t> dims(
+            Utilities::getNumGridPoints(mSicdData.getNumRows(), spacing),
+            Utilities::getNumGridPoints(mSicdData.getNumCols(), spacing));
+    std::vector<scene::Vector3> cache(dims.area());
+    Executor::get()->parallelFor(cache.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t ii = begin; ii < end; ++ii)
+        {
+            cache[ii] = project(types::RowCol<double>(
+                    static_cast<double>((ii / dims.col) * spacing),
+                    static_cast<double>((ii % dims.col) * spacing)));
+        }
+    }, MIN_GRAIN_SIZE);
+
+    mCacheSpacing = spacing;
+    mCacheDims = dims;
+    mCache.swap(cache);
+}
+
+double SlantPlanePixelTransformer::getCacheError() const
+{
+    // The center of a cell is as far as a pixel can be from the grid
+    const types::RowCol<size_t> numCells(mCacheDims.row - 1,
+                                         mCacheDims.col - 1);
+    std::vector<double> errors(numCells.area());
+    Executor::get()->parallelFor(errors.size(), [&](size_t begin, size_t end)
+    {
+        for (size_t ii = begin; ii < end; ++ii)
+        {
+            const size_t row = ii / numCells.col;
+            const size_t col = ii % numCells.col;
+            const scene::Vector3* const top =
+                    &mCache[row * mCacheDims.col + col];
+            const scene::Vector3* const bottom = top + mCacheDims.col;
+            const scene::Vector3 interpolated =
+                    (top[0] + top[1] + bottom[0] + bottom[1]) * 0.25;
+            const scene::Vector3 projected = project(types::RowCol<double>(
+                    (row + 0.5) * mCacheSpacing,
+                    (col + 0.5) * mCacheSpacing));
+            errors[ii] = (interpolated - projected).norm();
+        }
+    }, MIN_GRAIN_SIZE);
+    return errors.empty() ?
+            0.0 : *std::max_element(errors.begin(), errors.end());
+}
+
+bool SlantPlanePixelTransformer::interpolate(
+    const types::RowCol<double>& pixel,
+    scene::Vector3& ecef) const
+{
+    // Written this way round so NaNs aren't in the image either
+    if (mCache.empty() ||
+        !(pixel.row >= 0.0 && pixel.row <= mSicdData.getNumRows() - 1.0 &&
+          pixel.col >= 0.0 && pixel.col <= mSicdData.getNumCols() - 1.0))
+    {
+        return false;
+    }
+
+    const double gridRow = pixel.row / mCacheSpacing;
+    const double gridCol = pixel.col / mCacheSpacing;
+    const size_t cellRow = std::min(static_cast<size_t>(gridRow),
+                                    mCacheDims.row - 2);
+    const size_t cellCol = std::min(static_cast<size_t>(gridCol),
+                                    mCacheDims.col - 2);
+    const double rowFraction = gridRow - cellRow;
+    const double colFraction = gridCol - cellCol;
+
+    const scene::Vector3* const top = &mCache[cellRow * mCacheDims.col + cellCol];
+    const scene::Vector3* const bottom = top + mCacheDims.col;
+    const scene::Vector3 upper = top[0] + (top[1] - top[0]) * colFraction;
+    const scene::Vector3 lower =
+            bottom[0] + (bottom[1] - bottom[0]) * colFraction;
+    ecef = upper + (lower - upper) * rowFraction;
+    return true;
+}
+
 }
 }
@@ -38,6 +38,7 @@
 #include <math/Utilities.h>
 #include <math/poly/Fit.h>
 #include <mem/ScopedAlignedArray.h>
+#include <six/ComplexConversion.h>
 #include <six/NITFReadControl.h>
 #include <six/sicd/SICDWriteControl.h>
 #include <six/Utilities.h>
@@ -153,13 +154,10 @@ class SICD_readerAndConverter final
     }
     void process_RE16I_IM16I(size_t elementsPerRow, size_t row, size_t rowsToRead, const std::vector<int16_t>& tempVector) const
     {
-        // Take each Int16 out of the temp buffer and put it into the real buffer as a Float32
-        void* const pBuffer = buffer;
-        float* const bufferPtr = static_cast<float*>(pBuffer) + ((row - offset.row) * elementsPerRow);
-        for (size_t index = 0; index < elementsPerRow * rowsToRead; index++)
-        {
-            bufferPtr[index] = tempVector[index];
-        }
+        // Widen each Int16 pair out of the temp buffer into the real buffer as a complex<Float32>
+        auto bufferPtr = buffer + ((row - offset.row) * (elementsPerRow / 2));
+        six::promoteToComplexFloat(tempVector.data(), sizeof(std::complex<int16_t>),
+            (elementsPerRow * rowsToRead) / 2, false /*byteSwap*/, bufferPtr);
     }
 
     void process(size_t elementsPerRow, size_t row, size_t rowsToRead, const std::vector<uint8_t>& tempVector) const
@@ -984,6 +982,13 @@ bool Utilities::isClockwise(const std::vector<RowColInt>& vertices,
     return (area > 0);
 }
 
+size_t Utilities::getNumGridPoints(size_t numPixels, size_t gridSpacing)
+{
+    const size_t numCells = numPixels > 1 ?
+            (numPixels - 1 + gridSpacing - 1) / gridSpacing : 1;
+    return std::max<size_t>(numCells, 1) + 1;
+}
+
 template<typename TReturn, typename TSchemaPaths>
 TReturn Utilities_parseData(::io::InputStream& xmlStream, const TSchemaPaths& schemaPaths, logging::Logger& log)
 {
@@ -0,0 +1,163 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Benchmark for ComplexToAMP8IPHS8I::nearest_neighbor()
+// Encodes random complex<float> pixels to AMP8I_PHS8I with the fast encoder
+// and with the long double one it falls back to, with and without an
+// amplitude table, and reports Mpixels/s.  Both must agree on every pixel.
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <six/sicd/ComplexToAMP8IPHS8I.h>
+#include <import/cli.h>
+#include <import/except.h>
+
+namespace
+{
+using Encoder = six::sicd::details::ComplexToAMP8IPHS8I;
+
+template <typename TEncode>
+double timeEncoding(const std::vector<std::complex<float> >& input,
+                    size_t numTrials,
+                    std::vector<six::sicd::AMP8I_PHS8I_t>& output,
+                    TEncode encode)
+{
+    double bestSec = 0.0;
+    for (size_t trial = 0; trial < numTrials; ++trial)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t ii = 0; ii < input.size(); ++ii)
+        {
+            output[ii] = encode(input[ii]);
+        }
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double sec = std::chrono::duration<double>(stop - start).count();
+        bestSec = (trial == 0) ? sec : std::min(bestSec, sec);
+    }
+
+    return input.size() / bestSec / 1e6;
+}
+
+void run(const std::string& name,
+         const six::AmplitudeTable* pAmplitudeTable,
+         size_t numPixels,
+         size_t numTrials)
+{
+    std::unique_ptr<Encoder> pTree;
+    const Encoder& encoder = *Encoder::make(pAmplitudeTable, pTree);
+
+    // Cover the whole range of magnitudes, and then some
+    const float maxAmplitude = pAmplitudeTable ?
+            static_cast<float>(pAmplitudeTable->index(UINT8_MAX)) : 255.0f;
+    std::uniform_real_distribution<float> dist(-maxAmplitude, maxAmplitude);
+    std::default_random_engine eng(12345);
+    std::vector<std::complex<float> > input(numPixels);
+    for (auto& pixel : input)
+    {
+        pixel = std::complex<float>(dist(eng), dist(eng));
+    }
+
+    std::vector<six::sicd::AMP8I_PHS8I_t> exact(numPixels);
+    std::vector<six::sicd::AMP8I_PHS8I_t> fast(numPixels);
+    const double exactRate = timeEncoding(input, numTrials, exact,
+            [&](const std::complex<float>& v)
+            {
+                return encoder.nearest_neighbor_exact(v);
+            });
+    const double fastRate = timeEncoding(input, numTrials, fast,
+            [&](const std::complex<float>& v)
+            {
+                return encoder.nearest_neighbor(v);
+            });
+
+    if (exact != fast)
+    {
+        throw except::Exception(Ctxt(
+                "Fast and exact encoders disagree for " + name));
+    }
+
+    std::cout << std::setw(20) << name << std::fixed << std::setprecision(2)
+              << std::setw(12) << exactRate << std::setw(12) << fastRate
+              << std::setw(10) << fastRate / exactRate << "x\n";
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription("Reports the throughput of the AMP8I_PHS8I "
+                              "encoder");
+        parser.addArgument("--pixels", "Number of pixels to encode",
+                           cli::STORE, "pixels", "INT")->setDefault(1 << 22);
+        parser.addArgument("--trials", "Best of this many encodings is "
+                           "reported", cli::STORE, "trials", "INT")->
+                setDefault(3);
+        std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        const size_t numPixels = options->get<size_t>("pixels");
+        const size_t numTrials =
+                std::max<size_t>(options->get<size_t>("trials"), 1);
+
+        std::cout << "Mpixels/s encoding " << numPixels << " pixels\n\n"
+                  << std::setw(20) << "" << std::setw(12) << "exact"
+                  << std::setw(12) << "fast" << std::setw(11) << "speedup"
+                  << "\n";
+
+        run("no amplitude table", nullptr, numPixels, numTrials);
+
+        six::AmplitudeTable amplitudeTable;
+        for (size_t ii = 0; ii <= UINT8_MAX; ++ii)
+        {
+            amplitudeTable.index(ii) = static_cast<double>(ii * ii) / 100.0 + 10.0;
+        }
+        run("amplitude table", &amplitudeTable, numPixels, numTrials);
+
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "Caught except::Exception: " << ex.getMessage()
+                  << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught std::exception: " << ex.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unknown exception\n";
+        return 1;
+    }
+}
@@ -0,0 +1,190 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Benchmark for LazyComplexData
+// Times opening each SICD in a directory (by default, the croppedNitfs ones)
+// and getting what's needed to serve pixels -- ImageData, GeoData and Grid --
+// by parsing all the XML with NITFReadControl, and by parsing it lazily.
+// Once the lazy SICD is fully parsed, it must match the normal one.
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <std/filesystem>
+#include <import/cli.h>
+#include <import/except.h>
+#include <six/sicd/ComplexData.h>
+#include <six/sicd/LazyComplexData.h>
+#include <six/sicd/NITFReadComplexXMLControl.h>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+fs::path findCroppedSICDs(const fs::path& exePath)
+{
+    fs::path dir = absolute(exePath);
+    do
+    {
+        const auto sicds = dir / "croppedNitfs" / "SICD";
+        if (is_directory(sicds))
+        {
+            return sicds;
+        }
+        dir = dir.parent_path();
+    } while (dir != dir.parent_path());
+
+    throw except::Exception(Ctxt(
+            "Can't find croppedNitfs; use --dir to say where the SICDs are"));
+}
+
+template <typename TOpen>
+double timeOpening(size_t numTrials, TOpen open)
+{
+    double bestSec = 0.0;
+    for (size_t trial = 0; trial < numTrials; ++trial)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        open();
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double sec = std::chrono::duration<double>(stop - start).count();
+        bestSec = (trial == 0) ? sec : std::min(bestSec, sec);
+    }
+
+    return bestSec * 1000.0;
+}
+
+std::unique_ptr<six::sicd::ComplexData> readAll(const fs::path& pathname,
+                                                const std::vector<fs::path>* pSchemaPaths)
+{
+    six::sicd::NITFReadComplexXMLControl reader;
+    reader.load(pathname, pSchemaPaths);
+    return reader.getComplexData();
+}
+
+void run(const fs::path& pathname,
+         const std::vector<fs::path>* pSchemaPaths,
+         size_t numTrials)
+{
+    const double fullMS = timeOpening(numTrials, [&]()
+    {
+        readAll(pathname, pSchemaPaths);
+    });
+
+    const double lazyMS = timeOpening(numTrials, [&]()
+    {
+        const auto lazy = six::sicd::LazyComplexData::fromNITF(pathname,
+                                                               pSchemaPaths);
+        lazy->getImageData();
+        lazy->getGeoData();
+        lazy->getGrid();
+    });
+
+    const auto lazy = six::sicd::LazyComplexData::fromNITF(pathname,
+                                                           pSchemaPaths);
+    if (!(*lazy->getComplexData() == *readAll(pathname, pSchemaPaths)))
+    {
+        throw except::Exception(Ctxt(
+                "Lazy and full parses disagree for " + pathname.string()));
+    }
+
+    std::cout << std::setw(32) << pathname.filename().string()
+              << std::fixed << std::setprecision(3)
+              << std::setw(12) << fullMS << std::setw(12) << lazyMS
+              << std::setprecision(2) << std::setw(10) << fullMS / lazyMS
+              << "x\n";
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription("Reports how long it takes to open each SICD "
+                              "in a directory, parsing all of the XML and "
+                              "parsing just what's needed to serve pixels");
+        parser.addArgument("--dir", "Directory of SICDs, croppedNitfs/SICD "
+                           "if not given", cli::STORE, "dir", "DIR")->
+                setDefault("");
+        parser.addArgument("--schema", "Validate against the schemas in "
+                           "this directory", cli::STORE, "schema", "DIR")->
+                setDefault("");
+        parser.addArgument("--trials", "Best of this many opens is reported",
+                           cli::STORE, "trials", "INT")->setDefault(5);
+        std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        const std::string dirOption = options->get<std::string>("dir");
+        const fs::path dir = dirOption.empty() ?
+                findCroppedSICDs(argv[0]) : fs::path(dirOption);
+        const std::string schema = options->get<std::string>("schema");
+        const std::vector<fs::path> schemaPaths{schema};
+        const std::vector<fs::path>* const pSchemaPaths =
+                schema.empty() ? nullptr : &schemaPaths;
+        const size_t numTrials =
+                std::max<size_t>(options->get<size_t>("trials"), 1);
+
+        std::vector<fs::path> pathnames;
+        for (const auto& entry : fs::directory_iterator(dir))
+        {
+            if (entry.path().extension() == ".nitf" ||
+                entry.path().extension() == ".ntf")
+            {
+                pathnames.push_back(entry.path());
+            }
+        }
+        std::sort(pathnames.begin(), pathnames.end());
+
+        std::cout << "ms to open and get ImageData, GeoData and Grid\n\n"
+                  << std::setw(32) << "" << std::setw(12) << "full"
+                  << std::setw(12) << "lazy" << std::setw(11) << "speedup"
+                  << "\n";
+        for (const auto& pathname : pathnames)
+        {
+            run(pathname, pSchemaPaths, numTrials);
+        }
+
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "Caught except::Exception: " << ex.getMessage()
+                  << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught std::exception: " << ex.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unknown exception\n";
+        return 1;
+    }
+}
@@ -0,0 +1,180 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Benchmark for NITFReadControl::OPT_NUM_THREADS
+// Writes a multi-segment SICD, then reads the whole image back one segment
+// at a time and with the segments spread across threads.  Both reads must
+// produce the same pixels.
+
+#include <chrono>
+#include <complex>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/OS.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/XMLControlFactory.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <import/cli.h>
+
+#include "TestUtilities.h"
+
+namespace
+{
+void writeSICD(const std::string& pathname,
+               const types::RowCol<size_t>& dims,
+               size_t numRowsPerSeg)
+{
+    std::vector<std::complex<float> > image(dims.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = std::complex<float>(static_cast<float>(ii % 1000),
+                                        static_cast<float>(ii % 7));
+    }
+
+    std::shared_ptr<six::Container> container(
+            new six::Container(six::DataType::COMPLEX));
+    container->addData(createData<float>(dims).release());
+
+    // Force segmentation on (roughly) the requested number of rows
+    static const size_t APPROX_HEADER_SIZE = 2 * 1024;
+    const size_t numBytesPerRow = dims.col * sizeof(std::complex<float>);
+    six::Options options;
+    options.setParameter(six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE,
+                         numRowsPerSeg * numBytesPerRow + APPROX_HEADER_SIZE);
+
+    six::NITFWriteControl writer(options, container);
+    save(writer, image, pathname, std::vector<std::string>());
+}
+
+std::unique_ptr<six::UByte[]> timedRead(const std::string& pathname,
+                                        size_t numThreads,
+                                        size_t numTrials,
+                                        size_t& numSegments,
+                                        size_t& numBytes)
+{
+    six::NITFReadControl reader;
+    reader.getOptions().setParameter(six::NITFReadControl::OPT_NUM_THREADS,
+                                     numThreads);
+    reader.load(pathname);
+    numSegments = reader.getRecord().getNumImages();
+
+    std::unique_ptr<six::UByte[]> buffer;
+    double elapsedSec = 0.0;
+    for (size_t trial = 0; trial < numTrials; ++trial)
+    {
+        six::Region region;
+        const auto start = std::chrono::steady_clock::now();
+        buffer.reset(reader.interleaved(region, 0));
+        const auto stop = std::chrono::steady_clock::now();
+        elapsedSec += std::chrono::duration<double>(stop - start).count();
+
+        numBytes = region.getNumRows() * region.getNumCols() *
+                sizeof(std::complex<float>);
+    }
+
+    const double avgSec = elapsedSec / numTrials;
+    std::cout << numThreads << " thread(s): " << avgSec << " sec ("
+              << (numBytes / avgSec) / (1024.0 * 1024.0) << " MB/s)"
+              << std::endl;
+    return buffer;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription("Times full-image SICD reads with the image "
+                              "segments read serially and in parallel");
+        parser.addArgument("--rows", "Number of rows", cli::STORE,
+                           "rows", "INT")->setDefault(4096);
+        parser.addArgument("--cols", "Number of columns", cli::STORE,
+                           "cols", "INT")->setDefault(4096);
+        parser.addArgument("--rows-per-seg",
+                           "Approximate number of rows per image segment",
+                           cli::STORE, "rowsPerSeg", "INT")->setDefault(256);
+        parser.addArgument("--threads",
+                           "Number of threads for the parallel read "
+                           "(0 for one per CPU)",
+                           cli::STORE, "threads", "INT")->setDefault(0);
+        parser.addArgument("--trials", "Number of reads to average over",
+                           cli::STORE, "trials", "INT")->setDefault(3);
+        std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        const types::RowCol<size_t> dims(options->get<size_t>("rows"),
+                                         options->get<size_t>("cols"));
+        const size_t rowsPerSeg = options->get<size_t>("rowsPerSeg");
+        size_t numThreads = options->get<size_t>("threads");
+        if (numThreads == 0)
+        {
+            numThreads = sys::OS().getNumCPUs();
+        }
+        const size_t numTrials = std::max<size_t>(
+                options->get<size_t>("trials"), 1);
+
+        six::XMLControlFactory::getInstance().addCreator<
+                six::sicd::ComplexXMLControl>();
+
+        const std::string pathname("parallel_segment_read.nitf");
+        const EnsureFileCleanup ensureFileCleanup(pathname);
+        writeSICD(pathname, dims, rowsPerSeg);
+
+        size_t numSegments(0);
+        size_t numBytes(0);
+        const std::unique_ptr<six::UByte[]> serial =
+                timedRead(pathname, 1, numTrials, numSegments, numBytes);
+        const std::unique_ptr<six::UByte[]> parallel =
+                timedRead(pathname, numThreads, numTrials, numSegments,
+                          numBytes);
+        std::cout << numSegments << " image segment(s)" << std::endl;
+
+        if (!std::equal(serial.get(), serial.get() + numBytes, parallel.get()))
+        {
+            std::cerr << "Serial and parallel reads DO NOT MATCH\n";
+            return 1;
+        }
+
+        std::cout << "Serial and parallel reads match\n";
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "Caught except::Exception: " << ex.getMessage()
+                  << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught std::exception: " << ex.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unknown exception\n";
+        return 1;
+    }
+}
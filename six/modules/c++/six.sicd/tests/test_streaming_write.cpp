@@ -26,6 +26,7 @@
 
 #include <iostream>
 #include <string>
+#include <thread>
 
 #include "TestUtilities.h"
 
@@ -257,6 +258,9 @@ struct Tester final
     // Writes where some rows are written out with only some of the cols
     void testMultipleWritesOfPartialRows();
 
+    // Writes from several threads at once, full and partial rows
+    void testConcurrentWrites();
+
 private:
     void normalWrite();
 
@@ -446,6 +450,61 @@ void Tester<DataTypeT>::testMultipleWritesOfPartialRows()
     compare("Multiple writes of partial rows");
 }
 
+template <typename DataTypeT>
+void Tester<DataTypeT>::testConcurrentWrites()
+{
+    const EnsureFileCleanup ensureFileCleanup(mTestPathname);
+
+    six::Options options;
+    setMaxProductSize(options);
+
+    six::sicd::SICDWriteControl sicdWriter(mTestPathname, mSchemaPaths);
+    sicdWriter.initialize(options, mContainer);
+
+    // Rows [0, 60) in strips of 20, rows [60, 123) split into left and
+    // right halves
+    std::vector<types::RowCol<size_t> > offsets;
+    std::vector<types::RowCol<size_t> > dims;
+    for (size_t row = 0; row < 60; row += 20)
+    {
+        offsets.push_back(types::RowCol<size_t>(row, 0));
+        dims.push_back(types::RowCol<size_t>(20, mDims.col));
+    }
+    offsets.push_back(types::RowCol<size_t>(60, 0));
+    dims.push_back(types::RowCol<size_t>(63, 200));
+    offsets.push_back(types::RowCol<size_t>(60, 200));
+    dims.push_back(types::RowCol<size_t>(63, mDims.col - 200));
+
+    std::vector<std::vector<std::complex<DataTypeT> > > subsets(offsets.size());
+    for (size_t ii = 0; ii < offsets.size(); ++ii)
+    {
+        subsetData(mImagePtr, mDims.col, offsets[ii], dims[ii], subsets[ii]);
+    }
+    const auto original = subsets;
+
+    std::vector<std::thread> threads;
+    for (size_t ii = 0; ii < offsets.size(); ++ii)
+    {
+        threads.emplace_back([&, ii]()
+        {
+            sicdWriter.save(subsets[ii].data(), offsets[ii], dims[ii], false);
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    sicdWriter.close();
+
+    if (subsets != original)
+    {
+        std::cerr << "Concurrent writes modified the caller's data\n";
+        mSuccess = false;
+    }
+
+    compare("Concurrent writes");
+}
+
 template <typename DataTypeT>
 bool doTests(const std::vector<std::string>& schemaPaths,
              bool setMaxProductSize,
@@ -465,6 +524,7 @@ bool doTests(const std::vector<std::string>& schemaPaths,
     tester.testSingleWrite();
     tester.testMultipleWritesOfFullRows();
     tester.testMultipleWritesOfPartialRows();
+    tester.testConcurrentWrites();
 
     return tester.success();
 }
@@ -0,0 +1,259 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Benchmark for the XML number formatting and parsing
+// Formats and parses random doubles the way six used to, with streams, and
+// with six::details::toString()/toDouble(), which must give the same bytes
+// and values.  Then writes and reads back a SICD whose ValidData polygons
+// have lots of vertices, which must survive the round trip.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <import/cli.h>
+#include <import/except.h>
+#include <str/Convert.h>
+#include <six/Utilities.h>
+#include <six/sicd/ComplexData.h>
+#include <six/sicd/Utilities.h>
+
+namespace
+{
+template <typename TRun>
+double timeBest(size_t numTrials, TRun run)
+{
+    double bestSec = 0.0;
+    for (size_t trial = 0; trial < numTrials; ++trial)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double sec = std::chrono::duration<double>(stop - start).count();
+        bestSec = (trial == 0) ? sec : std::min(bestSec, sec);
+    }
+
+    return bestSec;
+}
+
+// How six::toString<double>() used to do it
+std::string toScientificString(double value)
+{
+    std::ostringstream os;
+    os << std::uppercase << std::scientific
+       << std::setprecision(std::numeric_limits<double>::max_digits10)
+       << value;
+    std::string strValue = os.str();
+    const size_t plusPos = strValue.find("+");
+    if (plusPos != std::string::npos)
+    {
+        strValue.erase(plusPos, 1);
+    }
+    return strValue;
+}
+
+void report(const std::string& name, double streamRate, double newRate)
+{
+    std::cout << std::setw(24) << name << std::fixed << std::setprecision(2)
+              << std::setw(12) << streamRate << std::setw(12) << newRate
+              << std::setw(10) << newRate / streamRate << "x\n";
+}
+
+template <typename TFormat>
+void runFormatting(const std::string& name,
+                   const std::vector<double>& values,
+                   size_t numTrials,
+                   TFormat formatStream,
+                   TFormat format)
+{
+    std::vector<std::string> expected(values.size());
+    std::vector<std::string> actual(values.size());
+    const double streamSec = timeBest(numTrials, [&]()
+    {
+        for (size_t ii = 0; ii < values.size(); ++ii)
+        {
+            expected[ii] = formatStream(values[ii]);
+        }
+    });
+    const double newSec = timeBest(numTrials, [&]()
+    {
+        for (size_t ii = 0; ii < values.size(); ++ii)
+        {
+            actual[ii] = format(values[ii]);
+        }
+    });
+
+    if (expected != actual)
+    {
+        throw except::Exception(Ctxt("Formatting disagrees for " + name));
+    }
+
+    std::vector<double> expectedValues(values.size());
+    std::vector<double> actualValues(values.size());
+    const double streamParseSec = timeBest(numTrials, [&]()
+    {
+        for (size_t ii = 0; ii < values.size(); ++ii)
+        {
+            expectedValues[ii] = str::toType<double>(expected[ii]);
+        }
+    });
+    const double newParseSec = timeBest(numTrials, [&]()
+    {
+        for (size_t ii = 0; ii < values.size(); ++ii)
+        {
+            actualValues[ii] = six::details::toDouble(actual[ii]);
+        }
+    });
+
+    if (expectedValues != actualValues || actualValues != values)
+    {
+        throw except::Exception(Ctxt("Parsing disagrees for " + name));
+    }
+
+    const double numValues = static_cast<double>(values.size()) / 1e6;
+    report("format " + name, numValues / streamSec, numValues / newSec);
+    report("parse " + name, numValues / streamParseSec,
+           numValues / newParseSec);
+}
+
+void runRoundTrip(size_t numVertices, size_t numTrials)
+{
+    auto data = six::sicd::Utilities::createFakeComplexData();
+
+    // Something like a ragged collection boundary
+    std::uniform_real_distribution<double> jitter(-1e-4, 1e-4);
+    std::default_random_engine eng(12345);
+    data->imageData->validData.clear();
+    data->geoData->validData.clear();
+    for (size_t ii = 0; ii < numVertices; ++ii)
+    {
+        const double angle = 6.283185307179586 * ii / numVertices;
+        data->imageData->validData.push_back(six::RowColInt(
+                static_cast<ptrdiff_t>(ii), static_cast<ptrdiff_t>(ii / 2)));
+        data->geoData->validData.push_back(six::LatLon(
+                40.0 + 0.1 * std::sin(angle) + jitter(eng),
+                -84.0 + 0.1 * std::cos(angle) + jitter(eng)));
+    }
+
+    std::u8string xml;
+    const double writeSec = timeBest(numTrials, [&]()
+    {
+        xml = six::sicd::Utilities::toXMLString(*data, nullptr);
+    });
+
+    std::unique_ptr<six::sicd::ComplexData> readData;
+    const double readSec = timeBest(numTrials, [&]()
+    {
+        readData = six::sicd::Utilities::parseDataFromString(xml, nullptr);
+    });
+
+    if (!(*readData == *data))
+    {
+        throw except::Exception(Ctxt("SICD didn't survive the round trip"));
+    }
+
+    const double mb = static_cast<double>(xml.size()) / (1024.0 * 1024.0);
+    std::cout << "\n" << numVertices << " ValidData vertices, "
+              << std::fixed << std::setprecision(2) << mb << " MB of XML\n"
+              << std::setw(24) << "write MB/s" << std::setw(12)
+              << mb / writeSec << "\n"
+              << std::setw(24) << "read MB/s" << std::setw(12)
+              << mb / readSec << "\n";
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription("Reports the throughput of formatting and "
+                              "parsing numbers for XML, and of writing and "
+                              "reading back a SICD's XML");
+        parser.addArgument("--numbers", "Number of doubles to format and "
+                           "parse", cli::STORE, "numbers", "INT")->
+                setDefault(1 << 20);
+        parser.addArgument("--vertices", "Number of ValidData vertices in "
+                           "the SICD", cli::STORE, "vertices", "INT")->
+                setDefault(1 << 16);
+        parser.addArgument("--trials", "Best of this many runs is reported",
+                           cli::STORE, "trials", "INT")->setDefault(3);
+        std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        const size_t numNumbers = options->get<size_t>("numbers");
+        const size_t numVertices = options->get<size_t>("vertices");
+        const size_t numTrials =
+                std::max<size_t>(options->get<size_t>("trials"), 1);
+
+        // Spread over the magnitudes SICD metadata actually has
+        std::uniform_real_distribution<double> mantissa(-1.0, 1.0);
+        std::uniform_int_distribution<int> exponent(-12, 12);
+        std::default_random_engine eng(334);
+        std::vector<double> values(numNumbers);
+        for (auto& value : values)
+        {
+            value = std::ldexp(mantissa(eng), 3 * exponent(eng));
+        }
+
+        std::cout << "Mnumbers/s for " << numNumbers << " doubles\n\n"
+                  << std::setw(24) << "" << std::setw(12) << "stream"
+                  << std::setw(12) << "new" << std::setw(11) << "speedup"
+                  << "\n";
+
+        using Format = std::string (*)(double);
+        runFormatting<Format>("scientific", values, numTrials,
+                [](double v) { return toScientificString(v); },
+                [](double v) { return six::toString(v); });
+        runFormatting<Format>("general", values, numTrials,
+                [](double v) { return str::toString(v); },
+                [](double v) { return six::details::toString(v, false); });
+
+        runRoundTrip(numVertices, numTrials);
+
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "Caught except::Exception: " << ex.getMessage()
+                  << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught std::exception: " << ex.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unknown exception\n";
+        return 1;
+    }
+}
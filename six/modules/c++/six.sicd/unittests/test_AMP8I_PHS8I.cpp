@@ -32,6 +32,7 @@
 #include <random>
 #include <std/span>
 #include <numeric>
+#include <limits>
 #include <future>
 
 #include <io/FileInputStream.h>
@@ -797,6 +798,83 @@ TEST_CASE(test_ComplexToAMP8IPHS8I)
     test_ComplexToAMP8IPHS8I(testName, item, inputs.begin(), inputs.end(), candidates);
 }
 
+static bool nearest_neighbor_matches_exact(const six::sicd::details::ComplexToAMP8IPHS8I& item, const std::complex<float>& v)
+{
+    return item.nearest_neighbor(v) == item.nearest_neighbor_exact(v);
+}
+static size_t count_nearest_neighbor_mismatches(const six::AmplitudeTable* pAmplitudeTable)
+{
+    std::unique_ptr<six::sicd::details::ComplexToAMP8IPHS8I> pTree;
+    const auto& item = *(six::sicd::details::ComplexToAMP8IPHS8I::make(pAmplitudeTable, pTree));
+
+    size_t retval = 0;
+    const auto check = [&](const std::complex<long double>& v) {
+        const std::complex<float> v_(static_cast<float>(v.real()), static_cast<float>(v.imag()));
+        if (!nearest_neighbor_matches_exact(item, v_)) retval++;
+
+        // A few ulps in every direction
+        auto real = v_.real();
+        auto imag = v_.imag();
+        for (int i = 0; i < 3; i++)
+        {
+            real = std::nextafter(real, std::numeric_limits<float>::max());
+            imag = std::nextafter(imag, std::numeric_limits<float>::lowest());
+            if (!nearest_neighbor_matches_exact(item, { real, v_.imag() })) retval++;
+            if (!nearest_neighbor_matches_exact(item, { v_.real(), imag })) retval++;
+            if (!nearest_neighbor_matches_exact(item, { real, imag })) retval++;
+        }
+    };
+
+    // Every encoded value, and the points halfway to its neighbors: that's where the decision boundaries are.
+    for (int amplitude = 0; amplitude <= UINT8_MAX; amplitude++)
+    {
+        for (int phase = 0; phase <= UINT8_MAX; phase++)
+        {
+            const auto v = six::sicd::Utilities::from_AMP8I_PHS8I(static_cast<uint8_t>(amplitude), static_cast<uint8_t>(phase), pAmplitudeTable);
+            check(v);
+
+            check(std::polar(std::abs(v), 2.0L * M_PI * (phase + 0.5L) / 256.0L));
+            if (amplitude < UINT8_MAX)
+            {
+                const auto next_amplitude = six::sicd::Utilities::from_AMP8I_PHS8I(static_cast<uint8_t>(amplitude + 1), static_cast<uint8_t>(phase), pAmplitudeTable);
+                check((v + next_amplitude) / 2.0L);
+            }
+        }
+    }
+
+    // Oddballs ...
+    constexpr auto inf = std::numeric_limits<float>::infinity();
+    const std::vector<std::complex<float>> special{ {0.0f, 0.0f}, {-0.0f, 0.0f}, {0.0f, -0.0f}, {-0.0f, -0.0f},
+        {-1.0f, -0.0f}, {1.0f, -0.0f}, {1.0f, -1e-4f}, {inf, 1.0f}, {1.0f, -inf}, {std::nanf(""), 1.0f},
+        {1e30f, -1e30f}, {1e-30f, 1e-30f}, {-1e5f, 3.0f} };
+    for (const auto& v : special)
+    {
+        if (!nearest_neighbor_matches_exact(item, v)) retval++;
+    }
+
+    // ... and everything else.
+    const auto max_amplitude = static_cast<float>(std::abs(six::sicd::Utilities::from_AMP8I_PHS8I(UINT8_MAX, 0, pAmplitudeTable)));
+    std::uniform_real_distribution<float> dist(-max_amplitude * 1.1f, max_amplitude * 1.1f);
+    std::default_random_engine eng(1234);  // ... fixed seed means deterministic tests...
+    for (size_t i = 0; i < 1000000; i++)
+    {
+        if (!nearest_neighbor_matches_exact(item, { dist(eng), dist(eng) })) retval++;
+    }
+    return retval;
+}
+TEST_CASE(test_nearest_neighbor_exact)
+{
+    // The fast nearest_neighbor() must give the same answers as the long double version.
+    TEST_ASSERT_EQ(count_nearest_neighbor_mismatches(nullptr), static_cast<size_t>(0));
+
+    six::AmplitudeTable amplitudeTable;
+    for (size_t i = 0; i < 256; i++)
+    {
+        amplitudeTable.index(i) = static_cast<double>(i * i) / 100.0 + 10.0;
+    }
+    TEST_ASSERT_EQ(count_nearest_neighbor_mismatches(&amplitudeTable), static_cast<size_t>(0));
+}
+
 TEST_MAIN(
     TEST_CHECK(test_8bit_ampphs);
     TEST_CHECK(read_8bit_ampphs_with_table);
@@ -807,5 +885,6 @@ TEST_MAIN(
     TEST_CHECK(test_nearest_neighbor);
     TEST_CHECK(test_verify_phase_uint8_ordering);
     TEST_CHECK(test_ComplexToAMP8IPHS8I);
+    TEST_CHECK(test_nearest_neighbor_exact);
     )
 
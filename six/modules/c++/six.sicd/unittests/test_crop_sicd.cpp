@@ -0,0 +1,176 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <complex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <std/cstddef>
+
+#include <sys/OS.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/XMLControlFactory.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/CropUtils.h>
+#include <six/sicd/Utilities.h>
+
+#include "TestCase.h"
+
+namespace
+{
+const types::RowCol<size_t> DIMS(45, 13);
+const types::RowCol<size_t> AOI_OFFSET(5, 3);
+const types::RowCol<size_t> AOI_DIMS(31, 8);
+
+template <typename T>
+void writeSICD(const std::string& pathname,
+               six::PixelType pixelType,
+               const std::vector<T>& image)
+{
+    six::XMLControlFactory::getInstance().addCreator<
+            six::sicd::ComplexXMLControl>();
+
+    std::unique_ptr<six::sicd::ComplexData> data(
+            six::sicd::Utilities::createFakeComplexData().release());
+    setExtent(*data, DIMS);
+    data->setPixelType(pixelType);
+
+    std::shared_ptr<six::Container> container(
+            new six::Container(six::DataType::COMPLEX));
+    container->addData(std::move(data));
+
+    six::NITFWriteControl writer(container);
+    save(writer, image, pathname, std::vector<std::string>());
+}
+
+types::RowCol<size_t> getFirstRowCol(const std::string& pathname)
+{
+    six::NITFReadControl reader;
+    reader.load(pathname);
+    const auto complexData = six::sicd::Utilities::getComplexData(reader);
+    return types::RowCol<size_t>(complexData->imageData->firstRow,
+                                 complexData->imageData->firstCol);
+}
+
+// The pixels of an AOI just as they are in the file
+std::vector<std::byte> readRaw(const std::string& pathname,
+                               const types::RowCol<size_t>& offset,
+                               const types::RowCol<size_t>& dims)
+{
+    six::NITFReadControl reader;
+    reader.load(pathname);
+    const auto complexData = six::sicd::Utilities::getComplexData(reader);
+
+    std::vector<std::byte> pixels(
+            dims.area() * complexData->getNumBytesPerPixel());
+    six::Region region;
+    setOffset(region, offset);
+    setDims(region, dims);
+    region.setBuffer(pixels.data());
+    reader.interleaved(region, 0);
+    return pixels;
+}
+
+// Crops a strip at a time and checks the pixels weren't changed at all
+bool cropMatches(const std::string& pathname, size_t numRowsPerStrip)
+{
+    const std::string croppedPathname("cropped_" + pathname);
+    six::sicd::cropSICD(pathname, std::vector<std::string>(), AOI_OFFSET,
+                        AOI_DIMS, croppedPathname, numRowsPerStrip);
+
+    bool matches;
+    {
+        six::NITFReadControl reader;
+        reader.load(croppedPathname);
+        const auto complexData = six::sicd::Utilities::getComplexData(reader);
+        matches = (getExtent(*complexData) == AOI_DIMS);
+    }
+    matches = matches && (getFirstRowCol(croppedPathname) ==
+                          getFirstRowCol(pathname) + AOI_OFFSET);
+    matches = matches &&
+            (readRaw(croppedPathname, types::RowCol<size_t>(0, 0), AOI_DIMS) ==
+             readRaw(pathname, AOI_OFFSET, AOI_DIMS));
+
+    sys::OS().remove(croppedPathname);
+    return matches;
+}
+}
+
+TEST_CASE(testRE32F_IM32F)
+{
+    const std::string pathname("test_crop_sicd_RE32F.nitf");
+    std::vector<std::complex<float> > image(DIMS.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = std::complex<float>(static_cast<float>(ii), -0.5f);
+    }
+    writeSICD(pathname, six::PixelType::RE32F_IM32F, image);
+
+    TEST_ASSERT(cropMatches(pathname, 1));
+    TEST_ASSERT(cropMatches(pathname, 7));
+    TEST_ASSERT(cropMatches(pathname, 0));
+
+    sys::OS().remove(pathname);
+}
+
+TEST_CASE(testRE16I_IM16I)
+{
+    const std::string pathname("test_crop_sicd_RE16I.nitf");
+    std::vector<std::complex<short> > image(DIMS.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = std::complex<short>(static_cast<short>(ii),
+                                        static_cast<short>(-1 - ii));
+    }
+    writeSICD(pathname, six::PixelType::RE16I_IM16I, image);
+
+    TEST_ASSERT(cropMatches(pathname, 1));
+    TEST_ASSERT(cropMatches(pathname, 10));
+    TEST_ASSERT(cropMatches(pathname, AOI_DIMS.row + 1));
+
+    sys::OS().remove(pathname);
+}
+
+TEST_CASE(testAMP8I_PHS8I)
+{
+    const std::string pathname("test_crop_sicd_AMP8I.nitf");
+    std::vector<std::pair<uint8_t, uint8_t> > image(DIMS.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = std::make_pair(static_cast<uint8_t>(ii),
+                                   static_cast<uint8_t>(ii * 7));
+    }
+    writeSICD(pathname, six::PixelType::AMP8I_PHS8I, image);
+
+    TEST_ASSERT(cropMatches(pathname, 1));
+    TEST_ASSERT(cropMatches(pathname, 4));
+    TEST_ASSERT(cropMatches(pathname, 0));
+
+    sys::OS().remove(pathname);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testRE32F_IM32F);
+    TEST_CHECK(testRE16I_IM16I);
+    TEST_CHECK(testAMP8I_PHS8I);
+)
@@ -0,0 +1,256 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <scene/ProjectionModel.h>
+#include <scene/SceneGeometry.h>
+#include <scene/Utilities.h>
+#include <six/sicd/GeoLocator.h>
+#include <six/sicd/SlantPlanePixelTransformer.h>
+#include <six/sicd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+const types::RowCol<size_t> SLANT_DIMS(200, 240);
+
+// A ground plane SICD of a scene at 40N, 80W, collected by a platform
+// flying north 15 km to the west of it, 8 km up
+std::unique_ptr<six::sicd::ComplexData> makeComplexData()
+{
+    std::unique_ptr<six::sicd::ComplexData> data =
+            six::sicd::Utilities::createFakeComplexData(&SLANT_DIMS);
+
+    const scene::LatLonAlt scpLatLon(40.0, -80.0, 0.0);
+    const six::Vector3 scp = scene::Utilities::latLonToECEF(scpLatLon);
+    const double lat = scpLatLon.getLatRadians();
+    const double lon = scpLatLon.getLonRadians();
+    const six::Vector3 up({std::cos(lat) * std::cos(lon),
+                           std::cos(lat) * std::sin(lon),
+                           std::sin(lat)});
+    const six::Vector3 east({-std::sin(lon), std::cos(lon), 0.0});
+    const six::Vector3 north = math::linear::cross(up, east);
+
+    data->geoData->scp.ecf = scp;
+    data->geoData->scp.llh = scpLatLon;
+
+    data->position->arpPoly = six::PolyXYZ(1);
+    data->position->arpPoly[0] = scp + up * 8000.0 - east * 15000.0;
+    data->position->arpPoly[1] = north * 200.0;
+    data->scpcoa->scpTime = 0.0;
+    data->scpcoa->arpPos = data->position->arpPoly[0];
+    data->scpcoa->arpVel = data->position->arpPoly[1];
+    data->scpcoa->sideOfTrack = six::SideOfTrackType::RIGHT;
+
+    // Broadside to each column, give or take
+    data->grid->type = six::ComplexImageGridType::PLANE;
+    data->grid->row->unitVector = east;
+    data->grid->col->unitVector = north;
+    data->grid->row->sampleSpacing = 1.0;
+    data->grid->col->sampleSpacing = 1.0;
+    data->grid->timeCOAPoly = six::Poly2D(1, 1);
+    data->grid->timeCOAPoly[0][1] = 0.005;
+    data->grid->timeCOAPoly[1][1] = 1e-6;
+
+    data->imageData->firstRow = 0;
+    data->imageData->firstCol = 0;
+    data->imageData->scpPixel = six::RowColInt(100, 120);
+
+    const double angle = 0.5;
+    data->radarCollection->area.reset(new six::sicd::Area());
+    data->radarCollection->area->plane.reset(new six::sicd::AreaPlane());
+    six::sicd::AreaPlane& plane = *data->radarCollection->area->plane;
+    plane.referencePoint.ecef = scp;
+    plane.referencePoint.rowCol = six::RowColDouble(90.0, 150.0);
+    plane.xDirection->unitVector =
+            east * std::cos(angle) + north * std::sin(angle);
+    plane.yDirection->unitVector =
+            north * std::cos(angle) - east * std::sin(angle);
+    plane.xDirection->spacing = 0.8;
+    plane.yDirection->spacing = 1.1;
+    plane.xDirection->elements = 181;
+    plane.yDirection->elements = 301;
+    return data;
+}
+
+std::vector<types::RowCol<double>> makePixels()
+{
+    // Off the grid, on it, on the edges, and outside the image
+    std::vector<types::RowCol<double>> pixels;
+    for (size_t ii = 0; ii < 500; ++ii)
+    {
+        pixels.push_back(types::RowCol<double>(0.37 * ii, 0.41 * ii + 3.3));
+    }
+    pixels.push_back(types::RowCol<double>(64.0, 96.0));
+    pixels.push_back(types::RowCol<double>(SLANT_DIMS.row - 1.0,
+                                           SLANT_DIMS.col - 1.0));
+    pixels.push_back(types::RowCol<double>(-10.0, 20.0));
+    pixels.push_back(types::RowCol<double>(250.0, 300.0));
+    return pixels;
+}
+
+template<typename T>
+std::span<T> span(std::vector<T>& values)
+{
+    return std::span<T>(values.data(), values.size());
+}
+
+template<typename T>
+std::span<const T> cspan(const std::vector<T>& values)
+{
+    return std::span<const T>(values.data(), values.size());
+}
+
+struct Transformer
+{
+    Transformer() :
+        data(makeComplexData()),
+        geometry(six::sicd::Utilities::getSceneGeometry(data.get())),
+        projection(six::sicd::Utilities::getProjectionModel(
+                data.get(), geometry.get())),
+        transformer(*data, *geometry, *projection)
+    {
+    }
+
+    std::unique_ptr<six::sicd::ComplexData> data;
+    std::unique_ptr<scene::SceneGeometry> geometry;
+    std::unique_ptr<scene::ProjectionModel> projection;
+    six::sicd::SlantPlanePixelTransformer transformer;
+};
+}
+
+TEST_CASE(testBatchMatchesSinglePixels)
+{
+    Transformer fixture;
+    const six::sicd::SlantPlanePixelTransformer& transformer =
+            fixture.transformer;
+    const std::vector<types::RowCol<double>> pixels = makePixels();
+
+    std::vector<scene::Vector3> ecef(pixels.size());
+    std::vector<scene::LatLonAlt> llas(pixels.size());
+    std::vector<scene::LatLon> latLons(pixels.size());
+    transformer.toECEF(cspan(pixels), span(ecef));
+    transformer.toLLA(cspan(pixels), span(llas));
+    transformer.toLatLon(cspan(pixels), span(latLons));
+    for (size_t ii = 0; ii < pixels.size(); ++ii)
+    {
+        const scene::Vector3 expected = transformer.toECEF(pixels[ii]);
+        TEST_ASSERT_EQ(ecef[ii][0], expected[0]);
+        TEST_ASSERT_EQ(ecef[ii][1], expected[1]);
+        TEST_ASSERT_EQ(ecef[ii][2], expected[2]);
+
+        const scene::LatLonAlt lla = transformer.toLLA(pixels[ii]);
+        TEST_ASSERT_ALMOST_EQ_EPS(llas[ii].getLat(), lla.getLat(), 1e-9);
+        TEST_ASSERT_ALMOST_EQ_EPS(llas[ii].getLon(), lla.getLon(), 1e-9);
+        TEST_ASSERT_ALMOST_EQ_EPS(llas[ii].getAlt(), lla.getAlt(), 1e-4);
+        TEST_ASSERT_EQ(latLons[ii].getLat(), llas[ii].getLat());
+        TEST_ASSERT_EQ(latLons[ii].getLon(), llas[ii].getLon());
+    }
+
+    std::vector<scene::Vector3> tooFew(pixels.size() - 1);
+    TEST_EXCEPTION(transformer.toECEF(cspan(pixels), span(tooFew)));
+}
+
+TEST_CASE(testCache)
+{
+    Transformer fixture;
+    six::sicd::SlantPlanePixelTransformer& transformer = fixture.transformer;
+    const std::vector<types::RowCol<double>> pixels = makePixels();
+    std::vector<scene::Vector3> expected(pixels.size());
+    transformer.toECEF(cspan(pixels), span(expected));
+
+    TEST_ASSERT_FALSE(transformer.hasCache());
+    const double maxError = 0.005;
+    TEST_ASSERT_EQ(transformer.enableCache(32, maxError),
+                   static_cast<size_t>(32));
+    TEST_ASSERT_TRUE(transformer.hasCache());
+
+    std::vector<scene::Vector3> cached(pixels.size());
+    transformer.toECEF(cspan(pixels), span(cached));
+    bool interpolated = false;
+    for (size_t ii = 0; ii < pixels.size(); ++ii)
+    {
+        const double error = (cached[ii] - expected[ii]).norm();
+        TEST_ASSERT_LESSER_EQ(error, maxError);
+        interpolated = interpolated || error > 0.0;
+
+        // Only pixels in the image come from the cache
+        const bool inImage = pixels[ii].row >= 0.0 &&
+                pixels[ii].row <= SLANT_DIMS.row - 1.0 &&
+                pixels[ii].col >= 0.0 &&
+                pixels[ii].col <= SLANT_DIMS.col - 1.0;
+        if (!inImage)
+        {
+            TEST_ASSERT_EQ(error, 0.0);
+        }
+    }
+    TEST_ASSERT_TRUE(interpolated);
+
+    // A bound that can't be met leaves the cache off rather than building
+    // a grid as big as the image
+    TEST_ASSERT_EQ(transformer.enableCache(32, 0.0), static_cast<size_t>(0));
+    TEST_ASSERT_FALSE(transformer.hasCache());
+
+    transformer.enableCache(32, maxError);
+    transformer.disableCache();
+    TEST_ASSERT_FALSE(transformer.hasCache());
+    transformer.toECEF(cspan(pixels), span(cached));
+    for (size_t ii = 0; ii < pixels.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(cached[ii][0], expected[ii][0]);
+    }
+    TEST_EXCEPTION(transformer.enableCache(0));
+    TEST_EXCEPTION(transformer.enableCache(
+            six::sicd::SlantPlanePixelTransformer::MIN_CACHE_SPACING - 1));
+}
+
+TEST_CASE(testGeoLocatorBatch)
+{
+    const std::unique_ptr<six::sicd::ComplexData> data = makeComplexData();
+    const six::sicd::GeoLocator locator(*data);
+    const std::vector<types::RowCol<double>> pixels = makePixels();
+
+    std::vector<scene::LatLonAlt> locations(pixels.size());
+    locator.geolocate(cspan(pixels), span(locations));
+    for (size_t ii = 0; ii < pixels.size(); ++ii)
+    {
+        const scene::LatLonAlt expected = locator.geolocate(pixels[ii]);
+        TEST_ASSERT_ALMOST_EQ_EPS(locations[ii].getLat(), expected.getLat(),
+                                  1e-9);
+        TEST_ASSERT_ALMOST_EQ_EPS(locations[ii].getLon(), expected.getLon(),
+                                  1e-9);
+        TEST_ASSERT_ALMOST_EQ_EPS(locations[ii].getAlt(), expected.getAlt(),
+                                  1e-4);
+    }
+
+    std::vector<scene::LatLonAlt> tooMany(pixels.size() + 1);
+    TEST_EXCEPTION(locator.geolocate(cspan(pixels), span(tooMany)));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testBatchMatchesSinglePixels);
+    TEST_CHECK(testCache);
+    TEST_CHECK(testGeoLocatorBatch);
+)
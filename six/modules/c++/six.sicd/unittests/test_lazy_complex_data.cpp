@@ -0,0 +1,111 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <string>
+
+#include <str/EncodedStringView.h>
+#include <six/sicd/ComplexData.h>
+#include <six/sicd/LazyComplexData.h>
+#include <six/sicd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+std::string createXML()
+{
+    const auto data = six::sicd::Utilities::createFakeComplexData();
+    const auto xml = six::sicd::Utilities::toXMLString(*data, nullptr);
+    return str::EncodedStringView(xml).native();
+}
+
+// What the SICD looks like when it's all parsed up front
+std::unique_ptr<six::sicd::ComplexData> parse(const std::string& xml)
+{
+    return six::sicd::Utilities::parseDataFromString(
+            str::EncodedStringView(xml).u8string(), nullptr);
+}
+}
+
+TEST_CASE(testBlocksParsedOnAccess)
+{
+    const std::string xml = createXML();
+    const auto data = parse(xml);
+    const six::sicd::LazyComplexData lazy(xml);
+    TEST_ASSERT_EQ(lazy.getNumBlocksParsed(), static_cast<size_t>(0));
+    TEST_ASSERT_EQ(lazy.getVersion(), data->getVersion());
+
+    TEST_ASSERT(lazy.getImageData() == *data->imageData);
+    TEST_ASSERT_EQ(lazy.getNumBlocksParsed(), static_cast<size_t>(1));
+
+    // Only the first access parses
+    TEST_ASSERT(lazy.getImageData() == *data->imageData);
+    TEST_ASSERT(lazy.getGeoData() == *data->geoData);
+    TEST_ASSERT(lazy.getGrid() == *data->grid);
+    TEST_ASSERT_EQ(lazy.getNumBlocksParsed(), static_cast<size_t>(3));
+
+    // ImageFormation brings the RadarCollection along with it
+    TEST_ASSERT(lazy.getImageFormation() == *data->imageFormation);
+    TEST_ASSERT_EQ(lazy.getNumBlocksParsed(), static_cast<size_t>(5));
+
+    // Optional blocks
+    TEST_ASSERT(lazy.getPFA() != nullptr);
+    TEST_ASSERT(*lazy.getPFA() == *data->pfa);
+    TEST_ASSERT_NULL(lazy.getRMA());
+    TEST_ASSERT_EQ(lazy.getNumBlocksParsed(), static_cast<size_t>(7));
+}
+
+TEST_CASE(testMatchesFullParse)
+{
+    const std::string xml = createXML();
+    const auto expected = parse(xml);
+
+    const six::sicd::LazyComplexData lazy(xml);
+    lazy.getGrid();
+    const auto actual = lazy.getComplexData();
+    TEST_ASSERT(*actual == *expected);
+    TEST_ASSERT_EQ(lazy.getNumBlocksParsed(),
+                   six::sicd::ComplexXMLParser::getBlockNames().size());
+
+    // Everything's still there once the DOM is gone
+    TEST_ASSERT(lazy.getGrid() == *expected->grid);
+    TEST_ASSERT(*lazy.getComplexData() == *expected);
+}
+
+TEST_CASE(testErrors)
+{
+    TEST_EXCEPTION(six::sicd::LazyComplexData("<SICD"));
+    TEST_EXCEPTION(six::sicd::LazyComplexData(
+            "<SIDD xmlns=\"urn:SIDD:2.0.0\"></SIDD>"));
+
+    // Required blocks are only found missing when they're asked for
+    const six::sicd::LazyComplexData lazy(
+            "<SICD xmlns=\"urn:SICD:1.2.1\"></SICD>");
+    TEST_EXCEPTION(lazy.getImageData());
+    TEST_ASSERT_NULL(lazy.getRadiometric());
+}
+
+TEST_MAIN(
+    TEST_CHECK(testBlocksParsedOnAccess);
+    TEST_CHECK(testMatchesFullParse);
+    TEST_CHECK(testErrors);
+)
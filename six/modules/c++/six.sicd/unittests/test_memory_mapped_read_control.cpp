@@ -0,0 +1,172 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+
+#include <complex>
+#include <string>
+#include <vector>
+#include <std/bit>
+#include <std/cstddef>
+
+#include <sys/Conf.h>
+#include <sys/OS.h>
+#include <six/NITFWriteControl.h>
+#include <six/XMLControlFactory.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/MemoryMappedReadControl.h>
+#include <six/sicd/Utilities.h>
+
+#include "TestCase.h"
+
+namespace
+{
+const types::RowCol<size_t> DIMS(64, 16);
+
+std::vector<std::complex<int16_t> > makeImage()
+{
+    std::vector<std::complex<int16_t> > image(DIMS.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = std::complex<int16_t>(static_cast<int16_t>(ii),
+                                          static_cast<int16_t>(-1 - ii));
+    }
+    return image;
+}
+
+// Writes a SICD with roughly 'numRowsPerSeg' rows in each image segment
+void writeSICD(const std::string& pathname,
+               const std::vector<std::complex<int16_t> >& image,
+               size_t numRowsPerSeg)
+{
+    six::XMLControlFactory::getInstance().addCreator<
+            six::sicd::ComplexXMLControl>();
+
+    std::unique_ptr<six::sicd::ComplexData> data(
+            six::sicd::Utilities::createFakeComplexData().release());
+    setExtent(*data, DIMS);
+    data->setPixelType(six::PixelType::RE16I_IM16I);
+
+    std::shared_ptr<six::Container> container(
+            new six::Container(six::DataType::COMPLEX));
+    container->addData(std::move(data));
+
+    static const size_t APPROX_HEADER_SIZE = 2 * 1024;
+    six::Options options;
+    options.setParameter(
+            six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE,
+            numRowsPerSeg * DIMS.col * sizeof(std::complex<int16_t>) +
+                    APPROX_HEADER_SIZE);
+
+    six::NITFWriteControl writer(options, container);
+    save(writer, image, pathname, std::vector<std::string>());
+}
+
+std::complex<int16_t> toPixel(const std::byte* bytes, bool byteSwap)
+{
+    std::complex<int16_t> pixel;
+    memcpy(&pixel, bytes, sizeof(pixel));
+    if (byteSwap)
+    {
+        sys::byteSwap(&pixel, sizeof(int16_t), 2);
+    }
+    return pixel;
+}
+}
+
+TEST_CASE(testSegmentViews)
+{
+    const std::string pathname("test_memory_mapped_read_control.nitf");
+    const auto image = makeImage();
+    writeSICD(pathname, image, 10);
+
+    {
+        six::sicd::MemoryMappedReadControl reader;
+        reader.load(pathname);
+
+        TEST_ASSERT_EQ(reader.getElementSize(), sizeof(int16_t));
+        TEST_ASSERT_EQ(reader.needsByteSwap(),
+                       std::endian::native == std::endian::little);
+        TEST_ASSERT_EQ(reader.getNumBytesPerRow(),
+                       DIMS.col * sizeof(std::complex<int16_t>));
+
+        const auto& segments = reader.getImageSegments();
+        TEST_ASSERT_GREATER(segments.size(), static_cast<size_t>(1));
+
+        size_t row = 0;
+        for (const auto& segment : segments)
+        {
+            TEST_ASSERT_EQ(segment.firstRow, row);
+            TEST_ASSERT_EQ(segment.pixels.size(),
+                           segment.numRows * reader.getNumBytesPerRow());
+
+            for (size_t ii = 0; ii < segment.numRows * DIMS.col; ++ii)
+            {
+                const auto pixel = toPixel(
+                        segment.pixels.data() + ii * sizeof(image[0]),
+                        reader.needsByteSwap());
+                TEST_ASSERT(pixel == image[row * DIMS.col + ii]);
+            }
+            row += segment.numRows;
+        }
+        TEST_ASSERT_EQ(row, DIMS.row);
+
+        // Every row is reachable on its own, wherever the segment
+        // boundaries fall
+        for (row = 0; row < DIMS.row; ++row)
+        {
+            const auto bytes = reader.getRow(row);
+            TEST_ASSERT_EQ(bytes.size(), reader.getNumBytesPerRow());
+
+            const auto pixel = toPixel(bytes.data(), reader.needsByteSwap());
+            TEST_ASSERT(pixel == image[row * DIMS.col]);
+        }
+
+        // ... but a span can't cross one
+        const auto& second = segments[1];
+        TEST_EXCEPTION(reader.getRows(second.firstRow - 1, 2));
+        TEST_EXCEPTION(reader.getRow(DIMS.row));
+
+        // The copying path is still available, and sees the same pixels
+        // (swapped to native byte order, unlike the views)
+        six::Region region;
+        std::unique_ptr<six::UByte[]> buffer;
+        reader.interleaved(region, 0, buffer);
+        const auto firstRow = reader.getRow(0);
+        for (size_t col = 0; col < DIMS.col; ++col)
+        {
+            const size_t offset = col * sizeof(image[0]);
+            const auto copied = toPixel(
+                    reinterpret_cast<const std::byte*>(buffer.get()) + offset,
+                    false /*byteSwap*/);
+            TEST_ASSERT(copied ==
+                        toPixel(firstRow.data() + offset, reader.needsByteSwap()));
+            TEST_ASSERT(copied == image[col]);
+        }
+    }
+
+    sys::OS().remove(pathname);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testSegmentViews);
+)
@@ -0,0 +1,258 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include <scene/Utilities.h>
+#include <six/Executor.h>
+#include <six/sicd/OutputPlaneResampler.h>
+#include <six/sicd/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+const types::RowCol<size_t> SLANT_DIMS(200, 240);
+
+// A ground plane SICD of a scene at 40N, 80W, collected by a platform
+// flying north 15 km to the west of it, 8 km up.  The output plane is
+// rotated and resampled from the image plane, and is wider than the image,
+// so some of it falls outside.
+std::unique_ptr<six::sicd::ComplexData> makeComplexData()
+{
+    std::unique_ptr<six::sicd::ComplexData> data =
+            six::sicd::Utilities::createFakeComplexData(&SLANT_DIMS);
+
+    const scene::LatLonAlt scpLatLon(40.0, -80.0, 0.0);
+    const six::Vector3 scp = scene::Utilities::latLonToECEF(scpLatLon);
+    const double lat = scpLatLon.getLatRadians();
+    const double lon = scpLatLon.getLonRadians();
+    const six::Vector3 up({std::cos(lat) * std::cos(lon),
+                           std::cos(lat) * std::sin(lon),
+                           std::sin(lat)});
+    const six::Vector3 east({-std::sin(lon), std::cos(lon), 0.0});
+    const six::Vector3 north = math::linear::cross(up, east);
+
+    data->geoData->scp.ecf = scp;
+    data->geoData->scp.llh = scpLatLon;
+
+    data->position->arpPoly = six::PolyXYZ(1);
+    data->position->arpPoly[0] = scp + up * 8000.0 - east * 15000.0;
+    data->position->arpPoly[1] = north * 200.0;
+    data->scpcoa->scpTime = 0.0;
+    data->scpcoa->arpPos = data->position->arpPoly[0];
+    data->scpcoa->arpVel = data->position->arpPoly[1];
+    data->scpcoa->sideOfTrack = six::SideOfTrackType::RIGHT;
+
+    // Broadside to each column, give or take
+    data->grid->type = six::ComplexImageGridType::PLANE;
+    data->grid->row->unitVector = east;
+    data->grid->col->unitVector = north;
+    data->grid->row->sampleSpacing = 1.0;
+    data->grid->col->sampleSpacing = 1.0;
+    data->grid->timeCOAPoly = six::Poly2D(1, 1);
+    data->grid->timeCOAPoly[0][1] = 0.005;
+    data->grid->timeCOAPoly[1][1] = 1e-6;
+
+    data->imageData->firstRow = 0;
+    data->imageData->firstCol = 0;
+    data->imageData->scpPixel = six::RowColInt(100, 120);
+
+    const double angle = 0.5;
+    data->radarCollection->area.reset(new six::sicd::Area());
+    data->radarCollection->area->plane.reset(new six::sicd::AreaPlane());
+    six::sicd::AreaPlane& plane = *data->radarCollection->area->plane;
+    plane.referencePoint.ecef = scp;
+    plane.referencePoint.rowCol = six::RowColDouble(90.0, 150.0);
+    plane.xDirection->unitVector =
+            east * std::cos(angle) + north * std::sin(angle);
+    plane.yDirection->unitVector =
+            north * std::cos(angle) - east * std::sin(angle);
+    plane.xDirection->spacing = 0.8;
+    plane.yDirection->spacing = 1.1;
+    plane.xDirection->elements = 181;
+    plane.yDirection->elements = 301;
+    return data;
+}
+
+std::vector<float> makeSlantImage()
+{
+    // Bilinear interpolation of this is exact
+    std::vector<float> image(SLANT_DIMS.area());
+    for (size_t row = 0, idx = 0; row < SLANT_DIMS.row; ++row)
+    {
+        for (size_t col = 0; col < SLANT_DIMS.col; ++col, ++idx)
+        {
+            image[idx] = 2.0f * row + 3.0f * col + 1.0f;
+        }
+    }
+    return image;
+}
+
+template<typename T>
+std::span<T> span(std::vector<T>& values)
+{
+    return std::span<T>(values.data(), values.size());
+}
+
+template<typename T>
+std::span<const T> cspan(const std::vector<T>& values)
+{
+    return std::span<const T>(values.data(), values.size());
+}
+
+bool inSlantImage(const types::RowCol<double>& pixel)
+{
+    return pixel.row >= 0.0 && pixel.row <= SLANT_DIMS.row - 1.0 &&
+            pixel.col >= 0.0 && pixel.col <= SLANT_DIMS.col - 1.0;
+}
+}
+
+TEST_CASE(testGridMatchesProjection)
+{
+    const std::unique_ptr<six::sicd::ComplexData> data = makeComplexData();
+    six::Executor executor(3);
+    const six::sicd::OutputPlaneResampler resampler(*data, 16, &executor);
+    TEST_ASSERT_EQ(resampler.getOutputDims().row, static_cast<size_t>(181));
+    TEST_ASSERT_EQ(resampler.getOutputDims().col, static_cast<size_t>(301));
+    TEST_ASSERT_EQ(resampler.getSlantDims().area(), SLANT_DIMS.area());
+
+    std::vector<types::RowCol<double>> opPixels;
+    for (size_t row = 0; row < 181; row += 9)
+    {
+        for (size_t col = 0; col < 301; col += 13)
+        {
+            opPixels.push_back(types::RowCol<double>(row, col));
+        }
+    }
+    opPixels.push_back(types::RowCol<double>(180.0, 300.0));
+
+    std::vector<types::RowCol<double>> spPixels;
+    six::sicd::Utilities::projectPixelsToSlantPlane(*data, opPixels, spPixels);
+    for (size_t ii = 0; ii < opPixels.size(); ++ii)
+    {
+        const types::RowCol<double> interpolated =
+                resampler.toSlantPixel(opPixels[ii]);
+        TEST_ASSERT_ALMOST_EQ_EPS(interpolated.row, spPixels[ii].row, 0.01);
+        TEST_ASSERT_ALMOST_EQ_EPS(interpolated.col, spPixels[ii].col, 0.01);
+    }
+}
+
+TEST_CASE(testResampleDetected)
+{
+    const std::unique_ptr<six::sicd::ComplexData> data = makeComplexData();
+    six::Executor executor(1);
+    const six::sicd::OutputPlaneResampler resampler(*data, 8, &executor);
+    const types::RowCol<size_t> dims = resampler.getOutputDims();
+    const std::vector<float> slantImage = makeSlantImage();
+
+    std::vector<float> output(dims.area());
+    resampler.resample(cspan(slantImage), span(output), &executor);
+
+    size_t numInside = 0;
+    for (size_t row = 0, idx = 0; row < dims.row; ++row)
+    {
+        for (size_t col = 0; col < dims.col; ++col, ++idx)
+        {
+            const types::RowCol<double> spPixel =
+                    resampler.toSlantPixel(types::RowCol<double>(row, col));
+            if (inSlantImage(spPixel))
+            {
+                ++numInside;
+                const double expected =
+                        2.0 * spPixel.row + 3.0 * spPixel.col + 1.0;
+                TEST_ASSERT_ALMOST_EQ_EPS(output[idx], expected, 1e-3);
+            }
+            else
+            {
+                TEST_ASSERT_EQ(output[idx], 0.0f);
+            }
+        }
+    }
+    TEST_ASSERT_LESSER(numInside, dims.area());
+    TEST_ASSERT_GREATER(numInside, dims.area() / 2);
+
+    // Same thing from complex samples, however many threads
+    std::vector<std::complex<float>> complexImage(slantImage.size());
+    for (size_t ii = 0; ii < slantImage.size(); ++ii)
+    {
+        complexImage[ii] = std::polar(slantImage[ii], 0.25f * (ii % 7));
+    }
+    six::Executor threaded(4);
+    std::vector<float> detected(dims.area());
+    resampler.resampleDetected(cspan(complexImage), span(detected), &threaded);
+    for (size_t ii = 0; ii < output.size(); ++ii)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(detected[ii], output[ii], 1e-3);
+    }
+}
+
+TEST_CASE(testResampleComplex)
+{
+    const std::unique_ptr<six::sicd::ComplexData> data = makeComplexData();
+    const six::sicd::OutputPlaneResampler resampler(*data);
+    const types::RowCol<size_t> dims = resampler.getOutputDims();
+    const std::vector<float> slantImage = makeSlantImage();
+
+    std::vector<std::complex<float>> complexImage(slantImage.size());
+    for (size_t ii = 0; ii < slantImage.size(); ++ii)
+    {
+        complexImage[ii] = std::complex<float>(slantImage[ii],
+                                               -0.5f * slantImage[ii]);
+    }
+
+    std::vector<float> output(dims.area());
+    std::vector<std::complex<float>> complexOutput(dims.area());
+    six::Executor executor(4);
+    resampler.resample(cspan(slantImage), span(output), &executor);
+    resampler.resample(cspan(complexImage), span(complexOutput), &executor);
+    for (size_t ii = 0; ii < output.size(); ++ii)
+    {
+        TEST_ASSERT_ALMOST_EQ_EPS(complexOutput[ii].real(), output[ii], 1e-3);
+        TEST_ASSERT_ALMOST_EQ_EPS(complexOutput[ii].imag(),
+                                  -0.5f * output[ii], 1e-3);
+    }
+}
+
+TEST_CASE(testWrongSizes)
+{
+    const std::unique_ptr<six::sicd::ComplexData> data = makeComplexData();
+    const six::sicd::OutputPlaneResampler resampler(*data);
+    std::vector<float> slantImage(SLANT_DIMS.area() - 1);
+    std::vector<float> output(resampler.getOutputDims().area());
+    TEST_EXCEPTION(resampler.resample(cspan(slantImage), span(output)));
+
+    slantImage.resize(SLANT_DIMS.area());
+    output.resize(output.size() + 1);
+    TEST_EXCEPTION(resampler.resample(cspan(slantImage), span(output)));
+
+    TEST_EXCEPTION(six::sicd::OutputPlaneResampler(*data, 0));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testGridMatchesProjection);
+    TEST_CHECK(testResampleDetected);
+    TEST_CHECK(testResampleComplex);
+    TEST_CHECK(testWrongSizes);
+)
@@ -0,0 +1,187 @@
+/* =========================================================================
+ * This file is part of six.sicd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sicd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <complex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/OS.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/XMLControlFactory.h>
+#include <six/sicd/ComplexXMLControl.h>
+#include <six/sicd/SICDStripReader.h>
+#include <six/sicd/Utilities.h>
+
+#include "TestCase.h"
+
+namespace
+{
+const types::RowCol<size_t> DIMS(45, 13);
+
+template <typename T>
+void writeSICD(const std::string& pathname,
+               six::PixelType pixelType,
+               const std::vector<T>& image)
+{
+    six::XMLControlFactory::getInstance().addCreator<
+            six::sicd::ComplexXMLControl>();
+
+    std::unique_ptr<six::sicd::ComplexData> data(
+            six::sicd::Utilities::createFakeComplexData().release());
+    setExtent(*data, DIMS);
+    data->setPixelType(pixelType);
+
+    std::shared_ptr<six::Container> container(
+            new six::Container(six::DataType::COMPLEX));
+    container->addData(std::move(data));
+
+    six::NITFWriteControl writer(container);
+    save(writer, image, pathname, std::vector<std::string>());
+}
+
+// Streams the whole image and checks it against getWidebandData()
+bool streamMatches(const std::string& pathname,
+                   size_t numRowsPerStrip,
+                   size_t numBuffers)
+{
+    six::NITFReadControl reader;
+    reader.load(pathname);
+    const auto complexData = six::sicd::Utilities::getComplexData(reader);
+
+    std::vector<std::complex<float> > expected;
+    six::sicd::Utilities::getWidebandData(reader, *complexData, expected);
+
+    std::vector<std::complex<float> > streamed;
+    {
+        six::sicd::SICDStripReader strips(reader, *complexData,
+                                          numRowsPerStrip, numBuffers);
+        six::sicd::SICDStrip strip;
+        while (strips.next(strip))
+        {
+            if (strip.firstRow * DIMS.col != streamed.size() ||
+                strip.numRows > numRowsPerStrip ||
+                strip.pixels.size() != strip.numRows * DIMS.col)
+            {
+                return false;
+            }
+            streamed.insert(streamed.end(), strip.pixels.begin(),
+                            strip.pixels.end());
+        }
+
+        // Done means done
+        if (strips.next(strip))
+        {
+            return false;
+        }
+    }
+
+    return streamed == expected;
+}
+}
+
+TEST_CASE(testRE32F_IM32F)
+{
+    const std::string pathname("test_sicd_strip_reader_RE32F.nitf");
+    std::vector<std::complex<float> > image(DIMS.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = std::complex<float>(static_cast<float>(ii), -0.5f);
+    }
+    writeSICD(pathname, six::PixelType::RE32F_IM32F, image);
+
+    TEST_ASSERT(streamMatches(pathname, 1, 1));
+    TEST_ASSERT(streamMatches(pathname, 7, 2));
+    TEST_ASSERT(streamMatches(pathname, 10, 3));
+    TEST_ASSERT(streamMatches(pathname, DIMS.row + 1, 2));
+
+    sys::OS().remove(pathname);
+}
+
+TEST_CASE(testRE16I_IM16I)
+{
+    const std::string pathname("test_sicd_strip_reader_RE16I.nitf");
+    std::vector<std::complex<short> > image(DIMS.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = std::complex<short>(static_cast<short>(ii),
+                                        static_cast<short>(-1 - ii));
+    }
+    writeSICD(pathname, six::PixelType::RE16I_IM16I, image);
+
+    TEST_ASSERT(streamMatches(pathname, 1, 1));
+    TEST_ASSERT(streamMatches(pathname, 7, 2));
+    TEST_ASSERT(streamMatches(pathname, DIMS.row, 4));
+
+    sys::OS().remove(pathname);
+}
+
+TEST_CASE(testAMP8I_PHS8I)
+{
+    const std::string pathname("test_sicd_strip_reader_AMP8I.nitf");
+    std::vector<std::pair<uint8_t, uint8_t> > image(DIMS.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = std::make_pair(static_cast<uint8_t>(ii),
+                                   static_cast<uint8_t>(ii * 7));
+    }
+    writeSICD(pathname, six::PixelType::AMP8I_PHS8I, image);
+
+    TEST_ASSERT(streamMatches(pathname, 1, 1));
+    TEST_ASSERT(streamMatches(pathname, 7, 2));
+    TEST_ASSERT(streamMatches(pathname, 16, 3));
+
+    sys::OS().remove(pathname);
+}
+
+TEST_CASE(testStopEarly)
+{
+    const std::string pathname("test_sicd_strip_reader_stop.nitf");
+    std::vector<std::complex<float> > image(DIMS.area());
+    writeSICD(pathname, six::PixelType::RE32F_IM32F, image);
+
+    {
+        six::NITFReadControl reader;
+        reader.load(pathname);
+        const auto complexData = six::sicd::Utilities::getComplexData(reader);
+
+        // Walking away with strips still queued must not hang or leak
+        six::sicd::SICDStripReader strips(reader, *complexData, 2, 3);
+        six::sicd::SICDStrip strip;
+        TEST_ASSERT(strips.next(strip));
+        TEST_ASSERT_EQ(strip.firstRow, static_cast<size_t>(0));
+        TEST_ASSERT_EQ(strips.getNumRowsPerStrip(), static_cast<size_t>(2));
+
+        TEST_EXCEPTION(six::sicd::SICDStripReader(reader, *complexData, 0));
+        TEST_EXCEPTION(six::sicd::SICDStripReader(reader, *complexData, 1, 0));
+    }
+
+    sys::OS().remove(pathname);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testRE32F_IM32F);
+    TEST_CHECK(testRE16I_IM16I);
+    TEST_CHECK(testAMP8I_PHS8I);
+    TEST_CHECK(testStopEarly);
+)
@@ -45,8 +45,20 @@ TEST_CASE(testCounterClockwiseTriangle)
     TEST_ASSERT(six::sicd::Utilities::isClockwise(vertices));
 }
 
+TEST_CASE(testNumGridPoints)
+{
+    // Every pixel falls in a cell, even when the spacing doesn't divide
+    TEST_ASSERT_EQ(six::sicd::Utilities::getNumGridPoints(0, 16), 2);
+    TEST_ASSERT_EQ(six::sicd::Utilities::getNumGridPoints(1, 16), 2);
+    TEST_ASSERT_EQ(six::sicd::Utilities::getNumGridPoints(17, 16), 2);
+    TEST_ASSERT_EQ(six::sicd::Utilities::getNumGridPoints(18, 16), 3);
+    TEST_ASSERT_EQ(six::sicd::Utilities::getNumGridPoints(33, 16), 3);
+    TEST_ASSERT_EQ(six::sicd::Utilities::getNumGridPoints(100, 1), 100);
+}
+
 TEST_MAIN(
     TEST_CHECK(testClockwiseBox);
     TEST_CHECK(testCounterClockwiseTriangle);
+    TEST_CHECK(testNumGridPoints);
 )
 
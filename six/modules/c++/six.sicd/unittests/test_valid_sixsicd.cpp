@@ -29,6 +29,7 @@
 #include <std/span>
 
 #include <io/FileInputStream.h>
+#include <io/StringStream.h>
 #include <logging/NullLogger.h>
 #include <import/sys.h>
 
@@ -69,6 +70,19 @@ static std::vector<std::filesystem::path> getSchemaPaths()
     return std::vector<std::filesystem::path> { (root_dir / schema_relative_path()) };
 }
 
+// Writing straight to a stream has to give exactly what printing the DOM does
+static void test_assert_streamed_xml(const std::string& testName, const six::sicd::ComplexData& complexData)
+{
+    six::sicd::ComplexXMLControl xmlControl;
+    const auto pDoc = xmlControl.toXML(complexData, nullptr /*pSchemaPaths*/);
+    io::StringStream domStream;
+    pDoc->getRootElement()->print(domStream);
+
+    io::StringStream xmlStream;
+    xmlControl.toXML(complexData, xmlStream, nullptr /*pSchemaPaths*/);
+    TEST_ASSERT_EQ(xmlStream.stream().str(), domStream.stream().str());
+}
+
 static std::unique_ptr<six::sicd::ComplexData> test_assert_round_trip(const std::string& testName,
     const six::sicd::ComplexData& complexData, const std::vector<std::filesystem::path>* pSchemaPaths)
 {
@@ -95,6 +109,8 @@ static void test_createFakeComplexData_(const std::string& testName, const std::
     auto Unmodeled = get_Unmodeled(*pFakeComplexData, strVersion);
     TEST_ASSERT_NULL(Unmodeled); // not part of the fake data, only added in SICD 1.3
 
+    test_assert_streamed_xml(testName, *pFakeComplexData);
+
     // NULL schemaPaths, no validation
     auto pComplexData = test_assert_round_trip(testName , *pFakeComplexData, nullptr /*pSchemaPaths*/);
     Unmodeled = get_Unmodeled(*pComplexData, strVersion);
@@ -153,6 +169,7 @@ static void test_read_sicd_xml(const std::string& testName, const std::filesyste
     // NULL schemaPaths, no validation
     auto pComplexData = six::sicd::Utilities::parseDataFromFile(pathname, nullptr /*pSchemaPaths*/);
     test_assert(testName, *pComplexData);
+    test_assert_streamed_xml(testName, *pComplexData);
 
     pComplexData = test_assert_round_trip(testName , *pComplexData, nullptr /*pSchemaPaths*/);
     test_assert(testName, *pComplexData);
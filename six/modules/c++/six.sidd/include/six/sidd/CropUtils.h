@@ -40,17 +40,24 @@ namespace sidd
  * TODO: The SIDD standard supports more complicated chipping than this -
  * you can translate, rotate, and/or scale.
  *
+ * The pixels of each product are copied as they are in the file, a strip of
+ * rows at a time, so only a couple of strips are ever in memory rather than
+ * the whole AOI.
+ *
  * \param inPathname Input SIDD pathname
  * \param schemaPaths Schema paths to use for reading and writing
  * \param aoiOffset Upper left corner of AOI
  * \param aoiDims Size of AOI
  * \param outPathname Output cropped SIDD pathname
+ * \param numRowsPerStrip Number of rows copied at a time.  If 0, each strip
+ * is as many rows as fit in about 32 MB.
  */
 void cropSIDD(const std::string& inPathname,
               const std::vector<std::string>& schemaPaths,
               const types::RowCol<size_t>& aoiOffset,
               const types::RowCol<size_t>& aoiDims,
-              const std::string& outPathname);
+              const std::string& outPathname,
+              size_t numRowsPerStrip = 0);
 }
 }
 
@@ -60,6 +60,9 @@ protected:
      */
     virtual xml::lite::Document* toXMLImpl(const Data* data);
     virtual std::unique_ptr<xml::lite::Document> toXMLImpl(const Data&) const override;
+
+    //! Writes the XML a top-level block at a time, without a full DOM
+    void toXMLImpl(const Data&, io::OutputStream&) const override;
     /*!
      *  Returns a new allocated DerivedData*, created from the DOM Document*
      *
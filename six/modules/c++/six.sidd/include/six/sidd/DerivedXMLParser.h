@@ -36,6 +36,13 @@ struct DerivedXMLParser : public six::XMLParser
     virtual xml::lite::Document* toXML(const DerivedData* data) const = 0;
     virtual std::unique_ptr<xml::lite::Document> toXML(const DerivedData&) const; // = 0;, breaks existing code
 
+    /*!
+     *  Writes the same XML as printing toXML()'s document.  The parsers for
+     *  each SIDD version do that a top-level block at a time, rather than
+     *  building the whole DOM first.
+     */
+    virtual void toXML(const DerivedData&, io::OutputStream&) const;
+
     virtual DerivedData* fromXML(const xml::lite::Document* doc) const = 0;
     virtual std::unique_ptr<DerivedData> fromXML(const xml::lite::Document&) const; // = 0;, breaks existing code
 
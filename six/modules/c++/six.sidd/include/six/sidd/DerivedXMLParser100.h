@@ -40,6 +40,7 @@ public:
 
     virtual xml::lite::Document* toXML(const DerivedData* data) const override;
     std::unique_ptr<xml::lite::Document> toXML(const DerivedData&) const override;
+    void toXML(const DerivedData&, io::OutputStream&) const override;
 
     virtual DerivedData* fromXML(const xml::lite::Document* doc) const override;
     std::unique_ptr<DerivedData> fromXML(const xml::lite::Document&) const override;
@@ -73,6 +74,10 @@ protected:
                                         XMLElem parent = nullptr) const;
 
 private:
+    // What toXML() adds to the root, in order
+    std::vector<XMLBlock> getXMLBlocks(const DerivedData& derived) const;
+    void setNamespaces(XMLElem root) const;
+
     static const char VERSION[];
     static const char SI_COMMON_URI[];
     static const char ISM_URI[];
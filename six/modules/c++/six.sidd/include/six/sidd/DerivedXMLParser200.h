@@ -41,6 +41,7 @@ struct DerivedXMLParser200 : public DerivedXMLParser
 
     virtual xml::lite::Document* toXML(const DerivedData* data) const override;
     std::unique_ptr<xml::lite::Document> toXML(const DerivedData&) const override;
+    void toXML(const DerivedData&, io::OutputStream&) const override;
 
     virtual DerivedData* fromXML(const xml::lite::Document* doc) const override;
     std::unique_ptr<DerivedData> fromXML(const xml::lite::Document&) const override;
@@ -75,6 +76,12 @@ struct DerivedXMLParser200 : public DerivedXMLParser
     static xml::lite::Element& convertDisplayToXML(const DerivedXMLParser&,
         const Display&, xml::lite::Element& parent);
 
+    /*!
+     * What convertDisplayToXML() adds, as a block writeBlocks() makes one
+     * band's processing at a time, since each can carry big LUTs.
+     */
+    static XMLBlock getDisplayBlock(const DerivedXMLParser&, const Display&);
+
 protected:
     virtual void parseDerivedClassificationFromXML(
             const xml::lite::Element* classificationElem,
@@ -120,6 +127,10 @@ protected:
         XMLElem parent = nullptr) const override;
 
 private:
+    // What toXML() adds to the root, in order
+    std::vector<XMLBlock> getXMLBlocks(const DerivedData& derived) const;
+    void setNamespaces(XMLElem root) const;
+
     static const char VERSION[];
     static const char SI_COMMON_URI[];
     static const char ISM_URI[];
@@ -127,6 +138,12 @@ private:
     static xml::lite::Element& convertLookupTableToXML(const DerivedXMLParser&,
         const std::string& name, const LookupTable&, xml::lite::Element& parent);
 
+    // Display without its processing and extensions, and then those
+    static xml::lite::Element& createDisplay(const DerivedXMLParser&,
+        const Display&, xml::lite::Element& parent);
+    static std::vector<XMLBlock> getDisplayChildren(const DerivedXMLParser&,
+        const Display&);
+
     static xml::lite::Element& convertNonInteractiveProcessingToXML(const DerivedXMLParser&,
         const NonInteractiveProcessing&, xml::lite::Element& parent);
 
@@ -42,11 +42,16 @@ struct DerivedXMLParser300 final : public DerivedXMLParser
 
     xml::lite::Document* toXML(const DerivedData* data) const override;
     std::unique_ptr<xml::lite::Document> toXML(const DerivedData&) const override;
+    void toXML(const DerivedData&, io::OutputStream&) const override;
 
     DerivedData* fromXML(const xml::lite::Document* doc) const override;
     std::unique_ptr<DerivedData> fromXML(const xml::lite::Document&) const override;
 
 private:
+    // What toXML() adds to the root, in order
+    std::vector<XMLBlock> getXMLBlocks(const DerivedData& derived) const;
+    void setNamespaces(XMLElem root) const;
+
     XMLElem convertDerivedClassificationToXML(const DerivedClassification&, XMLElem parent = nullptr) const override;
     void parseDerivedClassificationFromXML(const xml::lite::Element* classificationElem, DerivedClassification&) const override;
 
@@ -0,0 +1,125 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __SIX_SIDD_J2K_TILE_COMPRESSOR_H__
+#define __SIX_SIDD_J2K_TILE_COMPRESSOR_H__
+
+#include <functional>
+#include <vector>
+
+#include <std/cstddef>
+#include <std/span>
+#include <types/RowCol.h>
+#include <six/Executor.h>
+
+#include <nitf/J2KCompressionParameters.hpp>
+
+namespace six
+{
+namespace sidd
+{
+/*!
+ *  \class J2KTileCompressor
+ *  \brief Compresses a SIDD image into a J2K codestream, encoding the tiles
+ *  in parallel
+ *
+ *  Each J2K tile is one NITF block, and is encoded independently of the
+ *  others, so the tiles are spread across the threads of an Executor and
+ *  handed back in order as they finish.  Only a fixed number of tiles are in
+ *  flight at once (being encoded, or encoded but waiting on an earlier tile),
+ *  so the scratch memory is bounded by that rather than by the image size.
+ *
+ *  The codestream, and the compressed size of each tile, are what
+ *  CompressedSIDDByteProvider needs, with the tile dimensions as the
+ *  blocking.  Only single-byte pixels (MONO8I) can be compressed.
+ */
+class J2KTileCompressor
+{
+public:
+    /*!
+     *  Called with each compressed tile, in tile order.  The first tile
+     *  includes the codestream header and the last one its footer.  Calls
+     *  are never concurrent, but may come from any thread.
+     */
+    typedef std::function<void(size_t tileIndex,
+                               std::span<const std::byte> compressedTile)>
+            TileSink;
+
+    /*!
+     *  \param imageDims Dimensions of the image
+     *  \param tileDims Dimensions of each tile (the NITF blocking)
+     *  \param compressionRatio J2K compression ratio; 1 is lossless
+     *  \param numTilesInFlight Most tiles to hold at once.  0 is twice
+     *  the number of threads in the executor used.
+     *
+     *  \throws except::Exception if the dimensions are empty
+     */
+    J2KTileCompressor(const types::RowCol<size_t>& imageDims,
+                      const types::RowCol<size_t>& tileDims,
+                      double compressionRatio = 1.0,
+                      size_t numTilesInFlight = 0);
+
+    size_t getNumTiles() const
+    {
+        return mParams.getNumTiles();
+    }
+
+    /*!
+     *  Compresses the image, handing each tile to sink as soon as it and all
+     *  the tiles before it are compressed.
+     *
+     *  \param image The whole image, row-major
+     *  \param sink Where to send the compressed tiles
+     *  \param pExecutor Executor to compress on, or nullptr for the
+     *  process-wide one
+     *
+     *  \throws except::Exception if image is the wrong size, or the first
+     *  exception from compressing or from sink
+     */
+    void compress(std::span<const std::byte> image,
+                  const TileSink& sink,
+                  Executor* pExecutor = nullptr) const;
+
+    /*!
+     *  As above, but collects the whole codestream.
+     *
+     *  \param image The whole image, row-major
+     *  \param codestream [output] The compressed image
+     *  \param bytesPerTile [output] The compressed size of each tile, in
+     *  bytes.  This is one image segment's worth of
+     *  CompressedSIDDByteProvider's bytesPerBlock.
+     *  \param pExecutor Executor to compress on, or nullptr for the
+     *  process-wide one
+     */
+    void compress(std::span<const std::byte> image,
+                  std::vector<std::byte>& codestream,
+                  std::vector<size_t>& bytesPerTile,
+                  Executor* pExecutor = nullptr) const;
+
+private:
+    const j2k::CompressionParameters mParams;
+    const size_t mNumTilesInFlight;
+};
+}
+}
+
+#endif
@@ -0,0 +1,159 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2018, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __SIX_SIDD_WRITE_CONTROL_H__
+#define __SIX_SIDD_WRITE_CONTROL_H__
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include <types/RowCol.h>
+#include <six/NITFWriteControl.h>
+#include <six/PositionalFileWriter.h>
+#include <six/sidd/DerivedData.h>
+
+#include <nitf/coda-oss.hpp>
+
+namespace six
+{
+namespace sidd
+{
+/*!
+ * \class SIDDWriteControl
+ * \brief Specialized NITF write control that allows for writing SIDDs out
+ * in pieces
+ *
+ * This is the SIDD counterpart of SICDWriteControl: pixels may arrive in
+ * tiles, in any order, from several threads at once, rather than all at
+ * once through NITFWriteControl::save().  The file may hold several SIDD
+ * products (and their legends), each of which may be blocked (via the
+ * NITFHeaderCreator::OPT_NUM_ROWS_PER_BLOCK and OPT_NUM_COLS_PER_BLOCK
+ * options) and split across several image segments.  The layout is
+ * whatever NITFWriteControl would have written for the same container and
+ * options, so the resulting file is identical.
+ *
+ * Blocked image data is written a row of blocks at a time.  A tile that
+ * covers a whole row of blocks goes straight to the file; otherwise its
+ * pixels are held until the rest of that row of blocks arrives, so the
+ * memory held is one row of blocks for each row of blocks that is only
+ * partly written.  Saving tiles roughly in row order keeps that to one or
+ * two.  Unblocked image data is written directly, a row at a time.
+ *
+ * J2K compression, graphics, text and additional DESs are not supported.
+ */
+class SIDDWriteControl : public six::NITFWriteControl
+{
+public:
+    /*!
+     * Constructor
+     *
+     * \param outputPathname Full path to the output file to write
+     * \param schemaPaths Directories or files of schema locations
+     */
+    SIDDWriteControl(const std::string& outputPathname,
+                     const std::vector<std::string>& schemaPaths);
+
+    //! Calls close(), ignoring any errors
+    ~SIDDWriteControl();
+
+    SIDDWriteControl(const SIDDWriteControl&) = delete;
+    SIDDWriteControl& operator=(const SIDDWriteControl&) = delete;
+
+    using NITFWriteControl::initialize;
+
+    /*!
+     * Initializes the control for a single SIDD product.  Either this or
+     * the base class's initialize() function must be called prior to any of
+     * the save() methods or doing anything to manipulate the underlying
+     * Record object.
+     *
+     * \param data Representation of the derived data
+     */
+    void initialize(const DerivedData& data);
+
+    using NITFWriteControl::save;
+
+    /*!
+     * Writes a tile of one product's pixels to the file.  The first time
+     * this is called, the headers (and any legends) will be written to the
+     * file.  This may be called as many times as desired with different
+     * AOIs in any order, including from several threads at once, as long as
+     * the AOIs don't overlap.
+     *
+     * \param imageData The tile's pixels, row-major and in native byte
+     *     order; pixel-interleaved for RGB24I
+     * \param offset The offset in pixels of the tile within the product.
+     *     If the product spans several image segments, this is still simply
+     *     the product's pixel location.
+     * \param dims The dimensions of the tile
+     * \param imageNumber The product the tile belongs to
+     *
+     * \throws except::Exception if the tile isn't within the product
+     */
+    void save(const void* imageData,
+              const types::RowCol<size_t>& offset,
+              const types::RowCol<size_t>& dims,
+              size_t imageNumber = 0);
+
+    /*!
+     * Writes out any rows of blocks that are still only partly written, with
+     * the missing pixels set to 0, and closes the file.  This will occur
+     * implicitly in the destructor if it's not called.  No save()s may be
+     * running.
+     */
+    void close();
+
+private:
+    struct ImageSegment;
+    struct Product;
+
+    void writeHeaders();
+
+    void writeRows(const ImageSegment& segment,
+                   const std::byte* imageData,
+                   size_t startRow,
+                   size_t numRows,
+                   size_t startCol,
+                   size_t numCols);
+
+    void writeBlockRow(const ImageSegment& segment,
+                       size_t blockRow,
+                       const std::byte* imageData);
+
+private:
+    std::unique_ptr<PositionalFileWriter> mImageWriter;
+    const std::vector<std::string> mSchemaPaths;
+
+    std::vector<std::unique_ptr<Product> > mProducts;
+    std::mutex mHeaderMutex;
+    std::mutex mPendingMutex;
+    bool mHaveWrittenHeaders;
+};
+}
+}
+
+#endif
@@ -27,37 +27,13 @@
 
 #include <nitf/coda-oss.hpp>
 #include <except/Exception.h>
-#include <mem/ScopedArray.h>
 #include <six/NITFReadControl.h>
-#include <six/NITFWriteControl.h>
+#include <six/sidd/SIDDWriteControl.h>
 #include <six/sidd/Utilities.h>
 #include <six/sidd/DerivedData.h>
 
 namespace
 {
-struct Buffers final
-{
-    std::byte* add(size_t numBytes)
-    {        
-        mBuffers.push_back(std::vector<std::byte>(numBytes));
-        return mBuffers.back().data();
-    }
-
-    six::BufferList get()
-    {
-        six::BufferList retval;
-        for (auto& buffer : mBuffers)
-        {
-            const void* pBuffer = buffer.data();
-            retval.push_back(static_cast<const six::UByte*>(pBuffer));
-        }
-        return retval;
-    }
-
-private:
-    std::vector<std::vector<std::byte>> mBuffers;
-};
-
 struct ChipCoordinateToFullImageCoordinate final
 {
     ChipCoordinateToFullImageCoordinate(const six::sidd::DerivedData& data)
@@ -132,20 +108,22 @@ void cropSIDD(const std::string& inPathname,
               const std::vector<std::string>& schemaPaths,
               const types::RowCol<size_t>& aoiOffset,
               const types::RowCol<size_t>& aoiDims,
-              const std::string& outPathname)
+              const std::string& outPathname,
+              size_t numRowsPerStrip)
 {
     // Make sure it's a SIDD
     six::NITFReadControl reader;
     reader.load(inPathname, schemaPaths);
-    auto container(reader.getContainer());
-
-    if (container->getDataType() != six::DataType::DERIVED)
+    if (reader.getContainer()->getDataType() != six::DataType::DERIVED)
     {
         throw except::Exception(Ctxt(inPathname + " is not a SIDD"));
     }
 
-    Buffers buffers;
-    for (size_t ii = 0, imageNum = 0; ii < container->size(); ++ii)
+    // The reader still needs the original metadata, so the cropped
+    // metadata goes in a copy
+    auto container = std::make_shared<six::Container>(*reader.getContainer());
+    size_t numImages = 0;
+    for (size_t ii = 0; ii < container->size(); ++ii)
     {
         six::Data* const dataPtr = container->getData(ii);
         if (dataPtr->getDataType() == six::DataType::DERIVED)
@@ -167,16 +145,7 @@ void cropSIDD(const std::string& inPathname,
                 throw except::Exception(Ctxt("AOI must be non-empty"));
             }
 
-            // Read in the AOI
-            const size_t numBytesPerPixel(data->getNumBytesPerPixel());
-            const size_t numBytes = origDims.row * origDims.col * numBytesPerPixel;
-            auto const buffer = buffers.add(numBytes);
-
-            six::Region region;
-            setOffset(region, aoiOffset);
-            setDims(region, aoiDims);
-            region.setBuffer(buffer);
-            reader.interleaved(region, imageNum++);
+            ++numImages;
 
             // Update to reflect the AOI in the SIX metadata
             // Construct the pixel --> lat/lon functor first so updating this
@@ -228,9 +197,21 @@ void cropSIDD(const std::string& inPathname,
         }
     }
 
-    // Write the AOI SIDD out
-    six::NITFWriteControl writer(container);
-    writer.save(buffers.get(), outPathname, schemaPaths);
+    // Copy each AOI a strip at a time, as the raw pixels, so only a couple
+    // of strips are ever in memory
+    SIDDWriteControl writer(outPathname, schemaPaths);
+    writer.initialize(container);
+    for (size_t imageNum = 0; imageNum < numImages; ++imageNum)
+    {
+        reader.interleaved(aoiOffset, aoiDims, imageNum, numRowsPerStrip,
+                [&](const std::byte* strip,
+                    const types::RowCol<size_t>& offset,
+                    const types::RowCol<size_t>& dims)
+        {
+            writer.save(strip, offset, dims, imageNum);
+        });
+    }
+    writer.close();
 }
 }
 }
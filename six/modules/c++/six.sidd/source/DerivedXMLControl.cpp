@@ -90,6 +90,16 @@ std::unique_ptr<xml::lite::Document> DerivedXMLControl::toXMLImpl(const Data& da
     auto parser = getParser(data.getVersion());
     return parser->toXML(dynamic_cast<const DerivedData&>(data));
 }
+void DerivedXMLControl::toXMLImpl(const Data& data, io::OutputStream& os) const
+{
+    if (data.getDataType() != DataType::DERIVED)
+    {
+        throw except::Exception(Ctxt("Data must be SIDD"));
+    }
+
+    auto parser = getParser(data.getVersion());
+    parser->toXML(dynamic_cast<const DerivedData&>(data), os);
+}
 
 std::unique_ptr<DerivedXMLParser>
 DerivedXMLControl::getParser(const std::string& strVersion) const
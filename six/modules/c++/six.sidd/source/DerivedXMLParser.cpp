@@ -1961,6 +1961,11 @@ std::unique_ptr<xml::lite::Document> DerivedXMLParser::toXML(const DerivedData&
 {
     return std::unique_ptr<xml::lite::Document>(toXML(&data));
 }
+void DerivedXMLParser::toXML(const DerivedData& data, io::OutputStream& os) const
+{
+    const auto doc = toXML(data);
+    doc->getRootElement()->print(os);
+}
 std::unique_ptr<DerivedData> DerivedXMLParser::fromXML(const xml::lite::Document& doc) const
 {
     return std::unique_ptr<DerivedData>(fromXML(&doc));
@@ -291,64 +291,85 @@ std::unique_ptr<DerivedData> DerivedXMLParser100::fromXML(const xml::lite::Docum
     return std::unique_ptr<DerivedData>(fromXML(&doc));
 }
 
-xml::lite::Document*
-DerivedXMLParser100::toXML(const DerivedData* derived) const
+xml::lite::Document* DerivedXMLParser100::toXML(const DerivedData* derived) const
 {
-    xml::lite::Document* doc = new xml::lite::Document();
-    XMLElem root = newElement("SIDD");
-    doc->setRootElement(root);
-
-    convertProductCreationToXML(derived->productCreation.get(), root);
-    convertDisplayToXML(*derived->display, root);
-    convertGeographicTargetToXML(*derived->geographicAndTarget, root);
-    convertMeasurementToXML(derived->measurement.get(), root);
-    convertExploitationFeaturesToXML(derived->exploitationFeatures.get(),
-                                     root);
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    return blocksToXML("SIDD", getXMLBlocks(*derived), setNamespaces).release();
+}
+std::unique_ptr<xml::lite::Document> DerivedXMLParser100::toXML(const DerivedData& data) const
+{
+    return std::unique_ptr<xml::lite::Document>(toXML(&data));
+}
+void DerivedXMLParser100::toXML(const DerivedData& data, io::OutputStream& os) const
+{
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    writeBlocks(os, "SIDD", getXMLBlocks(data), setNamespaces);
+}
 
-    // optional
-    if (derived->productProcessing.get())
+std::vector<six::XMLParser::XMLBlock>
+DerivedXMLParser100::getXMLBlocks(const DerivedData& derived) const
+{
+    std::vector<XMLBlock> blocks;
+    blocks.push_back([&](XMLElem root) {
+        convertProductCreationToXML(derived.productCreation.get(), root); });
+    // SIDD 1.0 has at most one LUT (in RemapInformation) and it's most of
+    // Display, so there's nothing to gain by making Display a piece at a time.
+    blocks.push_back([&](XMLElem root) {
+        convertDisplayToXML(*derived.display, root); });
+    blocks.push_back([&](XMLElem root) {
+        convertGeographicTargetToXML(*derived.geographicAndTarget, root); });
+    blocks.push_back([&](XMLElem root) {
+        convertMeasurementToXML(derived.measurement.get(), root); });
+    blocks.push_back([&](XMLElem root) {
+        convertExploitationFeaturesToXML(derived.exploitationFeatures.get(),
+                                         root); });
+
+    // optional
+    if (derived.productProcessing.get())
     {
-        convertProductProcessingToXML(derived->productProcessing.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            convertProductProcessingToXML(derived.productProcessing.get(), root); });
     }
     // optional
-    if (derived->downstreamReprocessing.get())
+    if (derived.downstreamReprocessing.get())
     {
-        convertDownstreamReprocessingToXML(
-                derived->downstreamReprocessing.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            convertDownstreamReprocessingToXML(
+                    derived.downstreamReprocessing.get(), root); });
     }
     // optional
-    if (derived->errorStatistics.get())
+    if (derived.errorStatistics.get())
     {
-        common().convertErrorStatisticsToXML(derived->errorStatistics.get(),
-                                             root);
+        blocks.push_back([&](XMLElem root) {
+            common().convertErrorStatisticsToXML(
+                    derived.errorStatistics.get(), root); });
     }
     // optional
-    if (derived->radiometric.get())
+    if (derived.radiometric.get())
     {
-        common().convertRadiometryToXML(derived->radiometric.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            common().convertRadiometryToXML(derived.radiometric.get(), root); });
     }
     // optional
-    if (!derived->annotations.empty())
+    if (!derived.annotations.empty())
     {
-        XMLElem annotationsElem = newElement("Annotations", root);
-        for (size_t i = 0; i < derived->annotations.size(); ++i)
-        {
-            convertAnnotationToXML(derived->annotations[i].get(),
-                                   annotationsElem);
-        }
+        blocks.push_back([&](XMLElem root) {
+            XMLElem annotationsElem = newElement("Annotations", root);
+            for (const auto& pAnnotation : derived.annotations)
+            {
+                convertAnnotationToXML(pAnnotation.get(), annotationsElem);
+            } });
     }
+    return blocks;
+}
 
+void DerivedXMLParser100::setNamespaces(XMLElem root) const
+{
     //set the ElemNS
     root->setNamespacePrefix("", getDefaultURI());
     root->setNamespacePrefix("si", xml::lite::Uri(SI_COMMON_URI));
     root->setNamespacePrefix("sfa", xml::lite::Uri(SFA_URI));
     root->setNamespacePrefix("ism", xml::lite::Uri(ISM_URI));
-
-    return doc;
-}
-std::unique_ptr<xml::lite::Document> DerivedXMLParser100::toXML(const DerivedData& data) const
-{
-    return std::unique_ptr<xml::lite::Document>(toXML(&data));
 }
 
 XMLElem DerivedXMLParser100::convertDisplayToXML(
@@ -237,77 +237,100 @@ std::unique_ptr<DerivedData> DerivedXMLParser200::fromXML(const xml::lite::Docum
 
 xml::lite::Document* DerivedXMLParser200::toXML(const DerivedData* derived) const
 {
-    xml::lite::Document* doc = new xml::lite::Document();
-    XMLElem root = newElement("SIDD");
-    doc->setRootElement(root);
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    return blocksToXML("SIDD", getXMLBlocks(*derived), setNamespaces).release();
+}
+std::unique_ptr<xml::lite::Document> DerivedXMLParser200::toXML(const DerivedData& data) const
+{
+    return std::unique_ptr<xml::lite::Document>(toXML(&data));
+}
+void DerivedXMLParser200::toXML(const DerivedData& data, io::OutputStream& os) const
+{
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    writeBlocks(os, "SIDD", getXMLBlocks(data), setNamespaces);
+}
 
-    convertProductCreationToXML(derived->productCreation.get(), root);
-    convertDisplayToXML(*derived->display, root);
-    convertGeoDataToXML(*this, *derived->geoData, *root);
-    convertMeasurementToXML(derived->measurement.get(), root);
-    convertExploitationFeaturesToXML(derived->exploitationFeatures.get(),
-                                     root);
+std::vector<six::XMLParser::XMLBlock>
+DerivedXMLParser200::getXMLBlocks(const DerivedData& derived) const
+{
+    std::vector<XMLBlock> blocks;
+    blocks.push_back([&](XMLElem root) {
+        convertProductCreationToXML(derived.productCreation.get(), root); });
+    blocks.push_back(getDisplayBlock(*this, *derived.display));
+    blocks.push_back([&](XMLElem root) {
+        convertGeoDataToXML(*this, *derived.geoData, *root); });
+    blocks.push_back([&](XMLElem root) {
+        convertMeasurementToXML(derived.measurement.get(), root); });
+    blocks.push_back([&](XMLElem root) {
+        convertExploitationFeaturesToXML(derived.exploitationFeatures.get(),
+                                         root); });
 
     // optional
-    if (derived->downstreamReprocessing.get())
+    if (derived.downstreamReprocessing.get())
     {
-        convertDownstreamReprocessingToXML(
-                derived->downstreamReprocessing.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            convertDownstreamReprocessingToXML(
+                    derived.downstreamReprocessing.get(), root); });
     }
     // optional
-    if (derived->errorStatistics.get())
+    if (derived.errorStatistics.get())
     {
-        common().convertErrorStatisticsToXML(derived->errorStatistics.get(),
-                                             root);
+        blocks.push_back([&](XMLElem root) {
+            common().convertErrorStatisticsToXML(
+                    derived.errorStatistics.get(), root); });
     }
     // optional
-    if (derived->matchInformation.get())
+    if (derived.matchInformation.get())
     {
-        common().convertMatchInformationToXML(*derived->matchInformation,
-                                              root);
+        blocks.push_back([&](XMLElem root) {
+            common().convertMatchInformationToXML(
+                    *derived.matchInformation, root); });
     }
     // optional
-    if (derived->radiometric.get())
+    if (derived.radiometric.get())
     {
-        common().convertRadiometryToXML(derived->radiometric.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            common().convertRadiometryToXML(derived.radiometric.get(), root); });
     }
     // optional
-    if (derived->compression.get())
+    if (derived.compression.get())
     {
-       convertCompressionToXML(*derived->compression, root);
+        blocks.push_back([&](XMLElem root) {
+            convertCompressionToXML(*derived.compression, root); });
     }
     // optional
-    if (derived->digitalElevationData.get())
+    if (derived.digitalElevationData.get())
     {
-        convertDigitalElevationDataToXML(*this, *derived->digitalElevationData,
-                                         *root);
+        blocks.push_back([&](XMLElem root) {
+            convertDigitalElevationDataToXML(*this,
+                    *derived.digitalElevationData, *root); });
     }
     // optional
-    if (derived->productProcessing.get())
+    if (derived.productProcessing.get())
     {
-        convertProductProcessingToXML(derived->productProcessing.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            convertProductProcessingToXML(derived.productProcessing.get(), root); });
     }
     // optional
-    if (!derived->annotations.empty())
+    if (!derived.annotations.empty())
     {
-        XMLElem annotationsElem = newElement("Annotations", root);
-        for (const auto& pAnnotation : derived->annotations)
-        {
-            convertAnnotationToXML(pAnnotation.get(), annotationsElem);
-        }
+        blocks.push_back([&](XMLElem root) {
+            XMLElem annotationsElem = newElement("Annotations", root);
+            for (const auto& pAnnotation : derived.annotations)
+            {
+                convertAnnotationToXML(pAnnotation.get(), annotationsElem);
+            } });
     }
+    return blocks;
+}
 
+void DerivedXMLParser200::setNamespaces(XMLElem root) const
+{
     //set the ElemNS
     root->setNamespacePrefix("", getDefaultURI());
     root->setNamespacePrefix("si", xml::lite::Uri(SI_COMMON_URI));
     root->setNamespacePrefix("sfa", xml::lite::Uri(SFA_URI));
     root->setNamespacePrefix("ism", xml::lite::Uri(ISM_URI));
-
-    return doc;
-}
-std::unique_ptr<xml::lite::Document> DerivedXMLParser200::toXML(const DerivedData& data) const
-{
-    return std::unique_ptr<xml::lite::Document>(toXML(&data));
 }
 
 void DerivedXMLParser200::parseDerivedClassificationFromXML(
@@ -1802,9 +1825,25 @@ XMLElem DerivedXMLParser200::convertDisplayToXML(
 xml::lite::Element& DerivedXMLParser200::convertDisplayToXML(const DerivedXMLParser& parser,
     const Display& display, xml::lite::Element& parent)
 {
-    // NOTE: In several spots here, there are fields which are required in
-    //       SIDD 2.0 but a pointer in the Display class since it didn't exist
-    //       in SIDD 1.0, so need to confirm it's allocated
+    auto& displayElem = createDisplay(parser, display, parent);
+    for (const auto& add : getDisplayChildren(parser, display))
+    {
+        add(&displayElem);
+    }
+    return displayElem;
+}
+
+six::XMLParser::XMLBlock DerivedXMLParser200::getDisplayBlock(
+    const DerivedXMLParser& parser, const Display& display)
+{
+    return splitBlock([&parser, &display](XMLElem root) {
+        createDisplay(parser, display, *root); },
+        getDisplayChildren(parser, display));
+}
+
+xml::lite::Element& DerivedXMLParser200::createDisplay(const DerivedXMLParser& parser,
+    const Display& display, xml::lite::Element& parent)
+{
     auto& displayElem = parser.newElement("Display", parent);
 
     parser.createString("PixelType", display.pixelType, displayElem);
@@ -1814,33 +1853,46 @@ xml::lite::Element& DerivedXMLParser200::convertDisplayToXML(const DerivedXMLPar
     {
         parser.createInt("DefaultBandDisplay", display.defaultBandDisplay, displayElem);
     }
+    return displayElem;
+}
+
+std::vector<six::XMLParser::XMLBlock> DerivedXMLParser200::getDisplayChildren(
+    const DerivedXMLParser& parser, const Display& display)
+{
+    // NOTE: In several spots here, there are fields which are required in
+    //       SIDD 2.0 but a pointer in the Display class since it didn't exist
+    //       in SIDD 1.0, so need to confirm it's allocated
+    std::vector<XMLBlock> children;
 
     // NonInteractiveProcessing
     for (size_t ii = 0; ii < display.nonInteractiveProcessing.size(); ++ii)
     {
-        confirmNonNull(display.nonInteractiveProcessing[ii],
-                "nonInteractiveProcessing");
-        auto& temp = convertNonInteractiveProcessingToXML(parser,
-                *display.nonInteractiveProcessing[ii],
-                displayElem);
-        setAttribute(temp, "band", ii + 1);
+        children.push_back([&parser, &display, ii](XMLElem displayElem) {
+            confirmNonNull(display.nonInteractiveProcessing[ii],
+                    "nonInteractiveProcessing");
+            auto& temp = convertNonInteractiveProcessingToXML(parser,
+                    *display.nonInteractiveProcessing[ii],
+                    *displayElem);
+            setAttribute(temp, "band", ii + 1); });
     }
 
     for (size_t ii = 0; ii < display.interactiveProcessing.size(); ++ii)
     {
         // InteractiveProcessing
-        confirmNonNull(display.interactiveProcessing[ii],
-                "interactiveProcessing");
-        auto& temp = convertInteractiveProcessingToXML(parser,
-                *display.interactiveProcessing[ii],
-                displayElem);
-        setAttribute(temp, "band", ii + 1);
+        children.push_back([&parser, &display, ii](XMLElem displayElem) {
+            confirmNonNull(display.interactiveProcessing[ii],
+                    "interactiveProcessing");
+            auto& temp = convertInteractiveProcessingToXML(parser,
+                    *display.interactiveProcessing[ii],
+                    *displayElem);
+            setAttribute(temp, "band", ii + 1); });
     }
 
     // optional to unbounded
-    parser.common().addParameters("DisplayExtension", display.displayExtensions,
-                           &displayElem);
-    return displayElem;
+    children.push_back([&parser, &display](XMLElem displayElem) {
+        parser.common().addParameters("DisplayExtension",
+                display.displayExtensions, displayElem); });
+    return children;
 }
 
 xml::lite::Element& DerivedXMLParser200::convertGeoDataToXML(const DerivedXMLParser& parser,
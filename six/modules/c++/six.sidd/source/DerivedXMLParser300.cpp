@@ -155,73 +155,101 @@ std::unique_ptr<DerivedData> DerivedXMLParser300::fromXML(const xml::lite::Docum
 
 xml::lite::Document* DerivedXMLParser300::toXML(const DerivedData* derived) const
 {
-    xml::lite::Document* doc = new xml::lite::Document();
-    XMLElem root = newElement("SIDD");
-    doc->setRootElement(root);
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    return blocksToXML("SIDD", getXMLBlocks(*derived), setNamespaces).release();
+}
+std::unique_ptr<xml::lite::Document> DerivedXMLParser300::toXML(const DerivedData& data) const
+{
+    return std::unique_ptr<xml::lite::Document>(toXML(&data));
+}
+void DerivedXMLParser300::toXML(const DerivedData& data, io::OutputStream& os) const
+{
+    const XMLBlock setNamespaces = [&](XMLElem root) { this->setNamespaces(root); };
+    writeBlocks(os, "SIDD", getXMLBlocks(data), setNamespaces);
+}
 
-    convertProductCreationToXML(derived->productCreation.get(), root);
-    convertDisplayToXML(*derived->display, root);
-    DerivedXMLParser200::convertGeoDataToXML(*this, *derived->geoData, *root);
-    convertMeasurementToXML(derived->measurement.get(), root);
-    convertExploitationFeaturesToXML(derived->exploitationFeatures.get(), root);
+std::vector<six::XMLParser::XMLBlock>
+DerivedXMLParser300::getXMLBlocks(const DerivedData& derived) const
+{
+    std::vector<XMLBlock> blocks;
+    blocks.push_back([&](XMLElem root) {
+        convertProductCreationToXML(derived.productCreation.get(), root); });
+    blocks.push_back(DerivedXMLParser200::getDisplayBlock(*this, *derived.display));
+    blocks.push_back([&](XMLElem root) {
+        DerivedXMLParser200::convertGeoDataToXML(*this, *derived.geoData, *root); });
+    blocks.push_back([&](XMLElem root) {
+        convertMeasurementToXML(derived.measurement.get(), root); });
+    blocks.push_back([&](XMLElem root) {
+        convertExploitationFeaturesToXML(derived.exploitationFeatures.get(),
+                                         root); });
 
     // optional
-    if (derived->downstreamReprocessing.get())
+    if (derived.downstreamReprocessing.get())
     {
-        convertDownstreamReprocessingToXML(
-                derived->downstreamReprocessing.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            convertDownstreamReprocessingToXML(
+                    derived.downstreamReprocessing.get(), root); });
     }
     // optional
-    if (derived->errorStatistics.get())
+    if (derived.errorStatistics.get())
     {
-        common().convertErrorStatisticsToXML(derived->errorStatistics.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            common().convertErrorStatisticsToXML(
+                    derived.errorStatistics.get(), root); });
     }
     // optional
-    if (derived->matchInformation.get())
+    if (derived.matchInformation.get())
     {
-        common().convertMatchInformationToXML(*derived->matchInformation, root);
+        blocks.push_back([&](XMLElem root) {
+            common().convertMatchInformationToXML(
+                    *derived.matchInformation, root); });
     }
     // optional
-    if (derived->radiometric.get())
+    if (derived.radiometric.get())
     {
-        common().convertRadiometryToXML(derived->radiometric.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            common().convertRadiometryToXML(derived.radiometric.get(), root); });
     }
     // optional
-    if (derived->compression.get())
+    if (derived.compression.get())
     {
-        DerivedXMLParser200::convertCompressionToXML(*this, *derived->compression, *root);
+        blocks.push_back([&](XMLElem root) {
+            DerivedXMLParser200::convertCompressionToXML(*this,
+                    *derived.compression, *root); });
     }
     // optional
-    if (derived->digitalElevationData.get())
+    if (derived.digitalElevationData.get())
     {
-        DerivedXMLParser200::convertDigitalElevationDataToXML(*this, *derived->digitalElevationData, *root);
+        blocks.push_back([&](XMLElem root) {
+            DerivedXMLParser200::convertDigitalElevationDataToXML(*this,
+                    *derived.digitalElevationData, *root); });
     }
     // optional
-    if (derived->productProcessing.get())
+    if (derived.productProcessing.get())
     {
-        convertProductProcessingToXML(derived->productProcessing.get(), root);
+        blocks.push_back([&](XMLElem root) {
+            convertProductProcessingToXML(derived.productProcessing.get(), root); });
     }
     // optional
-    if (!derived->annotations.empty())
+    if (!derived.annotations.empty())
     {
-        XMLElem annotationsElem = newElement("Annotations", root);
-        for (const auto& pAnnotation : derived->annotations)
-        {
-            convertAnnotationToXML(pAnnotation.get(), annotationsElem);
-        }
+        blocks.push_back([&](XMLElem root) {
+            XMLElem annotationsElem = newElement("Annotations", root);
+            for (const auto& pAnnotation : derived.annotations)
+            {
+                convertAnnotationToXML(pAnnotation.get(), annotationsElem);
+            } });
     }
+    return blocks;
+}
 
+void DerivedXMLParser300::setNamespaces(XMLElem root) const
+{
     //set the ElemNS
     root->setNamespacePrefix("", getDefaultURI());
     root->setNamespacePrefix("si", xml::lite::Uri(SI_COMMON_URI));
     root->setNamespacePrefix("sfa", xml::lite::Uri(SFA_URI));
     root->setNamespacePrefix("ism", xml::lite::Uri(ISM_URI));
-
-    return doc;
-}
-std::unique_ptr<xml::lite::Document> DerivedXMLParser300::toXML(const DerivedData& data) const
-{
-    return std::unique_ptr<xml::lite::Document>(toXML(&data));
 }
 
 void DerivedXMLParser300::parseDerivedClassificationFromXML(
@@ -0,0 +1,212 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include <except/Exception.h>
+#include <nitf/J2KCompressor.hpp>
+#include <six/sidd/J2KTileCompressor.h>
+
+namespace
+{
+six::Executor& getExecutor(six::Executor* pExecutor,
+                           std::shared_ptr<six::Executor>& pDefaultExecutor)
+{
+    if (pExecutor == nullptr)
+    {
+        pDefaultExecutor = six::Executor::get();
+        pExecutor = pDefaultExecutor.get();
+    }
+    return *pExecutor;
+}
+
+j2k::CompressionParameters makeParams(const types::RowCol<size_t>& imageDims,
+                                      const types::RowCol<size_t>& tileDims,
+                                      double compressionRatio)
+{
+    if (imageDims.area() == 0 || tileDims.area() == 0)
+    {
+        throw except::Exception(Ctxt(
+                "Image and tile dimensions must be non-zero"));
+    }
+    return j2k::CompressionParameters(imageDims, tileDims, compressionRatio);
+}
+}
+
+namespace six
+{
+namespace sidd
+{
+J2KTileCompressor::J2KTileCompressor(const types::RowCol<size_t>& imageDims,
+                                     const types::RowCol<size_t>& tileDims,
+                                     double compressionRatio,
+                                     size_t numTilesInFlight) :
+    mParams(makeParams(imageDims, tileDims, compressionRatio)),
+    mNumTilesInFlight(numTilesInFlight)
+{
+}
+
+void J2KTileCompressor::compress(std::span<const std::byte> image,
+                                 const TileSink& sink,
+                                 Executor* pExecutor) const
+{
+    const types::RowCol<size_t> imageDims = mParams.getRawImageDims();
+    if (image.size() != imageDims.area())
+    {
+        std::ostringstream ostr;
+        ostr << "Expected " << imageDims.area() << " pixels but got "
+             << image.size();
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    std::shared_ptr<Executor> pDefaultExecutor;
+    Executor& executor = getExecutor(pExecutor, pDefaultExecutor);
+
+    const size_t numTiles = mParams.getNumTiles();
+    const size_t numWorkers = std::min(executor.getNumThreads(), numTiles);
+    const size_t numTilesInFlight = std::max(
+            mNumTilesInFlight == 0 ? 2 * numWorkers : mNumTilesInFlight,
+            static_cast<size_t>(1));
+
+    const types::RowCol<size_t> tileDims = mParams.getTileDims();
+    const size_t numColsOfTiles = mParams.getNumColsOfTiles();
+    const j2k::Compressor compressor(mParams);
+    const size_t maxBytesPerTile = compressor.getMaxBytesRequiredToCompress(1);
+
+    // Tile ii is compressed into slot ii % numTilesInFlight.  A tile isn't
+    // started until the one that last used its slot has been handed off.
+    struct Slot
+    {
+        std::vector<std::byte> buffer;
+        std::span<std::byte> compressed;
+        bool isReady = false;
+    };
+    std::vector<Slot> slots(numTilesInFlight);
+
+    std::mutex mutex;
+    std::condition_variable canStart;
+    size_t nextTile = 0;
+    size_t nextToSink = 0;
+    std::exception_ptr exception;
+
+    // Hands off every finished tile that's next in line.  Must hold the lock.
+    const auto sinkReadyTiles = [&]()
+    {
+        while (!exception && nextToSink < numTiles)
+        {
+            Slot& slot = slots[nextToSink % numTilesInFlight];
+            if (!slot.isReady)
+            {
+                break;
+            }
+            sink(nextToSink,
+                 std::span<const std::byte>(slot.compressed.data(),
+                                            slot.compressed.size()));
+            slot.isReady = false;
+            ++nextToSink;
+        }
+    };
+
+    executor.parallelFor(numWorkers, [&](size_t begin, size_t end)
+    {
+        for (size_t worker = begin; worker < end; ++worker)
+        {
+            while (true)
+            {
+                size_t tile;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    canStart.wait(lock, [&]()
+                    {
+                        return exception || nextTile >= numTiles ||
+                                nextTile < nextToSink + numTilesInFlight;
+                    });
+                    if (exception || nextTile >= numTiles)
+                    {
+                        break;
+                    }
+                    tile = nextTile++;
+                }
+
+                try
+                {
+                    Slot& slot = slots[tile % numTilesInFlight];
+                    slot.buffer.resize(maxBytesPerTile);
+
+                    // The compressor only needs the image from the tile's
+                    // upper left corner on
+                    const size_t offset =
+                            (tile / numColsOfTiles) * tileDims.row *
+                                    imageDims.col +
+                            (tile % numColsOfTiles) * tileDims.col;
+                    slot.compressed = compressor.compressTile(
+                            std::span<const std::byte>(image.data() + offset,
+                                                       image.size() - offset),
+                            tile,
+                            std::span<std::byte>(slot.buffer.data(),
+                                                 slot.buffer.size()));
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slot.isReady = true;
+                    sinkReadyTiles();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!exception)
+                    {
+                        exception = std::current_exception();
+                    }
+                }
+                canStart.notify_all();
+            }
+        }
+    }, 1);
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+void J2KTileCompressor::compress(std::span<const std::byte> image,
+                                 std::vector<std::byte>& codestream,
+                                 std::vector<size_t>& bytesPerTile,
+                                 Executor* pExecutor) const
+{
+    codestream.clear();
+    bytesPerTile.assign(getNumTiles(), 0);
+    compress(image, [&](size_t tileIndex,
+                        std::span<const std::byte> compressedTile)
+    {
+        codestream.insert(codestream.end(), compressedTile.begin(),
+                          compressedTile.end());
+        bytesPerTile[tileIndex] = compressedTile.size();
+    }, pExecutor);
+}
+}
+}
@@ -0,0 +1,584 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2018, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <six/sidd/SIDDWriteControl.h>
+
+#include <string.h>
+
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <std/cstddef>
+
+#include <except/Exception.h>
+#include <io/ByteStream.h>
+#include <nitf/IOStreamWriter.hpp>
+#include <nitf/ImageBlocker.hpp>
+#include <nitf/Writer.hpp>
+#include <str/EncodedStringView.h>
+#include <six/Executor.h>
+#include <six/Utilities.h>
+
+#undef min
+#undef max
+
+namespace
+{
+void copyFromStreamAndClear(io::ByteStream& stream,
+                            std::vector<std::byte>& rawBytes)
+{
+    rawBytes.resize(stream.getSize());
+    if (!rawBytes.empty())
+    {
+        ::memcpy(rawBytes.data(), stream.get(), stream.getSize());
+    }
+    stream.clear();
+}
+}
+
+namespace six
+{
+namespace sidd
+{
+/*
+ *  Where one image segment's data lives in the file and how it's blocked.
+ *  Unblocked data (a single column of blocks) is plain row-major, so rows
+ *  can be written wherever they land; blocked data is written a row of
+ *  blocks at a time.
+ */
+struct SIDDWriteControl::ImageSegment final
+{
+    size_t firstRow = 0;  // Within the product
+    size_t numRows = 0;
+    size_t numCols = 0;
+    size_t numBytesPerPixel = 0;
+    unsigned short elemSize = 0;  // Of one band, for byte swapping
+    size_t numRowsPerBlock = 0;
+    size_t numColsPerBlock = 0;
+    size_t numBlocksPerRow = 0;
+    nitf::Off dataOffset = 0;
+
+    ImageSegment(nitf::ImageSubheader subheader,
+                 size_t numBytesPerPixel_,
+                 nitf::Off dataOffset_) :
+        numRows(subheader.numRows()),
+        numCols(subheader.numCols()),
+        numBytesPerPixel(numBytesPerPixel_),
+        elemSize(static_cast<unsigned short>(
+                numBytesPerPixel_ / subheader.numImageBands())),
+        numRowsPerBlock(subheader.numPixelsPerVertBlock()),
+        numColsPerBlock(subheader.numPixelsPerHorizBlock()),
+        numBlocksPerRow(subheader.numBlocksPerRow()),
+        dataOffset(dataOffset_)
+    {
+        // 0 means the block is as big as the image
+        if (numRowsPerBlock == 0)
+        {
+            numRowsPerBlock = numRows;
+        }
+        if (numColsPerBlock == 0)
+        {
+            numColsPerBlock = numCols;
+        }
+    }
+
+    bool isBlocked() const
+    {
+        return numColsPerBlock != numCols;
+    }
+
+    size_t getNumBytesPerBlock() const
+    {
+        return numRowsPerBlock * numColsPerBlock * numBytesPerPixel;
+    }
+
+    size_t getNumBlockRows() const
+    {
+        return (numRows + numRowsPerBlock - 1) / numRowsPerBlock;
+    }
+
+    size_t getNumValidRows(size_t blockRow) const
+    {
+        return std::min(numRowsPerBlock, numRows - blockRow * numRowsPerBlock);
+    }
+};
+
+struct SIDDWriteControl::Product final
+{
+    // Pixels of a row of blocks that hasn't been completely saved yet
+    struct PendingBlockRow final
+    {
+        std::vector<std::byte> pixels;
+        size_t numPixelsLeft = 0;
+    };
+
+    types::RowCol<size_t> dims;
+    size_t numBytesPerPixel = 0;
+    std::vector<ImageSegment> segments;
+
+    // Keyed by segment and row of blocks within it
+    std::map<std::pair<size_t, size_t>, PendingBlockRow> pending;
+};
+
+SIDDWriteControl::SIDDWriteControl(const std::string& outputPathname,
+                                   const std::vector<std::string>& schemaPaths) :
+    mImageWriter(new PositionalFileWriter(outputPathname)),
+    mSchemaPaths(schemaPaths),
+    mHaveWrittenHeaders(false)
+{
+}
+
+SIDDWriteControl::~SIDDWriteControl()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+}
+
+void SIDDWriteControl::initialize(const DerivedData& data)
+{
+    // The container wants to take ownership of the data
+    // To avoid memory problems, we'll just clone it. After calling
+    // initialize, the base class will refer to this Container.
+    std::unique_ptr<Data> dataClone(data.clone());
+    auto container = std::make_shared<Container>(std::move(dataClone));
+    initialize(container);
+}
+
+void SIDDWriteControl::writeHeaders()
+{
+    if (!getSegmentWriters().empty())
+    {
+        throw except::NotImplementedException(Ctxt(
+                "Additional DESs are not supported"));
+    }
+
+    // Make a copy; writing the headers isn't const
+    nitf::Record record = getRecord().clone();
+    if (record.getNumGraphics() > 0 ||
+        record.getNumLabels() > 0 ||
+        record.getNumTexts() > 0 ||
+        record.getNumReservedExtensions() > 0)
+    {
+        throw except::NotImplementedException(Ctxt(
+                "Graphics, labels, text, and reserved extensions not "
+                "supported"));
+    }
+
+    auto byteStream = std::make_shared<io::ByteStream>();
+    nitf::IOStreamWriter io(byteStream);
+    nitf::Writer writer;
+    writer.prepareIO(io, record);
+
+    // Image subheaders.  Each segment's data directly follows its
+    // subheader, so these lay out the whole file but for the DESs.
+    const size_t numImages = record.getNumImages();
+    std::vector<std::vector<std::byte> > imageSubheaders(numImages);
+    std::vector<nitf::Off> imageDataLengths(numImages);
+    for (size_t ii = 0; ii < numImages; ++ii)
+    {
+        nitf::ImageSegment imageSegment = record.getImages()[ii];
+        nitf::ImageSubheader subheader = imageSegment.getSubheader();
+        const std::string compression =
+                subheader.getImageCompression().toString();
+        if (compression != "NC" && compression != "NM")
+        {
+            throw except::NotImplementedException(Ctxt(
+                    "Compressed image segments not supported"));
+        }
+
+        nitf::Off comratOff(0);
+        writer.writeImageSubheader(subheader, record.getVersion(), comratOff);
+        copyFromStreamAndClear(*byteStream, imageSubheaders[ii]);
+        imageDataLengths[ii] =
+                static_cast<nitf::Off>(subheader.getNumBytesOfImageData());
+    }
+
+    // DESs
+    const auto container = getContainer();
+    const size_t numDESs = record.getNumDataExtensions();
+    if (numDESs != container->size())
+    {
+        std::ostringstream ostr;
+        ostr << "Record has " << numDESs << " DESs but the container has "
+             << container->size() << " data";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    std::vector<size_t> desSubheaderLengths(numDESs);
+    std::vector<size_t> desDataLengths(numDESs);
+    for (size_t ii = 0; ii < numDESs; ++ii)
+    {
+        nitf::DESegment deSegment = record.getDataExtensions()[ii];
+        nitf::DESubheader subheader = deSegment.getSubheader();
+        const size_t prevSize = byteStream->getSize();
+        uint32_t userSublen;
+        writer.writeDESubheader(subheader, userSublen, record.getVersion());
+        desSubheaderLengths[ii] = byteStream->getSize() - prevSize;
+
+        const auto xml = six::toValidXMLString(container->getData(ii),
+                                               mSchemaPaths, mLog,
+                                               mXMLRegistry);
+        const std::string desData = str::EncodedStringView(xml).native();
+        byteStream->write(desData);
+        desDataLengths[ii] = desData.size();
+    }
+    std::vector<std::byte> desSubheadersAndData;
+    copyFromStreamAndClear(*byteStream, desSubheadersAndData);
+
+    // File header.  The first write leaves the lengths blank, so go back
+    // and fill them in.
+    nitf_Off fileLenOff;
+    uint32_t hdrLen;
+    record.setComplexityLevelIfUnset();
+    writer.writeHeader(fileLenOff, hdrLen);
+    const auto fileHeaderNumBytes =
+            static_cast<nitf::Off>(byteStream->getSize());
+
+    std::vector<nitf::Off> imageDataStart(numImages);
+    nitf::Off offset = fileHeaderNumBytes;
+    for (size_t ii = 0; ii < numImages; ++ii)
+    {
+        offset += static_cast<nitf::Off>(imageSubheaders[ii].size());
+        imageDataStart[ii] = offset;
+        offset += imageDataLengths[ii];
+    }
+    const nitf::Off desOffset = offset;
+    const nitf::Off fileNumBytes = desOffset +
+            static_cast<nitf::Off>(desSubheadersAndData.size());
+
+    byteStream->seek(fileLenOff, io::Seekable::START);
+    writer.writeInt64Field(static_cast<uint64_t>(fileNumBytes), NITF_FL_SZ,
+                           '0', NITF_WRITER_FILL_LEFT);
+    writer.writeInt64Field(hdrLen, NITF_HL_SZ, '0', NITF_WRITER_FILL_LEFT);
+    byteStream->seek(NITF_NUMI_SZ, io::Seekable::CURRENT);
+    for (size_t ii = 0; ii < numImages; ++ii)
+    {
+        writer.writeInt64Field(imageSubheaders[ii].size(), NITF_LISH_SZ, '0',
+                               NITF_WRITER_FILL_LEFT);
+        writer.writeInt64Field(static_cast<uint64_t>(imageDataLengths[ii]),
+                               NITF_LI_SZ, '0', NITF_WRITER_FILL_LEFT);
+    }
+    byteStream->seek(NITF_NUMS_SZ + NITF_NUMX_SZ + NITF_NUMT_SZ +
+                             NITF_NUMDES_SZ,
+                     io::Seekable::CURRENT);
+    for (size_t ii = 0; ii < numDESs; ++ii)
+    {
+        writer.writeInt64Field(desSubheaderLengths[ii], NITF_LDSH_SZ, '0',
+                               NITF_WRITER_FILL_LEFT);
+        writer.writeInt64Field(desDataLengths[ii], NITF_LD_SZ, '0',
+                               NITF_WRITER_FILL_LEFT);
+    }
+    std::vector<std::byte> fileHeader;
+    copyFromStreamAndClear(*byteStream, fileHeader);
+
+    // The DESs go last, so writing them makes the file its full length
+    // up front; image data that's never saved reads back as 0
+    mImageWriter->writeAt(0, fileHeader.data(), fileHeader.size());
+    for (size_t ii = 0; ii < numImages; ++ii)
+    {
+        mImageWriter->writeAt(
+                imageDataStart[ii] -
+                        static_cast<nitf::Off>(imageSubheaders[ii].size()),
+                imageSubheaders[ii].data(),
+                imageSubheaders[ii].size());
+    }
+    mImageWriter->writeAt(desOffset, desSubheadersAndData.data(),
+                          desSubheadersAndData.size());
+
+    // Now where each product's pixels go
+    const auto infos = getInfos();
+    mProducts.clear();
+    for (size_t ii = 0; ii < infos.size(); ++ii)
+    {
+        const NITFImageInfo& info = *infos[ii];
+        const Data& data = *info.getData();
+
+        std::unique_ptr<Product> product(new Product());
+        product->dims = getExtent(data);
+        product->numBytesPerPixel = data.getNumBytesPerPixel();
+
+        const std::vector<NITFSegmentInfo> segmentInfos =
+                info.getImageSegments();
+        for (size_t jj = 0; jj < segmentInfos.size(); ++jj)
+        {
+            const size_t imageIndex = info.getStartIndex() + jj;
+            nitf::ImageSegment imageSegment = record.getImages()[imageIndex];
+            nitf::ImageSubheader subheader = imageSegment.getSubheader();
+            const size_t numBands = subheader.numImageBands();
+            if (numBands > 1 &&
+                subheader.imageBlockingMode() != nitf::BlockingMode::Pixel)
+            {
+                throw except::NotImplementedException(Ctxt(
+                        "Only pixel interleaved multi-band images are "
+                        "supported"));
+            }
+
+            ImageSegment segment(subheader, product->numBytesPerPixel,
+                                 imageDataStart[imageIndex]);
+            segment.firstRow = segmentInfos[jj].getFirstRow();
+            product->segments.push_back(segment);
+        }
+        mProducts.push_back(std::move(product));
+
+        // Legends are already in memory, so get them out of the way.  A
+        // legend is the image segment right after its product's.
+        const Legend* const legend = container->getLegend(ii);
+        if (legend)
+        {
+            const size_t imageIndex =
+                    info.getStartIndex() + segmentInfos.size();
+            nitf::ImageSegment imageSegment = record.getImages()[imageIndex];
+            const ImageSegment segment(imageSegment.getSubheader(), 1,
+                                       imageDataStart[imageIndex]);
+            const std::byte* const image =
+                    reinterpret_cast<const std::byte*>(legend->mImage.data());
+            writeRows(segment, image, 0, segment.numRows, 0, segment.numCols);
+        }
+    }
+}
+
+void SIDDWriteControl::save(const void* imageData,
+                            const types::RowCol<size_t>& offset,
+                            const types::RowCol<size_t>& dims,
+                            size_t imageNumber)
+{
+    if (getContainer().get() == nullptr)
+    {
+        throw except::Exception(Ctxt(
+                "initialize() must be called prior to calling save()"));
+    }
+
+    // The first time through we'll write out all the headers
+    {
+        std::lock_guard<std::mutex> lock(mHeaderMutex);
+        if (!mHaveWrittenHeaders)
+        {
+            writeHeaders();
+            mHaveWrittenHeaders = true;
+        }
+    }
+
+    if (imageNumber >= mProducts.size())
+    {
+        throw except::Exception(Ctxt(
+                "Invalid image number " + std::to_string(imageNumber)));
+    }
+    Product& product = *mProducts[imageNumber];
+    if (offset.row + dims.row > product.dims.row ||
+        offset.col + dims.col > product.dims.col)
+    {
+        std::ostringstream ostr;
+        ostr << "Tile at (" << offset.row << ", " << offset.col
+             << ") of size (" << dims.row << ", " << dims.col
+             << ") doesn't fit in image " << imageNumber << " of size ("
+             << product.dims.row << ", " << product.dims.col << ")";
+        throw except::Exception(Ctxt(ostr.str()));
+    }
+
+    const size_t numBytesPerPixel = product.numBytesPerPixel;
+    const size_t numBytesPerTileRow = dims.col * numBytesPerPixel;
+    const std::byte* const tile = static_cast<const std::byte*>(imageData);
+    for (size_t seg = 0; seg < product.segments.size(); ++seg)
+    {
+        const ImageSegment& segment = product.segments[seg];
+        const size_t startRow = std::max(offset.row, segment.firstRow);
+        const size_t endRow = std::min(offset.row + dims.row,
+                                       segment.firstRow + segment.numRows);
+        if (startRow >= endRow)
+        {
+            continue;
+        }
+
+        if (!segment.isBlocked())
+        {
+            writeRows(segment,
+                      tile + (startRow - offset.row) * numBytesPerTileRow,
+                      startRow - segment.firstRow,
+                      endRow - startRow,
+                      offset.col,
+                      dims.col);
+            continue;
+        }
+
+        // Each row of blocks the tile touches is either entirely in the
+        // tile or has to wait for the rest of its pixels
+        const size_t firstBlockRow =
+                (startRow - segment.firstRow) / segment.numRowsPerBlock;
+        const size_t lastBlockRow =
+                (endRow - 1 - segment.firstRow) / segment.numRowsPerBlock;
+        for (size_t blockRow = firstBlockRow; blockRow <= lastBlockRow;
+             ++blockRow)
+        {
+            const size_t blockStartRow =
+                    segment.firstRow + blockRow * segment.numRowsPerBlock;
+            const size_t numValidRows = segment.getNumValidRows(blockRow);
+            const size_t overlapStartRow = std::max(startRow, blockStartRow);
+            const size_t overlapEndRow =
+                    std::min(endRow, blockStartRow + numValidRows);
+            const std::byte* const overlap =
+                    tile + (overlapStartRow - offset.row) * numBytesPerTileRow;
+
+            if (dims.col == segment.numCols &&
+                overlapEndRow - overlapStartRow == numValidRows)
+            {
+                writeBlockRow(segment, blockRow, overlap);
+                continue;
+            }
+
+            std::vector<std::byte> completed;
+            {
+                std::lock_guard<std::mutex> lock(mPendingMutex);
+                auto& pending =
+                        product.pending[std::make_pair(seg, blockRow)];
+                const size_t numBytesPerRow =
+                        segment.numCols * numBytesPerPixel;
+                if (pending.pixels.empty())
+                {
+                    pending.pixels.resize(numValidRows * numBytesPerRow);
+                    pending.numPixelsLeft = numValidRows * segment.numCols;
+                }
+
+                for (size_t row = overlapStartRow; row < overlapEndRow; ++row)
+                {
+                    ::memcpy(pending.pixels.data() +
+                                     (row - blockStartRow) * numBytesPerRow +
+                                     offset.col * numBytesPerPixel,
+                             overlap + (row - overlapStartRow) *
+                                     numBytesPerTileRow,
+                             numBytesPerTileRow);
+                }
+                pending.numPixelsLeft -=
+                        (overlapEndRow - overlapStartRow) * dims.col;
+                if (pending.numPixelsLeft == 0)
+                {
+                    completed.swap(pending.pixels);
+                    product.pending.erase(std::make_pair(seg, blockRow));
+                }
+            }
+
+            if (!completed.empty())
+            {
+                writeBlockRow(segment, blockRow, completed.data());
+            }
+        }
+    }
+}
+
+void SIDDWriteControl::writeRows(const ImageSegment& segment,
+                                 const std::byte* imageData,
+                                 size_t startRow,
+                                 size_t numRows,
+                                 size_t startCol,
+                                 size_t numCols)
+{
+    const size_t numBytesPerRow = numCols * segment.numBytesPerPixel;
+    const size_t fileRowStride = segment.numCols * segment.numBytesPerPixel;
+    const nitf::Off fileOffset = segment.dataOffset + static_cast<nitf::Off>(
+            startRow * fileRowStride + startCol * segment.numBytesPerPixel);
+
+    mImageWriter->writeRows(fileOffset,
+                            imageData,
+                            numRows,
+                            numBytesPerRow,
+                            fileRowStride,
+                            shouldByteSwap() ? segment.elemSize : 0,
+                            Executor::get(getOptions()).get());
+}
+
+void SIDDWriteControl::writeBlockRow(const ImageSegment& segment,
+                                     size_t blockRow,
+                                     const std::byte* imageData)
+{
+    // Block (and swap) the whole row of blocks into this thread's scratch
+    // buffer, a block per task, then write it in one go
+    thread_local std::vector<std::byte> scratch;
+    const size_t numBytesPerBlock = segment.getNumBytesPerBlock();
+    scratch.resize(segment.numBlocksPerRow * numBytesPerBlock);
+
+    const size_t numValidRows = segment.getNumValidRows(blockRow);
+    const bool byteSwap = segment.elemSize > 1 && shouldByteSwap();
+    std::byte* const blocks = scratch.data();
+    const auto executor = Executor::get(getOptions());
+    executor->parallelFor(segment.numBlocksPerRow,
+                          [&](size_t begin, size_t end)
+    {
+        for (size_t blockCol = begin; blockCol < end; ++blockCol)
+        {
+            const size_t startCol = blockCol * segment.numColsPerBlock;
+            const size_t numValidCols = std::min(segment.numColsPerBlock,
+                                                 segment.numCols - startCol);
+            std::byte* const block = blocks + blockCol * numBytesPerBlock;
+            nitf::ImageBlocker::block(
+                    imageData + startCol * segment.numBytesPerPixel,
+                    segment.numBytesPerPixel,
+                    segment.numCols,
+                    segment.numRowsPerBlock,
+                    segment.numColsPerBlock,
+                    numValidRows,
+                    numValidCols,
+                    block);
+            if (byteSwap)
+            {
+                sys::byteSwap(block, segment.elemSize,
+                              numBytesPerBlock / segment.elemSize);
+            }
+        }
+    }, 1);
+
+    const nitf::Off fileOffset = segment.dataOffset +
+            static_cast<nitf::Off>(blockRow * scratch.size());
+    mImageWriter->writeAt(fileOffset, scratch.data(), scratch.size());
+}
+
+void SIDDWriteControl::close()
+{
+    if (!mImageWriter.get())
+    {
+        return;
+    }
+
+    // Rows of blocks that never got all their pixels still get written,
+    // along with the headers if nothing was ever saved
+    if (getContainer().get() != nullptr && !mHaveWrittenHeaders)
+    {
+        writeHeaders();
+        mHaveWrittenHeaders = true;
+    }
+    for (auto& product : mProducts)
+    {
+        for (const auto& pending : product->pending)
+        {
+            writeBlockRow(product->segments[pending.first.first],
+                          pending.first.second,
+                          pending.second.pixels.data());
+        }
+        product->pending.clear();
+    }
+    mImageWriter.reset();
+}
+}
+}
@@ -0,0 +1,323 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2018, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Test program for SIDDWriteControl
+// Demonstrates that writing SIDDs tile by tile, out of order and from
+// several threads, results in the same files as the normal writes via
+// NITFWriteControl
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <io/ReadUtils.h>
+#include <io/TempFile.h>
+#include <types/RowCol.h>
+
+#include <six/NITFWriteControl.h>
+#include <six/XMLControlFactory.h>
+#include <six/sidd/DerivedXMLControl.h>
+#include <six/sidd/SIDDWriteControl.h>
+#include <six/sidd/Utilities.h>
+
+namespace
+{
+struct Image
+{
+    Image(const types::RowCol<size_t>& dims_, six::PixelType pixelType_) :
+        dims(dims_),
+        pixelType(pixelType_),
+        numBytesPerPixel(pixelType_ == six::PixelType::MONO16I ? 2 :
+                         pixelType_ == six::PixelType::RGB24I ? 3 : 1),
+        pixels(dims.area() * numBytesPerPixel)
+    {
+        for (size_t ii = 0; ii < pixels.size(); ++ii)
+        {
+            pixels[ii] = static_cast<std::byte>(rand() % 256);
+        }
+    }
+
+    const types::RowCol<size_t> dims;
+    const six::PixelType pixelType;
+    const size_t numBytesPerPixel;
+    std::vector<std::byte> pixels;
+};
+
+struct Tile
+{
+    size_t image;
+    types::RowCol<size_t> offset;
+    types::RowCol<size_t> dims;
+    std::vector<std::byte> pixels;
+};
+
+// The fake data is time-stamped when it's created, so both writes have to
+// clone the same data for their files to match
+std::vector<std::unique_ptr<six::Data> > createData(
+        const std::vector<Image>& images)
+{
+    std::vector<std::unique_ptr<six::Data> > allData;
+    for (const auto& image : images)
+    {
+        std::unique_ptr<six::sidd::DerivedData> data(
+                six::sidd::Utilities::createFakeDerivedData().release());
+        setExtent(*data, image.dims);
+        data->setPixelType(image.pixelType);
+        allData.push_back(std::move(data));
+    }
+    return allData;
+}
+
+std::shared_ptr<six::Container> createContainer(
+        const std::vector<std::unique_ptr<six::Data> >& allData)
+{
+    auto container = std::make_shared<six::Container>(
+            six::DataType::DERIVED);
+    for (const auto& data : allData)
+    {
+        container->addData(std::unique_ptr<six::Data>(data->clone()));
+    }
+    return container;
+}
+
+six::Options createOptions(size_t numRowsPerBlock,
+                           size_t numColsPerBlock,
+                           size_t maxProductSize)
+{
+    six::Options options;
+    if (numRowsPerBlock != 0)
+    {
+        options.setParameter(six::NITFHeaderCreator::OPT_NUM_ROWS_PER_BLOCK,
+                             numRowsPerBlock);
+    }
+    if (numColsPerBlock != 0)
+    {
+        options.setParameter(six::NITFHeaderCreator::OPT_NUM_COLS_PER_BLOCK,
+                             numColsPerBlock);
+    }
+    if (maxProductSize != 0)
+    {
+        options.setParameter(six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE,
+                             maxProductSize);
+    }
+    return options;
+}
+
+// Cuts each image into tiles and shuffles them all together
+std::vector<Tile> makeTiles(const std::vector<Image>& images,
+                            const types::RowCol<size_t>& tileDims)
+{
+    std::vector<Tile> tiles;
+    for (size_t ii = 0; ii < images.size(); ++ii)
+    {
+        const Image& image = images[ii];
+        for (size_t row = 0; row < image.dims.row; row += tileDims.row)
+        {
+            for (size_t col = 0; col < image.dims.col; col += tileDims.col)
+            {
+                Tile tile;
+                tile.image = ii;
+                tile.offset = types::RowCol<size_t>(row, col);
+                tile.dims = types::RowCol<size_t>(
+                        std::min(tileDims.row, image.dims.row - row),
+                        std::min(tileDims.col, image.dims.col - col));
+                const size_t numBytesPerRow =
+                        tile.dims.col * image.numBytesPerPixel;
+                tile.pixels.resize(tile.dims.row * numBytesPerRow);
+                for (size_t tileRow = 0; tileRow < tile.dims.row; ++tileRow)
+                {
+                    std::copy_n(image.pixels.data() +
+                                ((row + tileRow) * image.dims.col + col) *
+                                        image.numBytesPerPixel,
+                                numBytesPerRow,
+                                tile.pixels.data() +
+                                        tileRow * numBytesPerRow);
+                }
+                tiles.push_back(std::move(tile));
+            }
+        }
+    }
+
+    std::mt19937 generator(334);
+    std::shuffle(tiles.begin(), tiles.end(), generator);
+    return tiles;
+}
+
+bool runTest(const std::string& prefix,
+             const std::vector<Image>& images,
+             const types::RowCol<size_t>& tileDims,
+             size_t numRowsPerBlock,
+             size_t numColsPerBlock,
+             size_t maxProductSize = 0)
+{
+    const std::vector<std::string> schemaPaths;
+    const io::TempFile normalFile;
+    const io::TempFile testFile;
+    const auto allData = createData(images);
+
+    // The normal way, all at once
+    {
+        six::NITFWriteControl writer;
+        writer.initialize(createOptions(numRowsPerBlock, numColsPerBlock,
+                                        maxProductSize),
+                          createContainer(allData));
+        six::BufferList buffers;
+        for (const auto& image : images)
+        {
+            buffers.push_back(
+                    reinterpret_cast<const six::UByte*>(image.pixels.data()));
+        }
+        writer.save(buffers, normalFile.pathname(), schemaPaths);
+    }
+
+    // Tile by tile, several threads at a time
+    {
+        six::sidd::SIDDWriteControl writer(testFile.pathname(), schemaPaths);
+        writer.initialize(createOptions(numRowsPerBlock, numColsPerBlock,
+                                        maxProductSize),
+                          createContainer(allData));
+
+        const std::vector<Tile> tiles = makeTiles(images, tileDims);
+        static const size_t NUM_THREADS = 3;
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < NUM_THREADS; ++thread)
+        {
+            threads.emplace_back([&, thread]()
+            {
+                for (size_t ii = thread; ii < tiles.size(); ii += NUM_THREADS)
+                {
+                    const Tile& tile = tiles[ii];
+                    writer.save(tile.pixels.data(), tile.offset, tile.dims,
+                                tile.image);
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        writer.close();
+    }
+
+    std::vector<sys::byte> expected;
+    std::vector<sys::byte> actual;
+    io::readFileContents(normalFile.pathname(), expected);
+    io::readFileContents(testFile.pathname(), actual);
+    if (expected == actual)
+    {
+        std::cout << prefix << " matches" << std::endl;
+        return true;
+    }
+
+    if (expected.size() != actual.size())
+    {
+        std::cerr << prefix << " DOES NOT MATCH: file sizes are "
+                  << expected.size() << " vs. " << actual.size() << " bytes"
+                  << std::endl;
+    }
+    else
+    {
+        const auto mismatch =
+                std::mismatch(expected.begin(), expected.end(),
+                              actual.begin());
+        std::cerr << prefix << " DOES NOT MATCH at byte "
+                  << (mismatch.first - expected.begin()) << std::endl;
+    }
+    return false;
+}
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+    try
+    {
+        six::XMLControlFactory::getInstance().
+                addCreator<six::sidd::DerivedXMLControl>();
+        srand(334);
+
+        const Image mono16(types::RowCol<size_t>(123, 456),
+                           six::PixelType::MONO16I);
+        const Image mono8(types::RowCol<size_t>(61, 200),
+                          six::PixelType::MONO8I);
+        const Image rgb(types::RowCol<size_t>(50, 77),
+                        six::PixelType::RGB24I);
+        const types::RowCol<size_t> tileDims(20, 50);
+
+        bool success = true;
+        success &= runTest("Unblocked", {mono16}, tileDims, 0, 0);
+
+        // These intentionally do not divide evenly so there will be both
+        // pad rows and cols
+        success &= runTest("Blocked", {mono16}, tileDims, 7, 9);
+
+        // Whole rows of blocks in a tile skip the buffering
+        success &= runTest("Blocked, full width tiles", {mono16},
+                           types::RowCol<size_t>(14, 456), 7, 9);
+
+        // A few segments
+        const size_t maxProductSize = 30 * 456 * 2 + 2 * 1024;
+        success &= runTest("Multi-segment", {mono16}, tileDims, 0, 0,
+                           maxProductSize);
+        success &= runTest("Blocked multi-segment", {mono16}, tileDims, 7, 9,
+                           maxProductSize);
+
+        // Several products of different sizes and pixel types
+        success &= runTest("Multi-product", {mono16, mono8, rgb}, tileDims,
+                           0, 0);
+        success &= runTest("Blocked multi-product", {mono16, mono8, rgb},
+                           tileDims, 16, 32);
+
+        // With any luck we passed
+        if (success)
+        {
+            std::cout << "All tests pass!\n";
+        }
+        else
+        {
+            std::cerr << "Some tests FAIL!\n";
+        }
+
+        return (success ? 0 : 1);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught std::exception: " << ex.what() << std::endl;
+        return 1;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "Caught except::Exception: " << ex.getMessage()
+                  << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unknown exception\n";
+        return 1;
+    }
+}
@@ -0,0 +1,281 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <std/cstddef>
+
+#include <sys/OS.h>
+#include <six/NITFHeaderCreator.h>
+#include <six/NITFReadControl.h>
+#include <six/NITFWriteControl.h>
+#include <six/XMLControlFactory.h>
+#include <six/sidd/CropUtils.h>
+#include <six/sidd/DerivedData.h>
+#include <six/sidd/DerivedDataBuilder.h>
+#include <six/sidd/DerivedXMLControl.h>
+
+#include "TestCase.h"
+
+namespace
+{
+const size_t NUM_COLS = 200;
+const types::RowCol<size_t> AOI_OFFSET(10, 20);
+const types::RowCol<size_t> AOI_DIMS(25, 100);
+
+std::unique_ptr<six::sidd::DerivedData>
+mockupDerivedData(const types::RowCol<size_t>& dims)
+{
+    six::sidd::DerivedDataBuilder siddBuilder;
+    siddBuilder.addDisplay(six::PixelType::MONO8I);
+    siddBuilder.addGeographicAndTarget(six::RegionType::GEOGRAPHIC_INFO);
+    siddBuilder.addMeasurement(six::ProjectionType::PLANE).
+            addExploitationFeatures(1);
+
+    std::unique_ptr<six::sidd::DerivedData> data(siddBuilder.steal());
+    setExtent(*data, dims);
+
+    data->productCreation->productName = "ProductName";
+    data->productCreation->productClass = "Classy";
+    data->productCreation->classification.classification = "U";
+    data->productCreation->processorInformation.application = "ProcessorName";
+    data->productCreation->processorInformation.profile = "Profile";
+    data->productCreation->processorInformation.site = "Ypsilanti, MI";
+
+    data->display->decimationMethod = six::DecimationMethod::BRIGHTEST_PIXEL;
+    data->display->magnificationMethod =
+            six::MagnificationMethod::NEAREST_NEIGHBOR;
+
+    // A 1 m grid on the equator, so the cropped corners can be computed
+    six::sidd::PlaneProjection* const planeProjection =
+        static_cast<six::sidd::PlaneProjection*>(
+                data->measurement->projection.get());
+    planeProjection->referencePoint = six::ReferencePoint(6378137.0, 0, 0);
+    planeProjection->sampleSpacing = six::RowColDouble(1.0, 1.0);
+    planeProjection->productPlane.rowUnitVector = six::Vector3(0.0);
+    planeProjection->productPlane.rowUnitVector[2] = -1.0;
+    planeProjection->productPlane.colUnitVector = six::Vector3(0.0);
+    planeProjection->productPlane.colUnitVector[1] = 1.0;
+    planeProjection->timeCOAPoly = six::Poly2D(0, 0);
+    planeProjection->timeCOAPoly[0][0] = 1;
+    data->measurement->arpPoly = six::PolyXYZ(0);
+    data->measurement->arpPoly[0] = six::Vector3(0.0);
+
+    six::LatLonCorners corners;
+    corners.upperLeft = six::LatLon(0.001, 0);
+    corners.upperRight = six::LatLon(0.001, 0.001);
+    corners.lowerRight = six::LatLon(0, 0.001);
+    corners.lowerLeft = six::LatLon(0, 0);
+    data->setImageCorners(corners);
+
+    six::sidd::Collection* const parent =
+            data->exploitationFeatures->collections[0].get();
+    parent->information.resolution.rg = 0;
+    parent->information.resolution.az = 0;
+    parent->information.collectionDuration = 0;
+    parent->information.collectionDateTime = six::DateTime();
+    parent->information.radarMode = six::RadarModeType::SPOTLIGHT;
+    parent->information.sensorName.clear();
+
+    data->exploitationFeatures->product.resize(1);
+    data->exploitationFeatures->product[0].resolution.row = 0;
+    data->exploitationFeatures->product[0].resolution.col = 0;
+    data->geographicAndTarget->geographicCoverage.reset(
+            new six::sidd::GeographicCoverage(
+            six::RegionType::GEOGRAPHIC_INFO));
+    data->geographicAndTarget->geographicCoverage->footprint = corners;
+
+    return data;
+}
+
+struct TestHelper final
+{
+    TestHelper() :
+        mPathname("test_crop_sidd.nitf")
+    {
+        six::XMLControlFactory::getInstance().addCreator<
+                six::sidd::DerivedXMLControl>();
+
+        mMonoLegend.setDims(types::RowCol<size_t>(12, 34));
+        mMonoLegend.mType = six::PixelType::MONO8I;
+        mMonoLegend.mLocation.row = 56;
+        mMonoLegend.mLocation.col = 78;
+        for (size_t ii = 0; ii < mMonoLegend.mImage.size(); ++ii)
+        {
+            mMonoLegend.mImage[ii] = static_cast<sys::ubyte>(ii);
+        }
+
+        mRgbLegend.setDims(types::RowCol<size_t>(23, 45));
+        mRgbLegend.mType = six::PixelType::RGB8LU;
+        mRgbLegend.mLocation.row = 9;
+        mRgbLegend.mLocation.col = 87;
+        mRgbLegend.mLUT.reset(new six::LUT(256, 3));
+        for (size_t ii = 0; ii < mRgbLegend.mLUT->numEntries * 3; ++ii)
+        {
+            mRgbLegend.mLUT->getTable()[ii] = static_cast<unsigned char>(ii);
+        }
+
+        write();
+    }
+
+    ~TestHelper()
+    {
+        try
+        {
+            sys::OS().remove(mPathname);
+        }
+        catch (...)
+        {
+        }
+    }
+
+    // Four products; the last two span several image segments, and the
+    // second and fourth have legends
+    void write()
+    {
+        const std::vector<size_t> numRows{ 40, 40, 150, 155 };
+
+        auto container = std::make_shared<six::Container>(
+                six::DataType::DERIVED);
+        std::vector<std::vector<sys::ubyte> > images(numRows.size());
+        six::BufferList buffers;
+        for (size_t ii = 0; ii < numRows.size(); ++ii)
+        {
+            const types::RowCol<size_t> dims(numRows[ii], NUM_COLS);
+            images[ii].resize(dims.area());
+            for (size_t jj = 0; jj < images[ii].size(); ++jj)
+            {
+                images[ii][jj] = static_cast<sys::ubyte>(jj * 7 + ii * 31);
+            }
+            buffers.push_back(images[ii].data());
+
+            std::unique_ptr<six::Legend> legend;
+            if (ii == 1)
+            {
+                legend.reset(new six::Legend(mMonoLegend));
+            }
+            else if (ii == 3)
+            {
+                legend.reset(new six::Legend(mRgbLegend));
+            }
+            container->addData(mockupDerivedData(dims), std::move(legend));
+        }
+
+        six::Options options;
+        options.setParameter(six::NITFHeaderCreator::OPT_MAX_PRODUCT_SIZE,
+                             NUM_COLS * 50);
+        six::NITFWriteControl writer(options, container);
+        writer.save(buffers, mPathname, std::vector<std::string>());
+    }
+
+    const std::string mPathname;
+    six::Legend mMonoLegend;
+    six::Legend mRgbLegend;
+};
+
+// The pixels of an AOI just as they are in the file
+std::vector<std::byte> readRaw(six::NITFReadControl& reader,
+                               const types::RowCol<size_t>& offset,
+                               const types::RowCol<size_t>& dims,
+                               size_t imageNumber)
+{
+    std::vector<std::byte> pixels(dims.area());
+    six::Region region;
+    setOffset(region, offset);
+    setDims(region, dims);
+    region.setBuffer(pixels.data());
+    reader.interleaved(region, imageNumber);
+    return pixels;
+}
+
+bool legendsMatch(const six::Legend* legend, const six::Legend& expected)
+{
+    if (legend == nullptr)
+    {
+        return false;
+    }
+    const bool lutsMatch = (legend->mLUT.get() == nullptr) ?
+            (expected.mLUT.get() == nullptr) :
+            (expected.mLUT.get() != nullptr &&
+             *legend->mLUT == *expected.mLUT);
+    return legend->mType == expected.mType &&
+            legend->mLocation.row == expected.mLocation.row &&
+            legend->mLocation.col == expected.mLocation.col &&
+            legend->mDims.row == expected.mDims.row &&
+            legend->mDims.col == expected.mDims.col &&
+            legend->mImage == expected.mImage &&
+            lutsMatch;
+}
+
+// Crops a strip at a time and checks every product, and its legend, made
+// it across unchanged
+bool cropMatches(const TestHelper& testHelper, size_t numRowsPerStrip)
+{
+    const std::string croppedPathname("cropped_" + testHelper.mPathname);
+    six::sidd::cropSIDD(testHelper.mPathname, std::vector<std::string>(),
+                        AOI_OFFSET, AOI_DIMS, croppedPathname,
+                        numRowsPerStrip);
+
+    six::NITFReadControl reader;
+    reader.load(testHelper.mPathname);
+    six::NITFReadControl croppedReader;
+    croppedReader.load(croppedPathname);
+    const auto container = croppedReader.getContainer();
+
+    bool matches = (container->size() == reader.getContainer()->size());
+    for (size_t ii = 0; matches && ii < container->size(); ++ii)
+    {
+        const auto data =
+                dynamic_cast<const six::sidd::DerivedData*>(
+                        container->getData(ii));
+        matches = data != nullptr && getExtent(*data) == AOI_DIMS &&
+                data->downstreamReprocessing.get() != nullptr &&
+                data->downstreamReprocessing->geometricChip.get() != nullptr;
+        matches = matches &&
+                (readRaw(croppedReader, types::RowCol<size_t>(0, 0),
+                         AOI_DIMS, ii) ==
+                 readRaw(reader, AOI_OFFSET, AOI_DIMS, ii));
+    }
+
+    matches = matches &&
+            container->getLegend(0) == nullptr &&
+            legendsMatch(container->getLegend(1), testHelper.mMonoLegend) &&
+            container->getLegend(2) == nullptr &&
+            legendsMatch(container->getLegend(3), testHelper.mRgbLegend);
+
+    sys::OS().remove(croppedPathname);
+    return matches;
+}
+}
+
+TEST_CASE(testCropProductsAndLegends)
+{
+    const TestHelper testHelper;
+    TEST_ASSERT(cropMatches(testHelper, 1));
+    TEST_ASSERT(cropMatches(testHelper, 7));
+    TEST_ASSERT(cropMatches(testHelper, 0));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testCropProductsAndLegends);
+)
@@ -0,0 +1,148 @@
+/* =========================================================================
+ * This file is part of six.sidd-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six.sidd-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <nitf/J2KCompressor.hpp>
+#include <six/Executor.h>
+#include <six/sidd/J2KTileCompressor.h>
+#include "TestCase.h"
+
+namespace
+{
+// The tiles intentionally don't divide evenly, so there are partial tiles
+// on the right and bottom
+const types::RowCol<size_t> IMAGE_DIMS(300, 200);
+const types::RowCol<size_t> TILE_DIMS(64, 48);
+
+std::vector<std::byte> makeImage()
+{
+    // Some sort of pattern so compression has something to work with
+    std::vector<std::byte> image(IMAGE_DIMS.area());
+    for (size_t ii = 0; ii < image.size(); ++ii)
+    {
+        image[ii] = static_cast<std::byte>((ii / 100) % 128);
+    }
+    return image;
+}
+
+std::span<const std::byte> cspan(const std::vector<std::byte>& values)
+{
+    return std::span<const std::byte>(values.data(), values.size());
+}
+
+// Everything at once, on the calling thread
+void compressSerially(const std::vector<std::byte>& image,
+                      std::vector<std::byte>& codestream,
+                      std::vector<size_t>& bytesPerTile)
+{
+    const j2k::CompressionParameters params(IMAGE_DIMS, TILE_DIMS);
+    const j2k::Compressor compressor(params);
+    compressor.compress(cspan(image), codestream, bytesPerTile);
+}
+}
+
+TEST_CASE(testMatchesSerialCompression)
+{
+    const std::vector<std::byte> image = makeImage();
+    std::vector<std::byte> expected;
+    std::vector<size_t> expectedBytesPerTile;
+    compressSerially(image, expected, expectedBytesPerTile);
+
+    // However many threads and tiles in flight, it's the same codestream
+    for (size_t numThreads : {1, 4})
+    {
+        six::Executor executor(numThreads);
+        for (size_t numTilesInFlight : {0, 1, 3})
+        {
+            const six::sidd::J2KTileCompressor compressor(
+                    IMAGE_DIMS, TILE_DIMS, 1.0, numTilesInFlight);
+            TEST_ASSERT_EQ(compressor.getNumTiles(), static_cast<size_t>(25));
+
+            std::vector<std::byte> codestream;
+            std::vector<size_t> bytesPerTile;
+            compressor.compress(cspan(image), codestream, bytesPerTile,
+                                &executor);
+            TEST_ASSERT(bytesPerTile == expectedBytesPerTile);
+            TEST_ASSERT(codestream == expected);
+            TEST_ASSERT_EQ(std::accumulate(bytesPerTile.begin(),
+                                           bytesPerTile.end(),
+                                           static_cast<size_t>(0)),
+                           codestream.size());
+        }
+    }
+}
+
+TEST_CASE(testTilesArriveInOrder)
+{
+    const std::vector<std::byte> image = makeImage();
+    six::Executor executor(4);
+    const six::sidd::J2KTileCompressor compressor(IMAGE_DIMS, TILE_DIMS,
+                                                  1.0, 2);
+
+    size_t nextTile = 0;
+    compressor.compress(cspan(image),
+                        [&](size_t tileIndex, std::span<const std::byte> tile)
+    {
+        TEST_ASSERT_EQ(tileIndex, nextTile);
+        TEST_ASSERT_GREATER(tile.size(), static_cast<size_t>(0));
+        ++nextTile;
+    }, &executor);
+    TEST_ASSERT_EQ(nextTile, compressor.getNumTiles());
+}
+
+TEST_CASE(testErrors)
+{
+    const six::sidd::J2KTileCompressor compressor(IMAGE_DIMS, TILE_DIMS);
+    std::vector<std::byte> image(IMAGE_DIMS.area() - 1);
+    std::vector<std::byte> codestream;
+    std::vector<size_t> bytesPerTile;
+    TEST_EXCEPTION(compressor.compress(cspan(image), codestream,
+                                       bytesPerTile));
+
+    TEST_EXCEPTION(six::sidd::J2KTileCompressor(IMAGE_DIMS,
+                                                types::RowCol<size_t>(0, 0)));
+
+    // A failing sink stops the compression and its error comes back out
+    image = makeImage();
+    six::Executor executor(4);
+    size_t numSunk = 0;
+    TEST_THROWS(compressor.compress(cspan(image),
+                                    [&](size_t tileIndex,
+                                        std::span<const std::byte>)
+    {
+        ++numSunk;
+        if (tileIndex == 3)
+        {
+            throw std::runtime_error("Sink failed");
+        }
+    }, &executor));
+    TEST_ASSERT_EQ(numSunk, static_cast<size_t>(4));
+}
+
+TEST_MAIN(
+    TEST_CHECK(testMatchesSerialCompression);
+    TEST_CHECK(testTilesArriveInOrder);
+    TEST_CHECK(testErrors);
+)
@@ -29,6 +29,7 @@
 #include <std/span>
 
 #include <io/FileInputStream.h>
+#include <io/StringStream.h>
 #include <logging/NullLogger.h>
 #include <import/sys.h>
 
@@ -73,6 +74,19 @@ static std::vector<std::filesystem::path> getSchemaPaths()
     return std::vector<std::filesystem::path> { (root_dir / schema_relative_path()) };
 }
 
+// Writing straight to a stream has to give exactly what printing the DOM does
+static void test_assert_streamed_xml(const std::string& testName, const six::sidd::DerivedData& derivedData)
+{
+    six::sidd::DerivedXMLControl xmlControl;
+    const auto pDoc = xmlControl.toXML(derivedData, nullptr /*pSchemaPaths*/);
+    io::StringStream domStream;
+    pDoc->getRootElement()->print(domStream);
+
+    io::StringStream xmlStream;
+    xmlControl.toXML(derivedData, xmlStream, nullptr /*pSchemaPaths*/);
+    TEST_ASSERT_EQ(xmlStream.stream().str(), domStream.stream().str());
+}
+
 static std::unique_ptr<six::sidd::DerivedData> test_assert_round_trip(const std::string& testName,
     const six::sidd::DerivedData& derivedData, const std::vector<std::filesystem::path>* pSchemaPaths)
 {
@@ -99,6 +113,15 @@ static void test_createFakeDerivedData_(const std::string& testName, const std::
     auto Unmodeled = get_Unmodeled(*pFakeDerivedData, strVersion);
     TEST_ASSERT_NULL(Unmodeled); // not part of the fake data, only added in SIDD 3.0
 
+    test_assert_streamed_xml(testName, *pFakeDerivedData);
+
+    // Display is written one band's processing at a time
+    const auto pMoreBands = six::sidd::Utilities::createFakeDerivedData(strVersion);
+    auto& display = *(pMoreBands->display);
+    display.nonInteractiveProcessing.push_back(display.nonInteractiveProcessing[0]);
+    display.interactiveProcessing.push_back(display.interactiveProcessing[0]);
+    test_assert_streamed_xml(testName, *pMoreBands);
+
     // NULL schemaPaths, no validation
     auto pDerivedData = test_assert_round_trip(testName , *pFakeDerivedData, nullptr /*pSchemaPaths*/);
     Unmodeled = get_Unmodeled(*pDerivedData, strVersion);
@@ -151,6 +174,7 @@ static void test_read_sidd_xml(const std::string& testName, const std::filesyste
     // NULL schemaPaths, no validation
     auto pDerivedData = six::sidd::Utilities::parseDataFromFile(pathname, nullptr /*pSchemaPaths*/);
     test_assert_unmodeled(testName, *pDerivedData);
+    test_assert_streamed_xml(testName, *pDerivedData);
 
     pDerivedData = test_assert_round_trip(testName , *pDerivedData, nullptr /*pSchemaPaths*/);
     test_assert_unmodeled(testName, *pDerivedData);
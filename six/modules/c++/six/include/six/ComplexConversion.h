@@ -0,0 +1,128 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_COMPLEX_CONVERSION_H__
+#define __SIX_COMPLEX_CONVERSION_H__
+#pragma once
+
+#include <stddef.h>
+
+#include <complex>
+#include <string>
+
+namespace six
+{
+/*!
+ * \enum ConversionKernel
+ * \brief Instruction sets the complex<float> conversion routines can use
+ *
+ * The fastest one the CPU supports is picked at runtime; the others are
+ * exposed for testing and benchmarking.  Every kernel produces bit-identical
+ * results.
+ */
+enum class ConversionKernel
+{
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+//! \return The fastest kernel this build and CPU support
+ConversionKernel getBestConversionKernel();
+
+//! \return Whether this build and CPU can run 'kernel'
+bool isSupported(ConversionKernel kernel);
+
+//! \return A printable name for 'kernel'
+std::string toString(ConversionKernel kernel);
+
+/*!
+ * Converts complex pixels to complex<float>, byte swapping them first if
+ * necessary, in one pass.
+ *
+ * \param input Pixels of complex<int8_t>, complex<int16_t>, or
+ * complex<float>.  There are no alignment requirements.
+ * \param elementSize Size in bytes of each pixel (2, 4, or 8)
+ * \param numPixels Number of pixels to convert
+ * \param byteSwap Whether each real and imaginary component needs to be
+ * byte swapped.  Ignored for complex<int8_t>.
+ * \param output Converted pixels; may not overlap 'input'
+ *
+ * \throws except::Exception if elementSize is unsupported
+ */
+void promoteToComplexFloat(const void* input,
+                           size_t elementSize,
+                           size_t numPixels,
+                           bool byteSwap,
+                           std::complex<float>* output);
+
+/*!
+ * Same as above, with the kernel picked by the caller
+ *
+ * \throws except::Exception if the kernel isn't supported
+ */
+void promoteToComplexFloat(const void* input,
+                           size_t elementSize,
+                           size_t numPixels,
+                           bool byteSwap,
+                           std::complex<float>* output,
+                           ConversionKernel kernel);
+
+/*!
+ * Converts complex pixels to complex<float> and multiplies them by a scale
+ * factor, byte swapping them first if necessary, in one pass.  The
+ * multiplication is carried out in double precision, i.e.
+ * static_cast<float>(real * scaleFactor).
+ *
+ * \param input Pixels of complex<int8_t>, complex<int16_t>, or
+ * complex<float>.  There are no alignment requirements.
+ * \param elementSize Size in bytes of each pixel (2, 4, or 8)
+ * \param numPixels Number of pixels to convert
+ * \param byteSwap Whether each real and imaginary component needs to be
+ * byte swapped.  Ignored for complex<int8_t>.
+ * \param scaleFactor Value to multiply each component by
+ * \param output Converted pixels; may not overlap 'input'
+ *
+ * \throws except::Exception if elementSize is unsupported
+ */
+void scaleToComplexFloat(const void* input,
+                         size_t elementSize,
+                         size_t numPixels,
+                         bool byteSwap,
+                         double scaleFactor,
+                         std::complex<float>* output);
+
+/*!
+ * Same as above, with the kernel picked by the caller
+ *
+ * \throws except::Exception if the kernel isn't supported
+ */
+void scaleToComplexFloat(const void* input,
+                         size_t elementSize,
+                         size_t numPixels,
+                         bool byteSwap,
+                         double scaleFactor,
+                         std::complex<float>* output,
+                         ConversionKernel kernel);
+}
+
+#endif
@@ -35,7 +35,7 @@
 
 namespace six
 {
-
+class Executor;
 
 
 /*!
@@ -81,10 +81,15 @@ struct Data
     virtual PixelType getPixelType() const = 0;
     virtual void setPixelType(PixelType pixelType) = 0;
     virtual bool convertPixels_(std::span<const std::byte>, std::span<std::byte>, ptrdiff_t /*cutoff*/) const { return false; }
+    // As above, spreading the work over 'pExecutor' (if not NULL); unless overridden, the executor is ignored
+    virtual bool convertPixelsWith_(std::span<const std::byte> from, std::span<std::byte> to, ptrdiff_t cutoff, Executor* /*pExecutor*/) const
+    {
+        return convertPixels_(from, to, cutoff);
+    }
     template<typename T, typename U>
-    bool convertPixels(std::span<const T> from, std::span<U> to, ptrdiff_t cutoff = -1) const
+    bool convertPixels(std::span<const T> from, std::span<U> to, ptrdiff_t cutoff = -1, Executor* pExecutor = nullptr) const
     {
-        return convertPixels_(as_bytes(from), as_bytes(to), cutoff);
+        return convertPixelsWith_(as_bytes(from), as_bytes(to), cutoff, pExecutor);
     }
 
     /*!
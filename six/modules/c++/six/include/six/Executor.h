@@ -0,0 +1,167 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_EXECUTOR_H__
+#define __SIX_EXECUTOR_H__
+#pragma once
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace six
+{
+class Options;
+
+/*!
+ *  \class Executor
+ *  \brief A persistent pool of threads for data-parallel loops
+ *
+ *  Threads are started once, when the executor is constructed, rather than
+ *  on every call.  Each thread has its own queue of work; a thread that runs
+ *  out steals from the others, and the thread that called parallelFor()
+ *  works too rather than just waiting.  That also makes it safe to call
+ *  parallelFor() from inside a parallelFor().
+ *
+ *  Most code should share one of the process-wide executors from get()
+ *  rather than constructing its own.
+ */
+class Executor final
+{
+public:
+    /*!
+     *  Options key for the number of threads get() should use; 0 (the
+     *  default) is one per core.  Ignored if Options::setExecutor() has
+     *  been called.
+     */
+    static const char OPT_NUM_THREADS[];
+
+    /*!
+     *  \param numThreads Total number of threads working on each
+     *  parallelFor(), including the calling one.  0 is one per core; 1 does
+     *  everything on the calling thread.
+     */
+    explicit Executor(size_t numThreads = 0);
+
+    //!  Waits for any running work, then stops the threads
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    size_t getNumThreads() const
+    {
+        return mNumThreads;
+    }
+
+    /*!
+     *  The number of elements parallelFor() hands out at a time: small
+     *  enough that there are a few pieces per thread to balance the load,
+     *  but never less than minGrainSize.
+     *
+     *  \param size Number of elements
+     *  \param minGrainSize The fewest elements worth the overhead of
+     *  handing to another thread
+     */
+    size_t getGrainSize(size_t size, size_t minGrainSize = 1) const;
+
+    /*!
+     *  Calls func(begin, end) over disjoint pieces of [0, size) in parallel,
+     *  returning once they're all done.
+     *
+     *  \param size Number of elements
+     *  \param func Function to call for each piece
+     *  \param minGrainSize See getGrainSize()
+     *
+     *  \throws The first exception thrown by func, once every piece has
+     *  finished
+     */
+    void parallelFor(size_t size,
+                     const std::function<void(size_t, size_t)>& func,
+                     size_t minGrainSize = 1);
+
+    /*!
+     *  Parallel std::transform() for random-access iterators
+     */
+    template <typename InputIt, typename OutputIt, typename TFunc>
+    void transform(InputIt first, InputIt last, OutputIt d_first, TFunc f,
+                   size_t minGrainSize = 1)
+    {
+        const auto size = static_cast<size_t>(std::distance(first, last));
+        parallelFor(size, [&](size_t begin, size_t end)
+        {
+            std::transform(first + begin, first + end, d_first + begin, f);
+        }, minGrainSize);
+    }
+
+    /*!
+     *  \param numThreads 0 is one per core
+     *  \return The process-wide executor with this many threads, created
+     *  on first use.  Only the few most recently asked for sizes are kept
+     *  around, so asking for many different sizes doesn't pile up threads.
+     */
+    static std::shared_ptr<Executor> get(size_t numThreads = 0);
+
+    /*!
+     *  \return The executor set with Options::setExecutor(), else the
+     *  process-wide one sized by OPT_NUM_THREADS
+     */
+    static std::shared_ptr<Executor> get(const Options& options);
+
+private:
+    struct Job;
+    struct Task
+    {
+        Job* job;
+        size_t begin;
+        size_t end;
+    };
+    struct Queue;
+
+    void push(const std::vector<Task>& tasks);
+    bool tryRunOne(size_t home);
+    void run(const Task& task);
+    void workerLoop(size_t index);
+    size_t getHomeQueue() const;
+
+    const size_t mNumThreads;
+
+    // One per worker thread, plus one for threads that aren't ours
+    std::vector<std::unique_ptr<Queue> > mQueues;
+    std::vector<std::thread> mThreads;
+
+    std::mutex mSleepMutex;
+    std::condition_variable mWake;
+    std::atomic<size_t> mNumQueued;
+    std::atomic<size_t> mNextQueue;
+    bool mStop;
+};
+}
+
+#endif
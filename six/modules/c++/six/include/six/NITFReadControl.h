@@ -25,6 +25,8 @@
 
 #include <map>
 #include <memory>
+#include <functional>
+#include <cstddef>
 #include <std/filesystem>
 
 #include "six/NITFImageInfo.h"
@@ -32,6 +34,7 @@
 #include "six/ReadControlFactory.h"
 #include "six/Adapters.h"
 #include <io/SeekableStreams.h>
+#include <types/RowCol.h>
 #include <import/nitf.hpp>
 #include <nitf/IOStreamReader.hpp>
 
@@ -54,6 +57,18 @@ namespace six
  */
 struct NITFReadControl : public ReadControl
 {
+    /*!
+     *  Number of threads to use when a read spans more than one image
+     *  segment.  Each thread reads its segments through its own
+     *  nitf::Reader and file handle, writing into disjoint parts of the
+     *  caller's buffer.  0 means one thread per CPU.  Defaults to 1,
+     *  i.e., the segments are read one after another.
+     *
+     *  This is only honored if the NITF was loaded from a pathname; a
+     *  NITF loaded from a stream has no way to open another handle.
+     */
+    static const char OPT_NUM_THREADS[];
+
     //!  Constructor
     NITFReadControl(FILE* log);
     NITFReadControl();
@@ -181,6 +196,38 @@ struct NITFReadControl : public ReadControl
      */
     virtual UByte* interleaved(Region& region, size_t imageNumber) override;
 
+    /*!
+     * Handed one strip of rows of an AOI at a time
+     *
+     * \param strip The strip's pixels, row-major, as they are in the file
+     * (no conversion) but in native byte order
+     * \param offset Where the strip is within the AOI
+     * \param dims The dimensions of the strip
+     */
+    using StripFunc = std::function<void(const std::byte* strip,
+                                         const types::RowCol<size_t>& offset,
+                                         const types::RowCol<size_t>& dims)>;
+
+    /*!
+     * Reads an AOI of an image a strip of rows at a time, handing each
+     * strip to 'func' while the next one is read (the two share an
+     * Executor's threads).  Only two strips are ever held in memory, however
+     * large the AOI.
+     *
+     * \param aoiOffset Upper left corner of the AOI
+     * \param aoiDims Size of the AOI
+     * \param imageNumber Index of the image to read
+     * \param numRowsPerStrip Number of rows in each strip.  The last strip
+     * may have fewer.  If 0, each strip is as many rows as fit in about
+     * 32 MB (at least one).
+     * \param func Called once per strip, top to bottom, one at a time
+     */
+    void interleaved(const types::RowCol<size_t>& aoiOffset,
+                     const types::RowCol<size_t>& aoiDims,
+                     size_t imageNumber,
+                     size_t numRowsPerStrip,
+                     const StripFunc& func);
+
     std::string getFileType() const override
     {
         return "NITF";
@@ -278,11 +325,17 @@ private:
         return (iCat == "DED");
     }
 
+    size_t getNumThreads() const;
+
     // We need this for one of the load overloadings
     // to prevent data from being deleted prematurely
     // The issue occurs from the explicit destructor of
     // IOControl
     std::shared_ptr<nitf::IOInterface> mInterface;
+
+    // Set only when loading from a pathname; parallel segment reads
+    // need it to open their own file handles
+    std::string mPathname;
 };
 
 
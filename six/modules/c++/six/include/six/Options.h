@@ -25,9 +25,12 @@
 #include "six/Types.h"
 #include "six/Parameter.h"
 #include <map>
+#include <memory>
 
 namespace six
 {
+class Executor;
+
 /*!
  *  \class Options
  *  \brief Configurable option map
@@ -73,6 +76,19 @@ public:
      */
     virtual bool hasParameter(const std::string& option) const;
 
+    /*!
+     *  Threads for readers and writers to use (see Executor::get()).
+     *  Unlike parameters, this isn't part of the comparison.
+     */
+    void setExecutor(std::shared_ptr<Executor> executor)
+    {
+        mExecutor = executor;
+    }
+    std::shared_ptr<Executor> getExecutor() const
+    {
+        return mExecutor;
+    }
+
     //!  Allows us to iterate a parameter list
     ParameterIter begin() const { return mParameters.begin(); }
 
@@ -87,6 +103,7 @@ public:
 
 private:
     std::map<std::string, Parameter> mParameters;
+    std::shared_ptr<Executor> mExecutor;
 };
 }
 
@@ -0,0 +1,93 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2016, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef __SIX_POSITIONAL_FILE_WRITER_H__
+#define __SIX_POSITIONAL_FILE_WRITER_H__
+#pragma once
+
+#include <stddef.h>
+
+#include <string>
+
+#include <nitf/System.hpp>
+
+namespace six
+{
+class Executor;
+
+/*!
+ *  \class PositionalFileWriter
+ *  \brief Writes at an offset rather than at a shared cursor
+ *
+ *  Any number of threads can write at once: pwrite() on POSIX and
+ *  WriteFile() with an OVERLAPPED offset on Windows.  This is the only
+ *  handle on the file, so the headers have to be written through it too.
+ */
+class PositionalFileWriter final
+{
+public:
+    //! Creates the file, or truncates it if it exists
+    //! \throws sys::SystemException if the file can't be opened
+    explicit PositionalFileWriter(const std::string& pathname);
+
+    ~PositionalFileWriter();
+
+    PositionalFileWriter(const PositionalFileWriter&) = delete;
+    PositionalFileWriter& operator=(const PositionalFileWriter&) = delete;
+
+    //! Writes all 'size' bytes of 'data' starting at 'offset' in the file
+    void writeAt(nitf::Off offset, const void* data, size_t size) const;
+
+    /*!
+     *  Writes rows of pixels into a row-major image in the file.  Whole
+     *  image rows are written together; partial ones a row at a time.
+     *  Nothing is written if there are no rows or the rows are empty.
+     *
+     *  \param offset Where the first row goes in the file
+     *  \param data The rows, numBytesPerRow apart
+     *  \param numRows Number of rows
+     *  \param numBytesPerRow Bytes in each row of 'data'
+     *  \param fileRowStride Bytes between rows in the file
+     *  \param swapElemSize If more than 1, the size of the elements to
+     *  byte swap.  They're swapped a chunk at a time into a per-thread
+     *  scratch buffer, so 'data' is left alone.
+     *  \param pExecutor Executor to spread the byte swapping over, or NULL
+     *  to swap on the calling thread
+     */
+    void writeRows(nitf::Off offset,
+                   const void* data,
+                   size_t numRows,
+                   size_t numBytesPerRow,
+                   size_t fileRowStride,
+                   size_t swapElemSize = 0,
+                   Executor* pExecutor = nullptr) const;
+
+private:
+    const std::string mPathname;
+#if defined(_WIN32)
+    void* mFile;
+#else
+    int mFile;
+#endif
+};
+}
+
+#endif
@@ -91,6 +91,8 @@ template<typename T> T toType(const std::string& s)
 
 template<> std::string toString(const float& value);
 template<> std::string toString(const double& value);
+template<> float toType<float>(const std::string& s);
+template<> double toType<double>(const std::string& s);
 template<> std::string toString(const six::Vector3 & v);
 template<> std::string toString(const six::PolyXYZ & p);
 template<> six::EarthModelType
@@ -318,6 +320,24 @@ std::string findSchemaPath(const std::string& progname);
 
 namespace details
 {
+    /*!
+     *  Formats a value for the XML without going through a stream: what
+     *  printf()'s %.*g (or %.*E if scientific, less the '+' of the exponent)
+     *  gives with max_digits10 digits.  That's str::toString(), or
+     *  six::toString() if scientific, byte for byte.
+     */
+    std::string toString(double value, bool scientific);
+    std::string toString(float value, bool scientific);
+
+    /*!
+     *  Parses a value from the XML without going through a stream, accepting
+     *  what str::toType() does
+     *
+     *  \throws except::BadCastException if s doesn't start with a number
+     */
+    double toDouble(const std::string& s);
+    float toFloat(const std::string& s);
+
     template<typename T>
     inline std::span<const std::byte> as_bytes(std::span<const T> buffer)
     {
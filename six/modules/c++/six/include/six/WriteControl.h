@@ -79,10 +79,10 @@ struct WriteControl
     static const char OPT_BUFFER_SIZE[];
 
     // Control multi-threading for AMP8I_PHS8I conversion in six::sicd::ImageData.
-    // A negative means no multithreading, 0 will have "the system" guess at
-    // an appropriate cutoff (a hardcoded value based on testing).  Any other
-    // positive value is the number of pixels to process in each thread; it should
-    // be fairly large to make-up for the overhead of threading.
+    // A negative means no multithreading, 0 will have "the system" pick how
+    // many pixels each thread gets.  Any other positive value is the fewest
+    // pixels to hand to a thread; it should be fairly large to make-up for the
+    // overhead of threading.  The threads come from Executor::get(getOptions()).
     static const std::string AMP8I_PHS8I_CUTOFF;
     static constexpr ptrdiff_t AMP8I_PHS8I_DEFAULT_CUTOFF = 0; // to_AMP8I_PHS8I() is too slow w/o multi-threading
 
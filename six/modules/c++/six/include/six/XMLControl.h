@@ -29,6 +29,7 @@
 #include <scene/sys_Conf.h>
 
 #include <logging/Logger.h>
+#include <io/OutputStream.h>
 #include <import/xml/lite.h>
 
 #include "six/Types.h"
@@ -94,6 +95,10 @@ class XMLControl
      *  \func validate
      *  \brief Validate the xml and log any errors
      *
+     *  The schemas are only loaded and compiled the first time a set of
+     *  schema paths is used; after that, every thread in the process
+     *  validating against the same paths reuses them.
+     *
      *  \param doc XML document
      *  \param schemaPaths  Directories or files of schema locations
      *  \param log Logs validation errors
@@ -105,6 +110,25 @@ class XMLControl
         const std::vector<std::filesystem::path>* pSchemaPaths,
         logging::Logger* log);
 
+    /*
+     *  As above, but validates XML text as is (e.g. the bytes of a DES),
+     *  rather than re-serializing a DOM.
+     *
+     *  \param xml XML text
+     *  \param uri Namespace URI of the root element
+     *  \param pSchemaPaths  Directories or files of schema locations
+     *  \param log Logs validation errors
+     */
+    static void validate(const std::string& xml, const std::string& uri,
+        const std::vector<std::filesystem::path>* pSchemaPaths,
+        logging::Logger* log);
+
+    /*!
+     *  Forgets the schemas compiled by validate(), so they'll be reloaded
+     *  from disk next time
+     */
+    static void clearSchemaCache();
+
     /*!
      * Retrieve the proper schema paths for validation.
      * Schema paths can come from three sources, in
@@ -133,6 +157,18 @@ class XMLControl
     std::unique_ptr<xml::lite::Document> toXML(const Data&, const std::vector<std::string>&);
     std::unique_ptr<xml::lite::Document> toXML(const Data&, const std::vector<std::filesystem::path>*);
 
+    /*!
+     *  Write the Data model as XML, the same as printing toXML()'s DOM, but
+     *  without holding all of that DOM at once (for SICDs and SIDDs).
+     *  \param data         Data structure
+     *  \param os           Where the XML goes
+     *  \param pSchemaPaths Directories or files of schema locations; if
+     *                      there are any, the XML is kept in memory until
+     *                      it's been validated
+     */
+    void toXML(const Data& data, io::OutputStream& os,
+        const std::vector<std::filesystem::path>* pSchemaPaths);
+
     /*!
      *  Convert a document from a DOM into a Data model
      *  \param doc          XML Document
@@ -144,6 +180,18 @@ class XMLControl
     std::unique_ptr<Data> fromXML(const xml::lite::Document&,
         const std::vector<std::filesystem::path>*);
 
+    /*!
+     *  As above, but validates the XML text the document was parsed from
+     *  (e.g. the bytes of a DES) rather than re-serializing the DOM
+     *  \param doc          XML Document
+     *  \param xml          The text doc was parsed from
+     *  \param pSchemaPaths Directories or files of schema locations
+     *  \return a Data model
+     */
+    std::unique_ptr<Data> fromXML(const xml::lite::Document& doc,
+        const std::string& xml,
+        const std::vector<std::filesystem::path>* pSchemaPaths);
+
     /*!
      *  Provides a mapping from COMPLEX --> SICD and DERIVED --> SIDD
      */
@@ -179,6 +227,14 @@ class XMLControl
     virtual xml::lite::Document* toXMLImpl(const Data* data) = 0;
     virtual std::unique_ptr<xml::lite::Document> toXMLImpl(const Data&) const; // = 0;, would break existing code
 
+    /*!
+     *  Write the Data model as XML.  Unless overridden, this prints
+     *  toXMLImpl()'s DOM.
+     *  \param data the Data model
+     *  \param os Where the XML goes
+     */
+    virtual void toXMLImpl(const Data& data, io::OutputStream& os) const;
+
     static std::string getDefaultURI(const Data& data);
 
     static std::string getVersionFromURI(const xml::lite::Document* doc);
@@ -29,8 +29,12 @@
 #include <type_traits>
 #include <std/optional>
 #include <memory>
+#include <functional>
+#include <vector>
 
 #include <import/gsl.h>
+#include <io/OutputStream.h>
+#include <xml/lite/Document.h>
 
 #include <six/Types.h>
 #include <six/Init.h>
@@ -314,6 +318,35 @@ protected:
      */
     static XMLElem require(XMLElem element, const std::string& name);
 
+    //! Adds one top-level element, and everything under it, to the root
+    using XMLBlock = std::function<void(XMLElem root)>;
+
+    /*!
+     * Makes a document whose root, named rootName, gets each of the blocks
+     * in turn.  Once the root is complete, setNamespaces is called on it.
+     */
+    std::unique_ptr<xml::lite::Document> blocksToXML(const std::string& rootName,
+        const std::vector<XMLBlock>& blocks, const XMLBlock& setNamespaces) const;
+
+    /*!
+     * Writes exactly what printing the root of blocksToXML()'s document
+     * would, but each block is printed and freed before the next one is
+     * made, so there's never more than one block's worth of DOM; see
+     * splitBlock() for blocks too big for that.
+     */
+    void writeBlocks(io::OutputStream& os, const std::string& rootName,
+        const std::vector<XMLBlock>& blocks, const XMLBlock& setNamespaces) const;
+
+    /*!
+     * A block for an element too big to make all at once: addElement adds
+     * the element (and anything that has to come first under it) to the
+     * root, then each of addChildren adds more to that element, in order.
+     * writeBlocks() prints and frees each piece before making the next, so
+     * the most DOM there ever is, is one of those pieces.
+     */
+    static XMLBlock splitBlock(const XMLBlock& addElement,
+        const std::vector<XMLBlock>& addChildren);
+
 private:
     XmlLite mXmlLite;
 };
@@ -198,11 +198,11 @@ struct NewMemoryWriteHandler::Impl final
     std::vector<std::pair<uint8_t, uint8_t>> ampi8i_phs8i;
 
     void convertPixels(NewMemoryWriteHandler& instance, const NITFSegmentInfo& info, std::span<const std::complex<float>> buffer, const Data& data,
-        ptrdiff_t cutoff = -1)
+        ptrdiff_t cutoff = -1, Executor* pExecutor = nullptr)
     {
         ampi8i_phs8i.resize(buffer.size());
         const std::span<std::pair<uint8_t, uint8_t>> ampi8i_phs8i_(ampi8i_phs8i.data(), ampi8i_phs8i.size());
-        if (!data.convertPixels(buffer, ampi8i_phs8i_, cutoff))
+        if (!data.convertPixels(buffer, ampi8i_phs8i_, cutoff, pExecutor))
         {
             throw std::runtime_error("Unable to convert pixels.");
         }
@@ -247,7 +247,7 @@ inline const std::byte* cast(std::span<const T> buffer)
 
 NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
     std::span<const std::byte> buffer, size_t firstRow, const Data& data, bool doByteSwap,
-    ptrdiff_t cutoff)
+    ptrdiff_t cutoff, Executor* pExecutor)
     : NewMemoryWriteHandler(info, cast(buffer), firstRow, data, doByteSwap)
 {
     validate_bandSize(buffer, info, data);
@@ -261,18 +261,18 @@ NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
         const void* pBuffer_ = buffer.data();
         const auto pBuffer = static_cast<const std::complex<float>*>(pBuffer_);
         const std::span<const std::complex<float>> buffer_(pBuffer, buffer.size() / sizeof(std::complex<float>));
-        m_pImpl->convertPixels(*this, info, buffer_, data, cutoff);
+        m_pImpl->convertPixels(*this, info, buffer_, data, cutoff, pExecutor);
     }
 }
 
 NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
     std::span<const std::complex<float>> buffer, size_t firstRow, const Data& data, bool doByteSwap,
-    ptrdiff_t cutoff)
+    ptrdiff_t cutoff, Executor* pExecutor)
     : NewMemoryWriteHandler(info, cast(buffer), firstRow, data, doByteSwap)
 {
     if (data.getPixelType() == six::PixelType::AMP8I_PHS8I)
     {
-        m_pImpl->convertPixels(*this, info, buffer, data, cutoff);
+        m_pImpl->convertPixels(*this, info, buffer, data, cutoff, pExecutor);
     }
     else if (data.getPixelType() != six::PixelType::RE32F_IM32F)
     {
@@ -285,7 +285,7 @@ NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
 }
 
 NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
-    std::span<const std::pair<uint8_t, uint8_t>> buffer, size_t firstRow, const Data& data, bool doByteSwap, ptrdiff_t)
+    std::span<const std::pair<uint8_t, uint8_t>> buffer, size_t firstRow, const Data& data, bool doByteSwap, ptrdiff_t, Executor*)
     : NewMemoryWriteHandler(info, cast(buffer), firstRow, data, doByteSwap)
 {
     // This is for the uncommon case where the data is already in this format; normally, it is std::complex<float>.
@@ -297,7 +297,7 @@ NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
 }
 
 NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
-    std::span<const std::complex<short>> buffer, size_t firstRow, const Data& data, bool doByteSwap, ptrdiff_t)
+    std::span<const std::complex<short>> buffer, size_t firstRow, const Data& data, bool doByteSwap, ptrdiff_t, Executor*)
     : NewMemoryWriteHandler(info, cast(buffer), firstRow, data, doByteSwap)
 {
     // Each pixel is stored as a pair of numbers that represent the real and imaginary 
@@ -310,7 +310,7 @@ NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
     validate_buffer(buffer, info, data);
 }
 NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
-    std::span<const uint8_t> buffer, size_t firstRow, const Data& data, bool doByteSwap, ptrdiff_t)
+    std::span<const uint8_t> buffer, size_t firstRow, const Data& data, bool doByteSwap, ptrdiff_t, Executor*)
     : NewMemoryWriteHandler(info, cast(buffer), firstRow, data, doByteSwap)
 {
     switch (data.getPixelType())
@@ -326,7 +326,7 @@ NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
     validate_buffer(buffer, info, data);
 }
 NewMemoryWriteHandler::NewMemoryWriteHandler(const NITFSegmentInfo& info,
-    std::span<const uint16_t> buffer, size_t firstRow, const Data& data, bool doByteSwap, ptrdiff_t)
+    std::span<const uint16_t> buffer, size_t firstRow, const Data& data, bool doByteSwap, ptrdiff_t, Executor*)
     : NewMemoryWriteHandler(info, cast(buffer), firstRow, data, doByteSwap)
 {
     if (data.getPixelType() != six::PixelType::MONO16I)
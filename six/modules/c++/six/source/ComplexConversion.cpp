@@ -0,0 +1,649 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <six/ComplexConversion.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <std/cstddef>
+
+#include <sys/Conf.h>
+#include <except/Exception.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#define SIX_CONVERSION_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define SIX_CONVERSION_X86 0
+#endif
+
+// GCC and Clang need to be told which functions may use which instruction
+// sets; MSVC allows any intrinsic anywhere
+#if SIX_CONVERSION_X86 && (defined(__GNUC__) || defined(__clang__))
+#define SIX_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIX_TARGET(isa)
+#endif
+
+namespace
+{
+// Policies for what happens to each component after it's been widened
+struct NoScale final
+{
+};
+
+struct Scale final
+{
+    double factor;
+};
+
+inline float apply(float value, const NoScale&)
+{
+    return value;
+}
+
+inline float apply(double value, const Scale& scale)
+{
+    return static_cast<float>(value * scale.factor);
+}
+
+template <typename T>
+inline T load(const std::byte* in, bool byteSwap)
+{
+    std::byte bytes[sizeof(T)];
+    if (byteSwap)
+    {
+        for (size_t ii = 0; ii < sizeof(T); ++ii)
+        {
+            bytes[ii] = in[sizeof(T) - 1 - ii];
+        }
+        in = bytes;
+    }
+
+    // Can't byte swap in place as a float; the swapped bits might not be
+    // a valid float
+    T value;
+    memcpy(&value, in, sizeof(T));
+    return value;
+}
+
+// Also handles the leftover pixels for each of the vectorized kernels
+template <typename InT, typename ScaleT>
+void convertScalar(const std::byte* in,
+                   size_t numPixels,
+                   bool byteSwap,
+                   float* out,
+                   const ScaleT& scale)
+{
+    for (size_t ii = 0; ii < 2 * numPixels; ++ii, in += sizeof(InT))
+    {
+        out[ii] = apply(load<InT>(in, byteSwap), scale);
+    }
+}
+
+#if SIX_CONVERSION_X86
+namespace sse2
+{
+SIX_TARGET("sse2")
+inline void storeInts(float* out, __m128i ints, const NoScale&)
+{
+    _mm_storeu_ps(out, _mm_cvtepi32_ps(ints));
+}
+
+SIX_TARGET("sse2")
+inline void storeInts(float* out, __m128i ints, const Scale& scale)
+{
+    const __m128d factor = _mm_set1_pd(scale.factor);
+    const __m128 lo =
+            _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtepi32_pd(ints), factor));
+    const __m128 hi = _mm_cvtpd_ps(
+            _mm_mul_pd(_mm_cvtepi32_pd(_mm_srli_si128(ints, 8)), factor));
+    _mm_storeu_ps(out, _mm_movelh_ps(lo, hi));
+}
+
+SIX_TARGET("sse2")
+inline void storeFloats(float* out, __m128 floats, const NoScale&)
+{
+    _mm_storeu_ps(out, floats);
+}
+
+SIX_TARGET("sse2")
+inline void storeFloats(float* out, __m128 floats, const Scale& scale)
+{
+    const __m128d factor = _mm_set1_pd(scale.factor);
+    const __m128 lo =
+            _mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(floats), factor));
+    const __m128 hi = _mm_cvtpd_ps(
+            _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(floats, floats)), factor));
+    _mm_storeu_ps(out, _mm_movelh_ps(lo, hi));
+}
+
+SIX_TARGET("sse2")
+inline __m128i swap16(__m128i v)
+{
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+SIX_TARGET("sse2")
+inline __m128i swap32(__m128i v)
+{
+    v = swap16(v);
+    return _mm_or_si128(_mm_slli_epi32(v, 16), _mm_srli_epi32(v, 16));
+}
+
+// Sign extends the low/high four 16-bit values
+SIX_TARGET("sse2")
+inline __m128i widenLo16(__m128i v)
+{
+    return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+}
+
+SIX_TARGET("sse2")
+inline __m128i widenHi16(__m128i v)
+{
+    return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+}
+
+template <typename ScaleT>
+SIX_TARGET("sse2")
+void convertInt8(const std::byte* in, size_t numPixels, float* out,
+                 const ScaleT& scale)
+{
+    // 8 pixels at a time
+    size_t ii = 0;
+    for (; ii + 8 <= numPixels; ii += 8, in += 16, out += 16)
+    {
+        const __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        const __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(v, v), 8);
+        const __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(v, v), 8);
+        storeInts(out, widenLo16(lo), scale);
+        storeInts(out + 4, widenHi16(lo), scale);
+        storeInts(out + 8, widenLo16(hi), scale);
+        storeInts(out + 12, widenHi16(hi), scale);
+    }
+    convertScalar<int8_t>(in, numPixels - ii, false, out, scale);
+}
+
+template <typename ScaleT>
+SIX_TARGET("sse2")
+void convertInt16(const std::byte* in, size_t numPixels, bool byteSwap,
+                  float* out, const ScaleT& scale)
+{
+    // 4 pixels at a time
+    size_t ii = 0;
+    for (; ii + 4 <= numPixels; ii += 4, in += 16, out += 8)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        if (byteSwap)
+        {
+            v = swap16(v);
+        }
+        storeInts(out, widenLo16(v), scale);
+        storeInts(out + 4, widenHi16(v), scale);
+    }
+    convertScalar<int16_t>(in, numPixels - ii, byteSwap, out, scale);
+}
+
+template <typename ScaleT>
+SIX_TARGET("sse2")
+void convertFloat(const std::byte* in, size_t numPixels, bool byteSwap,
+                  float* out, const ScaleT& scale)
+{
+    // 2 pixels at a time
+    size_t ii = 0;
+    for (; ii + 2 <= numPixels; ii += 2, in += 16, out += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        if (byteSwap)
+        {
+            v = swap32(v);
+        }
+        storeFloats(out, _mm_castsi128_ps(v), scale);
+    }
+    convertScalar<float>(in, numPixels - ii, byteSwap, out, scale);
+}
+}
+
+namespace avx2
+{
+SIX_TARGET("avx2")
+inline void storeInts(float* out, __m256i ints, const NoScale&)
+{
+    _mm256_storeu_ps(out, _mm256_cvtepi32_ps(ints));
+}
+
+SIX_TARGET("avx2")
+inline void storeInts(float* out, __m256i ints, const Scale& scale)
+{
+    const __m256d factor = _mm256_set1_pd(scale.factor);
+    const __m128 lo = _mm256_cvtpd_ps(_mm256_mul_pd(
+            _mm256_cvtepi32_pd(_mm256_castsi256_si128(ints)), factor));
+    const __m128 hi = _mm256_cvtpd_ps(_mm256_mul_pd(
+            _mm256_cvtepi32_pd(_mm256_extracti128_si256(ints, 1)), factor));
+    _mm_storeu_ps(out, lo);
+    _mm_storeu_ps(out + 4, hi);
+}
+
+SIX_TARGET("avx2")
+inline void storeFloats(float* out, __m256 floats, const NoScale&)
+{
+    _mm256_storeu_ps(out, floats);
+}
+
+SIX_TARGET("avx2")
+inline void storeFloats(float* out, __m256 floats, const Scale& scale)
+{
+    const __m256d factor = _mm256_set1_pd(scale.factor);
+    const __m128 lo = _mm256_cvtpd_ps(_mm256_mul_pd(
+            _mm256_cvtps_pd(_mm256_castps256_ps128(floats)), factor));
+    const __m128 hi = _mm256_cvtpd_ps(_mm256_mul_pd(
+            _mm256_cvtps_pd(_mm256_extractf128_ps(floats, 1)), factor));
+    _mm_storeu_ps(out, lo);
+    _mm_storeu_ps(out + 4, hi);
+}
+
+SIX_TARGET("avx2")
+inline __m256i swap16(__m256i v)
+{
+    const __m256i mask = _mm256_setr_epi8(
+            1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+            1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    return _mm256_shuffle_epi8(v, mask);
+}
+
+SIX_TARGET("avx2")
+inline __m256i swap32(__m256i v)
+{
+    const __m256i mask = _mm256_setr_epi8(
+            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+            3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    return _mm256_shuffle_epi8(v, mask);
+}
+
+template <typename ScaleT>
+SIX_TARGET("avx2")
+void convertInt8(const std::byte* in, size_t numPixels, float* out,
+                 const ScaleT& scale)
+{
+    // 4 pixels at a time
+    size_t ii = 0;
+    for (; ii + 4 <= numPixels; ii += 4, in += 8, out += 8)
+    {
+        const __m128i v =
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in));
+        storeInts(out, _mm256_cvtepi8_epi32(v), scale);
+    }
+    convertScalar<int8_t>(in, numPixels - ii, false, out, scale);
+}
+
+template <typename ScaleT>
+SIX_TARGET("avx2")
+void convertInt16(const std::byte* in, size_t numPixels, bool byteSwap,
+                  float* out, const ScaleT& scale)
+{
+    // 8 pixels at a time
+    size_t ii = 0;
+    for (; ii + 8 <= numPixels; ii += 8, in += 32, out += 16)
+    {
+        __m256i v =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        if (byteSwap)
+        {
+            v = swap16(v);
+        }
+        storeInts(out, _mm256_cvtepi16_epi32(_mm256_castsi256_si128(v)),
+                  scale);
+        storeInts(out + 8,
+                  _mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1)),
+                  scale);
+    }
+    convertScalar<int16_t>(in, numPixels - ii, byteSwap, out, scale);
+}
+
+template <typename ScaleT>
+SIX_TARGET("avx2")
+void convertFloat(const std::byte* in, size_t numPixels, bool byteSwap,
+                  float* out, const ScaleT& scale)
+{
+    // 4 pixels at a time
+    size_t ii = 0;
+    for (; ii + 4 <= numPixels; ii += 4, in += 32, out += 8)
+    {
+        __m256i v =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        if (byteSwap)
+        {
+            v = swap32(v);
+        }
+        storeFloats(out, _mm256_castsi256_ps(v), scale);
+    }
+    convertScalar<float>(in, numPixels - ii, byteSwap, out, scale);
+}
+}
+
+// Only the widening benefits from the wider registers; floats go through
+// the AVX2 kernel
+namespace avx512
+{
+SIX_TARGET("avx512f,avx2")
+inline void storeInts(float* out, __m512i ints, const NoScale&)
+{
+    _mm512_storeu_ps(out, _mm512_cvtepi32_ps(ints));
+}
+
+SIX_TARGET("avx512f,avx2")
+inline void storeInts(float* out, __m512i ints, const Scale& scale)
+{
+    const __m512d factor = _mm512_set1_pd(scale.factor);
+    const __m256 lo = _mm512_cvtpd_ps(_mm512_mul_pd(
+            _mm512_cvtepi32_pd(_mm512_castsi512_si256(ints)), factor));
+    const __m256 hi = _mm512_cvtpd_ps(_mm512_mul_pd(
+            _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(ints, 1)), factor));
+    _mm256_storeu_ps(out, lo);
+    _mm256_storeu_ps(out + 8, hi);
+}
+
+template <typename ScaleT>
+SIX_TARGET("avx512f,avx2")
+void convertInt8(const std::byte* in, size_t numPixels, float* out,
+                 const ScaleT& scale)
+{
+    // 8 pixels at a time
+    size_t ii = 0;
+    for (; ii + 8 <= numPixels; ii += 8, in += 16, out += 16)
+    {
+        const __m128i v =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        storeInts(out, _mm512_cvtepi8_epi32(v), scale);
+    }
+    convertScalar<int8_t>(in, numPixels - ii, false, out, scale);
+}
+
+template <typename ScaleT>
+SIX_TARGET("avx512f,avx2")
+void convertInt16(const std::byte* in, size_t numPixels, bool byteSwap,
+                  float* out, const ScaleT& scale)
+{
+    // 16 pixels at a time, as two halves so the swap doesn't need AVX-512BW
+    size_t ii = 0;
+    for (; ii + 16 <= numPixels; ii += 16, in += 64, out += 32)
+    {
+        __m256i lo =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        __m256i hi =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32));
+        if (byteSwap)
+        {
+            lo = avx2::swap16(lo);
+            hi = avx2::swap16(hi);
+        }
+        storeInts(out, _mm512_cvtepi16_epi32(lo), scale);
+        storeInts(out + 16, _mm512_cvtepi16_epi32(hi), scale);
+    }
+    avx2::convertInt16(in, numPixels - ii, byteSwap, out, scale);
+}
+}
+#endif
+
+bool cpuSupports(six::ConversionKernel kernel)
+{
+#if SIX_CONVERSION_X86 && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    switch (kernel)
+    {
+    case six::ConversionKernel::Scalar:
+        return true;
+    case six::ConversionKernel::SSE2:
+        return __builtin_cpu_supports("sse2");
+    case six::ConversionKernel::AVX2:
+        return __builtin_cpu_supports("avx2");
+    case six::ConversionKernel::AVX512:
+        return __builtin_cpu_supports("avx512f") &&
+                __builtin_cpu_supports("avx2");
+    }
+    return false;
+#elif SIX_CONVERSION_X86 && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+
+    // The OS has to save the wider registers too
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool ymm = (xcr0 & 0x6) == 0x6;
+    const bool zmm = (xcr0 & 0xe6) == 0xe6;
+
+    bool avx2 = false;
+    bool avx512f = false;
+    if (maxLeaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+        avx512f = (info[1] & (1 << 16)) != 0;
+    }
+
+    switch (kernel)
+    {
+    case six::ConversionKernel::Scalar:
+        return true;
+    case six::ConversionKernel::SSE2:
+        return sse2;
+    case six::ConversionKernel::AVX2:
+        return avx2 && ymm;
+    case six::ConversionKernel::AVX512:
+        return avx2 && avx512f && zmm;
+    }
+    return false;
+#else
+    return kernel == six::ConversionKernel::Scalar;
+#endif
+}
+
+template <typename ScaleT>
+void convertInt8(const std::byte* in, size_t numPixels, float* out,
+                 const ScaleT& scale, six::ConversionKernel kernel)
+{
+    switch (kernel)
+    {
+#if SIX_CONVERSION_X86
+    case six::ConversionKernel::AVX512:
+        avx512::convertInt8(in, numPixels, out, scale);
+        break;
+    case six::ConversionKernel::AVX2:
+        avx2::convertInt8(in, numPixels, out, scale);
+        break;
+    case six::ConversionKernel::SSE2:
+        sse2::convertInt8(in, numPixels, out, scale);
+        break;
+#endif
+    default:
+        convertScalar<int8_t>(in, numPixels, false, out, scale);
+    }
+}
+
+template <typename ScaleT>
+void convertInt16(const std::byte* in, size_t numPixels, bool byteSwap,
+                  float* out, const ScaleT& scale,
+                  six::ConversionKernel kernel)
+{
+    switch (kernel)
+    {
+#if SIX_CONVERSION_X86
+    case six::ConversionKernel::AVX512:
+        avx512::convertInt16(in, numPixels, byteSwap, out, scale);
+        break;
+    case six::ConversionKernel::AVX2:
+        avx2::convertInt16(in, numPixels, byteSwap, out, scale);
+        break;
+    case six::ConversionKernel::SSE2:
+        sse2::convertInt16(in, numPixels, byteSwap, out, scale);
+        break;
+#endif
+    default:
+        convertScalar<int16_t>(in, numPixels, byteSwap, out, scale);
+    }
+}
+
+template <typename ScaleT>
+void convertFloat(const std::byte* in, size_t numPixels, bool byteSwap,
+                  float* out, const ScaleT& scale,
+                  six::ConversionKernel kernel)
+{
+    switch (kernel)
+    {
+#if SIX_CONVERSION_X86
+    case six::ConversionKernel::AVX512:
+    case six::ConversionKernel::AVX2:
+        avx2::convertFloat(in, numPixels, byteSwap, out, scale);
+        break;
+    case six::ConversionKernel::SSE2:
+        sse2::convertFloat(in, numPixels, byteSwap, out, scale);
+        break;
+#endif
+    default:
+        convertScalar<float>(in, numPixels, byteSwap, out, scale);
+    }
+}
+
+template <typename ScaleT>
+void convert(const void* input,
+             size_t elementSize,
+             size_t numPixels,
+             bool byteSwap,
+             const ScaleT& scale,
+             std::complex<float>* output,
+             six::ConversionKernel kernel)
+{
+    if (!six::isSupported(kernel))
+    {
+        throw except::Exception(Ctxt(
+                "The " + six::toString(kernel) +
+                " conversion kernel is not supported on this machine"));
+    }
+
+    const auto in = static_cast<const std::byte*>(input);
+    void* const output_ = output;
+    const auto out = static_cast<float*>(output_);
+
+    switch (elementSize)
+    {
+    case 2:
+        convertInt8(in, numPixels, out, scale, kernel);
+        break;
+    case 4:
+        convertInt16(in, numPixels, byteSwap, out, scale, kernel);
+        break;
+    case 8:
+        convertFloat(in, numPixels, byteSwap, out, scale, kernel);
+        break;
+    default:
+        throw except::Exception(Ctxt(
+                "Unexpected element size " + std::to_string(elementSize)));
+    }
+}
+}
+
+namespace six
+{
+ConversionKernel getBestConversionKernel()
+{
+    static const ConversionKernel best =
+            cpuSupports(ConversionKernel::AVX512) ? ConversionKernel::AVX512 :
+            cpuSupports(ConversionKernel::AVX2) ? ConversionKernel::AVX2 :
+            cpuSupports(ConversionKernel::SSE2) ? ConversionKernel::SSE2 :
+            ConversionKernel::Scalar;
+    return best;
+}
+
+bool isSupported(ConversionKernel kernel)
+{
+    return kernel <= getBestConversionKernel();
+}
+
+std::string toString(ConversionKernel kernel)
+{
+    switch (kernel)
+    {
+    case ConversionKernel::Scalar:
+        return "Scalar";
+    case ConversionKernel::SSE2:
+        return "SSE2";
+    case ConversionKernel::AVX2:
+        return "AVX2";
+    case ConversionKernel::AVX512:
+        return "AVX-512";
+    }
+    throw except::Exception(Ctxt("Unknown conversion kernel"));
+}
+
+void promoteToComplexFloat(const void* input,
+                           size_t elementSize,
+                           size_t numPixels,
+                           bool byteSwap,
+                           std::complex<float>* output)
+{
+    promoteToComplexFloat(input, elementSize, numPixels, byteSwap, output,
+                          getBestConversionKernel());
+}
+
+void promoteToComplexFloat(const void* input,
+                           size_t elementSize,
+                           size_t numPixels,
+                           bool byteSwap,
+                           std::complex<float>* output,
+                           ConversionKernel kernel)
+{
+    convert(input, elementSize, numPixels, byteSwap, NoScale(), output,
+            kernel);
+}
+
+void scaleToComplexFloat(const void* input,
+                         size_t elementSize,
+                         size_t numPixels,
+                         bool byteSwap,
+                         double scaleFactor,
+                         std::complex<float>* output)
+{
+    scaleToComplexFloat(input, elementSize, numPixels, byteSwap, scaleFactor,
+                        output, getBestConversionKernel());
+}
+
+void scaleToComplexFloat(const void* input,
+                         size_t elementSize,
+                         size_t numPixels,
+                         bool byteSwap,
+                         double scaleFactor,
+                         std::complex<float>* output,
+                         ConversionKernel kernel)
+{
+    Scale scale;
+    scale.factor = scaleFactor;
+    convert(input, elementSize, numPixels, byteSwap, scale, output, kernel);
+}
+}
@@ -0,0 +1,329 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+#include <six/Executor.h>
+
+#include <deque>
+#include <exception>
+#include <list>
+
+#include <six/Options.h>
+
+namespace
+{
+// Pieces per thread when the grain size is up to us.  More pieces balance
+// uneven work better; fewer cost less to hand out.
+const size_t PIECES_PER_THREAD = 4;
+
+size_t getDefaultNumThreads()
+{
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+// Which executor's worker, if any, is running on this thread
+thread_local const six::Executor* tExecutor = nullptr;
+thread_local size_t tQueue = 0;
+}
+
+namespace six
+{
+const char Executor::OPT_NUM_THREADS[] = "ExecutorNumThreads";
+
+struct Executor::Job
+{
+    Job(const std::function<void(size_t, size_t)>& func, size_t numTasks) :
+        func(func),
+        remaining(numTasks)
+    {
+    }
+
+    const std::function<void(size_t, size_t)>& func;
+    size_t remaining;
+    std::exception_ptr exception;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+struct Executor::Queue
+{
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+Executor::Executor(size_t numThreads) :
+    mNumThreads(numThreads == 0 ? getDefaultNumThreads() : numThreads),
+    mNumQueued(0),
+    mNextQueue(0),
+    mStop(false)
+{
+    // The caller of parallelFor() is one of the threads
+    const size_t numWorkers = mNumThreads - 1;
+    for (size_t ii = 0; ii <= numWorkers; ++ii)
+    {
+        mQueues.emplace_back(new Queue);
+    }
+
+    mThreads.reserve(numWorkers);
+    for (size_t ii = 0; ii < numWorkers; ++ii)
+    {
+        mThreads.emplace_back(&Executor::workerLoop, this, ii);
+    }
+}
+
+Executor::~Executor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+
+    for (auto& thread : mThreads)
+    {
+        thread.join();
+    }
+}
+
+size_t Executor::getGrainSize(size_t size, size_t minGrainSize) const
+{
+    if (mNumThreads == 1)
+    {
+        return std::max<size_t>(size, 1);
+    }
+
+    const size_t numPieces = mNumThreads * PIECES_PER_THREAD;
+    const size_t grainSize = (size + numPieces - 1) / numPieces;
+    return std::max<size_t>(std::max(grainSize, minGrainSize), 1);
+}
+
+void Executor::parallelFor(size_t size,
+                           const std::function<void(size_t, size_t)>& func,
+                           size_t minGrainSize)
+{
+    const size_t grainSize = getGrainSize(size, minGrainSize);
+    if (size <= grainSize)
+    {
+        if (size > 0)
+        {
+            func(0, size);
+        }
+        return;
+    }
+
+    const size_t numTasks = (size + grainSize - 1) / grainSize;
+    Job job(func, numTasks);
+
+    std::vector<Task> tasks;
+    tasks.reserve(numTasks);
+    for (size_t begin = 0; begin < size; begin += grainSize)
+    {
+        tasks.push_back({&job, begin, std::min(begin + grainSize, size)});
+    }
+    push(tasks);
+
+    // Help out until there's nothing left to take, then wait for whatever
+    // other threads are still working on
+    const size_t home = getHomeQueue();
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (job.remaining == 0)
+            {
+                break;
+            }
+        }
+        if (!tryRunOne(home))
+        {
+            std::unique_lock<std::mutex> lock(job.mutex);
+            job.done.wait(lock, [&job]() { return job.remaining == 0; });
+            break;
+        }
+    }
+
+    if (job.exception)
+    {
+        std::rethrow_exception(job.exception);
+    }
+}
+
+size_t Executor::getHomeQueue() const
+{
+    return tExecutor == this ? tQueue : mQueues.size() - 1;
+}
+
+void Executor::push(const std::vector<Task>& tasks)
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mNumQueued += tasks.size();
+    }
+
+    if (tExecutor == this)
+    {
+        // Our own worker: keep the work close, others will steal it
+        Queue& queue = *mQueues[tQueue];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.insert(queue.tasks.end(), tasks.begin(), tasks.end());
+    }
+    else
+    {
+        // Deal the work out so the workers don't all start on one queue
+        for (const auto& task : tasks)
+        {
+            Queue& queue = *mQueues[mNextQueue++ % mQueues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(task);
+        }
+    }
+
+    mWake.notify_all();
+}
+
+bool Executor::tryRunOne(size_t home)
+{
+    // Newest work from our own queue, else the oldest from someone else's
+    for (size_t ii = 0; ii < mQueues.size(); ++ii)
+    {
+        Queue& queue = *mQueues[(home + ii) % mQueues.size()];
+
+        Task task;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+            {
+                continue;
+            }
+            if (ii == 0)
+            {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            --mNumQueued;
+        }
+
+        run(task);
+        return true;
+    }
+    return false;
+}
+
+void Executor::run(const Task& task)
+{
+    Job& job = *task.job;
+
+    std::exception_ptr exception;
+    try
+    {
+        job.func(task.begin, task.end);
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    // The job lives on the stack of the thread waiting for it; it may go
+    // away as soon as the lock is released.
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if (exception && !job.exception)
+    {
+        job.exception = exception;
+    }
+    if (--job.remaining == 0)
+    {
+        job.done.notify_all();
+    }
+}
+
+void Executor::workerLoop(size_t index)
+{
+    tExecutor = this;
+    tQueue = index;
+
+    while (true)
+    {
+        if (tryRunOne(index))
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mWake.wait(lock, [this]() { return mStop || mNumQueued > 0; });
+        if (mStop && mNumQueued == 0)
+        {
+            return;
+        }
+    }
+}
+
+std::shared_ptr<Executor> Executor::get(size_t numThreads)
+{
+    if (numThreads == 0)
+    {
+        numThreads = getDefaultNumThreads();
+    }
+
+    // Only the most recently used few sizes are kept; one that's dropped
+    // lives on (threads and all) only as long as someone still holds it
+    static const size_t MAX_CACHED = 4;
+    static std::mutex mutex;
+    static std::list<std::shared_ptr<Executor> > executors;
+
+    // Declared before the lock so a dropped executor's threads are joined
+    // after it's been released
+    std::shared_ptr<Executor> dropped;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = executors.begin(); it != executors.end(); ++it)
+    {
+        if ((*it)->getNumThreads() == numThreads)
+        {
+            executors.splice(executors.begin(), executors, it);
+            return executors.front();
+        }
+    }
+
+    executors.push_front(std::make_shared<Executor>(numThreads));
+    if (executors.size() > MAX_CACHED)
+    {
+        dropped = std::move(executors.back());
+        executors.pop_back();
+    }
+    return executors.front();
+}
+
+std::shared_ptr<Executor> Executor::get(const Options& options)
+{
+    auto executor = options.getExecutor();
+    if (executor)
+    {
+        return executor;
+    }
+
+    const size_t numThreads =
+            options.getParameter(OPT_NUM_THREADS, Parameter(0));
+    return get(numThreads);
+}
+}
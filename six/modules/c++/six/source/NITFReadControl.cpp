@@ -25,10 +25,17 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
+#include <std/cstddef>
 #include <std/memory>
 
 #include <gsl/gsl.h>
+#include <mt/ThreadGroup.h>
+#include <mt/ThreadPlanner.h>
+#include <sys/OS.h>
+#include <sys/Runnable.h>
 
+#include <six/Executor.h>
 #include <six/NITFReadControl.h>
 #include <six/XMLControlFactory.h>
 #include <six/Utilities.h>
@@ -78,6 +85,96 @@ void assignLUT(const nitf::ImageSubheader& subheader, six::Legend& legend)
     }
 }
 
+// One image segment's worth of a Region
+struct SegmentRead final
+{
+    size_t imageSegment = 0;
+    size_t startRow = 0;
+    size_t numRows = 0;
+    size_t bufferOffset = 0;
+};
+
+// The columns of a Region, which are the same in every segment
+class SegmentReadWindow final
+{
+public:
+    SegmentReadWindow(uint32_t startCol,
+                      uint32_t numCols,
+                      const std::map<std::string, void*>& compressionOptions) :
+        mStartCol(startCol),
+        mNumCols(numCols),
+        mCompressionOptions(compressionOptions)
+    {
+    }
+
+    void read(nitf::Reader& reader,
+              const SegmentRead& segmentRead,
+              six::UByte* buffer) const
+    {
+        uint32_t bandList(0);
+        nitf::SubWindow sw;
+        sw.setStartRow(static_cast<uint32_t>(segmentRead.startRow));
+        sw.setNumRows(static_cast<uint32_t>(segmentRead.numRows));
+        sw.setStartCol(mStartCol);
+        sw.setNumCols(mNumCols);
+        sw.setNumBands(1);
+        sw.setBandList(&bandList);
+
+        nitf::ImageReader imageReader = reader.newImageReader(
+                static_cast<int>(segmentRead.imageSegment),
+                mCompressionOptions);
+
+        auto bufferPtr = buffer + segmentRead.bufferOffset;
+        int padded;
+        imageReader.read(sw, &bufferPtr, &padded);
+    }
+
+private:
+    const uint32_t mStartCol;
+    const uint32_t mNumCols;
+    const std::map<std::string, void*>& mCompressionOptions;
+};
+
+// Reads a contiguous run of segments through a private reader and file
+// handle, so several of these can run at once against the same file
+class ReadSegmentsRunnable final : public sys::Runnable
+{
+public:
+    ReadSegmentsRunnable(const std::string& pathname,
+                         const SegmentReadWindow& window,
+                         const SegmentRead* reads,
+                         size_t numReads,
+                         six::UByte* buffer) :
+        mPathname(pathname),
+        mWindow(window),
+        mReads(reads),
+        mNumReads(numReads),
+        mBuffer(buffer)
+    {
+    }
+
+    void run() override
+    {
+        nitf::IOHandle handle(mPathname);
+        nitf::Reader reader;
+
+        // The reader only holds a pointer to the record, so keep it alive
+        const nitf::Record record = reader.read(handle);
+
+        for (size_t ii = 0; ii < mNumReads; ++ii)
+        {
+            mWindow.read(reader, mReads[ii], mBuffer);
+        }
+    }
+
+private:
+    const std::string mPathname;
+    const SegmentReadWindow& mWindow;
+    const SegmentRead* const mReads;
+    const size_t mNumReads;
+    six::UByte* const mBuffer;
+};
+
 six::PixelType getPixelType(const nitf::ImageSubheader& subheader)
 {
     const auto iRep = subheader.imageRepresentation();
@@ -95,6 +192,8 @@ six::PixelType getPixelType(const nitf::ImageSubheader& subheader)
 
 namespace six
 {
+const char NITFReadControl::OPT_NUM_THREADS[] = "NumThreads";
+
 NITFReadControl::NITFReadControl(FILE* log)
 {
     // Make sure that if we use XML_DATA_CONTENT that we've loaded it into the
@@ -254,11 +353,13 @@ void NITFReadControl::load(const std::string& fromFile, const std::vector<std::s
 {
     auto handle(std::make_shared<nitf::IOHandle>(fromFile));
     load(handle, pSchemaPaths);
+    mPathname = fromFile;
 }
 void NITFReadControl::load(const std::filesystem::path& fromFile, const std::vector<std::filesystem::path>* pSchemaPaths)
 {
     std::shared_ptr<nitf::IOInterface> handle(std::make_shared<nitf::IOHandle>(fromFile.string()));
     load(handle, pSchemaPaths);
+    mPathname = fromFile.string();
 }
 
 void NITFReadControl::load(std::shared_ptr<nitf::IOInterface> ioInterface)
@@ -656,12 +757,6 @@ UByte* NITFReadControl::interleaved(Region& region, size_t imageNumber)
     }
 
     // Do segmenting here
-    nitf::SubWindow sw;
-    sw.setStartCol(static_cast<uint32_t>(startCol));
-    sw.setNumCols(static_cast<uint32_t>(numColsReq));
-    sw.setNumBands(1);
-    sw.setBandList(&bandList);
-
     std::vector < NITFSegmentInfo > imageSegments = thisImage.getImageSegments();
     const size_t numIS = imageSegments.size();
     size_t startOff = 0;
@@ -683,41 +778,152 @@ UByte* NITFReadControl::interleaved(Region& region, size_t imageNumber)
 
     }
     --i; // Need to get rid of the last one
-    size_t totalRead = 0;
-    auto numRowsLeft = numRowsReq;
-    sw.setStartRow(static_cast<uint32_t>(startRow - startOff));
 #if DEBUG_OFFSETS
     std::cout << "startRow: " << startRow
     << " startOff: " << startOff
-    << " sw.startRow: " << sw.getStartRow()
     << " i: " << i << std::endl;
 #endif
 
+    // Figure out which piece of each segment lands where in the buffer
     const auto nbpp = thisImage.getData()->getNumBytesPerPixel();
     const auto startIndex = thisImage.getStartIndex();
-    createCompressionOptions(mCompressionOptions);
+    std::vector<SegmentRead> reads;
+    size_t totalRead = 0;
+    auto numRowsLeft = numRowsReq;
+    size_t startRowSeg = gsl::narrow<size_t>(startRow) - startOff;
     for (; i < numIS && totalRead < subWindowSize; i++)
     {
         const auto numRowsReqSeg =
-                std::min(gsl::narrow<size_t>(numRowsLeft), imageSegments[i].getNumRows() - sw.getStartRow());
-
-        sw.setNumRows(static_cast<uint32_t>(numRowsReqSeg));
-        nitf::ImageReader imageReader = mReader.newImageReader(
-                static_cast<int>(startIndex + i),
-                mCompressionOptions);
+                std::min(gsl::narrow<size_t>(numRowsLeft), imageSegments[i].getNumRows() - startRowSeg);
 
-        auto bufferPtr = buffer + totalRead;
+        SegmentRead read;
+        read.imageSegment = startIndex + i;
+        read.startRow = startRowSeg;
+        read.numRows = numRowsReqSeg;
+        read.bufferOffset = totalRead;
+        reads.push_back(read);
 
-        int padded;
-        imageReader.read(sw, &bufferPtr, &padded);
         totalRead += numColsReq * nbpp * numRowsReqSeg;
-        sw.setStartRow(0);
+        startRowSeg = 0;
         numRowsLeft -= numRowsReqSeg;
     }
 
+    createCompressionOptions(mCompressionOptions);
+    const SegmentReadWindow window(static_cast<uint32_t>(startCol),
+                                   static_cast<uint32_t>(numColsReq),
+                                   mCompressionOptions);
+
+    const size_t numThreads = std::min(getNumThreads(), reads.size());
+    if (numThreads <= 1 || mPathname.empty())
+    {
+        for (const auto& read : reads)
+        {
+            window.read(mReader, read, buffer);
+        }
+    }
+    else
+    {
+        mt::ThreadGroup threads;
+        const mt::ThreadPlanner planner(reads.size(), numThreads);
+
+        size_t threadNum(0);
+        size_t startRead(0);
+        size_t numReadsThisThread(0);
+        while (planner.getThreadInfo(threadNum++, startRead, numReadsThisThread))
+        {
+            threads.createThread(std::make_unique<ReadSegmentsRunnable>(
+                    mPathname,
+                    window,
+                    &reads[startRead],
+                    numReadsThisThread,
+                    buffer));
+        }
+
+        threads.joinAll();
+    }
+
     return buffer;
 }
 
+void NITFReadControl::interleaved(const types::RowCol<size_t>& aoiOffset,
+                                  const types::RowCol<size_t>& aoiDims,
+                                  size_t imageNumber,
+                                  size_t numRowsPerStrip,
+                                  const StripFunc& func)
+{
+    if (aoiDims.row == 0 || aoiDims.col == 0)
+    {
+        return;
+    }
+
+    const size_t numBytesPerPixel =
+            mInfos.at(imageNumber)->getData()->getNumBytesPerPixel();
+    if (numRowsPerStrip == 0)
+    {
+        static const size_t DEFAULT_STRIP_SIZE = 32 * 1024 * 1024;
+        numRowsPerStrip = std::max<size_t>(
+                DEFAULT_STRIP_SIZE / (aoiDims.col * numBytesPerPixel), 1);
+    }
+    const size_t numRowsPerBuffer = std::min(numRowsPerStrip, aoiDims.row);
+    std::vector<std::byte> buffers[2];
+    for (auto& buffer : buffers)
+    {
+        buffer.resize(numRowsPerBuffer * aoiDims.col * numBytesPerPixel);
+    }
+
+    const size_t numStrips =
+            (aoiDims.row + numRowsPerStrip - 1) / numRowsPerStrip;
+    const auto read = [&](size_t strip)
+    {
+        const types::RowCol<size_t> offset(strip * numRowsPerStrip, 0);
+        Region region;
+        setOffset(region, aoiOffset + offset);
+        setDims(region, types::RowCol<size_t>(
+                std::min(numRowsPerStrip, aoiDims.row - offset.row),
+                aoiDims.col));
+        region.setBuffer(buffers[strip % 2].data());
+        interleaved(region, imageNumber);
+    };
+    const auto hand = [&](size_t strip)
+    {
+        const types::RowCol<size_t> offset(strip * numRowsPerStrip, 0);
+        const types::RowCol<size_t> dims(
+                std::min(numRowsPerStrip, aoiDims.row - offset.row),
+                aoiDims.col);
+        func(buffers[strip % 2].data(), offset, dims);
+    };
+
+    // Hand each strip off while the next one is read, using the executor's
+    // threads rather than starting one per strip
+    read(0);
+    if (numStrips > 1)
+    {
+        auto executor = Executor::get(std::max<size_t>(getNumThreads(), 2));
+        for (size_t strip = 1; strip < numStrips; ++strip)
+        {
+            executor->parallelFor(2, [&](size_t begin, size_t)
+            {
+                if (begin == 0)
+                {
+                    hand(strip - 1);
+                }
+                else
+                {
+                    read(strip);
+                }
+            });
+        }
+    }
+    hand(numStrips - 1);
+}
+
+size_t NITFReadControl::getNumThreads() const
+{
+    const size_t numThreads =
+            getOptions().getParameter(OPT_NUM_THREADS, Parameter(1));
+    return (numThreads == 0) ? sys::OS().getNumCPUs() : numThreads;
+}
+
 std::unique_ptr<Legend> NITFReadControl::findLegend(size_t productNum)
 {
     std::unique_ptr<Legend> legend;
@@ -789,6 +995,7 @@ void NITFReadControl::reset()
     }
     mInfos.clear();
     mInterface.reset();
+    mPathname.clear();
 }
 
 
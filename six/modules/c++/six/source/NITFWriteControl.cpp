@@ -36,6 +36,7 @@
 #include <gsl/gsl.h>
 #include <str/EncodedStringView.h>
 
+#include <six/Executor.h>
 #include <six/XMLControlFactory.h>
 #include <nitf/IOStreamWriter.hpp>
 
@@ -229,22 +230,22 @@ inline std::span<const std::byte> as_bytes(BufferList::value_type pImageData,
 template<typename T>
 inline std::shared_ptr<NewMemoryWriteHandler> makeWriteHandler(const NITFSegmentInfo& segmentInfo,
     std::span<const T> imageData, const Data& data, bool doByteSwap,
-    ptrdiff_t cutoff) // for eventual use by to_AMP8I_PHS8I()
+    ptrdiff_t cutoff, Executor* pExecutor) // for eventual use by to_AMP8I_PHS8I()
 {
     return std::make_shared<NewMemoryWriteHandler>(segmentInfo,
         imageData, segmentInfo.getFirstRow(), data, doByteSwap,
-        cutoff);
+        cutoff, pExecutor);
 }
 inline std::shared_ptr<NewMemoryWriteHandler> makeWriteHandler(const NITFSegmentInfo& segmentInfo,
     BufferList::value_type pImageData, const Data& data, bool doByteSwap,
-    ptrdiff_t cutoff) // for eventual use by to_AMP8I_PHS8I()
+    ptrdiff_t cutoff, Executor* pExecutor) // for eventual use by to_AMP8I_PHS8I()
 {
     const auto pImageData_ = as_bytes(pImageData, segmentInfo, data);
-    return makeWriteHandler(segmentInfo, pImageData_, data, doByteSwap, cutoff);
+    return makeWriteHandler(segmentInfo, pImageData_, data, doByteSwap, cutoff, pExecutor);
 }
 
 inline std::shared_ptr<StreamWriteHandler> makeWriteHandler(NITFSegmentInfo segmentInfo,
-io::InputStream* imageData, const Data& data, bool doByteSwap, ptrdiff_t)
+io::InputStream* imageData, const Data& data, bool doByteSwap, ptrdiff_t, Executor*)
 {
 //! TODO: This section of code (unlike the memory section above)
 //        does not account for blocked writing or J2K compression.
@@ -255,11 +256,11 @@ return std::make_shared<StreamWriteHandler>(segmentInfo, imageData, data, doByte
 template<typename TImageData>
 void writeWithoutNitro(nitf::Writer& mWriter, const TImageData& imageData,
     const std::vector<NITFSegmentInfo>& imageSegments, size_t startIndex, const Data& data, bool doByteSwap,
-    ptrdiff_t cutoff) // for eventual use by to_AMP8I_PHS8I()
+    ptrdiff_t cutoff, Executor* pExecutor) // for eventual use by to_AMP8I_PHS8I()
 {
     for (size_t j = 0; j < imageSegments.size(); ++j)
     {
-        auto writeHandler = makeWriteHandler(imageSegments[j], imageData, data, doByteSwap, cutoff);
+        auto writeHandler = makeWriteHandler(imageSegments[j], imageData, data, doByteSwap, cutoff, pExecutor);
         mWriter.setImageWriteHandler(static_cast<int>(startIndex + j), writeHandler);
     }
 }
@@ -292,6 +293,7 @@ void NITFWriteControl::save(const SourceList& imageData,
 {
     const bool doByteSwap = do_prepareIO(imageData.size(), outputFile);
     const auto& infos = getInfos();
+    const auto executor = Executor::get(getOptions());
 
     //! TODO: This section of code (unlike the memory section below)
     //        does not account for blocked writing or J2K compression.
@@ -303,7 +305,7 @@ void NITFWriteControl::save(const SourceList& imageData,
         const auto startIndex = info.getStartIndex();
         const six::Data* const pData = info.getData();
 
-        writeWithoutNitro(mWriter, imageData[i], imageSegments, startIndex, *pData, doByteSwap, AMP8I_PHS8I_cutoff());
+        writeWithoutNitro(mWriter, imageData[i], imageSegments, startIndex, *pData, doByteSwap, AMP8I_PHS8I_cutoff(), executor.get());
     }
 
     addDataAndWrite(schemaPaths);
@@ -463,7 +465,8 @@ void NITFWriteControl::write_imageData(const T& imageData, const NITFImageInfo&
     }
     else
     {
-        writeWithoutNitro(mWriter, imageData, imageSegments, startIndex, *pData, doByteSwap, AMP8I_PHS8I_cutoff());
+        const auto executor = Executor::get(getOptions());
+        writeWithoutNitro(mWriter, imageData, imageSegments, startIndex, *pData, doByteSwap, AMP8I_PHS8I_cutoff(), executor.get());
     }
 
     if (legend)
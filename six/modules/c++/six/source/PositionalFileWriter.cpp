@@ -0,0 +1,191 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2016, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <six/PositionalFileWriter.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <std/cstddef>
+
+#include <sys/Conf.h>
+#include <sys/SystemException.h>
+#include <six/Executor.h>
+
+#undef min
+#undef max
+
+namespace
+{
+// Most bytes swapped into scratch and written at a time
+const size_t MAX_SCRATCH_SIZE = 4 * 1024 * 1024;
+
+// There's not enough work in fewer elements than this to be worth handing
+// out to other threads
+const size_t MIN_SWAP_GRAIN_SIZE = 64 * 1024;
+}
+
+namespace six
+{
+PositionalFileWriter::PositionalFileWriter(const std::string& pathname) :
+    mPathname(pathname)
+{
+#if defined(_WIN32)
+    mFile = ::CreateFileA(pathname.c_str(), GENERIC_WRITE,
+                          FILE_SHARE_READ, nullptr,
+                          CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE)
+    {
+        throw sys::SystemException(Ctxt("Unable to open " + pathname));
+    }
+#else
+    mFile = ::open(pathname.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (mFile < 0)
+    {
+        throw sys::SystemException(Ctxt("Unable to open " + pathname));
+    }
+#endif
+}
+
+PositionalFileWriter::~PositionalFileWriter()
+{
+#if defined(_WIN32)
+    ::CloseHandle(mFile);
+#else
+    ::close(mFile);
+#endif
+}
+
+void PositionalFileWriter::writeAt(nitf::Off offset,
+                                   const void* data,
+                                   size_t size) const
+{
+    auto dataPtr = static_cast<const std::byte*>(data);
+    while (size > 0)
+    {
+#if defined(_WIN32)
+        const DWORD toWrite = static_cast<DWORD>(std::min<size_t>(
+                size, std::numeric_limits<DWORD>::max()));
+        OVERLAPPED overlapped = {};
+        overlapped.Offset = static_cast<DWORD>(offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD numWritten = 0;
+        if (!::WriteFile(mFile, dataPtr, toWrite, &numWritten, &overlapped))
+        {
+            throw sys::SystemException(Ctxt("Unable to write " + mPathname));
+        }
+#else
+        const ssize_t numWritten = ::pwrite(mFile, dataPtr, size, offset);
+        if (numWritten < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw sys::SystemException(Ctxt("Unable to write " + mPathname));
+        }
+#endif
+        dataPtr += numWritten;
+        offset += numWritten;
+        size -= numWritten;
+    }
+}
+
+void PositionalFileWriter::writeRows(nitf::Off offset,
+                                     const void* data,
+                                     size_t numRows,
+                                     size_t numBytesPerRow,
+                                     size_t fileRowStride,
+                                     size_t swapElemSize,
+                                     Executor* pExecutor) const
+{
+    if (numRows == 0 || numBytesPerRow == 0)
+    {
+        return;
+    }
+
+    // Full rows are contiguous in the file, so any number of them is one
+    // write; partial rows are one write each
+    const auto write = [&](const std::byte* rows, size_t firstRow,
+                           size_t numRowsToWrite)
+    {
+        const nitf::Off rowOffset = offset +
+                static_cast<nitf::Off>(firstRow * fileRowStride);
+        if (fileRowStride == numBytesPerRow)
+        {
+            writeAt(rowOffset, rows, numRowsToWrite * numBytesPerRow);
+            return;
+        }
+        for (size_t row = 0; row < numRowsToWrite; ++row)
+        {
+            writeAt(rowOffset + static_cast<nitf::Off>(row * fileRowStride),
+                    rows + row * numBytesPerRow,
+                    numBytesPerRow);
+        }
+    };
+
+    const auto imageData = static_cast<const std::byte*>(data);
+    if (swapElemSize < 2)
+    {
+        write(imageData, 0, numRows);
+        return;
+    }
+
+    // Swap a chunk of rows at a time into this thread's scratch buffer so
+    // the caller's data is left alone
+    thread_local std::vector<std::byte> scratch;
+    const auto elemSize = static_cast<unsigned short>(swapElemSize);
+    const size_t rowsPerChunk =
+            std::max<size_t>(MAX_SCRATCH_SIZE / numBytesPerRow, 1);
+    scratch.resize(std::min(rowsPerChunk, numRows) * numBytesPerRow);
+    for (size_t row = 0; row < numRows; row += rowsPerChunk)
+    {
+        const size_t numChunkRows = std::min(rowsPerChunk, numRows - row);
+        const std::byte* const chunk = imageData + row * numBytesPerRow;
+        const size_t numElements = numChunkRows * numBytesPerRow / elemSize;
+        std::byte* const swapped = scratch.data(); // This thread's
+        if (pExecutor)
+        {
+            pExecutor->parallelFor(numElements, [&](size_t begin, size_t end)
+            {
+                sys::byteSwap(chunk + begin * elemSize,
+                              elemSize,
+                              end - begin,
+                              swapped + begin * elemSize);
+            }, MIN_SWAP_GRAIN_SIZE);
+        }
+        else
+        {
+            sys::byteSwap(chunk, elemSize, numElements, swapped);
+        }
+        write(swapped, row, numChunkRows);
+    }
+}
+}
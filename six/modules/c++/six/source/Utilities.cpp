@@ -20,11 +20,29 @@
  *
  */
 
+#include <cctype>
 #include <iomanip>
+#include <limits>
+#include <locale>
 #include <sstream>
 #include <algorithm>
 #include <iterator>
-
+#include <typeinfo>
+#include <coda_oss/CPlusPlus.h>
+#if CODA_OSS_cpp17 && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+// Not every C++17 library has floating point to_chars()/from_chars()
+#if defined(__cpp_lib_to_chars)
+#define SIX_HAVE_TO_CHARS 1
+#else
+#define SIX_HAVE_TO_CHARS 0
+#endif
+
+#include <io/StringStream.h>
 #include <logging/NullLogger.h>
 #include <math/Utilities.h>
 #include <str/EncodedStringView.h>
@@ -85,6 +103,137 @@ void getSensorCovariance(const six::PosVelError& error,
         assign(sensorCovar, 2, 5, error.p3 * error.v3 * corrCoefs.p3v3);
     }
 }
+
+// This thread's stream of type TStream, emptied, that reads and writes
+// numbers the same way whatever the global C or C++ locale is
+template <typename TStream>
+TStream& getClassicStream()
+{
+    thread_local struct ClassicStream final
+    {
+        ClassicStream()
+        {
+            stream.imbue(std::locale::classic());
+        }
+        TStream stream;
+    } classic;
+
+    classic.stream.str(std::string());
+    classic.stream.clear();
+    return classic.stream;
+}
+
+template <typename T>
+std::string toFloatingPointString(T value, bool scientific)
+{
+    constexpr int precision = std::numeric_limits<T>::max_digits10;
+
+#if SIX_HAVE_TO_CHARS
+    // Plenty for the sign, digits, decimal point and exponent
+    char buffer[64];
+    char* const end = std::to_chars(buffer, buffer + sizeof(buffer),
+            value,
+            scientific ? std::chars_format::scientific :
+                         std::chars_format::general,
+            precision).ptr;
+    const std::string formatted(buffer, end);
+#else
+    auto& os = getClassicStream<std::ostringstream>();
+    os << std::setprecision(precision);
+    if (scientific)
+    {
+        os << std::scientific;
+    }
+    else
+    {
+        os.unsetf(std::ios::floatfield);
+    }
+    os << value;
+    const std::string formatted = os.str();
+#endif
+    if (!scientific)
+    {
+        return formatted;
+    }
+
+    // Uppercase, and remove any + in the exponent to meet SICD XML standard
+    std::string retval;
+    retval.reserve(formatted.size());
+    for (const char c : formatted)
+    {
+        if (c != '+')
+        {
+            retval += static_cast<char>(
+                    std::toupper(static_cast<unsigned char>(c)));
+        }
+    }
+    return retval;
+}
+
+// Parses [begin, end) with a stream, setting 'parsed' to just past the
+// number.  Underflow gives whatever the stream does (0 or a subnormal).
+template <typename T>
+bool streamToFloatingPoint(const char* begin, const char* end, T& value,
+                           const char*& parsed)
+{
+    auto& is = getClassicStream<std::istringstream>();
+    is.str(std::string(begin, end));
+    if (!(is >> value))
+    {
+        return false;
+    }
+    parsed = is.eof() ? end : begin + static_cast<ptrdiff_t>(is.tellg());
+    return true;
+}
+
+template <typename T>
+T toFloatingPoint(const std::string& s)
+{
+    // Accept what a stream would: leading whitespace and a sign, then a
+    // number, ignoring anything after it.  Unlike from_chars(), a stream
+    // doesn't take "inf" or "nan", and fails on an exponent without digits.
+    const char* begin = s.c_str();
+    const char* const end = begin + s.size();
+    while (begin != end && std::isspace(static_cast<unsigned char>(*begin)))
+    {
+        ++begin;
+    }
+    const bool isNegative = begin != end && *begin == '-';
+    if (begin != end && *begin == '+')
+    {
+        ++begin;
+    }
+    const char* const digits = isNegative ? begin + 1 : begin;
+
+    T value = 0;
+    bool ok = digits != end &&
+            (std::isdigit(static_cast<unsigned char>(*digits)) ||
+             *digits == '.');
+    if (ok)
+    {
+        const char* parsed = end;
+#if SIX_HAVE_TO_CHARS
+        const auto result = std::from_chars(begin, end, value);
+        parsed = result.ptr;
+        ok = result.ec == std::errc();
+        if (result.ec == std::errc::result_out_of_range)
+        {
+            // A stream only fails on overflow
+            ok = streamToFloatingPoint(begin, end, value, parsed);
+        }
+#else
+        ok = streamToFloatingPoint(begin, end, value, parsed);
+#endif
+        ok = ok && !(parsed != end && (*parsed == 'e' || *parsed == 'E'));
+    }
+
+    if (!ok)
+    {
+        throw except::BadCastException(Ctxt("Conversion failed: '" + s +
+                                             "' -> " + typeid(T).name()));
+    }
+    return value;
+}
 }
 
 using namespace six;
@@ -111,19 +260,8 @@ std::string six::toString<float>(const float& value)
                 Ctxt("Attempted use of uninitialized float value"));
     }
 
-    std::ostringstream os;
-    constexpr size_t precision = std::numeric_limits<float>::max_digits10;
-    os << std::uppercase << std::scientific << std::setprecision(precision)
-       << value;
-    std::string strValue = os.str();
-
-    // remove any + in scientific notation to meet SICD XML standard
-    const size_t plusPos = strValue.find("+");
-    if (plusPos != std::string::npos)
-    {
-        strValue.erase(plusPos, 1);
-    }
-    return strValue;
+    // scientific notation, without the + to meet SICD XML standard
+    return details::toString(value, true /*scientific*/);
 }
 
 template <>
@@ -135,19 +273,38 @@ std::string six::toString<double>(const double& value)
                 Ctxt("Attempted use of uninitialized double value"));
     }
 
-    std::ostringstream os;
-    constexpr size_t precision = std::numeric_limits<double>::max_digits10;
-    os << std::uppercase << std::scientific << std::setprecision(precision)
-       << value;
-    std::string strValue = os.str();
+    // scientific notation, without the + to meet SICD XML standard
+    return details::toString(value, true /*scientific*/);
+}
 
-    // remove any + in scientific notation to meet SICD XML standard
-    const size_t plusPos = strValue.find("+");
-    if (plusPos != std::string::npos)
-    {
-        strValue.erase(plusPos, 1);
-    }
-    return strValue;
+template <>
+float six::toType<float>(const std::string& s)
+{
+    return details::toFloat(s);
+}
+
+template <>
+double six::toType<double>(const std::string& s)
+{
+    return details::toDouble(s);
+}
+
+std::string six::details::toString(double value, bool scientific)
+{
+    return toFloatingPointString(value, scientific);
+}
+std::string six::details::toString(float value, bool scientific)
+{
+    return toFloatingPointString(value, scientific);
+}
+
+double six::details::toDouble(const std::string& s)
+{
+    return toFloatingPoint<double>(s);
+}
+float six::details::toFloat(const std::string& s)
+{
+    return toFloatingPoint<float>(s);
 }
 
 template <>
@@ -586,13 +743,16 @@ std::unique_ptr<Data> six::parseData(const XMLControlRegistry& xmlReg,
     return parseData(xmlReg, xmlStream, DataType::NOT_SET, pSchemaPaths, log);
 }
 
-inline mem::auto_ptr<Data> fromXML_(const xml::lite::Document& doc, XMLControl& xmlControl, const std::vector<std::string>& schemaPaths)
+inline mem::auto_ptr<Data> fromXML_(const xml::lite::Document& doc, const std::string& xml, XMLControl& xmlControl, const std::vector<std::string>& schemaPaths_)
 {
-    return mem::auto_ptr<Data>(xmlControl.fromXML(&doc, schemaPaths));
+    std::vector<std::filesystem::path> schemaPaths;
+    std::transform(schemaPaths_.begin(), schemaPaths_.end(), std::back_inserter(schemaPaths),
+        [](const std::string& s) { return s; });
+    return mem::auto_ptr<Data>(xmlControl.fromXML(doc, xml, &schemaPaths).release());
 }
-inline std::unique_ptr<Data> fromXML_(const xml::lite::Document& doc, XMLControl& xmlControl, const std::vector<std::filesystem::path>* pSchemaPaths)
+inline std::unique_ptr<Data> fromXML_(const xml::lite::Document& doc, const std::string& xml, XMLControl& xmlControl, const std::vector<std::filesystem::path>* pSchemaPaths)
 {
-    return xmlControl.fromXML(doc, pSchemaPaths);
+    return xmlControl.fromXML(doc, xml, pSchemaPaths);
 }
 template<typename TReturn, typename TSchemaPaths>
 TReturn six_parseData(const XMLControlRegistry& xmlReg,
@@ -601,10 +761,16 @@ TReturn six_parseData(const XMLControlRegistry& xmlReg,
                                    const TSchemaPaths& schemaPaths,
                                    logging::Logger& log)
 {
+    // Hang on to the XML as read so it can be validated as is, rather than
+    // re-serializing the DOM
+    io::StringStream xmlBytes;
+    xmlStream.streamTo(xmlBytes);
+    const std::string xml = xmlBytes.stream().str();
+
     six::MinidomParser xmlParser;
     try
     {
-        xmlParser.parse(xmlStream);
+        xmlParser.parse(xmlBytes);
     }
     catch (const except::Throwable& ex)
     {
@@ -630,7 +796,7 @@ TReturn six_parseData(const XMLControlRegistry& xmlReg,
 
     //! Create the correct type of XMLControl
     const std::unique_ptr<XMLControl> xmlControl(xmlReg.newXMLControl(xmlDataType, &log));
-    return fromXML_(doc, *xmlControl, schemaPaths);
+    return fromXML_(doc, xml, *xmlControl, schemaPaths);
 }
 mem::auto_ptr<Data> six::parseData(const XMLControlRegistry& xmlReg,
     ::io::InputStream& xmlStream,
@@ -25,7 +25,11 @@
 #include <std/filesystem>
 #include <algorithm>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
 
+#include <io/StringStream.h>
 #include <logging/NullLogger.h>
 #include <six/XMLControl.h>
 #include <six/Utilities.h>
@@ -143,27 +147,116 @@ static std::vector<TPath> check_whether_paths_exist(const std::vector<TPath>& pa
     return exist_paths;
 }
 
-//  NOTE: Errors are treated as detriments to valid processing
-//        and fail accordingly
-template<typename TPath>
-static void do_validate_(const xml::lite::Document& doc,
-    const std::vector<TPath>& paths, logging::Logger* log)
+namespace
 {
-    // validate against any specified schemas
-    xml::lite::Validator validator(paths, log, true);
+// Loading and compiling the schemas costs far more than validating against
+// them, so validators are kept for the life of the process, keyed by their
+// schema paths; the grammar pool covers every URI those schemas define.  A
+// validator can only check one document at a time, so each key has a pool of
+// idle validators that grows to the most threads validating at once.
+class ValidatorCache final
+{
+    using Key = std::vector<std::string>;
+    using ValidatorPtr = std::unique_ptr<xml::lite::Validator>;
 
-    const auto& rootElement = doc.getRootElement();
-    if (rootElement->getUri().empty())
+    std::mutex mMutex;
+    std::map<Key, std::vector<ValidatorPtr> > mIdle;
+
+    template<typename TPath>
+    static Key makeKey(const std::vector<TPath>& paths)
     {
-        throw six::DESValidationException(Ctxt("INVALID XML: URI is empty so document version cannot be determined to use for validation"));
+        Key key;
+        for (const auto& path : paths)
+        {
+            key.push_back(fs::absolute(fs::path(path)).lexically_normal().string());
+        }
+        return key;
     }
 
-    // Pretty-print so that lines numbers are useful
-    io::U8StringStream xmlStream;
-    rootElement->prettyPrint(xmlStream);
+    void release(Key&& key, ValidatorPtr&& validator) noexcept
+    {
+        try
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mIdle[std::move(key)].push_back(std::move(validator));
+        }
+        catch (...)
+        {
+            // Out of memory; this one just won't be reused
+        }
+    }
+
+public:
+    //! A validator checked out of the cache, which goes back when this does
+    class Lease final
+    {
+        ValidatorCache& mCache;
+        Key mKey;
+        ValidatorPtr mValidator;
+
+    public:
+        Lease(ValidatorCache& cache, Key&& key, ValidatorPtr&& validator) :
+            mCache(cache), mKey(std::move(key)), mValidator(std::move(validator))
+        {
+        }
+        ~Lease()
+        {
+            mCache.release(std::move(mKey), std::move(mValidator));
+        }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
 
+        const xml::lite::Validator& operator*() const
+        {
+            return *mValidator;
+        }
+    };
+
+    static ValidatorCache& getInstance()
+    {
+        static ValidatorCache instance;
+        return instance;
+    }
+
+    template<typename TPath>
+    Lease acquire(const std::vector<TPath>& paths, logging::Logger* log)
+    {
+        Key key = makeKey(paths);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            auto iter = mIdle.find(key);
+            if (iter != mIdle.end() && !iter->second.empty())
+            {
+                ValidatorPtr validator = std::move(iter->second.back());
+                iter->second.pop_back();
+                return Lease(*this, std::move(key), std::move(validator));
+            }
+        }
+
+        // Compile without holding the lock so other keys aren't held up
+        ValidatorPtr validator(new xml::lite::Validator(paths, log, true));
+        return Lease(*this, std::move(key), std::move(validator));
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIdle.clear();
+    }
+};
+}
+
+//  NOTE: Errors are treated as detriments to valid processing
+//        and fail accordingly
+template<typename TPath, typename TValidate>
+static void do_validate_(const std::vector<TPath>& paths,
+    logging::Logger* log, TValidate validate)
+{
     std::vector<xml::lite::ValidationInfo> errors;
-    validator.validate(xmlStream, rootElement->getUri(), errors);
+    {
+        const auto validator = ValidatorCache::getInstance().acquire(paths, log);
+        validate(*validator, errors);
+    }
 
     // log any error found and throw
     if (!errors.empty())
@@ -184,9 +277,56 @@ static void do_validate_(const xml::lite::Document& doc,
         throw six::DESValidationException(Ctxt("INVALID XML: Check both the XML being produced and the schemas available"));
     }
 }
+static void checkURI(const std::string& uri)
+{
+    if (uri.empty())
+    {
+        throw six::DESValidationException(Ctxt("INVALID XML: URI is empty so document version cannot be determined to use for validation"));
+    }
+}
+template<typename TPath>
+static void do_validate_(const xml::lite::Document& doc,
+    const std::vector<TPath>& paths, logging::Logger* log)
+{
+    const auto& rootElement = doc.getRootElement();
+    const auto uri = rootElement->getUri();
+    checkURI(uri);
+
+    // Pretty-print so that lines numbers are useful
+    io::U8StringStream xmlStream;
+    rootElement->prettyPrint(xmlStream);
+
+    do_validate_(paths, log, [&](const xml::lite::Validator& validator,
+                                 std::vector<xml::lite::ValidationInfo>& errors)
+    {
+        validator.validate(xmlStream, uri, errors);
+    });
+}
 template<typename TPath>
-static void validate_(const xml::lite::Document& doc,
-    std::vector<TPath> paths, logging::Logger* log)
+static void do_validate_(const std::string& xml, const std::string& uri,
+    const std::vector<TPath>& paths, logging::Logger* log)
+{
+    checkURI(uri);
+
+    // DES data may be padded out with NULs, which aren't XML
+    const auto end = xml.find_last_not_of('\0') + 1; // npos + 1 == 0
+    std::string trimmed;
+    const std::string* pXml = &xml;
+    if (end != xml.size())
+    {
+        trimmed = xml.substr(0, end);
+        pXml = &trimmed;
+    }
+
+    do_validate_(paths, log, [&](const xml::lite::Validator& validator,
+                                 std::vector<xml::lite::ValidationInfo>& errors)
+    {
+        validator.validate(*pXml, uri, errors);
+    });
+}
+template<typename TPath, typename... TArgs>
+static void validate_(std::vector<TPath> paths, logging::Logger* log,
+    const TArgs&... args)
 {
     // If the paths we have don't exist, throw
     paths = check_whether_paths_exist(paths);
@@ -194,7 +334,7 @@ static void validate_(const xml::lite::Document& doc,
     // validate against any specified schemas
     if (!paths.empty())
     {
-        do_validate_(doc, paths, log);
+        do_validate_(args..., paths, log);
     }
 }
 void XMLControl::validate(const xml::lite::Document* doc,
@@ -218,7 +358,7 @@ void XMLControl::validate(const xml::lite::Document* doc,
     }
 
     // validate against any specified schemas
-    validate_(*doc, paths, log);
+    validate_(paths, log, *doc);
 }
 void XMLControl::validate(const xml::lite::Document& doc,
     const std::vector<std::filesystem::path>* pSchemaPaths,
@@ -236,7 +376,29 @@ void XMLControl::validate(const xml::lite::Document& doc,
     }
 
     // validate against any specified schemas
-    validate_(doc, paths, log);
+    validate_(paths, log, doc);
+}
+void XMLControl::validate(const std::string& xml, const std::string& uri,
+    const std::vector<std::filesystem::path>* pSchemaPaths,
+    logging::Logger* log)
+{
+    // attempt to get the schema location from the environment if nothing is specified
+    auto paths = loadSchemaPaths(pSchemaPaths);
+    if ((log != nullptr) && (pSchemaPaths != nullptr) && paths.empty())
+    {
+        std::ostringstream oss;
+        oss << "Coudn't validate XML - no schemas paths provided "
+            << " and " << six::SCHEMA_PATH << " not set.";
+
+        log->warn(oss.str());
+    }
+
+    // validate against any specified schemas
+    validate_(paths, log, xml, uri);
+}
+void XMLControl::clearSchemaCache()
+{
+    ValidatorCache::getInstance().clear();
 }
 
 std::string XMLControl::getDefaultURI(const Data& data)
@@ -305,6 +467,28 @@ std::unique_ptr<xml::lite::Document> XMLControl::toXML(
     validate(*doc, pSchemaPaths, mLog);
     return doc;
 }
+void XMLControl::toXML(const Data& data, io::OutputStream& os,
+    const std::vector<std::filesystem::path>* pSchemaPaths)
+{
+    if (loadSchemaPaths(pSchemaPaths).empty())
+    {
+        // Nothing to validate against, so straight to the output
+        toXMLImpl(data, os);
+        return;
+    }
+
+    io::StringStream xmlStream;
+    toXMLImpl(data, xmlStream);
+    const auto xml = xmlStream.stream().str();
+    validate(xml, getDefaultURI(data), pSchemaPaths, mLog);
+    os.write(xml);
+}
+
+void XMLControl::toXMLImpl(const Data& data, io::OutputStream& os) const
+{
+    const auto doc = toXMLImpl(data);
+    doc->getRootElement()->print(os);
+}
 
 std::unique_ptr<Data> XMLControl::fromXMLImpl(const xml::lite::Document& doc) const
 {
@@ -332,6 +516,15 @@ std::unique_ptr<Data> XMLControl::fromXML(const xml::lite::Document& doc,
     data->setVersion(getVersionFromURI(&doc));
     return data;
 }
+std::unique_ptr<Data> XMLControl::fromXML(const xml::lite::Document& doc,
+    const std::string& xml,
+    const std::vector<std::filesystem::path>* pSchemaPaths)
+{
+    validate(xml, doc.getRootElement()->getUri(), pSchemaPaths, mLog);
+    auto data = fromXMLImpl(doc);
+    data->setVersion(getVersionFromURI(&doc));
+    return data;
+}
 
 std::string XMLControl::dataTypeToString(DataType dataType, bool appendXML)
 {
@@ -93,9 +93,8 @@ std::string six::toXMLString_(const Data* data,
     return str::EncodedStringView(result).native();
 }
 
-template<typename TSchemaPaths>
-std::u8string six_toValidXMLString(const Data& data,
-    const TSchemaPaths& schemaPaths,
+static std::u8string six_toValidXMLString(const Data& data,
+    const std::vector<std::filesystem::path>* pSchemaPaths,
     logging::Logger* log, const six::XMLControlRegistry* xmlRegistry)
 {
     if (!xmlRegistry)
@@ -106,12 +105,10 @@ std::u8string six_toValidXMLString(const Data& data,
     const std::unique_ptr<XMLControl>
         xmlControl(xmlRegistry->newXMLControl(data.getDataType(), log));
 
-    // this will validate if SIX_SCHEMA_PATH EnvVar is set
-    const std::unique_ptr<xml::lite::Document> doc(
-        xmlControl->toXML(data, schemaPaths));
-
+    // Written without building the whole DOM; this will validate if
+    // SIX_SCHEMA_PATH EnvVar is set
     io::U8StringStream oss;
-    getRootElement(*doc).print(oss);
+    xmlControl->toXML(data, oss, pSchemaPaths);
 
     return oss.stream().str();
 }
@@ -127,7 +124,9 @@ std::u8string six::toValidXMLString(const Data& data,
     const std::vector<std::string>& schemaPaths,
     logging::Logger* log, const six::XMLControlRegistry* xmlRegistry)
 {
-    return six_toValidXMLString(data, schemaPaths, log, xmlRegistry);
+    // Unlike a NULL pointer, an empty vector means the default schema path
+    const std::vector<std::filesystem::path> paths(schemaPaths.begin(), schemaPaths.end());
+    return six_toValidXMLString(data, &paths, log, xmlRegistry);
 }
 std::u8string six::toValidXMLString(const Data& data,
     const std::vector<std::filesystem::path>* pSchemaPaths,
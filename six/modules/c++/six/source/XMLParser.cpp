@@ -23,7 +23,9 @@
 
 #include <assert.h>
 
+#include <functional>
 #include <string>
+#include <vector>
 
 #include <nitf/coda-oss.hpp>
 #include <except/Exception.h>
@@ -36,6 +38,37 @@
 namespace
 {
 typedef xml::lite::Element* XMLElem;
+
+// What XMLParser::splitBlock() makes; writeBlocks() looks for it so it
+// can print each piece as soon as it's been added.
+struct SplitBlock final
+{
+    std::function<void(XMLElem)> addElement;
+    std::vector<std::function<void(XMLElem)>> addChildren;
+
+    void operator()(XMLElem root) const
+    {
+        addElement(root);
+        const auto element = root->getChildren().back();
+        for (const auto& add : addChildren)
+        {
+            add(element);
+        }
+    }
+};
+
+// "<qname attr=\"value\" ..." as xml::lite::Element::print() writes it
+std::string startTag(const xml::lite::Element& element)
+{
+    std::string retval = "<" + element.getQName();
+    const xml::lite::Attributes& attributes = element.getAttributes();
+    for (int ii = 0; ii < attributes.getLength(); ++ii)
+    {
+        retval += " " + attributes.getQName(ii) + "=\"" +
+                attributes.getValue(ii) + "\"";
+    }
+    return retval;
+}
 }
 
 namespace six
@@ -206,6 +239,113 @@ XMLElem XMLParser::require(XMLElem element, const std::string& name)
     return & XmlLite::require(element, name);
 }
 
+std::unique_ptr<xml::lite::Document> XMLParser::blocksToXML(const std::string& rootName,
+    const std::vector<XMLBlock>& blocks, const XMLBlock& setNamespaces) const
+{
+    std::unique_ptr<xml::lite::Document> doc(new xml::lite::Document());
+    XMLElem root = newElement(rootName);
+    doc->setRootElement(root);
+
+    for (const auto& block : blocks)
+    {
+        block(root);
+    }
+    setNamespaces(root);
+    return doc;
+}
+
+XMLParser::XMLBlock XMLParser::splitBlock(const XMLBlock& addElement,
+    const std::vector<XMLBlock>& addChildren)
+{
+    return SplitBlock{ addElement, addChildren };
+}
+
+void XMLParser::writeBlocks(io::OutputStream& os, const std::string& rootName,
+    const std::vector<XMLBlock>& blocks, const XMLBlock& setNamespaces) const
+{
+    // The root's name and namespace declarations don't depend on what's
+    // under it, so an empty root is enough for its tags.
+    const std::unique_ptr<xml::lite::Element> root(newElement(rootName));
+    setNamespaces(root.get());
+    const std::string openTag = startTag(*root);
+
+    bool isEmpty = true;
+    const auto startRoot = [&]()
+    {
+        if (isEmpty)
+        {
+            os.write(openTag + ">");
+            isEmpty = false;
+        }
+    };
+
+    for (const auto& block : blocks)
+    {
+        // setNamespaces() also sets the prefixes of everything under the
+        // root, so each block gets a root of its own to have that done.
+        const std::unique_ptr<xml::lite::Element> blockRoot(newElement(rootName));
+        const auto pSplit = block.target<SplitBlock>();
+        if (pSplit == nullptr)
+        {
+            block(blockRoot.get());
+            setNamespaces(blockRoot.get());
+            for (const auto child : blockRoot->getChildren())
+            {
+                startRoot();
+                child->print(os);
+            }
+            continue;
+        }
+
+        // Print the element's start tag and what addElement put under it,
+        // then each of the later pieces under a stand-in for the element,
+        // freeing each piece before the next one is made.
+        pSplit->addElement(blockRoot.get());
+        setNamespaces(blockRoot.get());
+        const xml::lite::Element& element = *(blockRoot->getChildren().back());
+        startRoot();
+        const std::string elementTag = startTag(element);
+        bool isElementEmpty = true;
+        const auto startElement = [&]()
+        {
+            if (isElementEmpty)
+            {
+                os.write(elementTag + ">");
+                isElementEmpty = false;
+            }
+        };
+
+        std::u8string characterData;
+        if (!element.getCharacterData(characterData).empty())
+        {
+            startElement();
+            os.write(characterData);
+        }
+        const auto printChildren = [&](const xml::lite::Element& parent)
+        {
+            for (const auto child : parent.getChildren())
+            {
+                startElement();
+                child->print(os);
+            }
+        };
+        printChildren(element);
+
+        for (const auto& add : pSplit->addChildren)
+        {
+            const std::unique_ptr<xml::lite::Element> childRoot(newElement(rootName));
+            const auto standIn = newElement(element.getLocalName(), element.getUri(), childRoot.get());
+            add(standIn);
+            setNamespaces(childRoot.get());
+            printChildren(*standIn);
+        }
+
+        os.write(isElementEmpty ? elementTag + "/>" : "</" + element.getQName() + ">");
+    }
+
+    os.write(isEmpty ? openTag + "/>" : "</" + root->getQName() + ">");
+}
+
 bool XMLParser::parseDouble(const xml::lite::Element& element, double& value) const
 {
     return mXmlLite.parseDouble(element, value);
@@ -248,7 +248,9 @@ xml::lite::Element& XmlLite::createInt_(const std::string& name, int p, xml::lit
 xml::lite::Element& XmlLite::createDouble(const xml::lite::QName& name, double p, xml::lite::Element& parent) const
 {
     p = value(p); // be sure this is initialized; throws if not
-    return createValue(name, p, parent, mAddClassAttributes, "xs:double", getDefaultURI());
+    const auto toString = [](double v) { return details::toString(v, false /*scientific*/); };
+    return createValue(name, p, parent, mAddClassAttributes, "xs:double", getDefaultURI(),
+        toString);
 }
 xml::lite::Element& XmlLite::createDouble(const xml::lite::QName& name, const std::optional<double>& p, xml::lite::Element& parent) const
 {
@@ -366,7 +368,7 @@ bool XmlLite::parseDouble(const xml::lite::Element& element, double& value) cons
 {
     value = Init::undefined<double>();
     const auto getValue = [&]() {
-        value = xml::lite::getValue<double>(element);
+        value = xml::lite::castValue(element, details::toDouble);
         assert(Init::isDefined(value)); };
     return parseValue(mLogger.get(), getValue);
 }
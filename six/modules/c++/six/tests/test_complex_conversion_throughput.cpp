@@ -0,0 +1,163 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2014, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Microbenchmark for the complex<float> conversion kernels
+// Converts a buffer of complex<int8_t>, complex<int16_t>, and complex<float>
+// with every kernel the CPU supports, with and without byte swapping and
+// scaling, and reports throughput in GB/s of complex<float> produced.
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <std/cstddef>
+
+#include <six/ComplexConversion.h>
+#include <import/cli.h>
+#include <import/except.h>
+
+namespace
+{
+double timeConversion(const std::vector<std::byte>& input,
+                      size_t elementSize,
+                      size_t numPixels,
+                      bool byteSwap,
+                      bool scale,
+                      six::ConversionKernel kernel,
+                      size_t numTrials,
+                      std::vector<std::complex<float> >& output)
+{
+    double bestSec = 0.0;
+    for (size_t trial = 0; trial < numTrials; ++trial)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        if (scale)
+        {
+            six::scaleToComplexFloat(input.data(), elementSize, numPixels,
+                                     byteSwap, 0.5, output.data(), kernel);
+        }
+        else
+        {
+            six::promoteToComplexFloat(input.data(), elementSize, numPixels,
+                                       byteSwap, output.data(), kernel);
+        }
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double sec = std::chrono::duration<double>(stop - start).count();
+        bestSec = (trial == 0) ? sec : std::min(bestSec, sec);
+    }
+
+    return (numPixels * sizeof(std::complex<float>)) / bestSec / 1e9;
+}
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        cli::ArgumentParser parser;
+        parser.setDescription("Reports the throughput of each complex<float> "
+                              "conversion kernel");
+        parser.addArgument("--pixels", "Number of pixels to convert",
+                           cli::STORE, "pixels", "INT")->setDefault(1 << 24);
+        parser.addArgument("--trials", "Best of this many conversions is "
+                           "reported", cli::STORE, "trials", "INT")->
+                setDefault(5);
+        std::unique_ptr<cli::Results> options(parser.parse(argc, argv));
+
+        const size_t numPixels = options->get<size_t>("pixels");
+        const size_t numTrials =
+                std::max<size_t>(options->get<size_t>("trials"), 1);
+
+        const six::ConversionKernel kernels[] = {
+                six::ConversionKernel::Scalar, six::ConversionKernel::SSE2,
+                six::ConversionKernel::AVX2, six::ConversionKernel::AVX512};
+
+        std::cout << "Best kernel on this machine: "
+                  << six::toString(six::getBestConversionKernel()) << "\n"
+                  << "GB/s of complex<float> output for " << numPixels
+                  << " pixels\n\n";
+
+        std::vector<std::complex<float> > output(numPixels);
+        for (const size_t elementSize : {2, 4, 8})
+        {
+            // Byte-swapped zeros are still zeros, so this is fair to every
+            // combination
+            const std::vector<std::byte> input(elementSize * numPixels);
+
+            std::cout << "complex<"
+                      << (elementSize == 2 ? "int8_t" :
+                          elementSize == 4 ? "int16_t" : "float")
+                      << ">\n";
+            std::cout << std::setw(10) << "kernel" << std::setw(12)
+                      << "promote" << std::setw(12) << "+swap"
+                      << std::setw(12) << "scale" << std::setw(12)
+                      << "+swap" << "\n";
+
+            for (const auto kernel : kernels)
+            {
+                if (!six::isSupported(kernel))
+                {
+                    continue;
+                }
+
+                std::cout << std::setw(10) << six::toString(kernel)
+                          << std::fixed << std::setprecision(2);
+                for (const bool scale : {false, true})
+                {
+                    for (const bool byteSwap : {false, true})
+                    {
+                        std::cout << std::setw(12)
+                                  << timeConversion(input, elementSize,
+                                                    numPixels, byteSwap,
+                                                    scale, kernel, numTrials,
+                                                    output);
+                    }
+                }
+                std::cout << "\n";
+            }
+            std::cout << "\n";
+        }
+
+        return 0;
+    }
+    catch (const except::Exception& ex)
+    {
+        std::cerr << "Caught except::Exception: " << ex.getMessage()
+                  << std::endl;
+        return 1;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "Caught std::exception: " << ex.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "Caught unknown exception\n";
+        return 1;
+    }
+}
@@ -0,0 +1,157 @@
+/* =========================================================================
+* This file is part of six-c++
+* =========================================================================
+*
+* (C) Copyright 2004 - 2018, MDA Information Systems LLC
+*
+* six-c++ is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation; either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this program; If not,
+* see <http://www.gnu.org/licenses/>.
+*
+*/
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <complex>
+#include <vector>
+#include <std/cstddef>
+
+#include "TestCase.h"
+#include <sys/Conf.h>
+#include <six/ComplexConversion.h>
+
+namespace
+{
+const six::ConversionKernel KERNELS[] = {six::ConversionKernel::SSE2,
+                                         six::ConversionKernel::AVX2,
+                                         six::ConversionKernel::AVX512};
+
+// Odd sizes so every kernel has leftover pixels to handle
+const size_t NUM_PIXELS[] = {0, 1, 3, 7, 8, 15, 16, 17, 33, 1001};
+
+// One extra byte up front so the input is never aligned
+std::vector<std::byte> getRandomInput(size_t elementSize,
+                                      size_t numPixels,
+                                      bool byteSwap)
+{
+    std::vector<std::byte> input(1 + elementSize * numPixels);
+    if (elementSize == 8)
+    {
+        // Random bits may not be a valid float
+        for (size_t ii = 0; ii < 2 * numPixels; ++ii)
+        {
+            float value = static_cast<float>(rand() % 200001 - 100000) / 7;
+            if (byteSwap)
+            {
+                sys::byteSwap(&value, sizeof(value), 1);
+            }
+            memcpy(&input[1 + ii * sizeof(value)], &value, sizeof(value));
+        }
+    }
+    else
+    {
+        for (auto& byte : input)
+        {
+            byte = static_cast<std::byte>(rand());
+        }
+    }
+    return input;
+}
+
+// Every kernel must match the scalar one bit for bit
+bool kernelsMatch(size_t elementSize, bool byteSwap, bool scale)
+{
+    static const double SCALE_FACTOR = 0.1234567;
+    for (const size_t numPixels : NUM_PIXELS)
+    {
+        const std::vector<std::byte> input =
+                getRandomInput(elementSize, numPixels, byteSwap);
+
+        auto convert = [&](six::ConversionKernel kernel)
+        {
+            std::vector<std::complex<float> > output(numPixels);
+            if (scale)
+            {
+                six::scaleToComplexFloat(&input[1], elementSize, numPixels,
+                                         byteSwap, SCALE_FACTOR,
+                                         output.data(), kernel);
+            }
+            else
+            {
+                six::promoteToComplexFloat(&input[1], elementSize, numPixels,
+                                           byteSwap, output.data(), kernel);
+            }
+            return output;
+        };
+
+        const auto expected = convert(six::ConversionKernel::Scalar);
+        for (const auto kernel : KERNELS)
+        {
+            if (six::isSupported(kernel) &&
+                memcmp(convert(kernel).data(), expected.data(),
+                       numPixels * sizeof(expected[0])) != 0)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+}
+
+TEST_CASE(testScalarPromote)
+{
+    const std::complex<int16_t> input[] = {{1, -2}, {-32768, 32767}};
+    std::complex<float> output[2];
+    six::promoteToComplexFloat(input, sizeof(input[0]), 2, false, output,
+                               six::ConversionKernel::Scalar);
+    TEST_ASSERT_EQ(output[0], std::complex<float>(1, -2));
+    TEST_ASSERT_EQ(output[1], std::complex<float>(-32768, 32767));
+
+    // 0x0100 byte swapped is 1
+    const int16_t swapped[] = {0x0100, static_cast<int16_t>(0xFFFF)};
+    six::scaleToComplexFloat(swapped, sizeof(swapped), 1, true, 0.5, output,
+                             six::ConversionKernel::Scalar);
+    TEST_ASSERT_EQ(output[0], std::complex<float>(0.5f, -0.5f));
+}
+
+TEST_CASE(testKernelsMatch)
+{
+    for (const size_t elementSize : {2, 4, 8})
+    {
+        for (const bool byteSwap : {false, true})
+        {
+            TEST_ASSERT(kernelsMatch(elementSize, byteSwap, false));
+            TEST_ASSERT(kernelsMatch(elementSize, byteSwap, true));
+        }
+    }
+}
+
+TEST_CASE(testSupport)
+{
+    TEST_ASSERT(six::isSupported(six::ConversionKernel::Scalar));
+    TEST_ASSERT(six::isSupported(six::getBestConversionKernel()));
+
+    std::complex<float> output;
+    const std::complex<double> input;
+    TEST_EXCEPTION(six::promoteToComplexFloat(&input, sizeof(input), 1,
+                                              false, &output));
+}
+
+TEST_MAIN(
+    srand(static_cast<unsigned int>(time(nullptr)));
+    TEST_CHECK(testScalarPromote);
+    TEST_CHECK(testKernelsMatch);
+    TEST_CHECK(testSupport);
+)
@@ -0,0 +1,181 @@
+/* =========================================================================
+* This file is part of six-c++
+* =========================================================================
+*
+* (C) Copyright 2004 - 2018, MDA Information Systems LLC
+*
+* six-c++ is free software; you can redistribute it and/or modify
+* it under the terms of the GNU Lesser General Public License as published by
+* the Free Software Foundation; either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU Lesser General Public License for more details.
+*
+* You should have received a copy of the GNU Lesser General Public
+* License along with this program; If not,
+* see <http://www.gnu.org/licenses/>.
+*
+*/
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "TestCase.h"
+#include <sys/Conf.h>
+#include <except/Exception.h>
+#include <six/Executor.h>
+#include <six/Options.h>
+
+namespace
+{
+// Every element must be visited exactly once
+bool coversRange(six::Executor& executor, size_t size, size_t minGrainSize)
+{
+    std::vector<std::atomic<int> > counts(size);
+    for (auto& count : counts)
+    {
+        count = 0;
+    }
+
+    executor.parallelFor(size, [&](size_t begin, size_t end)
+    {
+        for (size_t ii = begin; ii < end; ++ii)
+        {
+            ++counts[ii];
+        }
+    }, minGrainSize);
+
+    for (const auto& count : counts)
+    {
+        if (count != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+TEST_CASE(testParallelFor)
+{
+    for (const size_t numThreads : {1, 2, 3, 8})
+    {
+        six::Executor executor(numThreads);
+        TEST_ASSERT_EQ(executor.getNumThreads(), numThreads);
+        for (const size_t size : {0, 1, 7, 100, 10007})
+        {
+            TEST_ASSERT(coversRange(executor, size, 1));
+            TEST_ASSERT(coversRange(executor, size, 64));
+        }
+    }
+}
+
+TEST_CASE(testGrainSize)
+{
+    six::Executor executor(4);
+    TEST_ASSERT_EQ(executor.getGrainSize(1600), static_cast<size_t>(100));
+    TEST_ASSERT_EQ(executor.getGrainSize(1600, 500), static_cast<size_t>(500));
+    TEST_ASSERT_EQ(executor.getGrainSize(0), static_cast<size_t>(1));
+
+    six::Executor serial(1);
+    TEST_ASSERT_EQ(serial.getGrainSize(1600), static_cast<size_t>(1600));
+}
+
+TEST_CASE(testTransform)
+{
+    six::Executor executor(4);
+    std::vector<int> input(12345);
+    for (size_t ii = 0; ii < input.size(); ++ii)
+    {
+        input[ii] = static_cast<int>(ii);
+    }
+    std::vector<int> output(input.size());
+    executor.transform(input.begin(), input.end(), output.begin(),
+                       [](int value) { return value * 2; });
+    for (size_t ii = 0; ii < output.size(); ++ii)
+    {
+        TEST_ASSERT_EQ(output[ii], static_cast<int>(ii * 2));
+    }
+}
+
+TEST_CASE(testNested)
+{
+    // Waiting threads do other work, so this can't deadlock even with more
+    // outer pieces than threads
+    six::Executor executor(3);
+    std::atomic<size_t> total(0);
+    executor.parallelFor(50, [&](size_t begin, size_t end)
+    {
+        for (size_t ii = begin; ii < end; ++ii)
+        {
+            executor.parallelFor(100, [&](size_t innerBegin, size_t innerEnd)
+            {
+                total += innerEnd - innerBegin;
+            });
+        }
+    });
+    TEST_ASSERT_EQ(total.load(), static_cast<size_t>(5000));
+}
+
+TEST_CASE(testException)
+{
+    six::Executor executor(4);
+    std::atomic<size_t> numRun(0);
+    TEST_EXCEPTION(executor.parallelFor(1000, [&](size_t begin, size_t)
+    {
+        ++numRun;
+        if (begin == 0)
+        {
+            throw except::Exception(Ctxt("first piece"));
+        }
+    }));
+
+    // All of the pieces still ran, and the executor is still usable
+    TEST_ASSERT_EQ(numRun.load(), static_cast<size_t>(16));
+    TEST_ASSERT(coversRange(executor, 1000, 1));
+}
+
+TEST_CASE(testOptions)
+{
+    six::Options options;
+    TEST_ASSERT(six::Executor::get(options) == six::Executor::get());
+
+    options.setParameter(six::Executor::OPT_NUM_THREADS, 3);
+    const auto sized = six::Executor::get(options);
+    TEST_ASSERT_EQ(sized->getNumThreads(), static_cast<size_t>(3));
+    TEST_ASSERT(six::Executor::get(options) == sized);
+
+    const auto supplied = std::make_shared<six::Executor>(2);
+    options.setExecutor(supplied);
+    TEST_ASSERT(six::Executor::get(options) == supplied);
+}
+
+TEST_CASE(testCacheIsBounded)
+{
+    // Asking for lots of sizes doesn't keep all of their threads around
+    std::weak_ptr<six::Executor> first = six::Executor::get(21);
+    TEST_ASSERT(six::Executor::get(21) == first.lock());
+    for (size_t numThreads = 22; numThreads < 30; ++numThreads)
+    {
+        TEST_ASSERT_EQ(six::Executor::get(numThreads)->getNumThreads(),
+                       numThreads);
+    }
+    TEST_ASSERT(first.expired());
+
+    // The most recently used one is still shared
+    const auto last = six::Executor::get(29);
+    TEST_ASSERT(six::Executor::get(29) == last);
+}
+
+TEST_MAIN(
+    TEST_CHECK(testParallelFor);
+    TEST_CHECK(testGrainSize);
+    TEST_CHECK(testTransform);
+    TEST_CHECK(testNested);
+    TEST_CHECK(testException);
+    TEST_CHECK(testOptions);
+    TEST_CHECK(testCacheIsBounded);
+)
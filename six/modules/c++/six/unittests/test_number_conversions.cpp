@@ -0,0 +1,243 @@
+/* =========================================================================
+ * This file is part of six-c++
+ * =========================================================================
+ *
+ * (C) Copyright 2004 - 2020, MDA Information Systems LLC
+ *
+ * six-c++ is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program; If not,
+ * see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <string.h>
+
+#include <clocale>
+#include <iomanip>
+#include <limits>
+#include <locale>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <str/Convert.h>
+#include <six/Utilities.h>
+#include "TestCase.h"
+
+namespace
+{
+// How six::toString() used to do it
+template <typename T>
+std::string toScientificString(T value)
+{
+    std::ostringstream os;
+    os << std::uppercase << std::scientific
+       << std::setprecision(std::numeric_limits<T>::max_digits10) << value;
+    std::string strValue = os.str();
+    const size_t plusPos = strValue.find("+");
+    if (plusPos != std::string::npos)
+    {
+        strValue.erase(plusPos, 1);
+    }
+    return strValue;
+}
+
+// Random bits cover every exponent, subnormals included, plus the usual
+// suspects
+template <typename T, typename TBits>
+std::vector<T> makeValues()
+{
+    std::vector<T> values = {
+        0, -static_cast<T>(0), 1, -1, static_cast<T>(0.1),
+        static_cast<T>(1.0 / 3), static_cast<T>(123456789012345678.0),
+        std::numeric_limits<T>::min(), std::numeric_limits<T>::max(),
+        std::numeric_limits<T>::lowest(), std::numeric_limits<T>::epsilon(),
+        std::numeric_limits<T>::denorm_min()};
+
+    std::mt19937_64 generator(334);
+    while (values.size() < 20000)
+    {
+        const auto bits = static_cast<TBits>(generator());
+        T value;
+        memcpy(&value, &bits, sizeof(value));
+        if (std::isfinite(value))
+        {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+template <typename T>
+bool isSame(T lhs, T rhs)
+{
+    return memcmp(&lhs, &rhs, sizeof(lhs)) == 0;
+}
+
+// Writes 1234.5 as "1.234,5"
+struct CommaDecimalPoint final : public std::numpunct<char>
+{
+    char do_decimal_point() const override
+    {
+        return ',';
+    }
+    char do_thousands_sep() const override
+    {
+        return '.';
+    }
+    std::string do_grouping() const override
+    {
+        return "\3";
+    }
+};
+
+// Puts the global C and C++ locales back the way they were
+struct RestoreLocales final
+{
+    RestoreLocales() :
+        cLocale(setlocale(LC_NUMERIC, nullptr)),
+        cppLocale(std::locale())
+    {
+    }
+    ~RestoreLocales()
+    {
+        setlocale(LC_NUMERIC, cLocale.c_str());
+        std::locale::global(cppLocale);
+    }
+
+    const std::string cLocale;
+    const std::locale cppLocale;
+};
+}
+
+TEST_CASE(testDoublesMatchStreams)
+{
+    for (double value : makeValues<double, uint64_t>())
+    {
+        TEST_ASSERT_EQ(six::details::toString(value, false),
+                       str::toString(value));
+        TEST_ASSERT_EQ(six::toString(value), toScientificString(value));
+    }
+
+    for (double value : {std::numeric_limits<double>::infinity(),
+                         -std::numeric_limits<double>::infinity(),
+                         std::numeric_limits<double>::quiet_NaN()})
+    {
+        TEST_ASSERT_EQ(six::details::toString(value, false),
+                       str::toString(value));
+        TEST_ASSERT_EQ(six::details::toString(value, true),
+                       toScientificString(value));
+    }
+}
+
+TEST_CASE(testFloatsMatchStreams)
+{
+    for (float value : makeValues<float, uint32_t>())
+    {
+        TEST_ASSERT_EQ(six::details::toString(value, false),
+                       str::toString(value));
+        TEST_ASSERT_EQ(six::toString(value), toScientificString(value));
+    }
+}
+
+TEST_CASE(testRoundTrip)
+{
+    for (double value : makeValues<double, uint64_t>())
+    {
+        TEST_ASSERT(isSame(six::details::toDouble(
+                six::details::toString(value, false)), value));
+        TEST_ASSERT(isSame(six::toType<double>(six::toString(value)), value));
+    }
+    for (float value : makeValues<float, uint32_t>())
+    {
+        TEST_ASSERT(isSame(six::details::toFloat(
+                six::details::toString(value, false)), value));
+        TEST_ASSERT(isSame(six::toType<float>(six::toString(value)), value));
+    }
+}
+
+TEST_CASE(testParsing)
+{
+    // Whatever a stream takes
+    for (const std::string s : {"1.5", " \t1.5", "+1.5", "1.5E0", "15e-1",
+                                "1.5xyz", "1.5 2.5", ".15E1"})
+    {
+        TEST_ASSERT_EQ(six::details::toDouble(s), 1.5);
+        TEST_ASSERT_EQ(six::details::toDouble(s), str::toType<double>(s));
+        TEST_ASSERT_EQ(six::details::toFloat(s), 1.5f);
+    }
+    TEST_ASSERT_EQ(six::details::toDouble("-2"), -2.0);
+    TEST_ASSERT_EQ(six::details::toDouble("-.5"), -0.5);
+
+    // and nothing it doesn't
+    for (const std::string s : {"", " ", "abc", "-", "+-1", ".", "inf",
+                                "-inf", "nan", "1e999", "1e", "1.5E-"})
+    {
+        TEST_EXCEPTION(six::details::toDouble(s));
+        TEST_EXCEPTION(six::toType<double>(s));
+        TEST_EXCEPTION(six::details::toFloat(s));
+    }
+}
+
+TEST_CASE(testUnderflow)
+{
+    // Too small to represent is what a stream makes it, not an error
+    for (const std::string s : {"1e-400", "-1e-400", "0.5e-999"})
+    {
+        TEST_ASSERT(isSame(six::details::toDouble(s), str::toType<double>(s)));
+        TEST_ASSERT(isSame(six::toType<double>(s), str::toType<double>(s)));
+    }
+    TEST_ASSERT_EQ(six::details::toDouble("1e-400"), 0.0);
+    TEST_ASSERT_EQ(six::details::toFloat("1e-50"), 0.0f);
+    TEST_ASSERT_EQ(six::toType<float>("-1e-50"), 0.0f);
+}
+
+TEST_CASE(testIgnoresGlobalLocales)
+{
+    const std::string scientific = six::toString(1234.5);
+    const std::string general = six::details::toString(1234.5, false);
+    TEST_ASSERT_EQ(scientific, "1.23450000000000000E03");
+    TEST_ASSERT_EQ(general, "1234.5");
+
+    const RestoreLocales restore;
+    std::locale::global(std::locale(std::locale::classic(),
+                                    new CommaDecimalPoint()));
+    TEST_ASSERT_EQ(six::toString(1234.5), scientific);
+    TEST_ASSERT_EQ(six::details::toString(1234.5, false), general);
+    TEST_ASSERT_EQ(six::details::toDouble(general), 1234.5);
+    TEST_ASSERT_EQ(six::toType<double>(scientific), 1234.5);
+
+    // The C locale too, if there's one installed with a decimal comma
+    for (const char* name : {"de_DE.UTF-8", "de_DE.utf8", "de_DE",
+                             "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR"})
+    {
+        if (setlocale(LC_NUMERIC, name) != nullptr)
+        {
+            TEST_ASSERT_EQ(six::toString(1234.5), scientific);
+            TEST_ASSERT_EQ(six::details::toString(1234.5, false), general);
+            TEST_ASSERT_EQ(six::details::toDouble(general), 1234.5);
+            TEST_ASSERT_EQ(six::details::toFloat(general), 1234.5f);
+            break;
+        }
+    }
+}
+
+TEST_MAIN(
+    TEST_CHECK(testDoublesMatchStreams);
+    TEST_CHECK(testFloatsMatchStreams);
+    TEST_CHECK(testRoundTrip);
+    TEST_CHECK(testParsing);
+    TEST_CHECK(testUnderflow);
+    TEST_CHECK(testIgnoresGlobalLocales);
+)
@@ -23,9 +23,13 @@
 #include <std/filesystem>
 
 #include <six/XMLControl.h>
+#include <fstream>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <logging/NullLogger.h>
+
 #include "six/XmlLite.h"
 
 #include "TestCase.h"
@@ -216,6 +220,123 @@ TEST_CASE(test_six_toType)
 
 }
 
+namespace
+{
+// A tiny schema in a directory of its own, removed when done
+struct SchemaDirectory final
+{
+    SchemaDirectory() :
+        path(std::filesystem::temp_directory_path() /
+             ("six_test_xml_control_" + std::to_string(sys::OS().getProcessId())))
+    {
+        std::filesystem::create_directories(path);
+        std::ofstream schema((path / "example.xsd").string());
+        schema << "<xs:schema xmlns:xs=\"http://www.w3.org/2001/XMLSchema\" "
+                  "targetNamespace=\"urn:example:1.0\" "
+                  "xmlns=\"urn:example:1.0\" elementFormDefault=\"qualified\">"
+                  "<xs:element name=\"Root\"><xs:complexType><xs:sequence>"
+                  "<xs:element name=\"Value\" type=\"xs:int\"/>"
+                  "</xs:sequence></xs:complexType></xs:element>"
+                  "</xs:schema>";
+    }
+    ~SchemaDirectory()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+    SchemaDirectory(const SchemaDirectory&) = delete;
+    SchemaDirectory& operator=(const SchemaDirectory&) = delete;
+
+    const std::filesystem::path path;
+};
+
+std::string makeXml(const std::string& value)
+{
+    return "<Root xmlns=\"urn:example:1.0\"><Value>" + value +
+            "</Value></Root>";
+}
+}
+
+TEST_CASE(validateXmlText)
+{
+    const SchemaDirectory schemas;
+    const std::vector<std::filesystem::path> schemaPaths{schemas.path};
+    logging::NullLogger log;
+    const std::string uri = "urn:example:1.0";
+
+    six::XMLControl::validate(makeXml("42"), uri, &schemaPaths, &log);
+
+    // DES data may be padded with NULs
+    six::XMLControl::validate(makeXml("42") + std::string(3, '\0'), uri,
+                              &schemaPaths, &log);
+
+    TEST_EXCEPTION(six::XMLControl::validate(makeXml("forty-two"), uri,
+                                             &schemaPaths, &log));
+    TEST_EXCEPTION(six::XMLControl::validate(makeXml("42"), "",
+                                             &schemaPaths, &log));
+
+    // The DOM validates the same way
+    six::MinidomParser parser;
+    io::StringStream xmlStream;
+    xmlStream.write(makeXml("42"));
+    parser.parse(xmlStream);
+    six::XMLControl::validate(getDocument(parser), &schemaPaths, &log);
+
+    // Recompiled after clearing
+    six::XMLControl::clearSchemaCache();
+    six::XMLControl::validate(makeXml("42"), uri, &schemaPaths, &log);
+    TEST_EXCEPTION(six::XMLControl::validate(makeXml("forty-two"), uri,
+                                             &schemaPaths, &log));
+}
+
+TEST_CASE(validateConcurrently)
+{
+    const SchemaDirectory schemas;
+    const std::vector<std::filesystem::path> schemaPaths{schemas.path};
+    const std::string uri = "urn:example:1.0";
+
+    // Each thread gets a validator of its own, and the right answers
+    static const size_t NUM_THREADS = 4;
+    std::vector<size_t> numFailures(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < NUM_THREADS; ++thread)
+    {
+        threads.emplace_back([&, thread]()
+        {
+            logging::NullLogger log;
+            for (size_t ii = 0; ii < 20; ++ii)
+            {
+                const bool isValid = (ii + thread) % 2 == 0;
+                try
+                {
+                    six::XMLControl::validate(
+                            makeXml(isValid ? "42" : "forty-two"), uri,
+                            &schemaPaths, &log);
+                    if (!isValid)
+                    {
+                        ++numFailures[thread];
+                    }
+                }
+                catch (const six::DESValidationException&)
+                {
+                    if (isValid)
+                    {
+                        ++numFailures[thread];
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (size_t thread = 0; thread < NUM_THREADS; ++thread)
+    {
+        TEST_ASSERT_EQ(numFailures[thread], static_cast<size_t>(0));
+    }
+}
+
 TEST_MAIN(
     TEST_CHECK(loadCompiledSchemaPath);
     TEST_CHECK(respectGivenPaths);
@@ -223,6 +344,8 @@ TEST_MAIN(
     TEST_CHECK(ignoreEmptyEnvVariable);
     TEST_CHECK(dataTypeToString);
     TEST_CHECK(testXmlLiteAttributeClass);
+    TEST_CHECK(validateXmlText);
+    TEST_CHECK(validateConcurrently);
 
     TEST_CHECK(test_six_toString);
     TEST_CHECK(test_six_toType);
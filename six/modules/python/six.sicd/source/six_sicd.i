@@ -413,6 +413,8 @@ def readFromNITF(pathname, schemaPaths=VectorString()):
     return readNITF(pathname, schemaPaths)
 %}
 
+// Same as the void* overload as far as Python is concerned
+%ignore six::sicd::SICDWriteControl::save(const void*, const types::RowCol<size_t>&, const types::RowCol<size_t>&);
 %include "six/sicd/SICDWriteControl.h"
 %extend six::sicd::SICDWriteControl
 {